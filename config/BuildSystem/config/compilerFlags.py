@@ -149,6 +149,7 @@ class Configure(config.base.Configure):
       if out.find('__AVX2__') > -1 and out.find('__FMA__') > -1:
         self.text = self.text + 'Intel instruction sets utilizable by compiler:\n'
         self.text = self.text + '  AVX2\n'
+        if self.language[-1] == 'C': self.addDefine('HAVE_AVX2_FMA', 1)
       if out.find('__AVX512__') > -1:
         self.text = self.text + '  AVX512\n'
     except:
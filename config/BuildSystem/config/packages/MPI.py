@@ -551,6 +551,11 @@ Unable to run hostname to check the network')
       if (MPI_Irecv_c(buf,count,MPI_INT,source,tag,MPI_COMM_WORLD,&req)) return 1;
     '''):
       self.addDefine('HAVE_MPI_LARGE_COUNT', 1)
+    if self.checkLink('#include <mpi.h>\n',
+                      'MPI_Comm distcomm = MPI_COMM_NULL; \n\
+                       MPI_Request req; \n\
+                       if (MPI_Neighbor_alltoallv_init(0,0,0,MPI_INT,0,0,0,MPI_INT,distcomm,MPI_INFO_NULL,&req)) { }\n'):
+      self.addDefine('HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES', 1)
 
     self.compilers.CPPFLAGS = oldFlags
     self.compilers.LIBS = oldLibs
@@ -329,6 +329,8 @@ typedef struct {
   char     pending;
 } MatStashFrame;
 
+typedef struct _n_MatStashPlan *MatStashPlan; /* frozen communication of the BTS stash, see matstash.c */
+
 typedef struct _MatStash MatStash;
 struct _MatStash {
   PetscInt           nmax;              /* maximum stash size */
@@ -387,6 +389,8 @@ struct _MatStash {
   MPI_Datatype    blocktype;
   size_t          blocktype_size;
   InsertMode     *insertmode; /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+  PetscBool       persistent; /* -matstash_persistent, with MAT_SUBSET_OFF_PROC_ENTRIES reuse the messages of the first assembly */
+  MatStashPlan    plan;       /* persistent requests and buffers, set up at the end of the first assembly when persistent */
 };
 
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -578,6 +582,7 @@ struct _p_MatCoarsen {
 
 PETSC_EXTERN PetscErrorCode MatCoarsenMISKSetDistance(MatCoarsen, PetscInt);
 PETSC_EXTERN PetscErrorCode MatCoarsenMISKGetDistance(MatCoarsen, PetscInt *);
+PETSC_INTERN PetscErrorCode MatCoarsenMISKApply_Private(IS, const PetscInt, Mat, PetscErrorCode (*)(IS, Mat, PetscCoarsenData **, PetscInt *), PetscCoarsenData **);
 
 /*
     Used in aijdevice.h
@@ -1631,6 +1636,7 @@ PETSC_EXTERN PetscLogEvent MAT_Mult;
 PETSC_EXTERN PetscLogEvent MAT_MultMatrixFree;
 PETSC_EXTERN PetscLogEvent MAT_Mults;
 PETSC_EXTERN PetscLogEvent MAT_MultAdd;
+PETSC_EXTERN PetscLogEvent MAT_MatrixPowers;
 PETSC_EXTERN PetscLogEvent MAT_MultTranspose;
 PETSC_EXTERN PetscLogEvent MAT_MultTransposeAdd;
 PETSC_EXTERN PetscLogEvent MAT_Solve;
@@ -48,6 +48,8 @@ typedef struct gamg_TAG {
 
   PetscBool use_sa_esteig;
   PetscReal emin, emax;
+  PetscInt  recompute_esteig; /* refresh the SA eigen estimates every recompute_esteig setups that reuse the interpolation, 0 for never */
+  PetscInt  nreuse;           /* number of setups that reused the interpolation since the hierarchy was built */
 } PC_GAMG;
 
 PetscErrorCode PCReset_MG(PC);
@@ -61,6 +63,7 @@ PetscErrorCode PCDestroy_GAMG(PC);
 
 /* helper methods */
 PetscErrorCode PCGAMGGetDataWithGhosts(Mat, PetscInt, PetscReal[], PetscInt *, PetscReal **);
+PETSC_INTERN PetscErrorCode PCGAMGComputeEstEig_Internal(PC, Mat, PetscReal *, PetscReal *);
 
 enum tag {
   GAMG_SETUP = 0,
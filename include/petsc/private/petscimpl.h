@@ -1353,6 +1353,7 @@ typedef struct {
   PetscInt maxops;                    /* total amount of space we have for requests */
   PetscInt numopsbegin;               /* number of requests that have been queued in */
   PetscInt numopsend;                 /* number of requests that have been gotten by user */
+  struct _n_VecReductionBatch *batch; /* open batch of the asynchronous reduction queue, see VecDotAsync() */
 } PetscSplitReduction;
 
 PETSC_EXTERN PetscErrorCode PetscSplitReductionGet(MPI_Comm, PetscSplitReduction **);
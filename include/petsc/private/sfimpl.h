@@ -68,6 +68,8 @@ struct _PetscSFOps {
 
 typedef struct _n_PetscSFPackOpt *PetscSFPackOpt;
 
+typedef struct _n_PetscSFBatch *PetscSFBatch;
+
 struct _p_PetscSF {
   PETSCHEADER(struct _PetscSFOps);
   struct {                                  /* Fields needed to implement VecScatter behavior */
@@ -113,6 +115,8 @@ struct _p_PetscSF {
   MPI_Group      ingroup;              /* Group of processes connected to my roots */
   MPI_Group      outgroup;             /* Group of processes connected to my leaves */
   PetscSF        multi;                /* Internal graph used to implement gather and scatter operations */
+  PetscSF        batchsf;              /* Internal graph from the edges to the leaves, used by PetscSFBcastBatchBegin(). Built on demand */
+  PetscSFBatch   batches;              /* Buffers of batched broadcasts, for each sequence of datatypes used */
   PetscBool      graphset;             /* Flag indicating that the graph has been set, required before calling communication routines */
   PetscBool      setupcalled;          /* Type and communication structures have been set up */
   PetscSFPattern pattern;              /* Pattern of the graph */
@@ -108,6 +108,8 @@ struct _VecOps {
   PetscErrorCode (*sum)(Vec, PetscScalar *);
   PetscErrorCode (*setpreallocationcoo)(Vec, PetscCount, const PetscInt[]);
   PetscErrorCode (*setvaluescoo)(Vec, const PetscScalar[], InsertMode);
+  PetscErrorCode (*maxpymdot)(Vec, PetscInt, const PetscScalar *, Vec *, PetscScalar *, PetscReal *); /* y = y + alpha[j] x[j], z[j] = y dot x[j], nrm = ||y||_2 */
+  PetscErrorCode (*waxpydotnorm)(Vec, PetscScalar, Vec, Vec, Vec, PetscScalar *, PetscReal *);   /* w = y + alpha x, val = w dot z, nrm = ||w||_2 */
 };
 
 #if defined(offsetof) && (defined(__cplusplus) || (PETSC_C_VERSION >= 11))
@@ -197,6 +199,8 @@ PETSC_EXTERN PetscLogEvent VEC_AXPY;
 PETSC_EXTERN PetscLogEvent VEC_AYPX;
 PETSC_EXTERN PetscLogEvent VEC_WAXPY;
 PETSC_EXTERN PetscLogEvent VEC_MAXPY;
+PETSC_EXTERN PetscLogEvent VEC_MAXPYMDot;
+PETSC_EXTERN PetscLogEvent VEC_WAXPYDotNorm;
 PETSC_EXTERN PetscLogEvent VEC_AssemblyEnd;
 PETSC_EXTERN PetscLogEvent VEC_PointwiseMult;
 PETSC_EXTERN PetscLogEvent VEC_SetValues;
@@ -234,7 +238,11 @@ PETSC_EXTERN PetscErrorCode VecViennaCLCopyFromGPU(Vec v);
 #define VECHEADER \
   PetscScalar *array; \
   PetscScalar *array_allocated; /* if the array was allocated by PETSc this is its pointer */ \
-  PetscScalar *unplacedarray;   /* if one called VecPlaceArray(), this is where it stashed the original */
+  PetscScalar *unplacedarray;   /* if one called VecPlaceArray(), this is where it stashed the original */ \
+  PetscInt     nthreads;        /* number of threads used by the host kernels, see -vec_threads */ \
+  PetscInt    *threadstart;     /* if set, thread t processes the entries [threadstart[t], threadstart[t+1]), otherwise equal chunks */
+
+PETSC_EXTERN PetscErrorCode VecThreadsSetPartition_Private(Vec, PetscInt, const PetscInt[]);
 
 /* Get Root type of vector. e.g. VECSEQ -> VECSTANDARD, VECMPICUDA -> VECCUDA */
 PETSC_EXTERN PetscErrorCode VecGetRootType_Private(Vec, VecType *);
@@ -41,6 +41,7 @@ typedef const char *KSPType;
 #define KSPPIPELCG    "pipelcg"
 #define KSPPIPEPRCG   "pipeprcg"
 #define KSPPIPECG2    "pipecg2"
+#define KSPCACG       "cacg"
 #define KSPCGNE       "cgne"
 #define KSPNASH       "nash"
 #define KSPSTCG       "stcg"
@@ -56,6 +57,7 @@ typedef const char *KSPType;
 #define KSPLGMRES     "lgmres"
 #define KSPDGMRES     "dgmres"
 #define KSPPGMRES     "pgmres"
+#define KSPCAGMRES    "cagmres"
 #define KSPTCQMR      "tcqmr"
 #define KSPBCGS       "bcgs"
 #define KSPIBCGS      "ibcgs"
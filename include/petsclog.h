@@ -191,6 +191,9 @@ typedef struct {
   PetscLogDouble mallocIncrease;      /* How much the maximum malloced space has increased in this event */
   PetscLogDouble mallocSpace;         /* How much the space was malloced and kept during this event */
   PetscLogDouble mallocIncreaseEvent; /* Maximum of the high water mark with in event minus memory available at the end of the event */
+  PetscLogDouble hwCycles;            /* The CPU cycles counted by the hardware counters in this event */
+  PetscLogDouble hwInstructions;      /* The instructions retired in this event */
+  PetscLogDouble hwCacheMisses;       /* The last level cache misses in this event */
 #if defined(PETSC_HAVE_DEVICE)
   PetscLogDouble CpuToGpuCount; /* The total number of CPU to GPU copies */
   PetscLogDouble GpuToCpuCount; /* The total number of GPU to CPU copies */
@@ -285,6 +288,8 @@ PETSC_EXTERN PetscErrorCode PetscLogDefaultBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogAllBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogNestedBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogTraceBegin(FILE *);
+PETSC_EXTERN PetscErrorCode PetscLogChromeTraceBegin(PetscInt);
+PETSC_EXTERN PetscErrorCode PetscLogHWCountersBegin(void);
 PETSC_EXTERN PetscErrorCode PetscLogActions(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogObjects(PetscBool);
 PETSC_EXTERN PetscErrorCode PetscLogSetThreshold(PetscLogDouble, PetscLogDouble *);
@@ -294,6 +299,7 @@ PETSC_EXTERN PetscErrorCode PetscLogSet(PetscErrorCode (*)(int, int, PetscObject
 PETSC_EXTERN PetscErrorCode PetscLogView(PetscViewer);
 PETSC_EXTERN PetscErrorCode PetscLogViewFromOptions(void);
 PETSC_EXTERN PetscErrorCode PetscLogDump(const char[]);
+PETSC_EXTERN PetscErrorCode PetscLogChromeTraceDump(const char[]);
 
 /* Status checking functions */
 PETSC_EXTERN PetscErrorCode PetscLogIsActive(PetscBool *);
@@ -328,6 +334,7 @@ PETSC_EXTERN PetscErrorCode PetscLogPushCurrentEvent_Internal(PetscLogEvent);
 PETSC_EXTERN PetscErrorCode PetscLogPopCurrentEvent_Internal(void);
 
 PETSC_EXTERN PetscBool PetscLogMemory;
+PETSC_EXTERN PetscBool PetscLogHWCounters;
 
 PETSC_EXTERN PetscBool      PetscLogSyncOn; /* true if logging synchronization is enabled */
 PETSC_EXTERN PetscErrorCode PetscLogEventSynchronize(PetscLogEvent, MPI_Comm);
@@ -592,7 +599,8 @@ static inline int PetscMPIParallelComm(MPI_Comm comm)
 
 #else /* ---Logging is turned off --------------------------------------------*/
 
-  #define PetscLogMemory PETSC_FALSE
+  #define PetscLogMemory     PETSC_FALSE
+  #define PetscLogHWCounters PETSC_FALSE
 
   #define PetscLogFlops(n) ((void)(n), PETSC_SUCCESS)
   #define PetscGetFlops(a) (*(a) = 0.0, PETSC_SUCCESS)
@@ -632,19 +640,22 @@ static inline int PetscMPIParallelComm(MPI_Comm comm)
   #define PetscLogObjectDestroy(h)       PETSC_SUCCESS
 PETSC_EXTERN PetscErrorCode PetscLogObjectState(PetscObject, const char[], ...) PETSC_ATTRIBUTE_FORMAT(2, 3);
 
-  #define PetscLogDefaultBegin()     PETSC_SUCCESS
-  #define PetscLogAllBegin()         PETSC_SUCCESS
-  #define PetscLogNestedBegin()      PETSC_SUCCESS
-  #define PetscLogTraceBegin(file)   PETSC_SUCCESS
-  #define PetscLogActions(a)         PETSC_SUCCESS
-  #define PetscLogObjects(a)         PETSC_SUCCESS
-  #define PetscLogSetThreshold(a, b) PETSC_SUCCESS
-  #define PetscLogSet(lb, le)        PETSC_SUCCESS
-  #define PetscLogIsActive(flag)     (*(flag) = PETSC_FALSE, PETSC_SUCCESS)
-
-  #define PetscLogView(viewer)      PETSC_SUCCESS
-  #define PetscLogViewFromOptions() PETSC_SUCCESS
-  #define PetscLogDump(c)           PETSC_SUCCESS
+  #define PetscLogDefaultBegin()      PETSC_SUCCESS
+  #define PetscLogAllBegin()          PETSC_SUCCESS
+  #define PetscLogNestedBegin()       PETSC_SUCCESS
+  #define PetscLogTraceBegin(file)    PETSC_SUCCESS
+  #define PetscLogChromeTraceBegin(n) PETSC_SUCCESS
+  #define PetscLogHWCountersBegin()   PETSC_SUCCESS
+  #define PetscLogActions(a)          PETSC_SUCCESS
+  #define PetscLogObjects(a)          PETSC_SUCCESS
+  #define PetscLogSetThreshold(a, b)  PETSC_SUCCESS
+  #define PetscLogSet(lb, le)         PETSC_SUCCESS
+  #define PetscLogIsActive(flag)      (*(flag) = PETSC_FALSE, PETSC_SUCCESS)
+
+  #define PetscLogView(viewer)       PETSC_SUCCESS
+  #define PetscLogViewFromOptions()  PETSC_SUCCESS
+  #define PetscLogDump(c)            PETSC_SUCCESS
+  #define PetscLogChromeTraceDump(c) PETSC_SUCCESS
 
   #define PetscLogEventSync(e, comm)                            PETSC_SUCCESS
   #define PetscLogEventBegin(e, o1, o2, o3, o4)                 PETSC_SUCCESS
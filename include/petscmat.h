@@ -61,6 +61,10 @@ typedef const char *MatType;
 #define MATAIJPERM                   "aijperm"
 #define MATSEQAIJPERM                "seqaijperm"
 #define MATMPIAIJPERM                "mpiaijperm"
+#define MATSEQAIJCOMPRESSED          "seqaijcompressed"
+#define MATAIJMIXED                  "aijmixed"
+#define MATSEQAIJMIXED               "seqaijmixed"
+#define MATMPIAIJMIXED               "mpiaijmixed"
 #define MATAIJSELL                   "aijsell"
 #define MATSEQAIJSELL                "seqaijsell"
 #define MATMPIAIJSELL                "mpiaijsell"
@@ -436,7 +440,10 @@ PETSC_EXTERN PetscErrorCode MatCreateLRC(Mat, Mat, Vec, Mat, Mat *);
 PETSC_EXTERN PetscErrorCode MatLRCGetMats(Mat, Mat *, Mat *, Vec *, Mat *);
 PETSC_EXTERN PetscErrorCode MatCreateIS(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscInt, ISLocalToGlobalMapping, ISLocalToGlobalMapping, Mat *);
 PETSC_EXTERN PetscErrorCode MatCreateSeqAIJCRL(MPI_Comm, PetscInt, PetscInt, PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateSeqAIJCompressed(MPI_Comm, PetscInt, PetscInt, PetscInt, const PetscInt[], Mat *);
 PETSC_EXTERN PetscErrorCode MatCreateMPIAIJCRL(MPI_Comm, PetscInt, PetscInt, PetscInt, const PetscInt[], PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateSeqAIJMixed(MPI_Comm, PetscInt, PetscInt, PetscInt, const PetscInt[], Mat *);
+PETSC_EXTERN PetscErrorCode MatCreateMPIAIJMixed(MPI_Comm, PetscInt, PetscInt, PetscInt, PetscInt, PetscInt, const PetscInt[], PetscInt, const PetscInt[], Mat *);
 
 PETSC_EXTERN PetscErrorCode MatCreateScatter(MPI_Comm, VecScatter, Mat *);
 PETSC_EXTERN PetscErrorCode MatScatterSetVecScatter(Mat, VecScatter);
@@ -597,7 +604,8 @@ typedef enum {
   MAT_FORM_EXPLICIT_TRANSPOSE     = 24,
   MAT_STRUCTURAL_SYMMETRY_ETERNAL = 25,
   MAT_SPD_ETERNAL                 = 26,
-  MAT_OPTION_MAX                  = 27
+  MAT_THREAD_SAFE_ADD             = 27,
+  MAT_OPTION_MAX                  = 28
 } MatOption;
 
 PETSC_EXTERN const char *const *MatOptions;
@@ -665,6 +673,7 @@ PETSC_EXTERN PetscErrorCode MatDenseRestoreSubMatrix(Mat, Mat *);
 PETSC_EXTERN PetscErrorCode MatMult(Mat, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatMultDiagonalBlock(Mat, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatMultAdd(Mat, Vec, Vec, Vec);
+PETSC_EXTERN PetscErrorCode MatMatrixPowers(Mat, PetscInt, Vec, Vec[]);
 PETSC_EXTERN PetscErrorCode MatMultTranspose(Mat, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatMultHermitianTranspose(Mat, Vec, Vec);
 PETSC_EXTERN PetscErrorCode MatIsTranspose(Mat, Mat, PetscReal, PetscBool *);
@@ -2000,9 +2009,13 @@ PETSC_EXTERN PetscErrorCode MatIsShell(Mat, PetscBool *);
    PetscViewerPushFormat(viewer,PETSC_VIEWER_NATIVE); the matrices will
    be stored in a way natural for the matrix, for example dense matrices
    would be stored as dense. Matrices stored this way may only be
-   read into matrices of the same type.
+   read into matrices of the same type. If the viewer is also set with
+   PetscViewerBinarySetUseMmap(), sequential AIJ matrices are stored with their
+   arrays in native byte order, aligned in the file, so that they can be used
+   directly from a mapped file; only MATSEQAIJ can load them.
 */
-#define MATRIX_BINARY_FORMAT_DENSE -1
+#define MATRIX_BINARY_FORMAT_DENSE      -1
+#define MATRIX_BINARY_FORMAT_AIJ_NATIVE -2
 
 PETSC_EXTERN PetscErrorCode MatMPIBAIJSetHashTableFactor(Mat, PetscReal);
 
@@ -31,6 +31,7 @@ typedef const char *MatCoarsenType;
 #define MATCOARSENMIS  "mis"
 #define MATCOARSENHEM  "hem"
 #define MATCOARSENMISK "misk"
+#define MATCOARSENLUBY "luby"
 
 /* linked list for aggregates */
 typedef struct _PetscCDIntNd {
@@ -330,6 +330,7 @@ PETSC_EXTERN PetscErrorCode PCGAMGSetNSmooths(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetSquareGraph(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetAggressiveLevels(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetReuseInterpolation(PC, PetscBool);
+PETSC_EXTERN PetscErrorCode PCGAMGSetRecomputeEstEig(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGFinalizePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGInitializePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGRegister(PCGAMGType, PetscErrorCode (*)(PC));
@@ -423,6 +424,9 @@ PETSC_EXTERN PetscErrorCode PCHMGSetInnerPCType(PC, PCType);
 PETSC_EXTERN PetscErrorCode PCHMGSetCoarseningComponent(PC, PetscInt);
 PETSC_EXTERN PetscErrorCode PCHMGUseMatMAIJ(PC, PetscBool);
 
+PETSC_EXTERN PetscErrorCode PCChowILUSetLevels(PC, PetscInt);
+PETSC_EXTERN PetscErrorCode PCChowILUSetSweeps(PC, PetscInt, PetscInt);
+
 PETSC_EXTERN PetscErrorCode PCTelescopeGetSubcommType(PC, PetscSubcommType *);
 PETSC_EXTERN PetscErrorCode PCTelescopeSetSubcommType(PC, PetscSubcommType);
 PETSC_EXTERN PetscErrorCode PCTelescopeGetReductionFactor(PC, PetscInt *);
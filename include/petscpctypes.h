@@ -65,6 +65,7 @@ typedef const char *PCType;
 #define PCSVD                "svd"
 #define PCGAMG               "gamg"
 #define PCCHOWILUVIENNACL    "chowiluviennacl"
+#define PCCHOWILU            "chowilu"
 #define PCROWSCALINGVIENNACL "rowscalingviennacl"
 #define PCSAVIENNACL         "saviennacl"
 #define PCBDDC               "bddc"
@@ -313,8 +313,10 @@ PETSC_EXTERN PetscErrorCode VecSwap(Vec, Vec);
 PETSC_EXTERN PetscErrorCode VecAXPY(Vec, PetscScalar, Vec);
 PETSC_EXTERN PetscErrorCode VecAXPBY(Vec, PetscScalar, PetscScalar, Vec);
 PETSC_EXTERN PetscErrorCode VecMAXPY(Vec, PetscInt, const PetscScalar[], Vec[]);
+PETSC_EXTERN PetscErrorCode VecMAXPYMDot(Vec, PetscInt, const PetscScalar[], Vec[], PetscScalar[], PetscReal *);
 PETSC_EXTERN PetscErrorCode VecAYPX(Vec, PetscScalar, Vec);
 PETSC_EXTERN PetscErrorCode VecWAXPY(Vec, PetscScalar, Vec, Vec);
+PETSC_EXTERN PetscErrorCode VecWAXPYDotNorm(Vec, PetscScalar, Vec, Vec, Vec, PetscScalar *, PetscReal *);
 PETSC_EXTERN PetscErrorCode VecAXPBYPCZ(Vec, PetscScalar, PetscScalar, PetscScalar, Vec, Vec);
 PETSC_EXTERN PetscErrorCode VecPointwiseMax(Vec, Vec, Vec);
 PETSC_EXTERN PetscErrorCode VecPointwiseMaxAbs(Vec, Vec, Vec);
@@ -546,6 +548,25 @@ PETSC_EXTERN PetscErrorCode VecMTDotBegin(Vec, PetscInt, const Vec[], PetscScala
 PETSC_EXTERN PetscErrorCode VecMTDotEnd(Vec, PetscInt, const Vec[], PetscScalar[]);
 PETSC_EXTERN PetscErrorCode PetscCommSplitReductionBegin(MPI_Comm);
 
+/*S
+   VecReduction - handle to a global reduction queued with `VecDotAsync()`, `VecNormAsync()` and related routines
+
+   Level: advanced
+
+.seealso: `VecDotAsync()`, `VecTDotAsync()`, `VecMDotAsync()`, `VecNormAsync()`, `PetscCommReductionFlush()`, `VecReductionTest()`,
+          `VecReductionGetValues()`, `VecReductionGetNorm()`, `VecReductionDestroy()`
+S*/
+typedef struct _n_VecReduction *VecReduction;
+PETSC_EXTERN PetscErrorCode VecDotAsync(Vec, Vec, VecReduction *);
+PETSC_EXTERN PetscErrorCode VecTDotAsync(Vec, Vec, VecReduction *);
+PETSC_EXTERN PetscErrorCode VecMDotAsync(Vec, PetscInt, const Vec[], VecReduction *);
+PETSC_EXTERN PetscErrorCode VecNormAsync(Vec, NormType, VecReduction *);
+PETSC_EXTERN PetscErrorCode PetscCommReductionFlush(MPI_Comm);
+PETSC_EXTERN PetscErrorCode VecReductionTest(VecReduction, PetscBool *);
+PETSC_EXTERN PetscErrorCode VecReductionGetValues(VecReduction, PetscScalar[]);
+PETSC_EXTERN PetscErrorCode VecReductionGetNorm(VecReduction, PetscReal[]);
+PETSC_EXTERN PetscErrorCode VecReductionDestroy(VecReduction *);
+
 PETSC_EXTERN PetscErrorCode VecBindToCPU(Vec, PetscBool);
 PETSC_DEPRECATED_FUNCTION("Use VecBindToCPU (since v3.13)") static inline PetscErrorCode VecPinToCPU(Vec v, PetscBool flg)
 {
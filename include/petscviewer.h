@@ -53,6 +53,10 @@ PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetFlowControl(PetscViewer, PetscIn
 PETSC_EXTERN PetscErrorCode PetscViewerBinarySetFlowControl(PetscViewer, PetscInt);
 PETSC_EXTERN PetscErrorCode PetscViewerBinarySetUseMPIIO(PetscViewer, PetscBool);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetUseMPIIO(PetscViewer, PetscBool *);
+PETSC_EXTERN PetscErrorCode PetscViewerBinarySetUseMmap(PetscViewer, PetscBool);
+PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetUseMmap(PetscViewer, PetscBool *);
+PETSC_EXTERN PetscErrorCode PetscViewerBinaryReadMapped(PetscViewer, void **, PetscInt, PetscDataType, PetscObject *);
+PETSC_EXTERN PetscErrorCode PetscViewerBinaryAlign(PetscViewer, PetscInt);
 #if defined(PETSC_HAVE_MPIIO)
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetMPIIODescriptor(PetscViewer, MPI_File *);
 PETSC_EXTERN PetscErrorCode PetscViewerBinaryGetMPIIOOffset(PetscViewer, MPI_Offset *);
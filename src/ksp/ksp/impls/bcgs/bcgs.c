@@ -3,8 +3,13 @@
 
 PetscErrorCode KSPSetFromOptions_BCGS(KSP ksp, PetscOptionItems *PetscOptionsObject)
 {
+  KSP_BCGS *bcgs = (KSP_BCGS *)ksp->data;
+  PetscBool isbcgs;
+
   PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)ksp, KSPBCGS, &isbcgs));
   PetscOptionsHeadBegin(PetscOptionsObject, "KSP BCGS Options");
+  if (isbcgs) PetscCall(PetscOptionsBool("-ksp_bcgs_fused", "Fuse the residual update with its norm and the next inner product", "VecWAXPYDotNorm", bcgs->fused, &bcgs->fused, NULL));
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -19,7 +24,7 @@ PetscErrorCode KSPSetUp_BCGS(KSP ksp)
 PetscErrorCode KSPSolve_BCGS(KSP ksp)
 {
   PetscInt    i;
-  PetscScalar rho, rhoold, alpha, beta, omega, omegaold, d1;
+  PetscScalar rho, rhoold, alpha, beta, omega, omegaold, d1, rhonext = 0.0;
   Vec         X, B, V, P, R, RP, T, S;
   PetscReal   dp   = 0.0, d2;
   KSP_BCGS   *bcgs = (KSP_BCGS *)ksp->data;
@@ -72,7 +77,8 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
 
   i = 0;
   do {
-    PetscCall(VecDot(R, RP, &rho)); /*   rho <- (r,rp)      */
+    if (bcgs->fused && i) rho = rhonext; /* computed with the update of r below */
+    else PetscCall(VecDot(R, RP, &rho)); /*   rho <- (r,rp)      */
     beta = (rho / rhoold) * (alpha / omegaold);
     PetscCall(VecAXPBYPCZ(P, 1.0, -omegaold * beta, beta, R, V)); /* p <- r - omega * beta* v + beta * p */
     PetscCall(KSP_PCApplyBAorAB(ksp, P, V, T));                   /*   v <- K p           */
@@ -110,7 +116,11 @@ PetscErrorCode KSPSolve_BCGS(KSP ksp)
     }
     omega = d1 / d2;                                    /*   w <- (t's) / (t't) */
     PetscCall(VecAXPBYPCZ(X, alpha, omega, 1.0, P, S)); /* x <- alpha * p + omega * s + x */
-    PetscCall(VecWAXPY(R, -omega, T, S));               /*   r <- s - w t       */
+    /*   r <- s - w t       */
+    if (bcgs->fused) {
+      /* together with the rho of the next iteration, the norm is cached in R for the VecNorm() below */
+      PetscCall(VecWAXPYDotNorm(R, -omega, T, S, RP, &rhonext, ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i + 2 ? &dp : NULL));
+    } else PetscCall(VecWAXPY(R, -omega, T, S));
     if (ksp->normtype != KSP_NORM_NONE && ksp->chknorm < i + 2) {
       PetscCall(VecNorm(R, NORM_2, &dp));
       KSPCheckNorm(ksp, dp);
@@ -183,6 +193,10 @@ PetscErrorCode KSPDestroy_BCGS(KSP ksp)
 /*MC
      KSPBCGS - Implements the BiCGStab (Stabilized version of Biconjugate Gradient) method.
 
+   Options Database Key:
+.   -ksp_bcgs_fused - computes the residual update, its norm and the inner product (r,rp) of the next iteration in one pass over the vectors
+                      with a single reduction, see `VecWAXPYDotNorm()`
+
    Level: beginner
 
    Notes:
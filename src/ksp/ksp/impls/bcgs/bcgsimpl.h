@@ -9,7 +9,8 @@
 #include <petsc/private/kspimpl.h> /*I "petscksp.h" I*/
 
 typedef struct {
-  Vec guess; /* if using right preconditioning with nonzero initial guess must keep that around to "fix" solution */
+  Vec       guess; /* if using right preconditioning with nonzero initial guess must keep that around to "fix" solution */
+  PetscBool fused; /* KSPBCGS only: fuse the residual update with its norm and the next (r,rp), see VecWAXPYDotNorm() */
 } KSP_BCGS;
 
 PETSC_INTERN PetscErrorCode KSPSetFromOptions_BCGS(KSP, PetscOptionItems *PetscOptionsObject);
@@ -0,0 +1,460 @@
+#include <petsc/private/kspimpl.h>
+#include <petscblaslapack.h>
+
+typedef enum {
+  KSP_CACG_BASIS_MONOMIAL,
+  KSP_CACG_BASIS_NEWTON,
+  KSP_CACG_BASIS_CHEBYSHEV
+} KSPCACGBasisType;
+static const char *const KSPCACGBasisTypes[] = {"monomial", "newton", "chebyshev", "KSPCACGBasisType", "KSP_CACG_BASIS_", NULL};
+
+/*
+   The s-step basis of a vector y_0 is built with the three term recurrence
+
+     y_{i+1} = ((B A - theta_i) y_i - gamma_i y_{i-1}) / beta_i
+
+   The preconditioned vectors Y are stored together with the unpreconditioned ones W, Y = B W, so that the inner
+   products of CG are available from the Gram matrix G = Y^H W. With n = 2s + 1 the basis is
+
+     Y = [p_0, ..., p_s, z_0, ..., z_{s-1}]   W = [q_0, ..., q_s, r_0, ..., r_{s-1}]
+
+   and the CG iteration is run for s steps on the coordinates of p, r and x in this basis.
+*/
+typedef struct {
+  PetscInt         s;                    /* number of iterations per global reduction */
+  KSPCACGBasisType basis;                /* polynomial basis */
+  PetscReal        lmin, lmax;           /* eigenvalue estimates of the preconditioned operator */
+  PetscBool        haveeig;              /* lmin and lmax are known, otherwise they are computed from the first s iterations */
+  PetscBool        esteig;               /* lmin and lmax were computed, for the operators below, and not given by the user */
+  PetscObjectId    matid[2];             /* ids and states of the operator and preconditioning matrix of the estimates */
+  PetscObjectState matstate[2];
+  PetscReal       *theta, *gamma, *beta; /* coefficients of the basis recurrence */
+  PetscReal       *la, *lb;              /* CG coefficients of the first s iterations, for the eigenvalue estimates */
+  PetscScalar     *G, *Gr;               /* Gram matrices Y^H W and W^H W */
+  PetscScalar     *pc, *rc, *xc, *tc;    /* coordinates of p, r, x and a work array */
+} KSP_CACG;
+
+static PetscErrorCode KSPCACGSetBasis_Private(KSP ksp)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+  PetscInt  i, s = cacg->s;
+  PetscReal c = 0.5 * (cacg->lmax + cacg->lmin), d = 0.5 * (cacg->lmax - cacg->lmin);
+
+  PetscFunctionBegin;
+  for (i = 0; i < s; i++) {
+    cacg->theta[i] = 0.0;
+    cacg->gamma[i] = 0.0;
+    cacg->beta[i]  = 1.0;
+  }
+  if (!cacg->haveeig) PetscFunctionReturn(PETSC_SUCCESS);
+  if (cacg->basis == KSP_CACG_BASIS_MONOMIAL || d <= 0.0) {
+    if (cacg->lmax > 0.0)
+      for (i = 0; i < s; i++) cacg->beta[i] = cacg->lmax;
+  } else if (cacg->basis == KSP_CACG_BASIS_NEWTON) {
+    /* Chebyshev points of [lmin, lmax] in Leja order, scaled by the capacity of the interval */
+    PetscBool *used;
+
+    PetscCall(PetscCalloc1(s, &used));
+    for (i = 0; i < s; i++) {
+      PetscInt  k, kbest = -1;
+      PetscReal best = PETSC_MIN_REAL;
+
+      for (k = 0; k < s; k++) {
+        PetscReal x = c + d * PetscCosReal(PETSC_PI * (2.0 * k + 1.0) / (2.0 * s)), score = 0.0;
+
+        if (used[k]) continue;
+        if (!i) score = PetscAbsReal(x);
+        for (PetscInt j = 0; j < i; j++) score += PetscLogReal(PetscAbsReal(x - cacg->theta[j]));
+        if (kbest < 0 || score > best) {
+          kbest = k;
+          best  = score;
+        }
+      }
+      used[kbest]    = PETSC_TRUE;
+      cacg->theta[i] = c + d * PetscCosReal(PETSC_PI * (2.0 * kbest + 1.0) / (2.0 * s));
+      cacg->beta[i]  = 0.5 * d;
+    }
+    PetscCall(PetscFree(used));
+  } else {
+    /* Chebyshev polynomials of the first kind shifted and scaled to [lmin, lmax] */
+    for (i = 0; i < s; i++) {
+      cacg->theta[i] = c;
+      cacg->gamma[i] = i ? 0.5 * d : 0.0;
+      cacg->beta[i]  = i ? 0.5 * d : d;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPCACGGetOperatorState_Private(KSP ksp, PetscObjectId id[2], PetscObjectState state[2])
+{
+  Mat A[2];
+
+  PetscFunctionBegin;
+  PetscCall(KSPGetOperators(ksp, &A[0], &A[1]));
+  for (PetscInt i = 0; i < 2; i++) {
+    PetscCall(PetscObjectGetId((PetscObject)A[i], &id[i]));
+    PetscCall(PetscObjectStateGet((PetscObject)A[i], &state[i]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* eigenvalue estimates from the Lanczos tridiagonal matrix of the first s CG iterations */
+static PetscErrorCode KSPCACGEstimateEigenvalues_Private(KSP ksp, PetscInt n)
+{
+  KSP_CACG    *cacg = (KSP_CACG *)ksp->data;
+  PetscReal   *d, *e, work = 0.0, z = 0.0;
+  PetscBLASInt bn, ldz = 1, info;
+
+  PetscFunctionBegin;
+  if (n < 2) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc2(n, &d, n, &e));
+  for (PetscInt j = 0; j < n; j++) {
+    d[j] = 1.0 / cacg->la[j] + (j ? cacg->lb[j - 1] / cacg->la[j - 1] : 0.0);
+    e[j] = j < n - 1 ? PetscSqrtReal(cacg->lb[j]) / cacg->la[j] : 0.0;
+  }
+  PetscCall(PetscBLASIntCast(n, &bn));
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+  PetscCallBLAS("LAPACKsteqr", LAPACKREALsteqr_("N", &bn, d, e, &z, &ldz, &work, &info));
+  PetscCall(PetscFPTrapPop());
+  if (!info && d[0] > 0.0) {
+    cacg->lmin    = d[0];
+    cacg->lmax    = d[n - 1];
+    cacg->haveeig = PETSC_TRUE;
+    cacg->esteig  = PETSC_TRUE;
+    PetscCall(KSPCACGGetOperatorState_Private(ksp, cacg->matid, cacg->matstate));
+    PetscCall(PetscInfo(ksp, "Eigenvalue estimates for the s-step basis %g %g\n", (double)cacg->lmin, (double)cacg->lmax));
+    PetscCall(KSPCACGSetBasis_Private(ksp));
+  }
+  PetscCall(PetscFree2(d, e));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetUp_CACG(KSP ksp)
+{
+  KSP_CACG        *cacg = (KSP_CACG *)ksp->data;
+  PetscInt         s = cacg->s, n = 2 * s + 1;
+  PetscObjectId    id[2];
+  PetscObjectState state[2];
+
+  PetscFunctionBegin;
+  if (cacg->esteig) { /* the estimates are computed again if the operators have changed since */
+    PetscCall(KSPCACGGetOperatorState_Private(ksp, id, state));
+    if (id[0] != cacg->matid[0] || id[1] != cacg->matid[1] || state[0] != cacg->matstate[0] || state[1] != cacg->matstate[1]) {
+      PetscCall(PetscInfo(ksp, "Operators have changed, discarding the eigenvalue estimates for the s-step basis\n"));
+      cacg->lmin   = 0.0;
+      cacg->lmax   = 0.0;
+      cacg->esteig = PETSC_FALSE;
+    }
+  }
+  PetscCheck(s >= 1, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Number of steps %" PetscInt_FMT " must be positive", s);
+  /* the basis, and four vectors to recover p, q, z and r */
+  PetscCall(KSPSetWorkVecs(ksp, 2 * n + 4));
+  PetscCall(PetscFree3(cacg->theta, cacg->gamma, cacg->beta));
+  PetscCall(PetscFree2(cacg->la, cacg->lb));
+  PetscCall(PetscFree6(cacg->G, cacg->Gr, cacg->pc, cacg->rc, cacg->xc, cacg->tc));
+  PetscCall(PetscMalloc3(s, &cacg->theta, s, &cacg->gamma, s, &cacg->beta));
+  PetscCall(PetscMalloc2(s, &cacg->la, s, &cacg->lb));
+  PetscCall(PetscMalloc6(n * n, &cacg->G, n * n, &cacg->Gr, n, &cacg->pc, n, &cacg->rc, n, &cacg->xc, n, &cacg->tc));
+  cacg->haveeig = (PetscBool)(cacg->lmax > 0.0);
+  PetscCall(KSPCACGSetBasis_Private(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* u^H G v */
+static inline PetscScalar KSPCACGForm_Private(PetscInt n, const PetscScalar *G, const PetscScalar *u, const PetscScalar *v)
+{
+  PetscScalar sum = 0.0;
+
+  for (PetscInt j = 0; j < n; j++) {
+    PetscScalar t = 0.0;
+
+    if (v[j] == (PetscScalar)0.0) continue;
+    for (PetscInt i = 0; i < n; i++) t += PetscConj(u[i]) * G[i + j * n];
+    sum += t * v[j];
+  }
+  return sum;
+}
+
+/* computes the basis vectors i + 1, ..., i + m from vector i of Y and W */
+static PetscErrorCode KSPCACGBuildBasis_Private(KSP ksp, Mat A, Vec *Y, Vec *W, PetscInt m)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < m; i++) {
+    PetscCall(KSP_MatMult(ksp, A, Y[i], W[i + 1]));
+    if (i) PetscCall(VecAXPBYPCZ(W[i + 1], -cacg->theta[i] / cacg->beta[i], -cacg->gamma[i] / cacg->beta[i], 1.0 / cacg->beta[i], W[i], W[i - 1]));
+    else PetscCall(VecAXPBY(W[i + 1], -cacg->theta[i] / cacg->beta[i], 1.0 / cacg->beta[i], W[i]));
+    PetscCall(KSP_PCApply(ksp, W[i + 1], Y[i + 1]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* t = T c where T is the change of basis matrix, A Y = W T for all but the last vectors of the two blocks */
+static void KSPCACGApplyT_Private(KSP_CACG *cacg, const PetscScalar *c, PetscScalar *t)
+{
+  PetscInt s = cacg->s, n = 2 * s + 1;
+
+  for (PetscInt i = 0; i < n; i++) t[i] = 0.0;
+  for (PetscInt b = 0; b < 2; b++) {
+    PetscInt o = b * (s + 1), m = b ? s - 1 : s;
+
+    for (PetscInt i = 0; i < m; i++) {
+      t[o + i + 1] += cacg->beta[i] * c[o + i];
+      t[o + i] += cacg->theta[i] * c[o + i];
+      if (i) t[o + i - 1] += cacg->gamma[i] * c[o + i];
+    }
+  }
+}
+
+static PetscErrorCode KSPCACGNorm_Private(KSP ksp, PetscScalar gamma, PetscReal *dp)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+  PetscInt  n    = 2 * cacg->s + 1;
+
+  PetscFunctionBegin;
+  switch (ksp->normtype) {
+  case KSP_NORM_NATURAL:
+    *dp = PetscSqrtReal(PetscAbsScalar(gamma));
+    break;
+  case KSP_NORM_UNPRECONDITIONED:
+    *dp = PetscSqrtReal(PetscAbsScalar(KSPCACGForm_Private(n, cacg->Gr, cacg->rc, cacg->rc)));
+    break;
+  default:
+    *dp = 0.0;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSolve_CACG(KSP ksp)
+{
+  KSP_CACG   *cacg = (KSP_CACG *)ksp->data;
+  PetscInt    s = cacg->s, n = 2 * s + 1, i, j;
+  PetscScalar gamma, gammanew, alpha, beta, pAp;
+  PetscReal   dp;
+  Vec         x, b, *Y, *W, *T;
+  Mat         Amat, Pmat;
+  PetscBool   diagonalscale, first = (PetscBool)!cacg->haveeig;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
+  PetscCheck(!diagonalscale, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Krylov method %s does not support diagonal scaling", ((PetscObject)ksp)->type_name);
+
+  x = ksp->vec_sol;
+  b = ksp->vec_rhs;
+  Y = ksp->work;
+  W = ksp->work + n;
+  T = ksp->work + 2 * n;
+  PetscCall(PCGetOperators(ksp->pc, &Amat, &Pmat));
+
+  /* r is the first vector of the second block of W, z of Y */
+  ksp->its = 0;
+  if (!ksp->guess_zero) {
+    PetscCall(KSP_MatMult(ksp, Amat, x, W[s + 1])); /*     r <- b - Ax     */
+    PetscCall(VecAYPX(W[s + 1], -1.0, b));
+  } else {
+    PetscCall(VecCopy(b, W[s + 1])); /*     r <- b (x is 0) */
+  }
+  PetscCall(KSP_PCApply(ksp, W[s + 1], Y[s + 1])); /*     z <- Br         */
+  PetscCall(VecCopy(Y[s + 1], Y[0]));              /*     p <- z          */
+  PetscCall(VecCopy(W[s + 1], W[0]));              /*     q <- r, q = Ap  */
+  PetscCall(VecDotBegin(W[s + 1], Y[s + 1], &gamma));
+  if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) PetscCall(VecNormBegin(W[s + 1], NORM_2, &dp));
+  PetscCall(VecDotEnd(W[s + 1], Y[s + 1], &gamma));
+  if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) PetscCall(VecNormEnd(W[s + 1], NORM_2, &dp));
+  KSPCheckDot(ksp, gamma);
+  if (ksp->normtype == KSP_NORM_NATURAL) dp = PetscSqrtReal(PetscAbsScalar(gamma));
+  else if (ksp->normtype == KSP_NORM_NONE) dp = 0.0;
+  PetscCall(KSPLogResidualHistory(ksp, dp));
+  PetscCall(KSPMonitor(ksp, 0, dp));
+  ksp->rnorm = dp;
+  PetscCall((*ksp->converged)(ksp, 0, dp, &ksp->reason, ksp->cnvP));
+  if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
+
+  do {
+    /* s + 1 vectors from p and s from z, followed by the Gram matrices in a single reduction */
+    PetscCall(KSPCACGBuildBasis_Private(ksp, Amat, Y, W, s));
+    PetscCall(KSPCACGBuildBasis_Private(ksp, Amat, Y + s + 1, W + s + 1, s - 1));
+    for (j = 0; j < n; j++) {
+      PetscCall(VecMDotBegin(W[j], n, Y, cacg->G + j * n));
+      if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) PetscCall(VecMDotBegin(W[j], n, W, cacg->Gr + j * n));
+    }
+    PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)x)));
+    for (j = 0; j < n; j++) {
+      PetscCall(VecMDotEnd(W[j], n, Y, cacg->G + j * n));
+      if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) PetscCall(VecMDotEnd(W[j], n, W, cacg->Gr + j * n));
+    }
+
+    /* s iterations of CG on the coordinates */
+    PetscCall(PetscArrayzero(cacg->pc, n));
+    PetscCall(PetscArrayzero(cacg->rc, n));
+    PetscCall(PetscArrayzero(cacg->xc, n));
+    cacg->pc[0]     = 1.0;
+    cacg->rc[s + 1] = 1.0;
+    for (i = 0; i < s; i++) {
+      KSPCACGApplyT_Private(cacg, cacg->pc, cacg->tc);
+      pAp = KSPCACGForm_Private(n, cacg->G, cacg->pc, cacg->tc); /*     pAp <- p'Ap     */
+      KSPCheckDot(ksp, pAp);
+      if ((pAp == 0.0) || (PetscRealPart(pAp) <= 0.0)) {
+        ksp->reason = KSP_DIVERGED_INDEFINITE_MAT;
+        PetscCall(PetscInfo(ksp, "Diverged due to indefinite or negative definite matrix\n"));
+        break;
+      }
+      alpha = gamma / pAp;
+      for (j = 0; j < n; j++) {
+        cacg->xc[j] += alpha * cacg->pc[j]; /*     x <- x + alpha * p  */
+        cacg->rc[j] -= alpha * cacg->tc[j]; /*     r <- r - alpha * Ap */
+      }
+      gammanew = KSPCACGForm_Private(n, cacg->G, cacg->rc, cacg->rc); /*     gamma <- r'z    */
+      KSPCheckDot(ksp, gammanew);
+      if (PetscRealPart(gammanew) < 0.0) {
+        ksp->reason = KSP_DIVERGED_INDEFINITE_PC;
+        PetscCall(PetscInfo(ksp, "Diverged due to indefinite preconditioner\n"));
+        break;
+      }
+      PetscCall(KSPCACGNorm_Private(ksp, gammanew, &dp));
+      ksp->its++;
+      ksp->rnorm = dp;
+      PetscCall(KSPLogResidualHistory(ksp, dp));
+      PetscCall(KSPMonitor(ksp, ksp->its, dp));
+      PetscCall((*ksp->converged)(ksp, ksp->its, dp, &ksp->reason, ksp->cnvP));
+      beta  = gammanew / gamma;
+      gamma = gammanew;
+      if (first) {
+        cacg->la[i] = PetscRealPart(alpha);
+        cacg->lb[i] = PetscRealPart(beta);
+      }
+      if (ksp->reason || ksp->its >= ksp->max_it) break;
+      for (j = 0; j < n; j++) cacg->pc[j] = cacg->rc[j] + beta * cacg->pc[j]; /*     p <- r + beta * p   */
+    }
+
+    /* back to vectors, the new p, q, z and r replace the first vectors of the two blocks */
+    PetscCall(VecMAXPY(x, n, cacg->xc, Y));
+    if (ksp->reason || ksp->its >= ksp->max_it) break;
+    for (j = 0; j < 4; j++) PetscCall(VecSet(T[j], 0.0));
+    PetscCall(VecMAXPY(T[0], n, cacg->pc, Y));
+    PetscCall(VecMAXPY(T[1], n, cacg->pc, W));
+    PetscCall(VecMAXPY(T[2], n, cacg->rc, Y));
+    PetscCall(VecMAXPY(T[3], n, cacg->rc, W));
+    for (j = 0; j < 4; j++) {
+      Vec *v = j % 2 ? W : Y, t = T[j];
+
+      T[j]                 = v[j < 2 ? 0 : s + 1];
+      v[j < 2 ? 0 : s + 1] = t;
+    }
+    if (first) {
+      first = PETSC_FALSE;
+      PetscCall(KSPCACGEstimateEigenvalues_Private(ksp, s));
+    }
+  } while (!ksp->reason && ksp->its < ksp->max_it);
+  if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPReset_CACG(KSP ksp)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree3(cacg->theta, cacg->gamma, cacg->beta));
+  PetscCall(PetscFree2(cacg->la, cacg->lb));
+  PetscCall(PetscFree6(cacg->G, cacg->Gr, cacg->pc, cacg->rc, cacg->xc, cacg->tc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPDestroy_CACG(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPReset_CACG(ksp));
+  PetscCall(KSPDestroyDefault(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPView_CACG(KSP ksp, PetscViewer viewer)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+  PetscBool iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  steps per reduction %" PetscInt_FMT ", %s basis\n", cacg->s, KSPCACGBasisTypes[cacg->basis]));
+    if (cacg->haveeig) PetscCall(PetscViewerASCIIPrintf(viewer, "  eigenvalue estimates %g %g\n", (double)cacg->lmin, (double)cacg->lmax));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetFromOptions_CACG(KSP ksp, PetscOptionItems *PetscOptionsObject)
+{
+  KSP_CACG *cacg = (KSP_CACG *)ksp->data;
+  PetscBool flg1, flg2;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "KSP CACG options");
+  PetscCall(PetscOptionsInt("-ksp_cacg_s", "Number of iterations per global reduction", "", cacg->s, &cacg->s, NULL));
+  PetscCall(PetscOptionsEnum("-ksp_cacg_basis", "Polynomial basis", "", KSPCACGBasisTypes, (PetscEnum)cacg->basis, (PetscEnum *)&cacg->basis, NULL));
+  PetscCall(PetscOptionsReal("-ksp_cacg_lmin", "Estimate for smallest eigenvalue", "", cacg->lmin, &cacg->lmin, &flg1));
+  PetscCall(PetscOptionsReal("-ksp_cacg_lmax", "Estimate for largest eigenvalue", "", cacg->lmax, &cacg->lmax, &flg2));
+  if (flg1 || flg2) cacg->esteig = PETSC_FALSE;
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+    KSPCACG - s-step (communication avoiding) preconditioned conjugate gradient method. The vectors needed for s
+    iterations are computed first, and their inner products with a single global reduction. The s iterations are then
+    run on the coordinates in this basis, so there is one global reduction every s iterations instead of two per
+    iteration for `KSPCG`.
+
+    Options Database Keys:
++   -ksp_cacg_s <s> - number of iterations per global reduction (default 4)
+.   -ksp_cacg_basis <monomial,newton,chebyshev> - polynomial basis of the s-step vectors (default chebyshev)
+.   -ksp_cacg_lmin - approximation to the smallest eigenvalue of the preconditioned operator
+-   -ksp_cacg_lmax - approximation to the largest eigenvalue of the preconditioned operator
+
+    Level: advanced
+
+    Notes:
+    Each outer iteration costs 2s - 1 matrix-vector products and preconditioner applications for s iterations, about
+    twice as many as `KSPCG`, so the method pays off only when the global reductions dominate.
+
+    The monomial basis loses linear independence quickly as s grows. The Newton and Chebyshev bases are built from
+    the eigenvalue estimates -ksp_cacg_lmin and -ksp_cacg_lmax, which are computed from the first s iterations, run with
+    the monomial basis, when they are not given. Computed estimates are discarded when the operators change.
+
+    Only left preconditioning is supported, with the natural (default) or unpreconditioned norm. The unpreconditioned
+    norm requires a second Gram matrix in the same reduction.
+
+    References:
++   * - A. T. Chronopoulos and C. W. Gear, "s-step iterative methods for symmetric linear systems",
+        Journal of Computational and Applied Mathematics, 1989.
+-   * - E. Carson, "Communication-avoiding Krylov subspace methods in theory and practice", PhD thesis, UC Berkeley, 2015.
+
+.seealso: [](chapter_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSPCG`, `KSPPIPECG`, `KSPPIPELCG`, `KSPGROPPCG`, `KSPCAGMRES`
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_CACG(KSP ksp)
+{
+  KSP_CACG *cacg;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&cacg));
+  cacg->s     = 4;
+  cacg->basis = KSP_CACG_BASIS_CHEBYSHEV;
+  ksp->data   = (void *)cacg;
+
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NATURAL, PC_LEFT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_UNPRECONDITIONED, PC_LEFT, 1));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_LEFT, 1));
+
+  ksp->setupnewmatrix      = PETSC_TRUE;
+  ksp->ops->setup          = KSPSetUp_CACG;
+  ksp->ops->solve          = KSPSolve_CACG;
+  ksp->ops->reset          = KSPReset_CACG;
+  ksp->ops->destroy        = KSPDestroy_CACG;
+  ksp->ops->view           = KSPView_CACG;
+  ksp->ops->setfromoptions = KSPSetFromOptions_CACG;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
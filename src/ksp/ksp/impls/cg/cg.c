@@ -117,7 +117,7 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   Vec         X, B, Z, R, P, W;
   KSP_CG     *cg;
   Mat         Amat, Pmat;
-  PetscBool   diagonalscale, testobj;
+  PetscBool   diagonalscale, testobj, fusedot, havebeta = PETSC_FALSE;
 
   PetscFunctionBegin;
   PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
@@ -133,6 +133,8 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   P             = ksp->work[2];
   W             = Z;
   r2            = PetscSqr(cg->radius);
+  /* with the preconditioned norm, z'*z and the following z'*r are computed together */
+  fusedot = (PetscBool)(cg->fused && ksp->normtype == KSP_NORM_PRECONDITIONED && (!PetscDefined(USE_COMPLEX) || cg->type == KSP_CG_HERMITIAN));
 
   if (eigs) {
     e    = cg->e;
@@ -159,8 +161,14 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
 
   switch (ksp->normtype) {
   case KSP_NORM_PRECONDITIONED:
-    PetscCall(KSP_PCApply(ksp, R, Z));  /*    z <- Br                           */
-    PetscCall(VecNorm(Z, NORM_2, &dp)); /*    dp <- z'*z = e'*A'*B'*B*A*e       */
+    PetscCall(KSP_PCApply(ksp, R, Z)); /*    z <- Br                           */
+    if (fusedot) {
+      PetscCall(VecDotNorm2(R, Z, &beta, &dp)); /*    beta <- z'*r, dp <- z'*z         */
+      beta = PetscConj(beta);
+      KSPCheckDot(ksp, beta);
+      dp       = PetscSqrtReal(dp);
+      havebeta = PETSC_TRUE;
+    } else PetscCall(VecNorm(Z, NORM_2, &dp)); /*    dp <- z'*z = e'*A'*B'*B*A*e       */
     KSPCheckNorm(ksp, dp);
     break;
   case KSP_NORM_UNPRECONDITIONED:
@@ -203,7 +211,7 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
   if (ksp->reason) PetscFunctionReturn(PETSC_SUCCESS);
 
   if (ksp->normtype != KSP_NORM_PRECONDITIONED && (ksp->normtype != KSP_NORM_NATURAL)) { PetscCall(KSP_PCApply(ksp, R, Z)); /*     z <- Br                           */ }
-  if (ksp->normtype != KSP_NORM_NATURAL) {
+  if (ksp->normtype != KSP_NORM_NATURAL && !havebeta) {
     PetscCall(VecXDot(Z, R, &beta)); /*     beta <- z'*r                      */
     KSPCheckDot(ksp, beta);
   }
@@ -294,11 +302,22 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
         break;
       }
     }
-    PetscCall(VecAXPY(X, a, P));  /*     x <- x + ap                      */
-    PetscCall(VecAXPY(R, -a, W)); /*     r <- r - aw                      */
+    PetscCall(VecAXPY(X, a, P)); /*     x <- x + ap                      */
+    /*     r <- r - aw                      */
+    if (cg->fused && ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i + 2) {
+      /* the norm is cached in R for the VecNorm() below */
+      PetscCall(VecWAXPYDotNorm(R, -a, W, R, NULL, NULL, &dp));
+    } else PetscCall(VecAXPY(R, -a, W));
+    havebeta = PETSC_FALSE;
     if (ksp->normtype == KSP_NORM_PRECONDITIONED && ksp->chknorm < i + 2) {
-      PetscCall(KSP_PCApply(ksp, R, Z));  /*     z <- Br                          */
-      PetscCall(VecNorm(Z, NORM_2, &dp)); /*     dp <- z'*z                       */
+      PetscCall(KSP_PCApply(ksp, R, Z)); /*     z <- Br                          */
+      if (fusedot) {
+        PetscCall(VecDotNorm2(R, Z, &beta, &dp)); /*     beta <- z'*r, dp <- z'*z         */
+        beta = PetscConj(beta);
+        KSPCheckDot(ksp, beta);
+        dp       = PetscSqrtReal(dp);
+        havebeta = PETSC_TRUE;
+      } else PetscCall(VecNorm(Z, NORM_2, &dp)); /*     dp <- z'*z                       */
       KSPCheckNorm(ksp, dp);
     } else if (ksp->normtype == KSP_NORM_UNPRECONDITIONED && ksp->chknorm < i + 2) {
       PetscCall(VecNorm(R, NORM_2, &dp)); /*     dp <- r'*r                       */
@@ -332,7 +351,7 @@ static PetscErrorCode KSPSolve_CG(KSP ksp)
     }
 
     if ((ksp->normtype != KSP_NORM_PRECONDITIONED && (ksp->normtype != KSP_NORM_NATURAL)) || (ksp->chknorm >= i + 2)) { PetscCall(KSP_PCApply(ksp, R, Z)); /*     z <- Br                          */ }
-    if ((ksp->normtype != KSP_NORM_NATURAL) || (ksp->chknorm >= i + 2)) {
+    if (((ksp->normtype != KSP_NORM_NATURAL) || (ksp->chknorm >= i + 2)) && !havebeta) {
       PetscCall(VecXDot(Z, R, &beta)); /*     beta <- z'*r                     */
       KSPCheckDot(ksp, beta);
     }
@@ -562,6 +581,7 @@ PetscErrorCode KSPView_CG(KSP ksp, PetscViewer viewer)
     PetscCall(PetscViewerASCIIPrintf(viewer, "  variant %s\n", KSPCGTypes[cg->type]));
 #endif
     if (cg->singlereduction) PetscCall(PetscViewerASCIIPrintf(viewer, "  using single-reduction variant\n"));
+    if (cg->fused && !cg->singlereduction) PetscCall(PetscViewerASCIIPrintf(viewer, "  fusing the residual norm with the residual update or the inner product\n"));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -582,6 +602,7 @@ PetscErrorCode KSPSetFromOptions_CG(KSP ksp, PetscOptionItems *PetscOptionsObjec
 #endif
   PetscCall(PetscOptionsBool("-ksp_cg_single_reduction", "Merge inner products into single MPI_Allreduce()", "KSPCGUseSingleReduction", cg->singlereduction, &cg->singlereduction, &flg));
   if (flg) PetscCall(KSPCGUseSingleReduction(ksp, cg->singlereduction));
+  PetscCall(PetscOptionsBool("-ksp_cg_fused", "Fuse the residual norm with the residual update or the inner product", "VecWAXPYDotNorm", cg->fused, &cg->fused, NULL));
   PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -635,7 +656,9 @@ PETSC_INTERN PetscErrorCode KSPBuildResidual_CG(KSP ksp, Vec t, Vec v, Vec *V)
    Options Database Keys:
 +   -ksp_cg_type Hermitian - (for complex matrices only) indicates the matrix is Hermitian, see `KSPCGSetType()`
 .   -ksp_cg_type symmetric - (for complex matrices only) indicates the matrix is symmetric
--   -ksp_cg_single_reduction - performs both inner products needed in the algorithm with a single `MPI_Allreduce()` call, see `KSPCGUseSingleReduction()`
+.   -ksp_cg_single_reduction - performs both inner products needed in the algorithm with a single `MPI_Allreduce()` call, see `KSPCGUseSingleReduction()`
+-   -ksp_cg_fused - computes the residual norm in the same pass over the vectors as the residual update (unpreconditioned norm) or as the
+                    inner product z'*r (preconditioned norm), see `VecWAXPYDotNorm()` and `VecDotNorm2()`
 
    Level: beginner
 
@@ -39,6 +39,7 @@ typedef struct {
   PetscReal obj_min;
 
   PetscBool singlereduction; /* use variant of CG that combines both inner products */
+  PetscBool fused;           /* fuse the residual update with its norm, see VecWAXPYDotNorm() */
 } KSP_CG;
 
 #endif
@@ -20,8 +20,10 @@
 
    Options Database Keys:
 +   -ksp_gmres_classicalgramschmidt - Activates `KSPGMRESClassicalGramSchmidtOrthogonalization()`
--   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is
+.   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is
                                    used to increase the stability of the classical Gram-Schmidt  orthogonalization.
+-   -ksp_gmres_cgs_fused - compute the subtraction of the projections together with the norm of the new vector and the
+                           dot products of the refinement step with `VecMAXPYMDot()`
 
     Level: intermediate
 
@@ -30,6 +32,10 @@
     This is much faster than `KSPGMRESModifiedGramSchmidtOrthogonalization()` but has the small possibility of stability issues
     that can usually be handled by using a a single step of iterative refinement with `KSPGMRESSetCGSRefinementType()`
 
+    With -ksp_gmres_cgs_fused the basis vectors are read once less per iteration, or twice less with refinement, since
+    the norm and the dot products of the refinement step are computed while subtracting the projections. The dot
+    products are then computed with the refinement type `KSP_GMRES_CGS_REFINE_IFNEEDED` even if they turn out not to be needed.
+
 .seealso: [](chapter_ksp), `KSPGMRESCGSRefinementType`, `KSPGMRESSetOrthogonalization()`, `KSPGMRESSetCGSRefinementType()`,
            `KSPGMRESGetCGSRefinementType()`, `KSPGMRESGetOrthogonalization()`, `KSPGMRESModifiedGramSchmidtOrthogonalization()`
 @*/
@@ -37,14 +43,16 @@ PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt i
 {
   KSP_GMRES   *gmres = (KSP_GMRES *)(ksp->data);
   PetscInt     j;
-  PetscScalar *hh, *hes, *lhh;
+  PetscScalar *hh, *hes, *lhh, *lhh2;
   PetscReal    hnrm, wnrm;
   PetscBool    refine = (PetscBool)(gmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS);
 
   PetscFunctionBegin;
   PetscCall(PetscLogEventBegin(KSP_GMRESOrthogonalization, ksp, 0, 0, 0));
-  if (!gmres->orthogwork) PetscCall(PetscMalloc1(gmres->max_k + 2, &gmres->orthogwork));
-  lhh = gmres->orthogwork;
+  /* the second half holds the dot products of the refinement step computed by VecMAXPYMDot() */
+  if (!gmres->orthogwork) PetscCall(PetscMalloc1(2 * (gmres->max_k + 2), &gmres->orthogwork));
+  lhh  = gmres->orthogwork;
+  lhh2 = gmres->orthogwork + gmres->max_k + 2;
 
   /* update Hessenberg matrix and do unmodified Gram-Schmidt */
   hh  = HH(0, it);
@@ -71,7 +79,10 @@ PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt i
          This is really a matrix vector product:
          [h[0],h[1],...]*[ v[0]; v[1]; ...] subtracted from v[it+1].
   */
-  PetscCall(VecMAXPY(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0)));
+  if (gmres->cgsfused) {
+    /* the norm is cached in the vector for the normalization that follows */
+    PetscCall(VecMAXPYMDot(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0), gmres->cgstype == KSP_GMRES_CGS_REFINE_NEVER ? NULL : lhh2, &wnrm));
+  } else PetscCall(VecMAXPY(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0)));
   /* note lhh[j] is -<v,vnew> , hence the subtraction */
   for (j = 0; j <= it; j++) {
     hh[j] -= lhh[j];  /* hh += <v,vnew> */
@@ -87,7 +98,7 @@ PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt i
     for (j = 0; j <= it; j++) hnrm += PetscRealPart(lhh[j] * PetscConj(lhh[j]));
 
     hnrm = PetscSqrtReal(hnrm);
-    PetscCall(VecNorm(VEC_VV(it + 1), NORM_2, &wnrm));
+    if (!gmres->cgsfused) PetscCall(VecNorm(VEC_VV(it + 1), NORM_2, &wnrm));
     KSPCheckNorm(ksp, wnrm);
     if (ksp->reason) goto done;
     if (wnrm < hnrm) {
@@ -97,13 +108,15 @@ PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp, PetscInt i
   }
 
   if (refine) {
-    PetscCall(VecMDot(VEC_VV(it + 1), it + 1, &(VEC_VV(0)), lhh)); /* <v,vnew> */
+    if (gmres->cgsfused) PetscCall(PetscArraycpy(lhh, lhh2, it + 1));
+    else PetscCall(VecMDot(VEC_VV(it + 1), it + 1, &(VEC_VV(0)), lhh)); /* <v,vnew> */
     for (j = 0; j <= it; j++) {
       KSPCheckDot(ksp, lhh[j]);
       if (ksp->reason) goto done;
       lhh[j] = -lhh[j];
     }
-    PetscCall(VecMAXPY(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0)));
+    if (gmres->cgsfused) PetscCall(VecMAXPYMDot(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0), NULL, &wnrm));
+    else PetscCall(VecMAXPY(VEC_VV(it + 1), it + 1, lhh, &VEC_VV(0)));
     /* note lhh[j] is -<v,vnew> , hence the subtraction */
     for (j = 0; j <= it; j++) {
       hh[j] -= lhh[j];  /* hh += <v,vnew> */
@@ -0,0 +1,558 @@
+#include <petsc/private/kspimpl.h>
+#include <petscblaslapack.h>
+
+typedef enum {
+  KSP_CAGMRES_BASIS_MONOMIAL,
+  KSP_CAGMRES_BASIS_NEWTON
+} KSPCAGMRESBasisType;
+static const char *const KSPCAGMRESBasisTypes[] = {"monomial", "newton", "KSPCAGMRESBasisType", "KSP_CAGMRES_BASIS_", NULL};
+
+/*
+   Each block of s vectors is computed from the last orthonormal basis vector q with the recurrence
+
+     v_0 = q,  v_{i+1} = (A v_i - theta_i v_i - gamma_i v_{i-1})
+
+   so that A [v_0, ..., v_{s-1}] = [v_0, ..., v_s] B with B tridiagonal. The block is orthogonalized against the previous
+   basis and then within itself from the Gram matrices computed in one reduction, [v_0, ..., v_s] = Q Rk, and the new
+   columns of the Hessenberg matrix follow from A Q = Q H and Rk, B.
+*/
+typedef struct {
+  PetscInt            s;                /* number of basis vectors per global reduction */
+  PetscInt            max_k;            /* restart, a multiple of s */
+  PetscInt            it;               /* number of basis vectors of the current approximate solution */
+  KSPCAGMRESBasisType basis;            /* polynomial basis */
+  PetscBool           reorthog;         /* orthogonalize the blocks twice */
+  PetscBool           haveshifts;       /* the Newton shifts have been computed from the first cycle */
+  PetscScalar        *theta, *gamma;    /* coefficients of the basis recurrence */
+  PetscScalar        *H, *HR;           /* Hessenberg matrix, and its triangular factor from the plane rotations */
+  PetscScalar        *cs, *sn, *rs;     /* plane rotations and right-hand side of the least squares problem */
+  PetscScalar        *C, *C2, *Gm, *R;  /* coefficients of a block against the previous basis, its Gram matrix and triangular factor */
+  PetscScalar        *Rk, *M, *y, *tmp; /* work arrays */
+  Vec                 sol_temp;         /* approximate solution built during a cycle */
+} KSP_CAGMRES;
+
+static PetscErrorCode KSPSetUp_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+  PetscInt     s = cagmres->s, ld;
+
+  PetscFunctionBegin;
+  PetscCheck(s >= 1, PetscObjectComm((PetscObject)ksp), PETSC_ERR_ARG_OUTOFRANGE, "Number of steps %" PetscInt_FMT " must be positive", s);
+  cagmres->max_k = s * ((PetscMax(cagmres->max_k, 1) + s - 1) / s);
+  ld             = cagmres->max_k + 1;
+  /* the basis and two work vectors */
+  PetscCall(KSPSetWorkVecs(ksp, ld + 2));
+  PetscCall(PetscFree2(cagmres->theta, cagmres->gamma));
+  PetscCall(PetscFree5(cagmres->H, cagmres->HR, cagmres->cs, cagmres->sn, cagmres->rs));
+  PetscCall(PetscFree4(cagmres->C, cagmres->C2, cagmres->Gm, cagmres->R));
+  PetscCall(PetscFree4(cagmres->Rk, cagmres->M, cagmres->y, cagmres->tmp));
+  PetscCall(PetscCalloc2(s, &cagmres->theta, s, &cagmres->gamma));
+  PetscCall(PetscMalloc5(ld * ld, &cagmres->H, ld * ld, &cagmres->HR, ld, &cagmres->cs, ld, &cagmres->sn, ld, &cagmres->rs));
+  PetscCall(PetscMalloc4(ld * s, &cagmres->C, ld * s, &cagmres->C2, s * s, &cagmres->Gm, s * s, &cagmres->R));
+  PetscCall(PetscMalloc4(ld * (s + 1), &cagmres->Rk, ld * s, &cagmres->M, ld, &cagmres->y, ld, &cagmres->tmp));
+  cagmres->haveshifts = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Newton shifts from the Ritz values of the first cycle in (modified) Leja order, complex conjugate pairs are kept together */
+static PetscErrorCode KSPCAGMRESComputeShifts_Private(KSP ksp, PetscInt k)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+  PetscInt     s = cagmres->s, ld = cagmres->max_k + 1, i, j, nc = 0;
+  PetscScalar *Hc, *work, sdummy = 0;
+  PetscReal   *er, *ei, *cr, *ci;
+  PetscBool   *used;
+  PetscBLASInt bn, lwork, info, idummy = 1;
+#if defined(PETSC_USE_COMPLEX)
+  PetscScalar *w;
+  PetscReal   *rwork;
+#endif
+
+  PetscFunctionBegin;
+  cagmres->haveshifts = PETSC_TRUE;
+  if (k < 1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscBLASIntCast(k, &bn));
+  PetscCall(PetscBLASIntCast(5 * k, &lwork));
+  PetscCall(PetscMalloc4(k * k, &Hc, 5 * k, &work, k, &er, k, &ei));
+  PetscCall(PetscMalloc3(s, &cr, s, &ci, k, &used));
+  for (j = 0; j < k; j++)
+    for (i = 0; i < k; i++) Hc[i + j * k] = cagmres->H[i + j * ld];
+  PetscCall(PetscFPTrapPush(PETSC_FP_TRAP_OFF));
+#if !defined(PETSC_USE_COMPLEX)
+  PetscCallBLAS("LAPACKgeev", LAPACKgeev_("N", "N", &bn, Hc, &bn, er, ei, &sdummy, &idummy, &sdummy, &idummy, work, &lwork, &info));
+#else
+  PetscCall(PetscMalloc2(k, &w, 2 * k, &rwork));
+  PetscCallBLAS("LAPACKgeev", LAPACKgeev_("N", "N", &bn, Hc, &bn, w, &sdummy, &idummy, &sdummy, &idummy, work, &lwork, rwork, &info));
+  for (j = 0; j < k; j++) {
+    er[j] = PetscRealPart(w[j]);
+    ei[j] = PetscImaginaryPart(w[j]);
+  }
+  PetscCall(PetscFree2(w, rwork));
+#endif
+  PetscCall(PetscFPTrapPop());
+  if (info) {
+    PetscCall(PetscInfo(ksp, "Error in LAPACK routine %d, keeping the monomial basis\n", (int)info));
+    PetscCall(PetscFree4(Hc, work, er, ei));
+    PetscCall(PetscFree3(cr, ci, used));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+
+  for (j = 0; j < k; j++) used[j] = PETSC_FALSE;
+  for (i = 0; i < s;) {
+    PetscInt  jbest = -1;
+    PetscReal best  = PETSC_MIN_REAL;
+
+    for (j = 0; j < k; j++) {
+      PetscReal score = 0.0;
+
+#if !defined(PETSC_USE_COMPLEX)
+      if (ei[j] < 0.0) continue; /* represented by its conjugate */
+#endif
+      if (used[j]) continue;
+      if (!nc) score = PetscSqrtReal(er[j] * er[j] + ei[j] * ei[j]);
+      for (PetscInt c = 0; c < nc; c++) {
+        PetscReal dist = PetscSqrtReal((er[j] - cr[c]) * (er[j] - cr[c]) + (ei[j] - ci[c]) * (ei[j] - ci[c]));
+
+        score += dist > 0.0 ? PetscLogReal(dist) : PETSC_MIN_REAL / (2 * s);
+      }
+      if (jbest < 0 || score > best) {
+        jbest = j;
+        best  = score;
+      }
+    }
+    if (jbest < 0) { /* fewer Ritz values than shifts, reuse them */
+      for (j = 0; j < k; j++) used[j] = PETSC_FALSE;
+      continue;
+    }
+    used[jbest] = PETSC_TRUE;
+#if !defined(PETSC_USE_COMPLEX)
+    if (ei[jbest] > 0.0 && i + 1 < s) {
+      /* (A - a)^2 + b^2 in real arithmetic */
+      cagmres->theta[i]     = er[jbest];
+      cagmres->gamma[i]     = 0.0;
+      cagmres->theta[i + 1] = er[jbest];
+      cagmres->gamma[i + 1] = -ei[jbest] * ei[jbest];
+      cr[nc]                = er[jbest];
+      ci[nc++]              = ei[jbest];
+      cr[nc]                = er[jbest];
+      ci[nc++]              = -ei[jbest];
+      i += 2;
+      continue;
+    }
+    cagmres->theta[i] = er[jbest];
+#else
+    cagmres->theta[i] = PetscCMPLX(er[jbest], ei[jbest]);
+#endif
+    cagmres->gamma[i] = 0.0;
+    cr[nc]            = er[jbest];
+    ci[nc++]          = ei[jbest];
+    i++;
+  }
+  PetscCall(PetscInfo(ksp, "Newton basis shifts from %" PetscInt_FMT " Ritz values\n", k));
+  PetscCall(PetscFree4(Hc, work, er, ei));
+  PetscCall(PetscFree3(cr, ci, used));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* one or two passes of block classical Gram-Schmidt, the Gram matrix of the block comes with the last pass */
+static PetscErrorCode KSPCAGMRESProject_Private(KSP ksp, PetscInt nq, PetscInt nb, PetscScalar *C, PetscBool gram)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+  PetscInt     ld = cagmres->max_k + 1, s = cagmres->s;
+  Vec         *Q = ksp->work, *W = ksp->work + nq;
+
+  PetscFunctionBegin;
+  for (PetscInt j = 0; j < nb; j++) {
+    PetscCall(VecMDotBegin(W[j], nq, Q, C + j * ld));
+    if (gram) PetscCall(VecMDotBegin(W[j], nb, W, cagmres->Gm + j * s));
+  }
+  PetscCall(PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)ksp)));
+  for (PetscInt j = 0; j < nb; j++) {
+    PetscCall(VecMDotEnd(W[j], nq, Q, C + j * ld));
+    if (gram) PetscCall(VecMDotEnd(W[j], nb, W, cagmres->Gm + j * s));
+  }
+  for (PetscInt j = 0; j < nb; j++) {
+    for (PetscInt i = 0; i < nq; i++) cagmres->tmp[i] = -C[i + j * ld];
+    PetscCall(VecMAXPY(W[j], nq, cagmres->tmp, Q));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Orthonormalizes the nb vectors following the first nq ones of the basis, returns the number of vectors that are
+   numerically independent
+*/
+static PetscErrorCode KSPCAGMRESOrthogonalize_Private(KSP ksp, PetscInt nq, PetscInt nb, PetscInt *nvalid)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+  PetscInt     ld = cagmres->max_k + 1, s = cagmres->s, npass = cagmres->reorthog ? 2 : 1, a, b, i;
+  PetscScalar *C = cagmres->C, *Cl, *R = cagmres->R, *Gm = cagmres->Gm;
+  Vec         *W = ksp->work + nq;
+
+  PetscFunctionBegin;
+  for (PetscInt pass = 0;; pass++) {
+    Cl = pass ? cagmres->C2 : C;
+    PetscCall(KSPCAGMRESProject_Private(ksp, nq, nb, Cl, (PetscBool)(pass >= npass - 1)));
+    if (pass)
+      for (b = 0; b < nb; b++)
+        for (i = 0; i < nq; i++) C[i + b * ld] += Cl[i + b * ld];
+    if (pass < npass - 1) continue;
+
+    /* Cholesky factorization of the Gram matrix of the projected block, W^H W - Cl^H Cl = R^H R */
+    *nvalid = nb;
+    for (b = 0; b < nb; b++) {
+      PetscReal d = 0.0;
+
+      for (a = 0; a <= b; a++) {
+        PetscScalar g = Gm[a + b * s];
+
+        for (i = 0; i < nq; i++) g -= PetscConj(Cl[i + a * ld]) * Cl[i + b * ld];
+        for (i = 0; i < a; i++) g -= PetscConj(R[i + a * s]) * R[i + b * s];
+        if (a < b) R[a + b * s] = g / R[a + a * s];
+        else d = PetscRealPart(g);
+      }
+      if (!(d > PETSC_SMALL * PetscRealPart(Gm[b + b * s]))) {
+        R[b + b * s] = 0.0;
+        *nvalid      = b;
+        break;
+      }
+      R[b + b * s] = PetscSqrtReal(d);
+    }
+    if (*nvalid == nb || pass >= npass) break;
+    /* the cancellation may come from the squared condition number of the block only, try once more with the projected block */
+    PetscCall(PetscInfo(ksp, "Block vector %" PetscInt_FMT " lost orthogonality, orthogonalizing the block again\n", *nvalid));
+  }
+  if (*nvalid < nb) PetscCall(PetscInfo(ksp, "Block vector %" PetscInt_FMT " is not independent, keeping %" PetscInt_FMT " of %" PetscInt_FMT " vectors\n", *nvalid, *nvalid, nb));
+  for (b = 0; b < *nvalid; b++) {
+    for (a = 0; a < b; a++) cagmres->tmp[a] = -R[a + b * s];
+    PetscCall(VecMAXPY(W[b], b, cagmres->tmp, W));
+    PetscCall(VecScale(W[b], 1.0 / R[b + b * s]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* computes the columns ks, ..., ks + ncols - 1 of the Hessenberg matrix, see the comment at the top */
+static void KSPCAGMRESUpdateHessenberg_Private(KSP_CAGMRES *cagmres, PetscInt ks, PetscInt ncols)
+{
+  PetscInt     ld = cagmres->max_k + 1, s = cagmres->s, nr = ks + ncols + 1, r, c, a, i;
+  PetscScalar *Rk = cagmres->Rk, *M = cagmres->M, *H = cagmres->H;
+
+  /* [v_0, ..., v_ncols] = Q Rk */
+  for (c = 0; c <= ncols; c++)
+    for (r = 0; r < nr; r++) Rk[r + c * ld] = 0.0;
+  Rk[ks] = 1.0;
+  for (c = 1; c <= ncols; c++) {
+    for (r = 0; r <= ks; r++) Rk[r + c * ld] = cagmres->C[r + (c - 1) * ld];
+    for (a = 0; a < c; a++) Rk[ks + 1 + a + c * ld] = cagmres->R[a + (c - 1) * s];
+  }
+  /* M = Rk B - H(:, 0:ks-1) Rk(0:ks-1, :) */
+  for (c = 0; c < ncols; c++) {
+    for (r = 0; r < nr; r++) {
+      PetscScalar m = Rk[r + (c + 1) * ld] + cagmres->theta[c] * Rk[r + c * ld];
+
+      if (c) m += cagmres->gamma[c] * Rk[r + (c - 1) * ld];
+      for (i = PetscMax(r - 1, 0); i < ks; i++) m -= H[r + i * ld] * Rk[i + c * ld];
+      M[r + c * ld] = m;
+    }
+  }
+  /* H(:, ks:ks+ncols-1) Rk(ks:ks+ncols-1, 0:ncols-1) = M */
+  for (c = 0; c < ncols; c++) {
+    for (r = 0; r < nr; r++) {
+      PetscScalar h = M[r + c * ld];
+
+      for (a = 0; a < c; a++) h -= H[r + (ks + a) * ld] * Rk[ks + a + c * ld];
+      H[r + (ks + c) * ld] = h / Rk[ks + c + c * ld];
+    }
+  }
+}
+
+/* applies the plane rotations to column j of the Hessenberg matrix and returns the new residual norm */
+static PetscErrorCode KSPCAGMRESRotate_Private(KSP ksp, PetscInt j, PetscReal *res)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+  PetscInt     ld      = cagmres->max_k + 1;
+  PetscScalar *hh = cagmres->HR + j * ld, *cc = cagmres->cs, *ss = cagmres->sn, *rs = cagmres->rs, tt;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i <= j + 1; i++) hh[i] = cagmres->H[i + j * ld];
+  for (PetscInt i = 0; i < j; i++) {
+    tt        = hh[i];
+    hh[i]     = PetscConj(cc[i]) * tt + ss[i] * hh[i + 1];
+    hh[i + 1] = cc[i] * hh[i + 1] - ss[i] * tt;
+  }
+  tt = PetscSqrtScalar(PetscConj(hh[j]) * hh[j] + PetscConj(hh[j + 1]) * hh[j + 1]);
+  if (tt == 0.0) {
+    PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "tt == 0.0");
+    ksp->reason = KSP_DIVERGED_NULL;
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  cc[j]     = hh[j] / tt;
+  ss[j]     = hh[j + 1] / tt;
+  rs[j + 1] = -(ss[j] * rs[j]);
+  rs[j]     = PetscConj(cc[j]) * rs[j];
+  hh[j]     = PetscConj(cc[j]) * hh[j] + ss[j] * hh[j + 1];
+  hh[j + 1] = 0.0;
+  *res      = PetscAbsScalar(rs[j + 1]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* one restart cycle, returns the number of basis vectors of the solution update */
+static PetscErrorCode KSPCAGMRESCycle_Private(KSP ksp, PetscInt *k)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+  PetscInt     s = cagmres->s, max_k = cagmres->max_k, ld = max_k + 1, ks = 0, nb, nvalid = 0, ncols, i;
+  PetscReal    res;
+  PetscBool    hapend = PETSC_FALSE, pcnone;
+  Vec         *Q = ksp->work, vt = ksp->work[ld];
+  Mat          Amat;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetOperators(ksp->pc, &Amat, NULL));
+  PetscCall(PetscObjectTypeCompare((PetscObject)ksp->pc, PCNONE, &pcnone));
+  *k          = 0;
+  cagmres->it = 0;
+  PetscCall(VecNormalize(Q[0], &res));
+  KSPCheckNorm(ksp, res);
+  cagmres->rs[0] = res;
+  PetscCall(PetscArrayzero(cagmres->H, ld * ld));
+  ksp->rnorm = res;
+  PetscCall(KSPLogResidualHistory(ksp, res));
+  PetscCall(KSPMonitor(ksp, ksp->its, res));
+  if (!res) {
+    ksp->reason = KSP_CONVERGED_ATOL;
+    PetscCall(PetscInfo(ksp, "Converged due to zero residual norm on entry\n"));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall((*ksp->converged)(ksp, ksp->its, res, &ksp->reason, ksp->cnvP));
+
+  while (!ksp->reason && ks < max_k && ksp->its < ksp->max_it) {
+    /* s new vectors with the matrix powers, then one reduction for their orthogonalization */
+    nb = PetscMin(s, max_k - ks);
+    for (i = 0; i < nb; i++)
+      if (cagmres->theta[i] != (PetscScalar)0.0 || cagmres->gamma[i] != (PetscScalar)0.0) break;
+    if (pcnone && i == nb && !ksp->transpose_solve) PetscCall(MatMatrixPowers(Amat, nb, Q[ks], Q + ks + 1));
+    else {
+      for (i = 0; i < nb; i++) {
+        PetscCall(KSP_PCApplyBAorAB(ksp, Q[ks + i], Q[ks + i + 1], vt));
+        if (i && cagmres->gamma[i] != (PetscScalar)0.0) PetscCall(VecAXPBYPCZ(Q[ks + i + 1], -cagmres->theta[i], -cagmres->gamma[i], 1.0, Q[ks + i], Q[ks + i - 1]));
+        else if (cagmres->theta[i] != (PetscScalar)0.0) PetscCall(VecAXPY(Q[ks + i + 1], -cagmres->theta[i], Q[ks + i]));
+      }
+    }
+    PetscCall(KSPCAGMRESOrthogonalize_Private(ksp, ks + 1, nb, &nvalid));
+    if (!nvalid) {
+      /* A q is in the span of the basis: the last column has a zero subdiagonal entry */
+      ncols  = 1;
+      hapend = PETSC_TRUE;
+    } else ncols = nvalid;
+    KSPCAGMRESUpdateHessenberg_Private(cagmres, ks, ncols);
+
+    for (i = 0; i < ncols; i++) {
+      PetscCall(KSPCAGMRESRotate_Private(ksp, ks + i, &res));
+      if (ksp->reason) break;
+      ksp->its++;
+      *k          = ks + i + 1;
+      cagmres->it = *k;
+      ksp->rnorm  = res;
+      PetscCall((*ksp->converged)(ksp, ksp->its, res, &ksp->reason, ksp->cnvP));
+      /* the residual at restart is monitored by the next cycle */
+      if (ksp->reason || ksp->its >= ksp->max_it || *k < max_k) {
+        PetscCall(KSPLogResidualHistory(ksp, res));
+        PetscCall(KSPMonitor(ksp, ksp->its, res));
+      }
+      if (ksp->reason || ksp->its >= ksp->max_it) break;
+    }
+    ks += ncols;
+    if (hapend && !ksp->reason) {
+      if (ksp->normtype == KSP_NORM_NONE) ksp->reason = KSP_CONVERGED_HAPPY_BREAKDOWN;
+      else {
+        PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_NOT_CONVERGED, "You reached the happy break down, but convergence was not indicated. Residual norm = %g", (double)res);
+        ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      }
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* sol = x + Q y where y solves the least squares problem with the k first columns, sol may be x */
+static PetscErrorCode KSPCAGMRESBuildSoln_Private(KSP ksp, PetscInt k, Vec sol)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+  PetscInt     ld      = cagmres->max_k + 1;
+  PetscScalar *y = cagmres->y, *HR = cagmres->HR;
+  Vec          vt1 = ksp->work[ld], vt2 = ksp->work[ld + 1];
+
+  PetscFunctionBegin;
+  if (sol != ksp->vec_sol) PetscCall(VecCopy(ksp->vec_sol, sol));
+  if (!k) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt i = k - 1; i >= 0; i--) {
+    PetscScalar t = cagmres->rs[i];
+
+    for (PetscInt j = i + 1; j < k; j++) t -= HR[i + j * ld] * y[j];
+    if (HR[i + i * ld] == 0.0) {
+      PetscCheck(!ksp->errorifnotconverged, PetscObjectComm((PetscObject)ksp), PETSC_ERR_CONV_FAILED, "Likely your matrix or preconditioner is singular. HR(%" PetscInt_FMT ",%" PetscInt_FMT ") = 0", i, i);
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    y[i] = t / HR[i + i * ld];
+  }
+  PetscCall(VecSet(vt1, 0.0));
+  PetscCall(VecMAXPY(vt1, k, y, ksp->work));
+  PetscCall(KSPUnwindPreconditioner(ksp, vt1, vt2));
+  PetscCall(VecAXPY(sol, 1.0, vt1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPBuildSolution_CAGMRES(KSP ksp, Vec ptr, Vec *result)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+
+  PetscFunctionBegin;
+  if (!ptr) {
+    if (!cagmres->sol_temp) PetscCall(VecDuplicate(ksp->vec_sol, &cagmres->sol_temp));
+    ptr = cagmres->sol_temp;
+  }
+  PetscCall(KSPCAGMRESBuildSoln_Private(ksp, cagmres->it, ptr));
+  if (result) *result = ptr;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSolve_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+  PetscInt     ld = cagmres->max_k + 1, k;
+  PetscBool    diagonalscale, guess_zero = ksp->guess_zero;
+
+  PetscFunctionBegin;
+  PetscCall(PCGetDiagonalScale(ksp->pc, &diagonalscale));
+  PetscCheck(!diagonalscale, PetscObjectComm((PetscObject)ksp), PETSC_ERR_SUP, "Krylov method %s does not support diagonal scaling", ((PetscObject)ksp)->type_name);
+
+  ksp->its = 0;
+  PetscCall(KSPInitialResidual(ksp, ksp->vec_sol, ksp->work[ld], ksp->work[ld + 1], ksp->work[0], ksp->vec_rhs));
+  while (!ksp->reason) {
+    PetscCall(KSPCAGMRESCycle_Private(ksp, &k));
+    PetscCall(KSPCAGMRESBuildSoln_Private(ksp, k, ksp->vec_sol));
+    cagmres->it = 0;
+    if (cagmres->basis == KSP_CAGMRES_BASIS_NEWTON && !cagmres->haveshifts) PetscCall(KSPCAGMRESComputeShifts_Private(ksp, k));
+    if (ksp->reason) break;
+    if (ksp->its >= ksp->max_it) {
+      ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    ksp->guess_zero = PETSC_FALSE; /* every future call to KSPInitialResidual() will have nonzero guess */
+    PetscCall(KSPInitialResidual(ksp, ksp->vec_sol, ksp->work[ld], ksp->work[ld + 1], ksp->work[0], ksp->vec_rhs));
+  }
+  ksp->guess_zero = guess_zero; /* restore if user provided nonzero initial guess */
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPReset_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree2(cagmres->theta, cagmres->gamma));
+  PetscCall(PetscFree5(cagmres->H, cagmres->HR, cagmres->cs, cagmres->sn, cagmres->rs));
+  PetscCall(PetscFree4(cagmres->C, cagmres->C2, cagmres->Gm, cagmres->R));
+  PetscCall(PetscFree4(cagmres->Rk, cagmres->M, cagmres->y, cagmres->tmp));
+  PetscCall(VecDestroy(&cagmres->sol_temp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPDestroy_CAGMRES(KSP ksp)
+{
+  PetscFunctionBegin;
+  PetscCall(KSPReset_CAGMRES(ksp));
+  PetscCall(KSPDestroyDefault(ksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPView_CAGMRES(KSP ksp, PetscViewer viewer)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+  PetscBool    iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  restart=%" PetscInt_FMT ", steps per reduction %" PetscInt_FMT ", %s basis\n", cagmres->max_k, cagmres->s, KSPCAGMRESBasisTypes[cagmres->basis]));
+    if (cagmres->reorthog) PetscCall(PetscViewerASCIIPrintf(viewer, "  using two passes of block Gram-Schmidt\n"));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode KSPSetFromOptions_CAGMRES(KSP ksp, PetscOptionItems *PetscOptionsObject)
+{
+  KSP_CAGMRES *cagmres = (KSP_CAGMRES *)ksp->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "KSP CAGMRES options");
+  PetscCall(PetscOptionsInt("-ksp_cagmres_s", "Number of basis vectors per global reduction", "", cagmres->s, &cagmres->s, NULL));
+  PetscCall(PetscOptionsInt("-ksp_cagmres_restart", "Number of Krylov directions before restart, rounded up to a multiple of s", "", cagmres->max_k, &cagmres->max_k, NULL));
+  PetscCall(PetscOptionsEnum("-ksp_cagmres_basis", "Polynomial basis", "", KSPCAGMRESBasisTypes, (PetscEnum)cagmres->basis, (PetscEnum *)&cagmres->basis, NULL));
+  PetscCall(PetscOptionsBool("-ksp_cagmres_reorthogonalize", "Orthogonalize each block twice, with two global reductions", "", cagmres->reorthog, &cagmres->reorthog, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+    KSPCAGMRES - Communication avoiding GMRES. The Krylov basis is computed in blocks of s vectors, each orthogonalized
+    against the previous basis and within itself with a single global reduction, instead of one reduction per vector for
+    `KSPGMRES`.
+
+    Options Database Keys:
++   -ksp_cagmres_s <s> - number of basis vectors per global reduction (default 4)
+.   -ksp_cagmres_restart <restart> - number of Krylov directions before restart, rounded up to a multiple of s (default 32)
+.   -ksp_cagmres_basis <monomial,newton> - polynomial basis of the blocks (default newton)
+-   -ksp_cagmres_reorthogonalize - orthogonalize each block twice, which is more stable but needs two global reductions per block
+
+    Level: advanced
+
+    Notes:
+    The first restart cycle uses the monomial basis, the Newton basis of the following cycles uses the Ritz values of
+    the first cycle as shifts. The shifts are computed again after the operators are changed with `KSPSetOperators()`. The monomial basis loses linear independence quickly as s grows. When the Cholesky
+    factorization of the Gram matrix of a block breaks down, the block is orthogonalized once more at the cost of an
+    extra reduction, and truncated if its vectors are still not numerically independent.
+
+    Without a preconditioner, the blocks of the monomial basis are computed with `MatMatrixPowers()`, which for
+    `MATMPIAIJ` needs a single exchange of ghost values per block.
+
+    The block is orthogonalized with the Gram matrices of the block, one pass of block classical Gram-Schmidt with
+    Pythagorean update of the norms. This squares the condition number of the block, use -ksp_cagmres_reorthogonalize
+    if the convergence stagnates.
+
+    Left and right preconditioning are supported, but not symmetric preconditioning.
+
+    References:
++   * - M. Hoemmen, "Communication-avoiding Krylov subspace methods", PhD thesis, UC Berkeley, 2010.
+-   * - E. Carson, K. Lund, M. Rozloznik and S. Thomas, "Block Gram-Schmidt algorithms and their stability properties",
+        Linear Algebra and its Applications, 2022.
+
+.seealso: [](chapter_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSPGMRES`, `KSPPGMRES`, `KSPPIPEFGMRES`, `KSPCACG`
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_CAGMRES(KSP ksp)
+{
+  KSP_CAGMRES *cagmres;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&cagmres));
+  cagmres->s     = 4;
+  cagmres->max_k = 32;
+  cagmres->basis = KSP_CAGMRES_BASIS_NEWTON;
+  ksp->data      = (void *)cagmres;
+
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_PRECONDITIONED, PC_LEFT, 3));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_UNPRECONDITIONED, PC_RIGHT, 2));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_LEFT, 1));
+  PetscCall(KSPSetSupportedNorm(ksp, KSP_NORM_NONE, PC_RIGHT, 1));
+
+  ksp->setupnewmatrix      = PETSC_TRUE; /* the Newton shifts are computed again for new operators */
+  ksp->ops->setup          = KSPSetUp_CAGMRES;
+  ksp->ops->solve          = KSPSolve_CAGMRES;
+  ksp->ops->reset          = KSPReset_CAGMRES;
+  ksp->ops->destroy        = KSPDestroy_CAGMRES;
+  ksp->ops->view           = KSPView_CAGMRES;
+  ksp->ops->setfromoptions = KSPSetFromOptions_CAGMRES;
+  ksp->ops->buildsolution  = KSPBuildSolution_CAGMRES;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
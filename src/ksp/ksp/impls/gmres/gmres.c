@@ -483,6 +483,7 @@ PetscErrorCode KSPView_GMRES(KSP ksp, PetscViewer viewer)
   }
   if (iascii) {
     PetscCall(PetscViewerASCIIPrintf(viewer, "  restart=%" PetscInt_FMT ", using %s\n", gmres->max_k, cstr));
+    if (gmres->orthog == KSPGMRESClassicalGramSchmidtOrthogonalization && gmres->cgsfused) PetscCall(PetscViewerASCIIPrintf(viewer, "  fusing the Gram-Schmidt updates with the norm and refinement dot products\n"));
     PetscCall(PetscViewerASCIIPrintf(viewer, "  happy breakdown tolerance %g\n", (double)gmres->haptol));
   } else if (isstring) {
     PetscCall(PetscViewerStringSPrintf(viewer, "%s restart %" PetscInt_FMT, cstr, gmres->max_k));
@@ -554,6 +555,7 @@ PetscErrorCode KSPSetFromOptions_GMRES(KSP ksp, PetscOptionItems *PetscOptionsOb
   PetscCall(PetscOptionsBoolGroupEnd("-ksp_gmres_modifiedgramschmidt", "Modified Gram-Schmidt (slow,more stable)", "KSPGMRESSetOrthogonalization", &flg));
   if (flg) PetscCall(KSPGMRESSetOrthogonalization(ksp, KSPGMRESModifiedGramSchmidtOrthogonalization));
   PetscCall(PetscOptionsEnum("-ksp_gmres_cgs_refinement_type", "Type of iterative refinement for classical (unmodified) Gram-Schmidt", "KSPGMRESSetCGSRefinementType", KSPGMRESCGSRefinementTypes, (PetscEnum)gmres->cgstype, (PetscEnum *)&gmres->cgstype, &flg));
+  PetscCall(PetscOptionsBool("-ksp_gmres_cgs_fused", "Fuse the classical Gram-Schmidt updates with the norm and refinement dot products", "VecMAXPYMDot", gmres->cgsfused, &gmres->cgsfused, NULL));
   flg = PETSC_FALSE;
   PetscCall(PetscOptionsBool("-ksp_gmres_krylov_monitor", "Plot the Krylov directions", "KSPMonitorSet", flg, &flg, NULL));
   if (flg) {
@@ -835,6 +837,8 @@ PetscErrorCode KSPGMRESSetBreakdownTolerance(KSP ksp, PetscReal tol)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
 .   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
                                    stability of the classical Gram-Schmidt  orthogonalization.
+.   -ksp_gmres_cgs_fused - fuse the vector updates of the classical Gram-Schmidt orthogonalization with the following norm and
+                           refinement dot products, see `VecMAXPYMDot()`
 -   -ksp_gmres_krylov_monitor - plot the Krylov space generated
 
    Level: beginner
@@ -29,6 +29,7 @@
 \
   PetscErrorCode (*orthog)(KSP, PetscInt); \
   KSPGMRESCGSRefinementType cgstype; \
+  PetscBool                 cgsfused; /* use VecMAXPYMDot() in the classical Gram-Schmidt orthogonalization */ \
 \
   Vec     *vecs;           /* the work vectors */ \
   Vec     *vecb;           /* holds the last full basis vectors of the Krylov subspace to compute (harmonic) Ritz pairs */ \
@@ -100,18 +100,27 @@ PetscErrorCode KSPSolve_Richardson(KSP ksp)
       ksp->its++;
     }
   } else {
+    /* with a lagged norm the reduction is started here and only completed after the next residual has been computed */
+    PetscBool    lag = (PetscBool)(ksp->lagnorm && ksp->normtype != KSP_NORM_NONE);
+    VecReduction rred;
+
     for (i = 0; i < maxit; i++) {
       if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {
-        PetscCall(VecNorm(r, NORM_2, &rnorm)); /*   rnorm <- r'*r     */
+        if (lag) PetscCall(VecNormAsync(r, NORM_2, &rred)); /*   rnorm <- r'*r     */
+        else PetscCall(VecNorm(r, NORM_2, &rnorm));
       } else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {
-        PetscCall(KSP_PCApply(ksp, r, z));     /*   z <- B r          */
-        PetscCall(VecNorm(z, NORM_2, &rnorm)); /*   rnorm <- z'*z     */
+        PetscCall(KSP_PCApply(ksp, r, z)); /*   z <- B r          */
+        if (lag) PetscCall(VecNormAsync(z, NORM_2, &rred)); /*   rnorm <- z'*z     */
+        else PetscCall(VecNorm(z, NORM_2, &rnorm));
       } else rnorm = 0.0;
-      ksp->rnorm = rnorm;
-      PetscCall(KSPMonitor(ksp, i, rnorm));
-      PetscCall(KSPLogResidualHistory(ksp, rnorm));
-      PetscCall((*ksp->converged)(ksp, i, rnorm, &ksp->reason, ksp->cnvP));
-      if (ksp->reason) break;
+      if (lag) PetscCall(PetscCommReductionFlush(PetscObjectComm((PetscObject)r)));
+      else {
+        ksp->rnorm = rnorm;
+        PetscCall(KSPMonitor(ksp, i, rnorm));
+        PetscCall(KSPLogResidualHistory(ksp, rnorm));
+        PetscCall((*ksp->converged)(ksp, i, rnorm, &ksp->reason, ksp->cnvP));
+        if (ksp->reason) break;
+      }
       if (ksp->normtype != KSP_NORM_PRECONDITIONED) { PetscCall(KSP_PCApply(ksp, r, z)); /*   z <- B r          */ }
 
       PetscCall(VecAXPY(x, richardsonP->scale, z)); /*   x  <- x + scale z */
@@ -121,6 +130,16 @@ PetscErrorCode KSPSolve_Richardson(KSP ksp)
         PetscCall(KSP_MatMult(ksp, Amat, x, r)); /*   r  <- b - Ax      */
         PetscCall(VecAYPX(r, -1.0, b));
       }
+      if (lag) { /* the convergence test sees the norm of the previous residual, the solution is one step ahead */
+        PetscCall(VecReductionGetNorm(rred, &rnorm));
+        PetscCall(VecReductionDestroy(&rred));
+        KSPCheckNorm(ksp, rnorm);
+        ksp->rnorm = rnorm;
+        PetscCall(KSPMonitor(ksp, i, rnorm));
+        PetscCall(KSPLogResidualHistory(ksp, rnorm));
+        PetscCall((*ksp->converged)(ksp, i, rnorm, &ksp->reason, ksp->cnvP));
+        if (ksp->reason) break;
+      }
     }
   }
   if (!ksp->reason) {
@@ -224,8 +243,9 @@ static PetscErrorCode KSPBuildResidual_Richardson(KSP ksp, Vec t, Vec v, Vec *V)
 /*MC
      KSPRICHARDSON - The preconditioned Richardson iterative method
 
-   Options Database Key:
-.   -ksp_richardson_scale - damping factor on the correction (defaults to 1.0)
+   Options Database Keys:
++   -ksp_richardson_scale - damping factor on the correction (defaults to 1.0)
+-   -ksp_lag_norm - overlap the residual norm reduction with the next iteration, see `KSPSetLagNorm()`
 
    Level: beginner
 
@@ -245,6 +265,10 @@ static PetscErrorCode KSPBuildResidual_Richardson(KSP ksp, Vec t, Vec v, Vec *V)
     any other monitor) is not turned on then the convergence test is done by the preconditioner itself and
     so the solver may run more or fewer iterations then if -ksp_monitor is selected.
 
+    With `KSPSetLagNorm()` the norm of each residual is communicated while the next residual is computed, the convergence test
+    then sees the norm of the previous residual and the returned solution is one iteration ahead of it. This is not done with
+    `KSPRichardsonSetSelfScale()`.
+
     Supports only left preconditioning
 
     If using direct solvers such as `PCLU` and `PCCHOLESKY` one generally uses `KSPPREONLY` which uses exactly one iteration
@@ -258,7 +282,7 @@ $    -ksp_type richardson -pc_type jacobi gives one classically Jacobi precondit
   Containing Papers of a Mathematical or Physical Character, Vol. 210, 1911 (1911).
 
 .seealso: [](chapter_ksp), `KSPCreate()`, `KSPSetType()`, `KSPType`, `KSP`,
-          `KSPRichardsonSetScale()`, `KSPPREONLY`
+          `KSPRichardsonSetScale()`, `KSPPREONLY`, `KSPSetLagNorm()`
 M*/
 
 PETSC_EXTERN PetscErrorCode KSPCreate_Richardson(KSP ksp)
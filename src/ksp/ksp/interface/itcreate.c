@@ -325,7 +325,7 @@ PetscErrorCode KSPSetCheckNormIteration(KSP ksp, PetscInt it)
    Level: advanced
 
    Notes:
-   Currently only works with `KSPIBCGS`.
+   Currently only works with `KSPIBCGS` and `KSPRICHARDSON`.
 
    Use `KSPSetNormType`(ksp,`KSP_NORM_NONE`) to never check the norm
 
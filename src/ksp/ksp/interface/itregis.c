@@ -7,6 +7,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_GROPPCG(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPECG(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPECGRR(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPELCG(KSP);
+PETSC_EXTERN PetscErrorCode KSPCreate_CACG(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPEPRCG(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPECG2(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_CGNE(KSP);
@@ -41,6 +42,7 @@ PETSC_EXTERN PetscErrorCode KSPCreate_LCD(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_GCR(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PIPEGCR(KSP);
 PETSC_EXTERN PetscErrorCode KSPCreate_PGMRES(KSP);
+PETSC_EXTERN PetscErrorCode KSPCreate_CAGMRES(KSP);
 #if !defined(PETSC_USE_COMPLEX)
 PETSC_EXTERN PetscErrorCode KSPCreate_DGMRES(KSP);
 #endif
@@ -71,6 +73,7 @@ PetscErrorCode KSPRegisterAll(void)
   PetscCall(KSPRegister(KSPPIPECG, KSPCreate_PIPECG));
   PetscCall(KSPRegister(KSPPIPECGRR, KSPCreate_PIPECGRR));
   PetscCall(KSPRegister(KSPPIPELCG, KSPCreate_PIPELCG));
+  PetscCall(KSPRegister(KSPCACG, KSPCreate_CACG));
   PetscCall(KSPRegister(KSPPIPEPRCG, KSPCreate_PIPEPRCG));
   PetscCall(KSPRegister(KSPPIPECG2, KSPCreate_PIPECG2));
   PetscCall(KSPRegister(KSPCGNE, KSPCreate_CGNE));
@@ -108,6 +111,7 @@ PetscErrorCode KSPRegisterAll(void)
   PetscCall(KSPRegister(KSPGCR, KSPCreate_GCR));
   PetscCall(KSPRegister(KSPPIPEGCR, KSPCreate_PIPEGCR));
   PetscCall(KSPRegister(KSPPGMRES, KSPCreate_PGMRES));
+  PetscCall(KSPRegister(KSPCAGMRES, KSPCreate_CAGMRES));
 #if !defined(PETSC_USE_COMPLEX)
   PetscCall(KSPRegister(KSPDGMRES, KSPCreate_DGMRES));
 #endif
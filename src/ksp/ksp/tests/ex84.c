@@ -0,0 +1,102 @@
+static char help[] = "Tests MATAIJMIXED as the preconditioner matrix of a double precision solve.\n\n";
+
+#include <petscksp.h>
+
+int main(int argc, char **args)
+{
+  Mat       A, P;
+  Vec       x, b, y, z;
+  KSP       ksp;
+  PetscInt  n = 20, Istart, Iend, Ii, i, j;
+  PetscReal nrm, nrmy, rnorm;
+  PetscBool flg;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+
+  /* 5 point Laplacian on an n x n grid with values that are not exact in single precision */
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, n * n, n * n, 5, NULL, 5, NULL, &A));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (Ii = Istart; Ii < Iend; Ii++) {
+    i = Ii / n;
+    j = Ii - i * n;
+    if (i > 0) PetscCall(MatSetValue(A, Ii, Ii - n, -1.0 / 3.0, INSERT_VALUES));
+    if (i < n - 1) PetscCall(MatSetValue(A, Ii, Ii + n, -1.0 / 3.0, INSERT_VALUES));
+    if (j > 0) PetscCall(MatSetValue(A, Ii, Ii - 1, -1.0 / 7.0, INSERT_VALUES));
+    if (j < n - 1) PetscCall(MatSetValue(A, Ii, Ii + 1, -1.0 / 7.0, INSERT_VALUES));
+    PetscCall(MatSetValue(A, Ii, Ii, 4.0 / 3.0 + 0.1, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatConvert(A, MATAIJMIXED, MAT_INITIAL_MATRIX, &P));
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)P, &flg, MATSEQAIJMIXED, MATMPIAIJMIXED, ""));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Wrong matrix type after MatConvert()");
+
+  /* the products only differ by the rounding of the matrix entries */
+  PetscCall(MatCreateVecs(A, &x, &b));
+  PetscCall(VecDuplicate(b, &y));
+  PetscCall(VecDuplicate(b, &z));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(MatMult(A, x, y));
+  PetscCall(MatMult(P, x, z));
+  PetscCall(VecAXPY(z, -1.0, y));
+  PetscCall(VecNorm(z, NORM_INFINITY, &nrm));
+  PetscCall(VecNorm(y, NORM_INFINITY, &nrmy));
+  PetscCheck(nrm > 0.0 && nrm < 1.e-6 * nrmy, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Error in MatMult() %g", (double)nrm);
+  PetscCall(MatMultAdd(P, x, y, z));
+  PetscCall(VecAXPBY(z, -2.0, 1.0, y));
+  PetscCall(VecNorm(z, NORM_INFINITY, &nrm));
+  PetscCheck(nrm < 1.e-6 * nrmy, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Error in MatMultAdd() %g", (double)nrm);
+
+  /* changing the values must update the single precision copy */
+  PetscCall(MatScale(A, 2.0));
+  PetscCall(MatScale(P, 2.0));
+  PetscCall(MatMult(A, x, y));
+  PetscCall(MatMult(P, x, z));
+  PetscCall(VecAXPY(z, -1.0, y));
+  PetscCall(VecNorm(z, NORM_INFINITY, &nrm));
+  PetscCheck(nrm < 2.e-6 * nrmy, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Error in MatMult() after MatScale() %g", (double)nrm);
+
+  /* the solution must still be accurate to the tolerance of the solver */
+  PetscCall(MatMult(A, x, b));
+  PetscCall(KSPCreate(PETSC_COMM_WORLD, &ksp));
+  PetscCall(KSPSetOperators(ksp, A, P));
+  PetscCall(KSPSetTolerances(ksp, 1.e-12, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT));
+  PetscCall(KSPSetFromOptions(ksp));
+  PetscCall(KSPSolve(ksp, b, y));
+  PetscCall(MatMult(A, y, z));
+  PetscCall(VecAXPY(z, -1.0, b));
+  PetscCall(VecNorm(z, NORM_2, &rnorm));
+  PetscCall(VecNorm(b, NORM_2, &nrm));
+  PetscCheck(rnorm < 1.e-10 * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Residual norm %g", (double)rnorm);
+
+  PetscCall(KSPDestroy(&ksp));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&P));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&z));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   build:
+      requires: !complex double
+
+   test:
+      suffix: 1
+      nsize: {{1 2}}
+      output_file: output/empty.out
+      args: -ksp_type {{gmres cg}} -pc_type {{sor jacobi}}
+
+   test:
+      suffix: mg
+      nsize: 2
+      output_file: output/empty.out
+      args: -n 32 -pc_type gamg -mg_levels_pc_type sor -mg_levels_ksp_type richardson
+
+TEST*/
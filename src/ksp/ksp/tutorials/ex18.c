@@ -283,6 +283,31 @@ int main(int argc, char **args)
       args: -m 13 -n 17 -ksp_monitor_short -ksp_type cg -ksp_cg_single_reduction
       requires: !single
 
+   test:
+      suffix: cg_fused
+      nsize: 3
+      output_file: output/ex18_3.out
+      args: -m 13 -n 17 -ksp_monitor_short -ksp_type cg -ksp_cg_fused
+      requires: !single
+
+   test:
+      suffix: cg_fused_unpreconditioned
+      nsize: 3
+      args: -m 13 -n 17 -ksp_monitor_short -ksp_type cg -ksp_norm_type unpreconditioned -ksp_cg_fused
+      requires: !single
+
+   test:
+      suffix: bcgs_fused
+      nsize: 3
+      args: -m 13 -n 17 -ksp_monitor_short -ksp_type bcgs -ksp_bcgs_fused
+      requires: !single
+
+   test:
+      suffix: richardson_lag_norm
+      nsize: 3
+      args: -m 8 -n 7 -ksp_monitor_short -ksp_type richardson -pc_type sor -ksp_rtol 1e-2 -ksp_norm_type {{preconditioned unpreconditioned}separate output} -ksp_lag_norm
+      requires: !single
+
    test:
       suffix: bas
       args: -m 13 -n 17 -ksp_monitor_short -ksp_type cg -pc_type icc -pc_factor_mat_solver_type bas -ksp_view -pc_factor_levels 1
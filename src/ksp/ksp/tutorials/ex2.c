@@ -234,6 +234,36 @@ int main(int argc, char **args)
       nsize: 2
       args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type refine_always
 
+   test:
+      suffix: cacg
+      args: -ksp_monitor_short -ksp_type cacg -m 9 -n 9 -ksp_cacg_basis {{monomial newton chebyshev}}
+
+   test:
+      suffix: cacg_2
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type cacg -m 9 -n 9 -ksp_cacg_s 6 -ksp_norm_type unpreconditioned -pc_type jacobi
+
+   test:
+      suffix: cagmres
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type cagmres -m 9 -n 9 -ksp_cagmres_restart 8 -ksp_cagmres_basis {{monomial newton}} -ksp_cagmres_reorthogonalize {{0 1}}
+
+   test:
+      suffix: cagmres_powers
+      nsize: 3
+      args: -ksp_monitor_short -ksp_type cagmres -m 9 -n 9 -ksp_cagmres_s 5 -ksp_cagmres_restart 10 -ksp_cagmres_basis monomial -pc_type none
+
+   test:
+      suffix: cagmres_right
+      nsize: 2
+      args: -ksp_monitor_short -ksp_type cagmres -m 9 -n 9 -ksp_cagmres_s 3 -ksp_cagmres_restart 10 -ksp_pc_side right
+
+   test:
+      suffix: cgs_fused
+      nsize: 2
+      output_file: output/ex2_2.out
+      args: -ksp_monitor_short -m 5 -n 5 -ksp_gmres_cgs_refinement_type {{refine_never refine_ifneeded refine_always}} -ksp_gmres_cgs_fused
+
    test:
       suffix: 3
       args: -pc_type sor -pc_sor_symmetric -ksp_monitor_short -ksp_gmres_cgs_refinement_type refine_always
@@ -263,6 +293,11 @@ int main(int argc, char **args)
       nsize: 4
       args: -pc_type bjacobi -pc_bjacobi_blocks 4 -ksp_monitor_short -sub_pc_type jacobi -sub_ksp_type gmres
 
+   test:
+      suffix: chowilu
+      nsize: 2
+      args: -pc_type bjacobi -sub_pc_type chowilu -sub_pc_chowilu_levels 1 -ksp_monitor_short -ksp_converged_reason
+
    test:
       suffix: qmrcgs
       args: -ksp_type qmrcgs -pc_type ilu
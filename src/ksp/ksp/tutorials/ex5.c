@@ -384,6 +384,11 @@ int main(int argc, char **args)
       nsize: 4
       args: -pc_type asm
 
+   test:
+      suffix: cacg
+      args: -ksp_type cacg -pc_type jacobi -info :ksp
+      filter: grep -e "s-step basis" -e "Relative norm"
+
    test:
       suffix: asm_baij
       nsize: 4
@@ -0,0 +1,475 @@
+/*
+   Fine-grained iterative incomplete LU factorization of Chow and Patel for MATSEQAIJ matrices on CPU threads.
+
+   The nonzeros of the factors L (strictly lower triangular, unit diagonal) and U (upper triangular) are computed
+   by fixed-point sweeps over the nonzeros of the ILU(k) pattern S, all nonzeros being updated independently from
+   the values of the previous sweep:
+
+     l_ij = (a_ij - sum_{k < j} l_ik u_kj) / u_jj    for (i,j) in S, i > j
+     u_ij =  a_ij - sum_{k < i} l_ik u_kj            for (i,j) in S, i <= j
+
+   The triangular solves are replaced by a few Jacobi sweeps, which are also fully parallel.
+*/
+#include <petsc/private/pcimpl.h> /*I "petscpc.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef struct {
+  PetscInt       levels;                /* levels of fill of the pattern */
+  PetscInt       sweeps;                /* fixed-point sweeps of the factorization */
+  PetscInt       solvesweeps;           /* Jacobi sweeps of each triangular solve */
+  PetscInt       nthreads;              /* PETSC_DECIDE uses the threads of the matrix, see -mat_aij_threads */
+  PetscInt       nt;                    /* threads actually used */
+  PetscInt       n;                     /* number of rows */
+  PetscLogDouble flops;                 /* flops of one sweep of the factorization */
+  PetscInt      *li, *lj, *lrow, *la;   /* L by rows without the diagonal, row of each nonzero, location in A or -1 */
+  PetscScalar   *lv, *lvwork;           /* values of L, of the current and of the next sweep */
+  PetscInt      *uci, *ucj, *ucol, *ua; /* U by columns with the diagonal last in each column */
+  PetscScalar   *uv, *uvwork;           /* values of U, of the current and of the next sweep */
+  PetscInt      *uri, *urj, *urperm;    /* U by rows without the diagonal, and the location of each nonzero in the columns */
+  PetscScalar   *urv, *udinv, *work[3]; /* U by rows for the solves, the inverse of the diagonal of U and work arrays */
+} PC_ChowILU;
+
+static PetscErrorCode PCReset_ChowILU(PC pc)
+{
+  PC_ChowILU *ilu = (PC_ChowILU *)pc->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree6(ilu->li, ilu->lj, ilu->lrow, ilu->la, ilu->lv, ilu->lvwork));
+  PetscCall(PetscFree6(ilu->uci, ilu->ucj, ilu->ucol, ilu->ua, ilu->uv, ilu->uvwork));
+  PetscCall(PetscFree4(ilu->uri, ilu->urj, ilu->urperm, ilu->urv));
+  PetscCall(PetscFree4(ilu->udinv, ilu->work[0], ilu->work[1], ilu->work[2]));
+  ilu->n = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Sparse dot product of the row i of L with the column j of U restricted to k < m */
+static inline PetscScalar PCChowILUDot_Private(const PC_ChowILU *ilu, const PetscScalar *lv, const PetscScalar *uv, PetscInt i, PetscInt j, PetscInt m)
+{
+  PetscInt    p = ilu->li[i], pe = ilu->li[i + 1], q = ilu->uci[j], qe = ilu->uci[j + 1];
+  PetscScalar sum = 0.0;
+
+  while (p < pe && q < qe) {
+    const PetscInt kl = ilu->lj[p], ku = ilu->ucj[q];
+
+    if (kl >= m || ku >= m) break;
+    if (kl == ku) sum += lv[p++] * uv[q++];
+    else if (kl < ku) p++;
+    else q++;
+  }
+  return sum;
+}
+
+/* Number of products of PCChowILUDot_Private() */
+static PetscInt PCChowILUCount_Private(const PC_ChowILU *ilu, PetscInt i, PetscInt j, PetscInt m)
+{
+  PetscInt p = ilu->li[i], pe = ilu->li[i + 1], q = ilu->uci[j], qe = ilu->uci[j + 1], cnt = 0;
+
+  while (p < pe && q < qe) {
+    const PetscInt kl = ilu->lj[p], ku = ilu->ucj[q];
+
+    if (kl >= m || ku >= m) break;
+    if (kl == ku) {
+      cnt++;
+      p++;
+      q++;
+    } else if (kl < ku) p++;
+    else q++;
+  }
+  return cnt;
+}
+
+/* Computes the ILU(k) pattern with the symbolic factorization of MATSOLVERPETSC and the location of its nonzeros in A */
+static PetscErrorCode PCChowILUSetUpSymbolic_Private(PC pc)
+{
+  PC_ChowILU     *ilu = (PC_ChowILU *)pc->data;
+  Mat             A = pc->pmat, F;
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data, *f;
+  IS              row, col;
+  MatFactorInfo   info;
+  const PetscInt  n = A->rmap->n;
+  const PetscInt *fi, *fj, *fdiag;
+  PetscInt        i, j, k, p, nzl, nzu, *cnt;
+
+  PetscFunctionBegin;
+  PetscCall(PCReset_ChowILU(pc));
+  PetscCall(MatFactorInfoInitialize(&info));
+  info.levels = ilu->levels;
+  info.fill   = 1.0;
+  PetscCall(MatGetOrdering(A, MATORDERINGNATURAL, &row, &col));
+  PetscCall(MatGetFactor(A, MATSOLVERPETSC, MAT_FACTOR_ILU, &F));
+  PetscCall(MatILUFactorSymbolic(F, A, row, col, &info));
+  PetscCall(ISDestroy(&row));
+  PetscCall(ISDestroy(&col));
+
+  /* the row i of L is in fj[fi[i]:fi[i+1]], the row i of U without the diagonal in fj[fdiag[i+1]+1:fdiag[i]] */
+  f     = (Mat_SeqAIJ *)F->data;
+  fi    = f->i;
+  fj    = f->j;
+  fdiag = f->diag;
+  nzl   = fi[n];
+  nzu   = fdiag[0] - fdiag[n] - n;
+  PetscCall(PetscMalloc6(n + 1, &ilu->li, nzl, &ilu->lj, nzl, &ilu->lrow, nzl, &ilu->la, nzl, &ilu->lv, nzl, &ilu->lvwork));
+  PetscCall(PetscMalloc6(n + 1, &ilu->uci, nzu + n, &ilu->ucj, nzu + n, &ilu->ucol, nzu + n, &ilu->ua, nzu + n, &ilu->uv, nzu + n, &ilu->uvwork));
+  PetscCall(PetscMalloc4(n + 1, &ilu->uri, nzu, &ilu->urj, nzu, &ilu->urperm, nzu, &ilu->urv));
+  PetscCall(PetscMalloc4(n, &ilu->udinv, n, &ilu->work[0], n, &ilu->work[1], n, &ilu->work[2]));
+  ilu->n = n;
+
+  PetscCall(PetscArraycpy(ilu->li, fi, n + 1));
+  PetscCall(PetscArraycpy(ilu->lj, fj, nzl));
+  for (i = 0; i < n; i++) {
+    for (p = fi[i]; p < fi[i + 1]; p++) ilu->lrow[p] = i;
+  }
+  ilu->uri[0] = 0;
+  for (i = 0; i < n; i++) {
+    ilu->uri[i + 1] = ilu->uri[i] + fdiag[i] - fdiag[i + 1] - 1;
+    PetscCall(PetscArraycpy(ilu->urj + ilu->uri[i], fj + fdiag[i + 1] + 1, ilu->uri[i + 1] - ilu->uri[i]));
+  }
+  PetscCall(MatDestroy(&F));
+
+  /* U by columns, the rows are inserted in increasing order so the diagonal is the last entry of each column */
+  PetscCall(PetscCalloc1(n + 1, &cnt));
+  for (p = 0; p < nzu; p++) cnt[ilu->urj[p] + 1]++;
+  ilu->uci[0] = 0;
+  for (j = 0; j < n; j++) ilu->uci[j + 1] = ilu->uci[j] + cnt[j + 1] + 1;
+  for (j = 0; j < n; j++) cnt[j] = ilu->uci[j];
+  for (i = 0; i < n; i++) {
+    for (p = ilu->uri[i]; p < ilu->uri[i + 1]; p++) {
+      j                 = ilu->urj[p];
+      ilu->urperm[p]    = cnt[j];
+      ilu->ucj[cnt[j]]  = i;
+      ilu->ucol[cnt[j]] = j;
+      cnt[j]++;
+    }
+    ilu->ucj[cnt[i]]  = i;
+    ilu->ucol[cnt[i]] = i;
+    cnt[i]++;
+  }
+  PetscCall(PetscFree(cnt));
+
+  /* location of the nonzeros of the pattern in A, the rows of both are sorted */
+  for (i = 0; i < n; i++) {
+    const PetscInt *aj = a->j + a->i[i], anz = a->i[i + 1] - a->i[i];
+
+    for (k = 0, p = ilu->li[i]; p < ilu->li[i + 1]; p++) {
+      while (k < anz && aj[k] < ilu->lj[p]) k++;
+      ilu->la[p] = (k < anz && aj[k] == ilu->lj[p]) ? a->i[i] + k : -1;
+    }
+    while (k < anz && aj[k] < i) k++;
+    ilu->ua[ilu->uci[i + 1] - 1] = (k < anz && aj[k] == i) ? a->i[i] + k : -1;
+    for (p = ilu->uri[i]; p < ilu->uri[i + 1]; p++) {
+      while (k < anz && aj[k] < ilu->urj[p]) k++;
+      ilu->ua[ilu->urperm[p]] = (k < anz && aj[k] == ilu->urj[p]) ? a->i[i] + k : -1;
+    }
+  }
+  /* two flops for each common index of the sparse dot products */
+  ilu->flops = 0.0;
+  for (p = 0; p < nzl; p++) ilu->flops += 2.0 + 2.0 * PCChowILUCount_Private(ilu, ilu->lrow[p], ilu->lj[p], ilu->lj[p]);
+  for (p = 0; p < nzu + n; p++) ilu->flops += 1.0 + 2.0 * PCChowILUCount_Private(ilu, ilu->ucj[p], ilu->ucol[p], ilu->ucj[p]);
+  PetscCall(PetscInfo(pc, "ILU(%" PetscInt_FMT ") pattern with %" PetscInt_FMT " nonzeros in L and %" PetscInt_FMT " in U, %" PetscInt_FMT " in the matrix\n", ilu->levels, nzl, nzu + n, a->nz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetUp_ChowILU(PC pc)
+{
+  PC_ChowILU        *ilu = (PC_ChowILU *)pc->data;
+  Mat                A   = pc->pmat;
+  const PetscScalar *aa;
+  PetscInt           n, nzl, nzu, j, s, nt;
+  PetscBool          isseqaij;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectBaseTypeCompare((PetscObject)A, MATSEQAIJ, &isseqaij));
+  PetscCheck(isseqaij, PetscObjectComm((PetscObject)pc), PETSC_ERR_SUP, "Only for MATSEQAIJ matrices, use it as the subdomain solver of PCBJACOBI or PCASM in parallel");
+  if (!pc->setupcalled || pc->flag != SAME_NONZERO_PATTERN) PetscCall(PCChowILUSetUpSymbolic_Private(pc));
+  pc->failedreason = PC_NOERROR;
+  n                = ilu->n;
+  nzl              = ilu->li[n];
+  nzu              = ilu->uci[n];
+  nt               = ilu->nthreads == PETSC_DECIDE ? ((Mat_SeqAIJ *)A->data)->threads.n : ilu->nthreads;
+  ilu->nt          = nt;
+  PetscCheck(nt >= 1, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Number of threads %" PetscInt_FMT " must be positive", nt);
+
+  /* the initial guess is the strictly lower part of A scaled by the diagonal and the upper part of A */
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (j = 0; j < n; j++) {
+    const PetscInt d = ilu->ua[ilu->uci[j + 1] - 1];
+
+    if (d < 0 || aa[d] == 0.0) {
+      PetscCall(PetscInfo(pc, "Zero diagonal entry in row %" PetscInt_FMT "\n", j));
+      pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+      PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+  }
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+  for (PetscInt p = 0; p < nzl; p++) ilu->lv[p] = ilu->la[p] < 0 ? 0.0 : aa[ilu->la[p]] / aa[ilu->ua[ilu->uci[ilu->lj[p] + 1] - 1]];
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+  for (PetscInt p = 0; p < nzu; p++) ilu->uv[p] = ilu->ua[p] < 0 ? 0.0 : aa[ilu->ua[p]];
+
+  for (s = 0; s < ilu->sweeps; s++) {
+    const PetscScalar *lv = ilu->lv, *uv = ilu->uv;
+    PetscScalar       *lvnew = ilu->lvwork, *uvnew = ilu->uvwork;
+
+    for (j = 0; j < n; j++) {
+      if (uv[ilu->uci[j + 1] - 1] == 0.0) {
+        PetscCall(PetscInfo(pc, "Zero pivot in row %" PetscInt_FMT " at sweep %" PetscInt_FMT "\n", j, s));
+        pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+        PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+        PetscFunctionReturn(PETSC_SUCCESS);
+      }
+    }
+    PetscPragmaOMP(parallel num_threads(nt))
+    {
+      PetscPragmaOMP(for schedule(static) nowait)
+      for (PetscInt p = 0; p < nzl; p++) {
+        const PetscInt i = ilu->lrow[p], jj = ilu->lj[p];
+
+        lvnew[p] = ((ilu->la[p] < 0 ? 0.0 : aa[ilu->la[p]]) - PCChowILUDot_Private(ilu, lv, uv, i, jj, jj)) / uv[ilu->uci[jj + 1] - 1];
+      }
+      PetscPragmaOMP(for schedule(static))
+      for (PetscInt p = 0; p < nzu; p++) {
+        const PetscInt i = ilu->ucj[p], jj = ilu->ucol[p];
+
+        uvnew[p] = (ilu->ua[p] < 0 ? 0.0 : aa[ilu->ua[p]]) - PCChowILUDot_Private(ilu, lv, uv, i, jj, i);
+      }
+    }
+    ilu->lvwork = ilu->lv;
+    ilu->lv     = lvnew;
+    ilu->uvwork = ilu->uv;
+    ilu->uv     = uvnew;
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(PetscLogFlops(ilu->sweeps * ilu->flops));
+
+  for (j = 0; j < n; j++) {
+    const PetscScalar d = ilu->uv[ilu->uci[j + 1] - 1];
+
+    if (d == 0.0) {
+      PetscCall(PetscInfo(pc, "Zero pivot in row %" PetscInt_FMT "\n", j));
+      pc->failedreason = PC_FACTOR_NUMERIC_ZEROPIVOT;
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    ilu->udinv[j] = 1.0 / d;
+  }
+  for (PetscInt p = 0; p < ilu->uri[n]; p++) ilu->urv[p] = ilu->uv[ilu->urperm[p]];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCApply_ChowILU(PC pc, Vec x, Vec y)
+{
+  PC_ChowILU        *ilu = (PC_ChowILU *)pc->data;
+  const PetscInt     n = ilu->n, nt = ilu->nt, *li = ilu->li, *lj = ilu->lj, *uri = ilu->uri, *urj = ilu->urj;
+  const PetscScalar *b, *lv = ilu->lv, *urv = ilu->urv, *udinv = ilu->udinv;
+  PetscScalar       *t0 = ilu->work[0], *t1 = ilu->work[1], *t2 = ilu->work[2], *xx, *tmp;
+  PetscInt           s;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(x, &b));
+  PetscCall(VecGetArrayWrite(y, &xx));
+  /* Jacobi sweeps for L t0 = b, starting from t0 = b */
+  PetscCall(PetscArraycpy(t0, b, n));
+  for (s = 0; s < ilu->solvesweeps; s++) {
+    PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+    for (PetscInt i = 0; i < n; i++) {
+      PetscScalar sum = b[i];
+
+      for (PetscInt p = li[i]; p < li[i + 1]; p++) sum -= lv[p] * t0[lj[p]];
+      t1[i] = sum;
+    }
+    tmp = t0;
+    t0  = t1;
+    t1  = tmp;
+  }
+  /* Jacobi sweeps for U t1 = t0, starting from t1 = D^{-1} t0 */
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+  for (PetscInt i = 0; i < n; i++) t1[i] = udinv[i] * t0[i];
+  for (s = 0; s < ilu->solvesweeps; s++) {
+    PetscPragmaOMP(parallel for num_threads(nt) schedule(static))
+    for (PetscInt i = 0; i < n; i++) {
+      PetscScalar sum = t0[i];
+
+      for (PetscInt p = uri[i]; p < uri[i + 1]; p++) sum -= urv[p] * t1[urj[p]];
+      t2[i] = udinv[i] * sum;
+    }
+    tmp = t1;
+    t1  = t2;
+    t2  = tmp;
+  }
+  PetscCall(PetscArraycpy(xx, t1, n));
+  PetscCall(VecRestoreArrayRead(x, &b));
+  PetscCall(VecRestoreArrayWrite(y, &xx));
+  PetscCall(PetscLogFlops(2.0 * ilu->solvesweeps * (li[n] + uri[n]) + n * (ilu->solvesweeps + 1.0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCDestroy_ChowILU(PC pc)
+{
+  PetscFunctionBegin;
+  PetscCall(PCReset_ChowILU(pc));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCChowILUSetLevels_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCChowILUSetSweeps_C", NULL));
+  PetscCall(PetscFree(pc->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCSetFromOptions_ChowILU(PC pc, PetscOptionItems *PetscOptionsObject)
+{
+  PC_ChowILU *ilu = (PC_ChowILU *)pc->data;
+  PetscInt    levels, sweeps, solvesweeps;
+  PetscBool   flg1, flg2, flg3;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "Chow-Patel iterative ILU options");
+  PetscCall(PetscOptionsInt("-pc_chowilu_levels", "Levels of fill of the pattern", "PCChowILUSetLevels", ilu->levels, &levels, &flg1));
+  if (flg1) PetscCall(PCChowILUSetLevels(pc, levels));
+  PetscCall(PetscOptionsInt("-pc_chowilu_sweeps", "Number of fixed-point sweeps of the factorization", "PCChowILUSetSweeps", ilu->sweeps, &sweeps, &flg2));
+  PetscCall(PetscOptionsInt("-pc_chowilu_solve_sweeps", "Number of Jacobi sweeps of each triangular solve", "PCChowILUSetSweeps", ilu->solvesweeps, &solvesweeps, &flg3));
+  if (flg2 || flg3) PetscCall(PCChowILUSetSweeps(pc, flg2 ? sweeps : ilu->sweeps, flg3 ? solvesweeps : ilu->solvesweeps));
+  PetscCall(PetscOptionsInt("-pc_chowilu_threads", "Number of threads, PETSC_DECIDE uses the threads of the matrix (-mat_aij_threads)", "", ilu->nthreads, &ilu->nthreads, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCView_ChowILU(PC pc, PetscViewer viewer)
+{
+  PC_ChowILU *ilu = (PC_ChowILU *)pc->data;
+  PetscBool   iascii;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPrintf(viewer, "  %" PetscInt_FMT " levels of fill, %" PetscInt_FMT " factorization sweeps, %" PetscInt_FMT " sweeps per triangular solve\n", ilu->levels, ilu->sweeps, ilu->solvesweeps));
+    if (ilu->n) PetscCall(PetscViewerASCIIPrintf(viewer, "  %" PetscInt_FMT " nonzeros in L, %" PetscInt_FMT " in U, %" PetscInt_FMT " threads\n", ilu->li[ilu->n], ilu->uci[ilu->n], ilu->nt));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCChowILUSetLevels_ChowILU(PC pc, PetscInt levels)
+{
+  PC_ChowILU *ilu = (PC_ChowILU *)pc->data;
+
+  PetscFunctionBegin;
+  if (levels != ilu->levels) {
+    ilu->levels     = levels;
+    pc->setupcalled = 0;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCChowILUSetSweeps_ChowILU(PC pc, PetscInt sweeps, PetscInt solvesweeps)
+{
+  PC_ChowILU *ilu = (PC_ChowILU *)pc->data;
+
+  PetscFunctionBegin;
+  ilu->sweeps      = sweeps;
+  ilu->solvesweeps = solvesweeps;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PCChowILUSetLevels - Sets the number of levels of fill of the pattern of the iterative incomplete factorization `PCCHOWILU`
+
+   Logically Collective
+
+   Input Parameters:
++  pc - the preconditioner context
+-  levels - the number of levels of fill, 0 uses the nonzero pattern of the matrix
+
+   Options Database Key:
+.  -pc_chowilu_levels <levels> - the number of levels
+
+   Level: intermediate
+
+.seealso: `PCCHOWILU`, `PCChowILUSetSweeps()`, `PCFactorSetLevels()`
+@*/
+PetscErrorCode PCChowILUSetLevels(PC pc, PetscInt levels)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(pc, levels, 2);
+  PetscCheck(levels >= 0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Number of levels %" PetscInt_FMT " cannot be negative", levels);
+  PetscTryMethod(pc, "PCChowILUSetLevels_C", (PC, PetscInt), (pc, levels));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PCChowILUSetSweeps - Sets the number of sweeps of the iterative incomplete factorization `PCCHOWILU` and of its triangular solves
+
+   Logically Collective
+
+   Input Parameters:
++  pc - the preconditioner context
+.  sweeps - the number of fixed-point sweeps computing the factors
+-  solvesweeps - the number of Jacobi sweeps approximating each triangular solve
+
+   Options Database Keys:
++  -pc_chowilu_sweeps <sweeps> - the number of sweeps of the factorization
+-  -pc_chowilu_solve_sweeps <solvesweeps> - the number of sweeps of each triangular solve
+
+   Level: intermediate
+
+   Note:
+   With as many sweeps as the depth of the dependency graph of the factorization, respectively of the triangular factors, the
+   result is the one of the sequential incomplete factorization, respectively of the exact triangular solves. A few sweeps are
+   usually enough for a preconditioner.
+
+.seealso: `PCCHOWILU`, `PCChowILUSetLevels()`
+@*/
+PetscErrorCode PCChowILUSetSweeps(PC pc, PetscInt sweeps, PetscInt solvesweeps)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(pc, sweeps, 2);
+  PetscValidLogicalCollectiveInt(pc, solvesweeps, 3);
+  PetscCheck(sweeps >= 0 && solvesweeps >= 0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Number of sweeps cannot be negative");
+  PetscTryMethod(pc, "PCChowILUSetSweeps_C", (PC, PetscInt, PetscInt), (pc, sweeps, solvesweeps));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+     PCCHOWILU - Fine-grained parallel iterative incomplete LU factorization of Chow and Patel for `MATSEQAIJ` matrices, using OpenMP threads
+
+   Options Database Keys:
++  -pc_chowilu_levels <0> - levels of fill of the pattern of the factors, see `PCChowILUSetLevels()`
+.  -pc_chowilu_sweeps <3> - number of fixed-point sweeps of the factorization, see `PCChowILUSetSweeps()`
+.  -pc_chowilu_solve_sweeps <3> - number of Jacobi sweeps of each triangular solve
+-  -pc_chowilu_threads <n> - number of threads, by default the number of threads of the matrix set with -mat_aij_threads
+
+   Level: intermediate
+
+   Notes:
+   The nonzeros of the factors are computed independently of each other by a few fixed-point sweeps starting from the entries of
+   the matrix, and the triangular solves are replaced by Jacobi sweeps, so that all the work is spread over the threads over the
+   nonzeros or the rows, unlike `PCILU` whose factorization and solves are sequential. The preconditioner is an approximation of ILU(k)
+   that is independent of the number of threads. The symbolic part is reused when the nonzero pattern of the matrix does not change.
+
+   In parallel use it as the subdomain solver of `PCBJACOBI` or `PCASM`. This is a CPU version of `PCCHOWILUVIENNACL`.
+
+   References:
+.  * - E. Chow and A. Patel, "Fine-grained parallel incomplete LU factorization", SIAM J. Sci. Comput. 37(2), 2015.
+
+.seealso: `PCCreate()`, `PCSetType()`, `PCType`, `PC`, `PCILU`, `PCChowILUSetLevels()`, `PCChowILUSetSweeps()`, `MATSEQAIJ`
+M*/
+
+PETSC_EXTERN PetscErrorCode PCCreate_ChowILU(PC pc)
+{
+  PC_ChowILU *ilu;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&ilu));
+  ilu->levels      = 0;
+  ilu->sweeps      = 3;
+  ilu->solvesweeps = 3;
+  ilu->nthreads    = PETSC_DECIDE;
+  pc->data         = (void *)ilu;
+
+  pc->ops->apply          = PCApply_ChowILU;
+  pc->ops->setup          = PCSetUp_ChowILU;
+  pc->ops->reset          = PCReset_ChowILU;
+  pc->ops->destroy        = PCDestroy_ChowILU;
+  pc->ops->setfromoptions = PCSetFromOptions_ChowILU;
+  pc->ops->view           = PCView_ChowILU;
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCChowILUSetLevels_C", PCChowILUSetLevels_ChowILU));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCChowILUSetSweeps_C", PCChowILUSetSweeps_ChowILU));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
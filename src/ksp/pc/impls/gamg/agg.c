@@ -695,14 +695,9 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc, Mat Amat, Mat *a_P)
   PC_GAMG_AGG *pc_gamg_agg = (PC_GAMG_AGG *)pc_gamg->subctx;
   PetscInt     jj;
   Mat          Prol = *a_P;
-  MPI_Comm     comm;
-  KSP          eksp;
-  Vec          bb, xx;
-  PC           epc;
   PetscReal    alpha, emax, emin;
 
   PetscFunctionBegin;
-  PetscCall(PetscObjectGetComm((PetscObject)Amat, &comm));
   PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_OPT], 0, 0, 0, 0));
 
   /* compute maximum singular value of operator to be used in smoother */
@@ -712,42 +707,8 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc, Mat Amat, Mat *a_P)
       emin = pc_gamg->emin;
       emax = pc_gamg->emax;
     } else {
-      const char *prefix;
-
-      PetscCall(MatCreateVecs(Amat, &bb, NULL));
-      PetscCall(MatCreateVecs(Amat, &xx, NULL));
-      PetscCall(KSPSetNoisy_Private(bb));
-
-      PetscCall(KSPCreate(comm, &eksp));
-      PetscCall(PCGetOptionsPrefix(pc, &prefix));
-      PetscCall(KSPSetOptionsPrefix(eksp, prefix));
-      PetscCall(KSPAppendOptionsPrefix(eksp, "pc_gamg_esteig_"));
-      {
-        PetscBool isset, sflg;
-        PetscCall(MatIsSPDKnown(Amat, &isset, &sflg));
-        if (isset && sflg) PetscCall(KSPSetType(eksp, KSPCG));
-      }
-      PetscCall(KSPSetErrorIfNotConverged(eksp, pc->erroriffailure));
-      PetscCall(KSPSetNormType(eksp, KSP_NORM_NONE));
-
-      PetscCall(KSPSetInitialGuessNonzero(eksp, PETSC_FALSE));
-      PetscCall(KSPSetOperators(eksp, Amat, Amat));
-
-      PetscCall(KSPGetPC(eksp, &epc));
-      PetscCall(PCSetType(epc, PCJACOBI)); /* smoother in smoothed agg. */
-
-      PetscCall(KSPSetTolerances(eksp, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT, 10)); // 10 is safer, but 5 is often fine, can override with -pc_gamg_esteig_ksp_max_it -mg_levels_ksp_chebyshev_esteig 0,0.25,0,1.2
-
-      PetscCall(KSPSetFromOptions(eksp));
-      PetscCall(KSPSetComputeSingularValues(eksp, PETSC_TRUE));
-      PetscCall(KSPSolve(eksp, bb, xx));
-      PetscCall(KSPCheckSolve(eksp, pc, xx));
-
-      PetscCall(KSPComputeExtremeSingularValues(eksp, &emax, &emin));
+      PetscCall(PCGAMGComputeEstEig_Internal(pc, Amat, &emax, &emin));
       PetscCall(PetscInfo(pc, "%s: Smooth P0: max eigen=%e min=%e PC=%s\n", ((PetscObject)pc)->prefix, (double)emax, (double)emin, PCJACOBI));
-      PetscCall(VecDestroy(&xx));
-      PetscCall(VecDestroy(&bb));
-      PetscCall(KSPDestroy(&eksp));
     }
     if (pc_gamg->use_sa_esteig) {
       mg->min_eigen_DinvA[pc_gamg->current_level] = emin;
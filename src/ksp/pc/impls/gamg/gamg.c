@@ -527,6 +527,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
       /* reset everything */
       PetscCall(PCReset_MG(pc));
       pc->setupcalled = 0;
+      pc_gamg->nreuse = 0;
     } else {
       PC_MG_Levels **mglevels = mg->levels;
       /* just do Galerkin grids */
@@ -564,6 +565,33 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
           PetscCall(PetscLogStagePop());
 #endif
         }
+
+        /* the SA eigen estimates given to the Chebyshev smoothers are lagged, refresh them for the new operators */
+        pc_gamg->nreuse++;
+        if (pc_gamg->use_sa_esteig && pc_gamg->emax <= 0 && pc_gamg->recompute_esteig > 0 && !(pc_gamg->nreuse % pc_gamg->recompute_esteig)) {
+          PetscCall(PetscLogEventBegin(petsc_gamg_setup_events[GAMG_OPT], 0, 0, 0, 0));
+          for (lidx = 1, level = pc_gamg->Nlevels - 2; level >= 0; lidx++, level--) {
+            KSP       smoother;
+            PetscBool ischeb;
+
+            PetscCall(PCMGGetSmoother(pc, lidx, &smoother));
+            PetscCall(PetscObjectTypeCompare((PetscObject)smoother, KSPCHEBYSHEV, &ischeb));
+            if (ischeb && mg->max_eigen_DinvA[level] > 0) {
+              KSP_Chebyshev *cheb = (KSP_Chebyshev *)smoother->data;
+              PetscReal      emax, emin;
+
+              if (cheb->kspest) continue; /* the smoother computes its own estimates */
+              PetscCall(KSPGetOperators(smoother, NULL, &B));
+              PetscCall(PCGAMGComputeEstEig_Internal(pc, B, &emax, &emin));
+              PetscCall(PetscInfo(pc, "%s: PCSetUp_GAMG: recompute eigen estimates on level %" PetscInt_FMT " (N=%" PetscInt_FMT ") after %" PetscInt_FMT " reuses, emax = %g (was %g) emin = %g\n", ((PetscObject)pc)->prefix, level, B->rmap->N, pc_gamg->nreuse, (double)emax, (double)mg->max_eigen_DinvA[level], (double)emin));
+              mg->min_eigen_DinvA[level] = emin;
+              mg->max_eigen_DinvA[level] = emax;
+              cheb->emin_provided        = emin;
+              cheb->emax_provided        = emax;
+            }
+          }
+          PetscCall(PetscLogEventEnd(petsc_gamg_setup_events[GAMG_OPT], 0, 0, 0, 0));
+        }
       }
 
       PetscCall(PCSetUp_MG(pc));
@@ -851,6 +879,7 @@ PetscErrorCode PCDestroy_GAMG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRepartition_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetEigenvalues_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseSAEstEig_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRecomputeEstEig_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseInterpolation_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGASMSetUseAggs_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseParallelCoarseGridSolve_C", NULL));
@@ -1058,6 +1087,51 @@ static PetscErrorCode PCGAMGSetEigenvalues_GAMG(PC pc, PetscReal emax, PetscReal
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   PCGAMGSetRecomputeEstEig - Set how often the eigen estimates from smoothed aggregation that are given to the Chebyshev smoothers are recomputed
+   when the preconditioner is rebuilt with the interpolation reused
+
+   Logically Collective
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - recompute the estimates every n setups that reuse the interpolation, 0 to never recompute them
+
+   Options Database Key:
+.  -pc_gamg_recompute_esteig <n> - recompute the eigen estimates every n reuses
+
+   Level: intermediate
+
+   Notes:
+   When the interpolation is reused, see `PCGAMGSetReuseInterpolation()`, a new setup, for example at each Newton iteration, only computes the
+   Galerkin coarse grid operators with the nonzero pattern of the previous setup. The eigen estimates of the Chebyshev smoothers obtained
+   while smoothing the aggregates, see `PCGAMGSetUseSAEstEig()`, are not recomputed and may no longer bound the spectrum of the new operators.
+   This recomputes them, with a few iterations of a Jacobi preconditioned Krylov method per level, every n such setups.
+
+   Estimates given with `PCGAMGSetEigenvalues()` and smoothers that compute their own estimates are not affected.
+
+.seealso: [](ch_ksp), `PCGAMG`, `PCGAMGSetReuseInterpolation()`, `PCGAMGSetUseSAEstEig()`, `KSPChebyshevSetEigenvalues()`
+@*/
+PetscErrorCode PCGAMGSetRecomputeEstEig(PC pc, PetscInt n)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc, PC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(pc, n, 2);
+  PetscTryMethod(pc, "PCGAMGSetRecomputeEstEig_C", (PC, PetscInt), (pc, n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PCGAMGSetRecomputeEstEig_GAMG(PC pc, PetscInt n)
+{
+  PC_MG   *mg      = (PC_MG *)pc->data;
+  PC_GAMG *pc_gamg = (PC_GAMG *)mg->innerctx;
+
+  PetscFunctionBegin;
+  PetscCheck(n >= 0, PetscObjectComm((PetscObject)pc), PETSC_ERR_ARG_OUTOFRANGE, "Number of reuses %" PetscInt_FMT " cannot be negative", n);
+  pc_gamg->recompute_esteig = n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    PCGAMGSetReuseInterpolation - Reuse prolongation when rebuilding a `PCGAMG` algebraic multigrid preconditioner
 
@@ -1076,7 +1150,7 @@ static PetscErrorCode PCGAMGSetEigenvalues_GAMG(PC pc, PetscReal emax, PetscReal
    May negatively affect the convergence rate of the method on new matrices if the matrix entries change a great deal, but allows
    rebuilding the preconditioner quicker.
 
-.seealso: `PCGAMG`
+.seealso: `PCGAMG`, `PCGAMGSetRecomputeEstEig()`
 @*/
 PetscErrorCode PCGAMGSetReuseInterpolation(PC pc, PetscBool n)
 {
@@ -1488,6 +1562,7 @@ static PetscErrorCode PCView_GAMG(PC pc, PetscViewer viewer)
   PetscCall(PetscViewerASCIIPrintf(viewer, "      Threshold scaling factor for each level not specified = %g\n", (double)pc_gamg->threshold_scale));
   if (pc_gamg->use_aggs_in_asm) PetscCall(PetscViewerASCIIPrintf(viewer, "      Using aggregates from coarsening process to define subdomains for PCASM\n"));
   if (pc_gamg->use_parallel_coarse_grid_solver) PetscCall(PetscViewerASCIIPrintf(viewer, "      Using parallel coarse grid solver (all coarse grid equations not put on one process)\n"));
+  if (pc_gamg->recompute_esteig) PetscCall(PetscViewerASCIIPrintf(viewer, "      Recomputing the eigen estimates every %" PetscInt_FMT " reuses of the interpolation\n", pc_gamg->recompute_esteig));
   if (pc_gamg->ops->view) PetscCall((*pc_gamg->ops->view)(pc, viewer));
   PetscCall(PCMGGetGridComplexity(pc, &gc, &oc));
   PetscCall(PetscViewerASCIIPrintf(viewer, "      Complexity:    grid = %g    operator = %g\n", (double)gc, (double)oc));
@@ -1512,6 +1587,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOptionsObject
   PetscCall(PetscOptionsBool("-pc_gamg_repartition", "Repartion coarse grids", "PCGAMGSetRepartition", pc_gamg->repart, &pc_gamg->repart, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_use_sa_esteig", "Use eigen estimate from smoothed aggregation for smoother", "PCGAMGSetUseSAEstEig", pc_gamg->use_sa_esteig, &pc_gamg->use_sa_esteig, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_reuse_interpolation", "Reuse prolongation operator", "PCGAMGReuseInterpolation", pc_gamg->reuse_prol, &pc_gamg->reuse_prol, NULL));
+  PetscCall(PetscOptionsRangeInt("-pc_gamg_recompute_esteig", "Recompute the smoothed aggregation eigen estimates every n reuses of the interpolation", "PCGAMGSetRecomputeEstEig", pc_gamg->recompute_esteig, &pc_gamg->recompute_esteig, NULL, 0, PETSC_MAX_INT));
   PetscCall(PetscOptionsBool("-pc_gamg_asm_use_agg", "Use aggregation aggregates for ASM smoother", "PCGAMGASMSetUseAggs", pc_gamg->use_aggs_in_asm, &pc_gamg->use_aggs_in_asm, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_use_parallel_coarse_grid_solver", "Use parallel coarse grid solver (otherwise put last grid on one process)", "PCGAMGSetUseParallelCoarseGridSolve", pc_gamg->use_parallel_coarse_grid_solver, &pc_gamg->use_parallel_coarse_grid_solver, NULL));
   PetscCall(PetscOptionsBool("-pc_gamg_cpu_pin_coarse_grids", "Pin coarse grids to the CPU", "PCGAMGSetCpuPinCoarseGrids", pc_gamg->cpu_pin_coarse_grids, &pc_gamg->cpu_pin_coarse_grids, NULL));
@@ -1566,6 +1642,7 @@ PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOptionsObject
                                         equations on each process that has degrees of freedom
 .   -pc_gamg_coarse_eq_limit <limit, default=50> - Set maximum number of equations on coarsest grid to aim for.
 .   -pc_gamg_reuse_interpolation <bool,default=true> - when rebuilding the algebraic multigrid preconditioner reuse the previously computed interpolations (should always be true)
+.   -pc_gamg_recompute_esteig <n,default=0> - when reusing the interpolations recompute the eigen estimates for the Chebyshev smoothers every n rebuilds, see `PCGAMGSetRecomputeEstEig()`
 .   -pc_gamg_threshold[] <thresh,default=[-1,...]> - Before aggregating the graph `PCGAMG` will remove small values from the graph on each level (< 0 does no filtering)
 -   -pc_gamg_threshold_scale <scale,default=1> - Scaling of threshold on each coarser grid if not specified
 
@@ -1590,7 +1667,8 @@ PetscErrorCode PCSetFromOptions_GAMG(PC pc, PetscOptionItems *PetscOptionsObject
   See [the Users Manual section on PCGAMG](sec_amg) for more details.
 
 .seealso: `PCCreate()`, `PCSetType()`, `MatSetBlockSize()`, `PCMGType`, `PCSetCoordinates()`, `MatSetNearNullSpace()`, `PCGAMGSetType()`, `PCGAMGAGG`, `PCGAMGGEO`, `PCGAMGCLASSICAL`, `PCGAMGSetProcEqLim()`,
-          `PCGAMGSetCoarseEqLim()`, `PCGAMGSetRepartition()`, `PCGAMGRegister()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGASMSetUseAggs()`, `PCGAMGSetUseParallelCoarseGridSolve()`, `PCGAMGSetNlevels()`, `PCGAMGSetThreshold()`, `PCGAMGGetType()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGSetUseSAEstEig()`
+          `PCGAMGSetCoarseEqLim()`, `PCGAMGSetRepartition()`, `PCGAMGRegister()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGASMSetUseAggs()`, `PCGAMGSetUseParallelCoarseGridSolve()`, `PCGAMGSetNlevels()`, `PCGAMGSetThreshold()`, `PCGAMGGetType()`, `PCGAMGSetReuseInterpolation()`, `PCGAMGSetUseSAEstEig()`,
+          `PCGAMGSetRecomputeEstEig()`
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
@@ -1630,6 +1708,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_GAMG(PC pc)
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRepartition_C", PCGAMGSetRepartition_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetEigenvalues_C", PCGAMGSetEigenvalues_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseSAEstEig_C", PCGAMGSetUseSAEstEig_GAMG));
+  PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetRecomputeEstEig_C", PCGAMGSetRecomputeEstEig_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetReuseInterpolation_C", PCGAMGSetReuseInterpolation_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGASMSetUseAggs_C", PCGAMGASMSetUseAggs_GAMG));
   PetscCall(PetscObjectComposeFunction((PetscObject)pc, "PCGAMGSetUseParallelCoarseGridSolve_C", PCGAMGSetUseParallelCoarseGridSolve_GAMG));
@@ -61,6 +61,60 @@ PetscErrorCode PCGAMGGetDataWithGhosts(Mat Gmat, PetscInt data_sz, PetscReal dat
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   PCGAMGComputeEstEig_Internal - Estimates the extreme eigenvalues of D^{-1} A with a few iterations of a Jacobi preconditioned
+   Krylov method, CG if A is known to be SPD, started from a noisy right hand side
+
+   Input Parameter:
+   . pc - the PCGAMG context, for the options prefix pc_gamg_esteig_
+   . Amat - the operator of the level
+
+   Output Parameter:
+   . emax - the largest eigenvalue estimate
+   . emin - the smallest eigenvalue estimate
+*/
+PetscErrorCode PCGAMGComputeEstEig_Internal(PC pc, Mat Amat, PetscReal *emax, PetscReal *emin)
+{
+  KSP         eksp;
+  PC          epc;
+  Vec         bb, xx;
+  const char *prefix;
+  PetscBool   isset, sflg;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreateVecs(Amat, &bb, NULL));
+  PetscCall(MatCreateVecs(Amat, &xx, NULL));
+  PetscCall(KSPSetNoisy_Private(bb));
+
+  PetscCall(KSPCreate(PetscObjectComm((PetscObject)Amat), &eksp));
+  PetscCall(PCGetOptionsPrefix(pc, &prefix));
+  PetscCall(KSPSetOptionsPrefix(eksp, prefix));
+  PetscCall(KSPAppendOptionsPrefix(eksp, "pc_gamg_esteig_"));
+  PetscCall(MatIsSPDKnown(Amat, &isset, &sflg));
+  if (isset && sflg) PetscCall(KSPSetType(eksp, KSPCG));
+  PetscCall(KSPSetErrorIfNotConverged(eksp, pc->erroriffailure));
+  PetscCall(KSPSetNormType(eksp, KSP_NORM_NONE));
+
+  PetscCall(KSPSetInitialGuessNonzero(eksp, PETSC_FALSE));
+  PetscCall(KSPSetOperators(eksp, Amat, Amat));
+
+  PetscCall(KSPGetPC(eksp, &epc));
+  PetscCall(PCSetType(epc, PCJACOBI)); /* smoother in smoothed agg. */
+
+  PetscCall(KSPSetTolerances(eksp, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT, 10)); // 10 is safer, but 5 is often fine, can override with -pc_gamg_esteig_ksp_max_it -mg_levels_ksp_chebyshev_esteig 0,0.25,0,1.2
+
+  PetscCall(KSPSetFromOptions(eksp));
+  PetscCall(KSPSetComputeSingularValues(eksp, PETSC_TRUE));
+  PetscCall(KSPSolve(eksp, bb, xx));
+  PetscCall(KSPCheckSolve(eksp, pc, xx));
+
+  PetscCall(KSPComputeExtremeSingularValues(eksp, emax, emin));
+  PetscCall(VecDestroy(&xx));
+  PetscCall(VecDestroy(&bb));
+  PetscCall(KSPDestroy(&eksp));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode PCGAMGHashTableCreate(PetscInt a_size, PCGAMGHashTable *a_tab)
 {
   PetscInt kk;
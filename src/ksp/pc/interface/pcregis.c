@@ -35,6 +35,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_Telescope(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_Patch(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_LMVM(PC);
 PETSC_EXTERN PetscErrorCode PCCreate_HMG(PC);
+PETSC_EXTERN PetscErrorCode PCCreate_ChowILU(PC);
 #if defined(PETSC_HAVE_AMGX)
 PETSC_EXTERN PetscErrorCode PCCreate_AMGX(PC);
 #endif
@@ -126,6 +127,7 @@ PetscErrorCode PCRegisterAll(void)
   PetscCall(PCRegister(PCTELESCOPE, PCCreate_Telescope));
   PetscCall(PCRegister(PCPATCH, PCCreate_Patch));
   PetscCall(PCRegister(PCHMG, PCCreate_HMG));
+  PetscCall(PCRegister(PCCHOWILU, PCCreate_ChowILU));
 #if defined(PETSC_HAVE_AMGX)
   PetscCall(PCRegister(PCAMGX, PCCreate_AMGX));
 #endif
@@ -0,0 +1,97 @@
+static char help[] = "Tests PCCHOWILU: with enough sweeps it matches PCILU, and it does not depend on the number of threads.\n\n";
+
+#include <petscpc.h>
+
+/* Applies the preconditioner of the given type to b, after refactoring it for the shifted matrix */
+static PetscErrorCode ApplyPC(Mat A, PCType type, PetscInt levels, PetscInt sweeps, PetscInt nthreads, Vec b, Vec x)
+{
+  PC pc;
+
+  PetscFunctionBegin;
+  PetscCall(PCCreate(PETSC_COMM_SELF, &pc));
+  PetscCall(PCSetOperators(pc, A, A));
+  PetscCall(PCSetType(pc, type));
+  if (levels > 0) PetscCall(PCFactorSetLevels(pc, levels));
+  PetscCall(PCChowILUSetLevels(pc, levels));
+  PetscCall(PCChowILUSetSweeps(pc, sweeps, sweeps));
+  if (nthreads > 0) {
+    char str[16];
+
+    PetscCall(PetscSNPrintf(str, sizeof(str), "%" PetscInt_FMT, nthreads));
+    PetscCall(PetscOptionsSetValue(NULL, "-pc_chowilu_threads", str));
+  }
+  PetscCall(PCSetFromOptions(pc));
+  PetscCall(PetscOptionsClearValue(NULL, "-pc_chowilu_threads"));
+  PetscCall(PCSetUp(pc));
+  PetscCall(PCApply(pc, b, x));
+  /* refactor with new values and the same nonzero pattern */
+  PetscCall(MatShift(A, 1.0));
+  PetscCall(PCSetUp(pc));
+  PetscCall(PCApply(pc, b, x));
+  PetscCall(MatShift(A, -1.0));
+  PetscCall(PCDestroy(&pc));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat       A;
+  Vec       b, x, y;
+  PetscInt  m = 10, n, i, j, row, levels = 0, nthreads = 2;
+  PetscReal nrm, err;
+  PetscBool flg;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-levels", &levels, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nthreads", &nthreads, NULL));
+  n = m * m;
+
+  /* nonsymmetric 5-point operator on an m x m grid */
+  PetscCall(MatCreateSeqAIJ(PETSC_COMM_SELF, n, n, 5, NULL, &A));
+  for (i = 0; i < m; i++) {
+    for (j = 0; j < m; j++) {
+      row = i * m + j;
+      PetscCall(MatSetValue(A, row, row, 4.0, INSERT_VALUES));
+      if (i > 0) PetscCall(MatSetValue(A, row, row - m, -1.0, INSERT_VALUES));
+      if (i < m - 1) PetscCall(MatSetValue(A, row, row + m, -1.0, INSERT_VALUES));
+      if (j > 0) PetscCall(MatSetValue(A, row, row - 1, -1.5, INSERT_VALUES));
+      if (j < m - 1) PetscCall(MatSetValue(A, row, row + 1, -0.5, INSERT_VALUES));
+    }
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatCreateVecs(A, &x, &b));
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecSetRandom(b, NULL));
+
+  /* as many sweeps as unknowns give the exact incomplete factorization and triangular solves */
+  PetscCall(ApplyPC(A, PCILU, levels, 0, 0, b, x));
+  PetscCall(ApplyPC(A, PCCHOWILU, levels, n, 0, b, y));
+  PetscCall(VecNorm(x, NORM_INFINITY, &nrm));
+  PetscCall(VecAXPY(y, -1.0, x));
+  PetscCall(VecNorm(y, NORM_INFINITY, &err));
+  PetscCheck(err <= 1.e-10 * nrm, PETSC_COMM_SELF, PETSC_ERR_PLIB, "PCCHOWILU differs from PCILU %g", (double)(err / nrm));
+
+  /* a few sweeps, the result must not depend on the number of threads */
+  PetscCall(ApplyPC(A, PCCHOWILU, levels, 3, 1, b, x));
+  PetscCall(ApplyPC(A, PCCHOWILU, levels, 3, nthreads, b, y));
+  PetscCall(VecEqual(x, y, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "PCCHOWILU depends on the number of threads");
+
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      output_file: output/empty.out
+      args: -levels {{0 2}} -nthreads {{2 3}}
+
+TEST*/
@@ -0,0 +1,291 @@
+#include <petsc/private/matimpl.h> /*I "petscmat.h" I*/
+#include <petsc/private/hashtable.h>
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petscsf.h>
+
+#define MIS_NOT_DONE       -2
+#define MIS_DELETED        -1
+#define MIS_REMOVED        -3
+#define MIS_IS_SELECTED(s) (s >= 0)
+
+/* random priority of a vertex, a hash of its global index so that the priorities of the ghost vertices need no communication */
+#define LUBY_PRIORITY(gid) ((PetscInt)(PetscHashInt(gid) >> 1))
+/* total order of the vertices, the priority with ties broken by the global index */
+#define LUBY_GREATER(pa, ga, pb, gb) ((pa) > (pb) || ((pa) == (pb) && (ga) > (gb)))
+
+/*
+  MatCoarsenLubyMIS_Private - parallel randomized (Luby) MIS-1
+
+  A vertex is selected when it has a larger priority than all its undecided neighbors, its neighbors are then deleted. The local
+  vertices are swept by decreasing priority so that each sweep decides all the vertices that only depend on local vertices, a
+  global round is needed only for the chains of decreasing priorities that cross process boundaries. Each round is one
+  communication of the states of the boundary vertices and one reduction, the priorities are hashes of the global indices and
+  are never communicated. The MIS is the greedy MIS in order of decreasing priority, it does not depend on the number of processes.
+
+  Input Parameter:
+   . perm - not used, the random priorities define the ordering
+   . cMat - graph
+
+  Output Parameter:
+   . a_agg_lists - strict aggregates, the list of each selected local vertex holds the global indices of its aggregate
+   . a_nselected - number of selected local vertices
+*/
+static PetscErrorCode MatCoarsenLubyMIS_Private(IS perm, Mat cMat, PetscCoarsenData **a_agg_lists, PetscInt *a_nselected)
+{
+  Mat_SeqAIJ       *matA, *matB = NULL;
+  Mat_MPIAIJ       *mpimat = NULL;
+  const PetscInt    nloc   = cMat->rmap->n;
+  PetscCoarsenData *agg_lists;
+  PetscInt         *cpcol_gid = NULL, *cpcol_state = NULL, *cpcol_prio = NULL, *lid_cprowID, *lid_state, *lid_prio, *lid_parent_gid, *order;
+  PetscInt          num_fine_ghosts = 0, kk, n, ix, j, *idx, *ai, my0, Iend, nremoved = 0, lid, lidj, cpid, gid, nDone = 0, nselected = 0, nrounds = 0, t1, t2;
+  PetscBool         isMPI, isOK;
+  MPI_Comm          comm;
+  PetscLayout       layout;
+  PetscSF           sf = NULL;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)cMat, &comm));
+  PetscCall(PetscObjectBaseTypeCompare((PetscObject)cMat, MATMPIAIJ, &isMPI));
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ *)cMat->data;
+    matA   = (Mat_SeqAIJ *)mpimat->A->data;
+    matB   = (Mat_SeqAIJ *)mpimat->B->data;
+    /* force compressed storage of B */
+    PetscCall(MatCheckCompressedRow(mpimat->B, matB->nonzerorowcnt, &matB->compressedrow, matB->i, cMat->rmap->n, -1.0));
+  } else {
+    PetscBool isAIJ;
+    PetscCall(PetscObjectBaseTypeCompare((PetscObject)cMat, MATSEQAIJ, &isAIJ));
+    PetscCheck(isAIJ, PETSC_COMM_SELF, PETSC_ERR_USER, "Require AIJ matrix.");
+    matA = (Mat_SeqAIJ *)cMat->data;
+  }
+  PetscCall(MatGetOwnershipRange(cMat, &my0, &Iend));
+  if (mpimat) {
+    /* the global indices of the ghosts are in garray, only their states are communicated */
+    cpcol_gid = mpimat->garray;
+    PetscCall(VecGetLocalSize(mpimat->lvec, &num_fine_ghosts));
+    PetscCall(PetscMalloc2(num_fine_ghosts, &cpcol_state, num_fine_ghosts, &cpcol_prio));
+    for (cpid = 0; cpid < num_fine_ghosts; cpid++) {
+      cpcol_state[cpid] = MIS_NOT_DONE;
+      cpcol_prio[cpid]  = LUBY_PRIORITY(cpcol_gid[cpid]);
+    }
+    PetscCall(PetscSFCreate(comm, &sf));
+    PetscCall(MatGetLayouts(cMat, &layout, NULL));
+    PetscCall(PetscSFSetGraphLayout(sf, layout, num_fine_ghosts, NULL, PETSC_COPY_VALUES, mpimat->garray));
+  }
+  PetscCall(PetscMalloc5(nloc, &lid_cprowID, nloc, &lid_state, nloc, &lid_prio, nloc, &lid_parent_gid, nloc, &order));
+  PetscCall(PetscCDCreate(nloc, &agg_lists));
+  for (lid = 0; lid < nloc; lid++) {
+    lid_cprowID[lid]    = -1;
+    lid_state[lid]      = MIS_NOT_DONE;
+    lid_parent_gid[lid] = -1;
+    lid_prio[lid]       = LUBY_PRIORITY(lid + my0);
+  }
+  /* set index into compressed row 'lid_cprowID' */
+  if (matB) {
+    for (ix = 0; ix < matB->compressedrow.nrows; ix++) lid_cprowID[matB->compressedrow.rindex[ix]] = ix;
+  }
+  /* remove the singletons, like the Dirichlet boundary conditions, and sort the others by increasing priority */
+  for (lid = 0, kk = 0; lid < nloc; lid++) {
+    n = matA->i[lid + 1] - matA->i[lid];
+    if (n < 2) {
+      ix = lid_cprowID[lid];
+      if (ix == -1 || !(matB->compressedrow.i[ix + 1] - matB->compressedrow.i[ix])) {
+        lid_state[lid] = MIS_REMOVED;
+        nremoved++;
+        nDone++;
+        continue;
+      }
+    }
+    order[kk]          = lid;
+    lid_parent_gid[kk] = lid_prio[lid]; /* work array for the sort */
+    kk++;
+  }
+  PetscCall(PetscSortIntWithArray(kk, lid_parent_gid, order));
+  for (lid = 0; lid < nloc; lid++) lid_parent_gid[lid] = -1;
+
+  /* MIS */
+  while (PETSC_TRUE) {
+    nrounds++;
+    /* sweep the undecided local vertices by decreasing priority */
+    for (ix = kk - 1; ix >= 0; ix--) {
+      lid = order[ix];
+      if (lid_state[lid] != MIS_NOT_DONE) continue;
+      /* blocked by an undecided neighbor with a larger priority */
+      isOK = PETSC_TRUE;
+      ai   = matA->i;
+      n    = ai[lid + 1] - ai[lid];
+      idx  = matA->j + ai[lid];
+      for (j = 0; j < n && isOK; j++) {
+        lidj = idx[j];
+        if (lid_state[lidj] == MIS_NOT_DONE && lidj != lid && LUBY_GREATER(lid_prio[lidj], lidj, lid_prio[lid], lid)) isOK = PETSC_FALSE;
+      }
+      if (isOK && lid_cprowID[lid] != -1) {
+        const PetscInt cprow = lid_cprowID[lid], *ghost = matB->j + matB->compressedrow.i[cprow];
+
+        n = matB->compressedrow.i[cprow + 1] - matB->compressedrow.i[cprow];
+        for (j = 0; j < n && isOK; j++) {
+          cpid = ghost[j];
+          if (cpcol_state[cpid] == MIS_NOT_DONE && LUBY_GREATER(cpcol_prio[cpid], cpcol_gid[cpid], lid_prio[lid], lid + my0)) isOK = PETSC_FALSE;
+        }
+      }
+      if (!isOK) continue;
+      /* SELECTED state encoded with global index */
+      lid_state[lid] = lid + my0;
+      nselected++;
+      nDone++;
+      PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
+      /* delete local adj, the ghost adj delete themselves after the communication */
+      n   = ai[lid + 1] - ai[lid];
+      idx = matA->j + ai[lid];
+      for (j = 0; j < n; j++) {
+        lidj = idx[j];
+        if (lid_state[lidj] == MIS_NOT_DONE) {
+          nDone++;
+          PetscCall(PetscCDAppendID(agg_lists, lid, lidj + my0));
+          lid_state[lidj] = MIS_DELETED;
+        }
+      }
+    }
+    if (!mpimat) break; /* all done */
+
+    /* update ghost states, delete the boundary vertices with a selected ghost neighbor */
+    PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
+    ai = matB->compressedrow.i;
+    for (ix = 0; ix < matB->compressedrow.nrows; ix++) {
+      lid = matB->compressedrow.rindex[ix];
+      if (lid_state[lid] != MIS_NOT_DONE) continue;
+      n   = ai[ix + 1] - ai[ix];
+      idx = matB->j + ai[ix];
+      for (j = 0; j < n; j++) {
+        cpid = idx[j];
+        if (MIS_IS_SELECTED(cpcol_state[cpid])) {
+          nDone++;
+          lid_state[lid]      = MIS_DELETED;
+          lid_parent_gid[lid] = cpcol_state[cpid]; /* the selected state is the global index */
+          break;
+        }
+      }
+    }
+    /* all done? */
+    t1 = nloc - nDone;
+    PetscCall(MPIU_Allreduce(&t1, &t2, 1, MPIU_INT, MPI_SUM, comm));
+    if (!t2) break;
+  }
+  PetscCall(PetscInfo(cMat, "\t removed %" PetscInt_FMT " of %" PetscInt_FMT " vertices.  %" PetscInt_FMT " selected in %" PetscInt_FMT " rounds.\n", nremoved, nloc, nselected, nrounds));
+
+  /* tell the owners of the selected ghosts about the local vertices they deleted */
+  if (mpimat) {
+    PetscInt *cpcol_sel_gid;
+
+    PetscCall(PetscMalloc1(num_fine_ghosts, &cpcol_sel_gid));
+    PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_parent_gid, cpcol_sel_gid, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_parent_gid, cpcol_sel_gid, MPI_REPLACE));
+    for (cpid = 0; cpid < num_fine_ghosts; cpid++) {
+      gid = cpcol_sel_gid[cpid];
+      if (gid >= my0 && gid < Iend) PetscCall(PetscCDAppendID(agg_lists, gid - my0, cpcol_gid[cpid]));
+    }
+    PetscCall(PetscFree(cpcol_sel_gid));
+    PetscCall(PetscSFDestroy(&sf));
+    PetscCall(PetscFree2(cpcol_state, cpcol_prio));
+  }
+  PetscCall(PetscFree5(lid_cprowID, lid_state, lid_prio, lid_parent_gid, order));
+  *a_agg_lists = agg_lists;
+  *a_nselected = nselected;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Distance k randomized MIS. k is in 'subctx'
+*/
+static PetscErrorCode MatCoarsenApply_LUBY(MatCoarsen coarse)
+{
+  Mat      mat = coarse->graph;
+  PetscInt k, nselected;
+
+  PetscFunctionBegin;
+  PetscCall(MatCoarsenMISKGetDistance(coarse, &k));
+  PetscCheck(k > 0, PETSC_COMM_SELF, PETSC_ERR_SUP, "too few levels: %d", (int)k);
+  if (k == 1) PetscCall(MatCoarsenLubyMIS_Private(NULL, mat, &coarse->agg_lists, &nselected));
+  else PetscCall(MatCoarsenMISKApply_Private(NULL, k, mat, MatCoarsenLubyMIS_Private, &coarse->agg_lists));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatCoarsenView_LUBY(MatCoarsen coarse, PetscViewer viewer)
+{
+  PetscMPIInt rank;
+  PetscBool   iascii;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)coarse), &rank));
+  PetscCall(PetscObjectTypeCompare((PetscObject)viewer, PETSCVIEWERASCII, &iascii));
+  if (iascii) {
+    PetscCall(PetscViewerASCIIPushSynchronized(viewer));
+    PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "  [%d] Luby MIS aggregator, distance %" PetscInt_FMT "\n", rank, (PetscInt)(size_t)coarse->subctx));
+    if (coarse->agg_lists) {
+      PetscCDIntNd *pos, *pos2;
+      for (PetscInt kk = 0; kk < coarse->agg_lists->size; kk++) {
+        PetscCall(PetscCDGetHeadPos(coarse->agg_lists, kk, &pos));
+        if ((pos2 = pos)) PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "selected local %d: ", (int)kk));
+        while (pos) {
+          PetscInt gid1;
+          PetscCall(PetscCDIntNdGetID(pos, &gid1));
+          PetscCall(PetscCDGetNextPos(coarse->agg_lists, kk, &pos));
+          PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, " %d ", (int)gid1));
+        }
+        if (pos2) PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "\n"));
+      }
+    }
+    PetscCall(PetscViewerFlush(viewer));
+    PetscCall(PetscViewerASCIIPopSynchronized(viewer));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatCoarsenSetFromOptions_LUBY(MatCoarsen coarse, PetscOptionItems *PetscOptionsObject)
+{
+  PetscInt  k = (PetscInt)(size_t)coarse->subctx;
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "MatCoarsen-Luby options");
+  PetscCall(PetscOptionsInt("-mat_coarsen_misk_distance", "k distance for MIS", "MatCoarsenMISKSetDistance", k, &k, &flg));
+  if (flg) coarse->subctx = (void *)(size_t)k;
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATCOARSENLUBY - A coarsener that uses a randomized parallel maximal independent set (MIS) algorithm, in the manner of Luby
+
+   Level: beginner
+
+   Options Database Key:
+.   -mat_coarsen_misk_distance <k> - distance for MIS
+
+   Notes:
+   Each vertex gets a pseudo-random priority, a hash of its global index, and is selected when its priority is larger than those of
+   all its undecided neighbors. Unlike `MATCOARSENMIS` and `MATCOARSENMISK`, whose greedy algorithm breaks the ties between processes
+   with the process ranks and may thus need a number of communication rounds that grows with the number of processes, the number of
+   rounds only depends on the longest chain of decreasing priorities that crosses process boundaries. The local vertices are swept by
+   decreasing priority so that the vertices that only depend on local vertices are decided without communication. Each round is a single
+   exchange of the states of the boundary vertices and a single reduction.
+
+   The selected vertices do not depend on the number of processes. The ordering given with `MatCoarsenSetGreedyOrdering()` is not used.
+
+   As with `MATCOARSENMISK`, a distance k MIS, see `MatCoarsenMISKSetDistance()`, is computed with k applications of the distance 1 MIS
+   on successively coarsened graphs, which is what `PCGAMG` uses for its aggressive coarsening levels.
+
+.seealso: `MatCoarsen`, `MATCOARSENMISK`, `MATCOARSENMIS`, `MatCoarsenMISKSetDistance()`, `MatCoarsenApply()`, `MatCoarsenSetType()`, `MatCoarsenType`, `MatCoarsenCreate()`
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_LUBY(MatCoarsen coarse)
+{
+  PetscFunctionBegin;
+  coarse->ops->apply          = MatCoarsenApply_LUBY;
+  coarse->ops->view           = MatCoarsenView_LUBY;
+  coarse->subctx              = (void *)(size_t)1;
+  coarse->ops->setfromoptions = MatCoarsenSetFromOptions_LUBY;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
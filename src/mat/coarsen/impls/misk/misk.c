@@ -34,222 +34,245 @@ static PetscErrorCode PetscCoarsenDataView_private(PetscCoarsenData *agg_lists,
 }
 
 /*
-  MatCoarsenApply_MISK_private - parallel heavy edge matching
+  MatCoarsenMISKGreedy_Private - greedy parallel MIS-1 in the order of perm, ties across processes are broken by the process rank
 
   Input Parameter:
-   . perm - permutation
+   . perm - local ordering of the vertices, or NULL for the natural ordering
+   . cMat - graph
+
+  Output Parameter:
+   . a_agg_lists - strict aggregates, the list of each selected local vertex holds the global indices of its aggregate
+   . a_nselected - number of selected local vertices
+*/
+static PetscErrorCode MatCoarsenMISKGreedy_Private(IS perm, Mat cMat, PetscCoarsenData **a_agg_lists, PetscInt *a_nselected)
+{
+  Mat_SeqAIJ       *matA, *matB = NULL;
+  Mat_MPIAIJ       *mpimat = NULL;
+  const PetscInt   *perm_ix;
+  const PetscInt    nloc = cMat->rmap->n;
+  PetscCoarsenData *agg_lists;
+  PetscInt         *cpcol_gid = NULL, *cpcol_state, *lid_cprowID, *lid_state, *lid_parent_gid = NULL;
+  PetscInt          num_fine_ghosts, kk, n, ix, j, *idx, *ai, Iend, my0, nremoved, gid, lid, cpid, lidj, sgid, t1, t2, slid, nDone, nselected = 0, state;
+  PetscBool        *lid_removed, isOK, isMPI;
+  MPI_Comm          comm;
+  PetscLayout       layout;
+  PetscSF           sf;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)cMat, &comm));
+  PetscCall(PetscObjectBaseTypeCompare((PetscObject)cMat, MATMPIAIJ, &isMPI));
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ *)cMat->data;
+    matA   = (Mat_SeqAIJ *)mpimat->A->data;
+    matB   = (Mat_SeqAIJ *)mpimat->B->data;
+    /* force compressed storage of B */
+    PetscCall(MatCheckCompressedRow(mpimat->B, matB->nonzerorowcnt, &matB->compressedrow, matB->i, cMat->rmap->n, -1.0));
+  } else {
+    PetscBool isAIJ;
+    PetscCall(PetscObjectBaseTypeCompare((PetscObject)cMat, MATSEQAIJ, &isAIJ));
+    PetscCheck(isAIJ, PETSC_COMM_SELF, PETSC_ERR_USER, "Require AIJ matrix.");
+    matA = (Mat_SeqAIJ *)cMat->data;
+  }
+  PetscCall(MatGetOwnershipRange(cMat, &my0, &Iend));
+  if (mpimat) {
+    PetscInt *lid_gid;
+    PetscCall(PetscMalloc1(nloc, &lid_gid)); /* explicit array needed */
+    for (kk = 0, gid = my0; kk < nloc; kk++, gid++) lid_gid[kk] = gid;
+    PetscCall(VecGetLocalSize(mpimat->lvec, &num_fine_ghosts));
+    PetscCall(PetscMalloc1(num_fine_ghosts, &cpcol_gid));
+    PetscCall(PetscMalloc1(num_fine_ghosts, &cpcol_state));
+    PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)cMat), &sf));
+    PetscCall(MatGetLayouts(cMat, &layout, NULL));
+    PetscCall(PetscSFSetGraphLayout(sf, layout, num_fine_ghosts, NULL, PETSC_COPY_VALUES, mpimat->garray));
+    PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_gid, cpcol_gid, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_gid, cpcol_gid, MPI_REPLACE));
+    for (kk = 0; kk < num_fine_ghosts; kk++) cpcol_state[kk] = MIS_NOT_DONE;
+    PetscCall(PetscFree(lid_gid));
+  } else num_fine_ghosts = 0;
+
+  PetscCall(PetscMalloc1(nloc, &lid_cprowID));
+  PetscCall(PetscMalloc1(nloc, &lid_removed)); /* explicit array needed */
+  PetscCall(PetscMalloc1(nloc, &lid_parent_gid));
+  PetscCall(PetscMalloc1(nloc, &lid_state));
+
+  /* the data structure */
+  PetscCall(PetscCDCreate(nloc, &agg_lists));
+  /* need an inverse map - locals */
+  for (kk = 0; kk < nloc; kk++) {
+    lid_cprowID[kk]    = -1;
+    lid_removed[kk]    = PETSC_FALSE;
+    lid_parent_gid[kk] = -1.0;
+    lid_state[kk]      = MIS_NOT_DONE;
+  }
+  /* set index into cmpressed row 'lid_cprowID' */
+  if (matB) {
+    for (ix = 0; ix < matB->compressedrow.nrows; ix++) {
+      lid              = matB->compressedrow.rindex[ix];
+      lid_cprowID[lid] = ix;
+    }
+  }
+  /* MIS */
+  nremoved = nDone = 0;
+  if (perm) PetscCall(ISGetIndices(perm, &perm_ix));
+  else perm_ix = NULL;
+  while (nDone < nloc || PETSC_TRUE) { /* asynchronous not implemented */
+    /* check all vertices */
+    for (kk = 0; kk < nloc; kk++) {
+      lid   = perm_ix ? perm_ix[kk] : kk;
+      state = lid_state[lid];
+      if (lid_removed[lid]) continue;
+      if (state == MIS_NOT_DONE) {
+        /* parallel test, delete if selected ghost */
+        isOK = PETSC_TRUE;
+        /* parallel test */
+        if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
+          ai  = matB->compressedrow.i;
+          n   = ai[ix + 1] - ai[ix];
+          idx = matB->j + ai[ix];
+          for (j = 0; j < n; j++) {
+            cpid = idx[j]; /* compressed row ID in B mat */
+            gid  = cpcol_gid[cpid];
+            if (cpcol_state[cpid] == MIS_NOT_DONE && gid >= Iend) { /* or pe>rank */
+              isOK = PETSC_FALSE;                                   /* can not delete */
+              break;
+            }
+          }
+        }
+        if (isOK) { /* select or remove this vertex if it is a true singleton like a BC */
+          nDone++;
+          /* check for singleton */
+          ai = matA->i;
+          n  = ai[lid + 1] - ai[lid];
+          if (n < 2) {
+            /* if I have any ghost adj then not a singleton */
+            ix = lid_cprowID[lid];
+            if (ix == -1 || !(matB->compressedrow.i[ix + 1] - matB->compressedrow.i[ix])) {
+              nremoved++;
+              lid_removed[lid] = PETSC_TRUE;
+              /* should select this because it is technically in the MIS but lets not */
+              continue; /* one local adj (me) and no ghost - singleton */
+            }
+          }
+          /* SELECTED state encoded with global index */
+          lid_state[lid] = nselected; // >= 0  is selected, cache for ordering coarse grid
+          nselected++;
+          PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
+          /* delete local adj */
+          idx = matA->j + ai[lid];
+          for (j = 0; j < n; j++) {
+            lidj = idx[j];
+            if (lid_state[lidj] == MIS_NOT_DONE) {
+              nDone++;
+              PetscCall(PetscCDAppendID(agg_lists, lid, lidj + my0));
+              lid_state[lidj] = MIS_DELETED; /* delete this */
+            }
+          }
+        } /* selected */
+      }   /* not done vertex */
+    }     /* vertex loop */
+
+    /* update ghost states and count todos */
+    if (mpimat) {
+      /* scatter states, check for done */
+      PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
+      PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
+      ai = matB->compressedrow.i;
+      for (ix = 0; ix < matB->compressedrow.nrows; ix++) {
+        lid   = matB->compressedrow.rindex[ix]; /* local boundary node */
+        state = lid_state[lid];
+        if (state == MIS_NOT_DONE) {
+          /* look at ghosts */
+          n   = ai[ix + 1] - ai[ix];
+          idx = matB->j + ai[ix];
+          for (j = 0; j < n; j++) {
+            cpid = idx[j];                            /* compressed row ID in B mat */
+            if (MIS_IS_SELECTED(cpcol_state[cpid])) { /* lid is now deleted by ghost */
+              nDone++;
+              lid_state[lid]      = MIS_DELETED; /* delete this */
+              sgid                = cpcol_gid[cpid];
+              lid_parent_gid[lid] = sgid; /* keep track of proc that I belong to */
+              break;
+            }
+          }
+        }
+      }
+      /* all done? */
+      t1 = nloc - nDone;
+      PetscCall(MPIU_Allreduce(&t1, &t2, 1, MPIU_INT, MPI_SUM, comm)); /* synchronous version */
+      if (!t2) break;
+    } else break; /* no mpi - all done */
+  }               /* outer parallel MIS loop */
+  if (perm) PetscCall(ISRestoreIndices(perm, &perm_ix));
+  PetscCall(PetscInfo(cMat, "\t removed %" PetscInt_FMT " of %" PetscInt_FMT " vertices.  %" PetscInt_FMT " selected.\n", nremoved, nloc, nselected));
+
+  /* tell adj who my lid_parent_gid vertices belong to - fill in agg_lists selected ghost lists */
+  if (matB) {
+    PetscInt *cpcol_sel_gid, *icpcol_gid;
+    /* need to copy this to free buffer -- should do this globally */
+    PetscCall(PetscMalloc1(num_fine_ghosts, &cpcol_sel_gid));
+    PetscCall(PetscMalloc1(num_fine_ghosts, &icpcol_gid));
+    for (cpid = 0; cpid < num_fine_ghosts; cpid++) icpcol_gid[cpid] = cpcol_gid[cpid];
+    /* get proc of deleted ghost */
+    PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_parent_gid, cpcol_sel_gid, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_parent_gid, cpcol_sel_gid, MPI_REPLACE));
+    for (cpid = 0; cpid < num_fine_ghosts; cpid++) {
+      sgid = cpcol_sel_gid[cpid];
+      gid  = icpcol_gid[cpid];
+      if (sgid >= my0 && sgid < Iend) { /* I own this deleted */
+        slid = sgid - my0;
+        PetscCall(PetscCDAppendID(agg_lists, slid, gid));
+      }
+    }
+    // done - cleanup
+    PetscCall(PetscFree(icpcol_gid));
+    PetscCall(PetscFree(cpcol_sel_gid));
+    PetscCall(PetscSFDestroy(&sf));
+    PetscCall(PetscFree(cpcol_gid));
+    PetscCall(PetscFree(cpcol_state));
+  }
+  PetscCall(PetscFree(lid_cprowID));
+  PetscCall(PetscFree(lid_removed));
+  PetscCall(PetscFree(lid_parent_gid));
+  PetscCall(PetscFree(lid_state));
+  *a_agg_lists = agg_lists;
+  *a_nselected = nselected;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  MatCoarsenMISKApply_Private - distance k MIS by k applications of an MIS-1 algorithm on successively coarsened graphs
+
+  Input Parameter:
+   . perm - permutation, or NULL
+   . misk - distance
    . Gmat - global matrix of graph (data not defined)
+   . mis - the MIS-1 algorithm, it returns strict aggregates and the number of selected vertices
 
   Output Parameter:
    . a_locals_llist - array of list of local nodes rooted at local node
 */
-static PetscErrorCode MatCoarsenApply_MISK_private(IS perm, const PetscInt misk, Mat Gmat, PetscCoarsenData **a_locals_llist)
+PetscErrorCode MatCoarsenMISKApply_Private(IS perm, const PetscInt misk, Mat Gmat, PetscErrorCode (*mis)(IS, Mat, PetscCoarsenData **, PetscInt *), PetscCoarsenData **a_locals_llist)
 {
-  PetscBool   isMPI;
   MPI_Comm    comm;
-  PetscMPIInt rank, size;
   Mat         cMat, Prols[5], Rtot;
   PetscScalar one = 1;
 
   PetscFunctionBegin;
-  PetscValidHeaderSpecific(perm, IS_CLASSID, 1);
+  if (perm) PetscValidHeaderSpecific(perm, IS_CLASSID, 1);
   PetscValidHeaderSpecific(Gmat, MAT_CLASSID, 3);
-  PetscValidPointer(a_locals_llist, 4);
+  PetscValidPointer(a_locals_llist, 5);
   PetscCheck(misk < 5 && misk > 0, PETSC_COMM_SELF, PETSC_ERR_SUP, "too many/few levels: %d", (int)misk);
-  PetscCall(PetscObjectBaseTypeCompare((PetscObject)Gmat, MATMPIAIJ, &isMPI));
   PetscCall(PetscObjectGetComm((PetscObject)Gmat, &comm));
-  PetscCallMPI(MPI_Comm_rank(comm, &rank));
-  PetscCallMPI(MPI_Comm_size(comm, &size));
   PetscCall(PetscInfo(Gmat, "misk %d\n", (int)misk));
   /* make a copy of the graph, this gets destroyed in iterates */
   if (misk > 1) PetscCall(MatDuplicate(Gmat, MAT_COPY_VALUES, &cMat));
   else cMat = Gmat;
   for (PetscInt iterIdx = 0; iterIdx < misk; iterIdx++) {
-    Mat_SeqAIJ       *matA, *matB = NULL;
-    Mat_MPIAIJ       *mpimat = NULL;
-    const PetscInt   *perm_ix;
-    const PetscInt    nloc = cMat->rmap->n;
     PetscCoarsenData *agg_lists;
-    PetscInt         *cpcol_gid = NULL, *cpcol_state, *lid_cprowID, *lid_state, *lid_parent_gid = NULL;
-    PetscInt          num_fine_ghosts, kk, n, ix, j, *idx, *ai, Iend, my0, nremoved, gid, lid, cpid, lidj, sgid, t1, t2, slid, nDone, nselected = 0, state;
-    PetscBool        *lid_removed, isOK;
-    PetscLayout       layout;
-    PetscSF           sf;
-
-    if (isMPI) {
-      mpimat = (Mat_MPIAIJ *)cMat->data;
-      matA   = (Mat_SeqAIJ *)mpimat->A->data;
-      matB   = (Mat_SeqAIJ *)mpimat->B->data;
-      /* force compressed storage of B */
-      PetscCall(MatCheckCompressedRow(mpimat->B, matB->nonzerorowcnt, &matB->compressedrow, matB->i, cMat->rmap->n, -1.0));
-    } else {
-      PetscBool isAIJ;
-      PetscCall(PetscObjectBaseTypeCompare((PetscObject)cMat, MATSEQAIJ, &isAIJ));
-      PetscCheck(isAIJ, PETSC_COMM_SELF, PETSC_ERR_USER, "Require AIJ matrix.");
-      matA = (Mat_SeqAIJ *)cMat->data;
-    }
-    PetscCall(MatGetOwnershipRange(cMat, &my0, &Iend));
-    if (mpimat) {
-      PetscInt *lid_gid;
-      PetscCall(PetscMalloc1(nloc, &lid_gid)); /* explicit array needed */
-      for (kk = 0, gid = my0; kk < nloc; kk++, gid++) lid_gid[kk] = gid;
-      PetscCall(VecGetLocalSize(mpimat->lvec, &num_fine_ghosts));
-      PetscCall(PetscMalloc1(num_fine_ghosts, &cpcol_gid));
-      PetscCall(PetscMalloc1(num_fine_ghosts, &cpcol_state));
-      PetscCall(PetscSFCreate(PetscObjectComm((PetscObject)cMat), &sf));
-      PetscCall(MatGetLayouts(cMat, &layout, NULL));
-      PetscCall(PetscSFSetGraphLayout(sf, layout, num_fine_ghosts, NULL, PETSC_COPY_VALUES, mpimat->garray));
-      PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_gid, cpcol_gid, MPI_REPLACE));
-      PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_gid, cpcol_gid, MPI_REPLACE));
-      for (kk = 0; kk < num_fine_ghosts; kk++) cpcol_state[kk] = MIS_NOT_DONE;
-      PetscCall(PetscFree(lid_gid));
-    } else num_fine_ghosts = 0;
-
-    PetscCall(PetscMalloc1(nloc, &lid_cprowID));
-    PetscCall(PetscMalloc1(nloc, &lid_removed)); /* explicit array needed */
-    PetscCall(PetscMalloc1(nloc, &lid_parent_gid));
-    PetscCall(PetscMalloc1(nloc, &lid_state));
-
-    /* the data structure */
-    PetscCall(PetscCDCreate(nloc, &agg_lists));
-    /* need an inverse map - locals */
-    for (kk = 0; kk < nloc; kk++) {
-      lid_cprowID[kk]    = -1;
-      lid_removed[kk]    = PETSC_FALSE;
-      lid_parent_gid[kk] = -1.0;
-      lid_state[kk]      = MIS_NOT_DONE;
-    }
-    /* set index into cmpressed row 'lid_cprowID' */
-    if (matB) {
-      for (ix = 0; ix < matB->compressedrow.nrows; ix++) {
-        lid              = matB->compressedrow.rindex[ix];
-        lid_cprowID[lid] = ix;
-      }
-    }
-    /* MIS */
-    nremoved = nDone = 0;
-    if (!iterIdx) PetscCall(ISGetIndices(perm, &perm_ix)); // use permutation on first MIS
-    else perm_ix = NULL;
-    while (nDone < nloc || PETSC_TRUE) { /* asynchronous not implemented */
-      /* check all vertices */
-      for (kk = 0; kk < nloc; kk++) {
-        lid   = perm_ix ? perm_ix[kk] : kk;
-        state = lid_state[lid];
-        if (lid_removed[lid]) continue;
-        if (state == MIS_NOT_DONE) {
-          /* parallel test, delete if selected ghost */
-          isOK = PETSC_TRUE;
-          /* parallel test */
-          if ((ix = lid_cprowID[lid]) != -1) { /* if I have any ghost neighbors */
-            ai  = matB->compressedrow.i;
-            n   = ai[ix + 1] - ai[ix];
-            idx = matB->j + ai[ix];
-            for (j = 0; j < n; j++) {
-              cpid = idx[j]; /* compressed row ID in B mat */
-              gid  = cpcol_gid[cpid];
-              if (cpcol_state[cpid] == MIS_NOT_DONE && gid >= Iend) { /* or pe>rank */
-                isOK = PETSC_FALSE;                                   /* can not delete */
-                break;
-              }
-            }
-          }
-          if (isOK) { /* select or remove this vertex if it is a true singleton like a BC */
-            nDone++;
-            /* check for singleton */
-            ai = matA->i;
-            n  = ai[lid + 1] - ai[lid];
-            if (n < 2) {
-              /* if I have any ghost adj then not a singleton */
-              ix = lid_cprowID[lid];
-              if (ix == -1 || !(matB->compressedrow.i[ix + 1] - matB->compressedrow.i[ix])) {
-                nremoved++;
-                lid_removed[lid] = PETSC_TRUE;
-                /* should select this because it is technically in the MIS but lets not */
-                continue; /* one local adj (me) and no ghost - singleton */
-              }
-            }
-            /* SELECTED state encoded with global index */
-            lid_state[lid] = nselected; // >= 0  is selected, cache for ordering coarse grid
-            nselected++;
-            PetscCall(PetscCDAppendID(agg_lists, lid, lid + my0));
-            /* delete local adj */
-            idx = matA->j + ai[lid];
-            for (j = 0; j < n; j++) {
-              lidj = idx[j];
-              if (lid_state[lidj] == MIS_NOT_DONE) {
-                nDone++;
-                PetscCall(PetscCDAppendID(agg_lists, lid, lidj + my0));
-                lid_state[lidj] = MIS_DELETED; /* delete this */
-              }
-            }
-          } /* selected */
-        }   /* not done vertex */
-      }     /* vertex loop */
-
-      /* update ghost states and count todos */
-      if (mpimat) {
-        /* scatter states, check for done */
-        PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
-        PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_state, cpcol_state, MPI_REPLACE));
-        ai = matB->compressedrow.i;
-        for (ix = 0; ix < matB->compressedrow.nrows; ix++) {
-          lid   = matB->compressedrow.rindex[ix]; /* local boundary node */
-          state = lid_state[lid];
-          if (state == MIS_NOT_DONE) {
-            /* look at ghosts */
-            n   = ai[ix + 1] - ai[ix];
-            idx = matB->j + ai[ix];
-            for (j = 0; j < n; j++) {
-              cpid = idx[j];                            /* compressed row ID in B mat */
-              if (MIS_IS_SELECTED(cpcol_state[cpid])) { /* lid is now deleted by ghost */
-                nDone++;
-                lid_state[lid]      = MIS_DELETED; /* delete this */
-                sgid                = cpcol_gid[cpid];
-                lid_parent_gid[lid] = sgid; /* keep track of proc that I belong to */
-                break;
-              }
-            }
-          }
-        }
-        /* all done? */
-        t1 = nloc - nDone;
-        PetscCall(MPIU_Allreduce(&t1, &t2, 1, MPIU_INT, MPI_SUM, comm)); /* synchronous version */
-        if (!t2) break;
-      } else break; /* no mpi - all done */
-    }               /* outer parallel MIS loop */
-    if (!iterIdx) PetscCall(ISRestoreIndices(perm, &perm_ix));
-    PetscCall(PetscInfo(Gmat, "\t removed %" PetscInt_FMT " of %" PetscInt_FMT " vertices.  %" PetscInt_FMT " selected.\n", nremoved, nloc, nselected));
-
-    /* tell adj who my lid_parent_gid vertices belong to - fill in agg_lists selected ghost lists */
-    if (matB) {
-      PetscInt *cpcol_sel_gid, *icpcol_gid;
-      /* need to copy this to free buffer -- should do this globally */
-      PetscCall(PetscMalloc1(num_fine_ghosts, &cpcol_sel_gid));
-      PetscCall(PetscMalloc1(num_fine_ghosts, &icpcol_gid));
-      for (cpid = 0; cpid < num_fine_ghosts; cpid++) icpcol_gid[cpid] = cpcol_gid[cpid];
-      /* get proc of deleted ghost */
-      PetscCall(PetscSFBcastBegin(sf, MPIU_INT, lid_parent_gid, cpcol_sel_gid, MPI_REPLACE));
-      PetscCall(PetscSFBcastEnd(sf, MPIU_INT, lid_parent_gid, cpcol_sel_gid, MPI_REPLACE));
-      for (cpid = 0; cpid < num_fine_ghosts; cpid++) {
-        sgid = cpcol_sel_gid[cpid];
-        gid  = icpcol_gid[cpid];
-        if (sgid >= my0 && sgid < Iend) { /* I own this deleted */
-          slid = sgid - my0;
-          PetscCall(PetscCDAppendID(agg_lists, slid, gid));
-        }
-      }
-      // done - cleanup
-      PetscCall(PetscFree(icpcol_gid));
-      PetscCall(PetscFree(cpcol_sel_gid));
-      PetscCall(PetscSFDestroy(&sf));
-      PetscCall(PetscFree(cpcol_gid));
-      PetscCall(PetscFree(cpcol_state));
-    }
-    PetscCall(PetscFree(lid_cprowID));
-    PetscCall(PetscFree(lid_removed));
-    PetscCall(PetscFree(lid_parent_gid));
-    PetscCall(PetscFree(lid_state));
+    PetscInt          nselected;
+    const PetscInt    nloc = cMat->rmap->n;
 
+    PetscCall((*mis)(iterIdx ? NULL : perm, cMat, &agg_lists, &nselected)); // use permutation on first MIS
     /* MIS done - make projection matrix - P */
     MatType jtype;
     PetscCall(MatGetType(Gmat, &jtype));
@@ -362,10 +385,10 @@ static PetscErrorCode MatCoarsenApply_MISK(MatCoarsen coarse)
 
     PetscCall(MatGetLocalSize(mat, &m, &n));
     PetscCall(ISCreateStride(PetscObjectComm((PetscObject)mat), m, 0, 1, &perm));
-    PetscCall(MatCoarsenApply_MISK_private(perm, (PetscInt)k, mat, &coarse->agg_lists));
+    PetscCall(MatCoarsenMISKApply_Private(perm, (PetscInt)k, mat, MatCoarsenMISKGreedy_Private, &coarse->agg_lists));
     PetscCall(ISDestroy(&perm));
   } else {
-    PetscCall(MatCoarsenApply_MISK_private(coarse->perm, (PetscInt)k, mat, &coarse->agg_lists));
+    PetscCall(MatCoarsenMISKApply_Private(coarse->perm, (PetscInt)k, mat, MatCoarsenMISKGreedy_Private, &coarse->agg_lists));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -5,6 +5,7 @@
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS(MatCoarsen);
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_HEM(MatCoarsen);
 PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MISK(MatCoarsen);
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_LUBY(MatCoarsen);
 
 /*@C
   MatCoarsenRegisterAll - Registers all of the matrix Coarsen routines in PETSc.
@@ -35,6 +36,7 @@ PetscErrorCode MatCoarsenRegisterAll(void)
   PetscCall(MatCoarsenRegister(MATCOARSENMIS, MatCoarsenCreate_MIS));
   PetscCall(MatCoarsenRegister(MATCOARSENHEM, MatCoarsenCreate_HEM));
   PetscCall(MatCoarsenRegister(MATCOARSENMISK, MatCoarsenCreate_MISK));
+  PetscCall(MatCoarsenRegister(MATCOARSENLUBY, MatCoarsenCreate_LUBY));
 
   PetscFunctionReturn(PETSC_SUCCESS);
 }
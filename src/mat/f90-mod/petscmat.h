@@ -71,7 +71,8 @@
       PetscEnum, parameter :: MAT_FORM_EXPLICIT_TRANSPOSE = 24
       PetscEnum, parameter :: MAT_STRUCTURAL_SYMMETRY_ETERNAL = 25
       PetscEnum, parameter :: MAT_SPD_ETERNAL = 26
-      PetscEnum, parameter :: MAT_OPTION_MAX = 27
+      PetscEnum, parameter :: MAT_THREAD_SAFE_ADD = 27
+      PetscEnum, parameter :: MAT_OPTION_MAX = 28
 !
 !  MatFactorShiftType
 !
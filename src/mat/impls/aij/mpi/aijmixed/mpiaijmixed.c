@@ -0,0 +1,110 @@
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+/*@C
+   MatCreateMPIAIJMixed - Creates a sparse parallel matrix whose local
+   portions are stored as `MATSEQAIJMIXED` matrices (a matrix class that inherits
+   from `MATSEQAIJ` but keeps a single precision copy of its values for `MatMult()`
+   and `MatSOR()`).
+
+   Collective
+
+   Input Parameters:
++  comm - MPI communicator
+.  m - number of local rows (or `PETSC_DECIDE` to have calculated if `M` is given)
+.  n - number of local columns (or `PETSC_DECIDE` to have calculated if `N` is given)
+.  M - number of global rows (or `PETSC_DETERMINE` to have calculated if `m` is given)
+.  N - number of global columns (or `PETSC_DETERMINE` to have calculated if `n` is given)
+.  d_nz  - number of nonzeros per row in DIAGONAL portion of local submatrix
+           (same value is used for all local rows)
+.  d_nnz - array containing the number of nonzeros in the various rows of the
+           DIAGONAL portion of the local submatrix (possibly different for each row)
+           or `NULL`, if `d_nz` is used to specify the nonzero structure.
+.  o_nz  - number of nonzeros per row in the OFF-DIAGONAL portion of local
+           submatrix (same value is used for all local rows).
+-  o_nnz - array containing the number of nonzeros in the various rows of the
+           OFF-DIAGONAL portion of the local submatrix (possibly different for
+           each row) or `NULL`, if `o_nz` is used to specify the nonzero
+           structure.
+
+   Output Parameter:
+.  A - the matrix
+
+   Level: intermediate
+
+   Notes:
+   See `MatCreateAIJ()` for the meaning of the parameters.
+
+   When calling this routine with a single process communicator, a matrix of
+   type `MATSEQAIJMIXED` is returned.
+
+.seealso: [](chapter_matrices), `Mat`, [Sparse Matrix Creation](sec_matsparse), `MATMPIAIJMIXED`, `MatCreate()`, `MatCreateSeqAIJMixed()`, `MatSetValues()`
+@*/
+PetscErrorCode MatCreateMPIAIJMixed(MPI_Comm comm, PetscInt m, PetscInt n, PetscInt M, PetscInt N, PetscInt d_nz, const PetscInt d_nnz[], PetscInt o_nz, const PetscInt o_nnz[], Mat *A)
+{
+  PetscMPIInt size;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreate(comm, A));
+  PetscCall(MatSetSizes(*A, m, n, M, N));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  if (size > 1) {
+    PetscCall(MatSetType(*A, MATMPIAIJMIXED));
+    PetscCall(MatMPIAIJSetPreallocation(*A, d_nz, d_nnz, o_nz, o_nnz));
+  } else {
+    PetscCall(MatSetType(*A, MATSEQAIJMIXED));
+    PetscCall(MatSeqAIJSetPreallocation(*A, d_nz, d_nnz));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMPIAIJSetPreallocation_MPIAIJMixed(Mat B, PetscInt d_nz, const PetscInt d_nnz[], PetscInt o_nz, const PetscInt o_nnz[])
+{
+  Mat_MPIAIJ *b = (Mat_MPIAIJ *)B->data;
+
+  PetscFunctionBegin;
+  PetscCall(MatMPIAIJSetPreallocation_MPIAIJ(B, d_nz, d_nnz, o_nz, o_nnz));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(b->A, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &b->A));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(b->B, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &b->B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJMixed(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat         B = *newmat;
+  Mat_MPIAIJ *b;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  b = (Mat_MPIAIJ *)B->data;
+
+  /* an already preallocated matrix only needs its local blocks converted */
+  if (b->A) PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(b->A, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &b->A));
+  if (b->B) PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(b->B, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &b->B));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATMPIAIJMIXED));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatMPIAIJSetPreallocation_C", MatMPIAIJSetPreallocation_MPIAIJMixed));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJMixed(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATMPIAIJ));
+  PetscCall(MatConvert_MPIAIJ_MPIAIJMixed(A, MATMPIAIJMIXED, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATAIJMIXED - "aijmixed" - A matrix type to be used for sparse matrices whose values are read in single precision
+   by `MatMult()`, `MatMultAdd()` and `MatSOR()`, while the vectors remain in the precision of `PetscScalar`.
+
+   This matrix type is identical to `MATSEQAIJMIXED` when constructed with a single process communicator,
+   and `MATMPIAIJMIXED` otherwise. An assembled `MATAIJ` matrix can be converted with `MatConvert()`.
+
+   Options Database Key:
+. -mat_type aijmixed - sets the matrix type to `MATAIJMIXED`
+
+  Level: intermediate
+
+.seealso: [](chapter_matrices), `Mat`, `MatCreateMPIAIJMixed()`, `MATSEQAIJMIXED`, `MATMPIAIJMIXED`, `MATSEQAIJ`, `MATMPIAIJ`
+M*/
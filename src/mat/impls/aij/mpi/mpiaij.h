@@ -31,6 +31,18 @@ typedef struct {                                /* used by MatPtAPXXX_MPIAIJ_MPI
   Mat_Merge_SeqsToMPI *merge;
 } Mat_APMPI;
 
+typedef struct {                       /* used by MatMatrixPowers_MPIAIJ() */
+  PetscInt         s;                   /* depth of the ghost region */
+  PetscObjectState nonzerostate, state; /* of the matrix when the local matrix was extracted */
+  IS               is;                  /* local rows and the rows within distance s of them, sorted */
+  Mat             *Aloc;                /* the corresponding square submatrix */
+  Vec              xloc;                /* input vector on is */
+  VecScatter       scatter;             /* gathers xloc, the only communication of MatMatrixPowers() */
+  PetscScalar     *w;                   /* two work arrays of the size of is */
+  PetscInt         rstart;              /* position of the first local row in is */
+  PetscInt        *nrows, *rows;        /* rows[0, nrows[d]) are the rows of Aloc within distance d of the local rows */
+} Mat_MatrixPowers;
+
 typedef struct {
   Mat         A, B; /* local submatrices: A (diag part),
                                            B (off-diag part) */
@@ -81,6 +93,8 @@ typedef struct {
   PetscScalar *sendbuf, *recvbuf;          /* Buffers for remote values in MatSetValuesCOO() */
   PetscInt     sendlen, recvlen;           /* Lengths (in unit of PetscScalar) of send/recvbuf */
 
+  Mat_MatrixPowers *mpow; /* ghost region of MatMatrixPowers() */
+
   struct _MatOps cops;
 } Mat_MPIAIJ;
 
@@ -93,6 +107,8 @@ PETSC_INTERN PetscErrorCode MatDisAssemble_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatDuplicate_MPIAIJ(Mat, MatDuplicateOption, Mat *);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ(Mat, PetscInt, IS[], PetscInt);
 PETSC_INTERN PetscErrorCode MatIncreaseOverlap_MPIAIJ_Scalable(Mat, PetscInt, IS[], PetscInt);
+PETSC_INTERN PetscErrorCode MatMatrixPowers_MPIAIJ(Mat, PetscInt, Vec, Vec[]);
+PETSC_INTERN PetscErrorCode MatMatrixPowersDestroy_MPIAIJ(Mat_MatrixPowers **);
 PETSC_INTERN PetscErrorCode MatFDColoringCreate_MPIXAIJ(Mat, ISColoring, MatFDColoring);
 PETSC_INTERN PetscErrorCode MatFDColoringSetUp_MPIXAIJ(Mat, ISColoring, MatFDColoring);
 PETSC_INTERN PetscErrorCode MatCreateSubMatrices_MPIAIJ(Mat, PetscInt, const IS[], const IS[], MatReuse, Mat *[]);
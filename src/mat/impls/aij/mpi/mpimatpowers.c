@@ -0,0 +1,135 @@
+/*
+   Matrix powers kernel for MATMPIAIJ: the rows within distance s of the local rows are gathered once with
+   MatIncreaseOverlap() and MatCreateSubMatrices(), then A^k x, k = 1, ..., s, is computed without communication by
+   recomputing the products on a shrinking ghost region.
+*/
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+
+PetscErrorCode MatMatrixPowersDestroy_MPIAIJ(Mat_MatrixPowers **mpow)
+{
+  PetscFunctionBegin;
+  if (!*mpow) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(ISDestroy(&(*mpow)->is));
+  PetscCall(MatDestroySubMatrices(1, &(*mpow)->Aloc));
+  PetscCall(VecDestroy(&(*mpow)->xloc));
+  PetscCall(VecScatterDestroy(&(*mpow)->scatter));
+  PetscCall(PetscFree((*mpow)->w));
+  PetscCall(PetscFree2((*mpow)->nrows, (*mpow)->rows));
+  PetscCall(PetscFree(*mpow));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMatrixPowersSetUp_MPIAIJ(Mat A, PetscInt s, Vec x)
+{
+  Mat_MPIAIJ       *aij = (Mat_MPIAIJ *)A->data;
+  Mat_MatrixPowers *mpow;
+  PetscObjectState  state;
+  IS               *is;
+  const PetscInt   *idx, *ridx;
+  PetscInt          n, nk, k, i, pos, *level;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectStateGet((PetscObject)A, &state));
+  mpow = aij->mpow;
+  if (mpow && mpow->s == s && mpow->nonzerostate == A->nonzerostate) {
+    if (mpow->state != state) {
+      PetscCall(MatCreateSubMatrices(A, 1, &mpow->is, &mpow->is, MAT_REUSE_MATRIX, &mpow->Aloc));
+      mpow->state = state;
+    }
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatMatrixPowersDestroy_MPIAIJ(&aij->mpow));
+  PetscCall(PetscNew(&mpow));
+  aij->mpow          = mpow;
+  mpow->s            = s;
+  mpow->nonzerostate = A->nonzerostate;
+  mpow->state        = state;
+
+  /* is[k] holds the rows within distance k of the local rows, one round of communication each */
+  PetscCall(PetscMalloc1(s + 1, &is));
+  PetscCall(ISCreateStride(PETSC_COMM_SELF, A->rmap->n, A->rmap->rstart, 1, &is[0]));
+  for (k = 1; k <= s; k++) {
+    PetscCall(ISDuplicate(is[k - 1], &is[k]));
+    PetscCall(MatIncreaseOverlap(A, 1, &is[k], 1));
+    PetscCall(ISSort(is[k]));
+  }
+  mpow->is = is[s];
+  PetscCall(ISGetLocalSize(mpow->is, &n));
+  PetscCall(ISGetIndices(mpow->is, &idx));
+  PetscCall(PetscMalloc1(n, &level));
+  for (i = 0; i < n; i++) level[i] = s;
+  for (k = s - 1; k >= 0; k--) {
+    PetscCall(ISGetLocalSize(is[k], &nk));
+    PetscCall(ISGetIndices(is[k], &ridx));
+    for (i = 0; i < nk; i++) {
+      PetscCall(PetscFindInt(ridx[i], n, idx, &pos));
+      level[pos] = k;
+    }
+    PetscCall(ISRestoreIndices(is[k], &ridx));
+    PetscCall(ISDestroy(&is[k]));
+  }
+  PetscCall(PetscFree(is));
+  if (A->rmap->n) PetscCall(PetscFindInt(A->rmap->rstart, n, idx, &mpow->rstart));
+  PetscCall(ISRestoreIndices(mpow->is, &idx));
+
+  /* the rows sorted by their distance to the local rows, the rows at distance s are only needed as columns */
+  PetscCall(PetscMalloc2(s, &mpow->nrows, n, &mpow->rows));
+  for (k = 0, nk = 0; k < s; k++) {
+    for (i = 0; i < n; i++)
+      if (level[i] == k) mpow->rows[nk++] = i;
+    mpow->nrows[k] = nk;
+  }
+  PetscCall(PetscFree(level));
+
+  PetscCall(MatCreateSubMatrices(A, 1, &mpow->is, &mpow->is, MAT_INITIAL_MATRIX, &mpow->Aloc));
+  PetscCall(VecCreateSeq(PETSC_COMM_SELF, n, &mpow->xloc));
+  PetscCall(VecScatterCreate(x, mpow->is, mpow->xloc, NULL, &mpow->scatter));
+  PetscCall(PetscMalloc1(2 * n, &mpow->w));
+  PetscCall(PetscInfo(A, "Ghost region of depth %" PetscInt_FMT " with %" PetscInt_FMT " rows for %" PetscInt_FMT " local rows\n", s, n, A->rmap->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMatrixPowers_MPIAIJ(Mat A, PetscInt s, Vec x, Vec y[])
+{
+  Mat_MPIAIJ        *aij = (Mat_MPIAIJ *)A->data;
+  Mat_MatrixPowers  *mpow;
+  Mat_SeqAIJ        *a;
+  const PetscInt    *ai, *aj, *rows;
+  const PetscScalar *aa, *in;
+  PetscScalar       *out, *ya, sum;
+  PetscInt           n, m = A->rmap->n, k, r, i, j;
+  PetscLogDouble     nz = 0;
+
+  PetscFunctionBegin;
+  PetscCall(MatMatrixPowersSetUp_MPIAIJ(A, s, x));
+  mpow = aij->mpow;
+  PetscCall(VecScatterBegin(mpow->scatter, x, mpow->xloc, INSERT_VALUES, SCATTER_FORWARD));
+  PetscCall(VecScatterEnd(mpow->scatter, x, mpow->xloc, INSERT_VALUES, SCATTER_FORWARD));
+
+  a    = (Mat_SeqAIJ *)mpow->Aloc[0]->data;
+  ai   = a->i;
+  aj   = a->j;
+  rows = mpow->rows;
+  PetscCall(ISGetLocalSize(mpow->is, &n));
+  PetscCall(MatSeqAIJGetArrayRead(mpow->Aloc[0], &aa));
+  PetscCall(VecGetArrayRead(mpow->xloc, &in));
+  for (k = 0; k < s; k++) {
+    /* A^(k+1) x is only correct within distance s - k - 1 of the local rows */
+    out = mpow->w + (k % 2) * n;
+    for (r = 0; r < mpow->nrows[s - k - 1]; r++) {
+      i   = rows[r];
+      sum = 0.0;
+      for (j = ai[i]; j < ai[i + 1]; j++) sum += aa[j] * in[aj[j]];
+      out[i] = sum;
+      nz += ai[i + 1] - ai[i];
+    }
+    PetscCall(VecGetArrayWrite(y[k], &ya));
+    PetscCall(PetscArraycpy(ya, out + mpow->rstart, m));
+    PetscCall(VecRestoreArrayWrite(y[k], &ya));
+    if (!k) PetscCall(VecRestoreArrayRead(mpow->xloc, &in));
+    in = out;
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(mpow->Aloc[0], &aa));
+  PetscCall(PetscLogFlops(2.0 * nz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -645,15 +645,59 @@ PetscErrorCode MatGetValues_SeqAIJ(Mat A, PetscInt m, const PetscInt im[], Petsc
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+  With the PETSC_VIEWER_NATIVE format and a viewer set to use mmap the header is followed by the number of nonzeros, whether the arrays are big-endian and the
+  size of a scalar, then by the row offsets, column indices and values as they are in memory, each aligned to PETSC_MEMALIGN in the
+  file, so that MatLoad() can use them directly from a file mapped with -viewer_binary_mmap
+*/
+static PetscErrorCode MatView_SeqAIJ_Binary_NativeArray(PetscViewer viewer, const void *data, size_t len)
+{
+  size_t off, n;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerBinaryAlign(viewer, PETSC_MEMALIGN));
+  /* the data is written as bytes, so that it is not converted to big-endian, in pieces whose size fits in a PetscInt */
+  for (off = 0; off < len; off += n) {
+    n = PetscMin(len - off, (size_t)PETSC_MAX_INT);
+    PetscCall(PetscViewerBinaryWrite(viewer, (const char *)data + off, (PetscInt)n, PETSC_CHAR));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatView_SeqAIJ_Binary_Native(Mat mat, PetscViewer viewer)
+{
+  Mat_SeqAIJ        *A = (Mat_SeqAIJ *)mat->data;
+  const PetscScalar *av;
+  PetscInt           layout[3], m = mat->rmap->n, nz = A->nz;
+
+  PetscFunctionBegin;
+  layout[0] = nz;
+  layout[1] = PetscBinaryBigEndian();
+  layout[2] = (PetscInt)sizeof(PetscScalar);
+  PetscCall(PetscViewerBinaryWrite(viewer, layout, 3, PETSC_INT));
+  PetscCall(MatView_SeqAIJ_Binary_NativeArray(viewer, A->i, (size_t)(m + 1) * sizeof(PetscInt)));
+  PetscCall(MatView_SeqAIJ_Binary_NativeArray(viewer, A->j, (size_t)nz * sizeof(PetscInt)));
+  PetscCall(MatSeqAIJGetArrayRead(mat, &av));
+  PetscCall(MatView_SeqAIJ_Binary_NativeArray(viewer, av, (size_t)nz * sizeof(PetscScalar)));
+  PetscCall(MatSeqAIJRestoreArrayRead(mat, &av));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatView_SeqAIJ_Binary(Mat mat, PetscViewer viewer)
 {
   Mat_SeqAIJ        *A = (Mat_SeqAIJ *)mat->data;
   const PetscScalar *av;
   PetscInt           header[4], M, N, m, nz, i;
   PetscInt          *rowlens;
+  PetscViewerFormat  format;
+  PetscBool          native;
 
   PetscFunctionBegin;
   PetscCall(PetscViewerSetUp(viewer));
+  PetscCall(PetscViewerGetFormat(viewer, &format));
+  /* the layout that can be used from a mapped file is only written on request, since only MATSEQAIJ can load it */
+  PetscCall(PetscViewerBinaryGetUseMmap(viewer, &native));
+  native = (native && format == PETSC_VIEWER_NATIVE) ? PETSC_TRUE : PETSC_FALSE;
 
   M  = mat->rmap->N;
   N  = mat->cmap->N;
@@ -664,20 +708,24 @@ PetscErrorCode MatView_SeqAIJ_Binary(Mat mat, PetscViewer viewer)
   header[0] = MAT_FILE_CLASSID;
   header[1] = M;
   header[2] = N;
-  header[3] = nz;
+  header[3] = native ? MATRIX_BINARY_FORMAT_AIJ_NATIVE : nz;
   PetscCall(PetscViewerBinaryWrite(viewer, header, 4, PETSC_INT));
 
-  /* fill in and store row lengths */
-  PetscCall(PetscMalloc1(m, &rowlens));
-  for (i = 0; i < m; i++) rowlens[i] = A->i[i + 1] - A->i[i];
-  PetscCall(PetscViewerBinaryWrite(viewer, rowlens, m, PETSC_INT));
-  PetscCall(PetscFree(rowlens));
-  /* store column indices */
-  PetscCall(PetscViewerBinaryWrite(viewer, A->j, nz, PETSC_INT));
-  /* store nonzero values */
-  PetscCall(MatSeqAIJGetArrayRead(mat, &av));
-  PetscCall(PetscViewerBinaryWrite(viewer, av, nz, PETSC_SCALAR));
-  PetscCall(MatSeqAIJRestoreArrayRead(mat, &av));
+  if (native) {
+    PetscCall(MatView_SeqAIJ_Binary_Native(mat, viewer));
+  } else {
+    /* fill in and store row lengths */
+    PetscCall(PetscMalloc1(m, &rowlens));
+    for (i = 0; i < m; i++) rowlens[i] = A->i[i + 1] - A->i[i];
+    PetscCall(PetscViewerBinaryWrite(viewer, rowlens, m, PETSC_INT));
+    PetscCall(PetscFree(rowlens));
+    /* store column indices */
+    PetscCall(PetscViewerBinaryWrite(viewer, A->j, nz, PETSC_INT));
+    /* store nonzero values */
+    PetscCall(MatSeqAIJGetArrayRead(mat, &av));
+    PetscCall(PetscViewerBinaryWrite(viewer, av, nz, PETSC_SCALAR));
+    PetscCall(MatSeqAIJRestoreArrayRead(mat, &av));
+  }
 
   /* write block size option to the viewer's .info file */
   PetscCall(MatView_Binary_BlockSizes(mat, viewer));
@@ -1102,6 +1150,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
   PetscReal   ratio = 0.6;
 
   PetscFunctionBegin;
+  if (a->threads.nstash) PetscCall(MatSeqAIJMergeThreadStash_Private(A));
   if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
   PetscCall(MatSeqAIJInvalidateDiagonal(A));
   if (A->was_assembled && A->ass_nonzerostate == A->nonzerostate) {
@@ -1153,6 +1202,7 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A, MatAssemblyType mode)
   a->rmax             = rmax;
 
   if (!A->structure_only) PetscCall(MatCheckCompressedRow(A, a->nonzerorowcnt, &a->compressedrow, a->i, m, ratio));
+  PetscCall(MatAssemblyEnd_SeqAIJ_Threads(A, mode));
   PetscCall(MatAssemblyEnd_SeqAIJ_Inode(A, mode));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1231,6 +1281,7 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscFree(a->saved_values));
   PetscCall(PetscFree2(a->compressedrow.i, a->compressedrow.rindex));
   PetscCall(MatDestroy_SeqAIJ_Inode(A));
+  PetscCall(MatDestroy_SeqAIJ_Threads(A));
   PetscCall(PetscFree(A->data));
 
   /* MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted may allocate this.
@@ -1249,6 +1300,8 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqsbaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqbaij_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijperm_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijcompressed_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijmixed_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijsell_C", NULL));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaij_seqaijmkl_C", NULL));
@@ -1357,6 +1410,10 @@ PetscErrorCode MatSetOption_SeqAIJ(Mat A, MatOption op, PetscBool flg)
   case MAT_FORM_EXPLICIT_TRANSPOSE:
     A->form_explicit_transpose = flg;
     break;
+  case MAT_THREAD_SAFE_ADD:
+    PetscCall(MatSetOption_SeqAIJ_Threads(A, MAT_THREAD_SAFE_ADD, flg));
+    if (!flg) A->ops->setvalues = A->sortedfull ? MatSetValues_SeqAIJ_SortedFull : MatSetValues_SeqAIJ;
+    break;
   default:
     SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "unknown option %d", op);
   }
@@ -1416,6 +1473,10 @@ PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A, Vec xx, Vec zz, Vec yy)
 #endif
 
   PetscFunctionBegin;
+  if (a->threads.n > 1) {
+    PetscCall(MatMultTransposeAdd_SeqAIJ_Threads(A, xx, zz, yy));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (zz != yy) PetscCall(VecCopy(zz, yy));
   PetscCall(VecGetArrayRead(xx, &x));
   PetscCall(VecGetArray(yy, &y));
@@ -1477,6 +1538,10 @@ PetscErrorCode MatMult_SeqAIJ(Mat A, Vec xx, Vec yy)
 #endif
 
   PetscFunctionBegin;
+  if (a->threads.n > 1) {
+    PetscCall(MatMult_SeqAIJ_Threads(A, xx, yy));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (a->inode.use && a->inode.checked) {
     PetscCall(MatMult_SeqAIJ_Inode(A, xx, yy));
     PetscFunctionReturn(PETSC_SUCCESS);
@@ -1634,6 +1699,10 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A, Vec xx, Vec yy, Vec zz)
   PetscBool          usecprow = a->compressedrow.use;
 
   PetscFunctionBegin;
+  if (a->threads.n > 1) {
+    PetscCall(MatMultAdd_SeqAIJ_Threads(A, xx, yy, zz));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (a->inode.use && a->inode.checked) {
     PetscCall(MatMultAdd_SeqAIJ_Inode(A, xx, yy, zz));
     PetscFunctionReturn(PETSC_SUCCESS);
@@ -1931,6 +2000,10 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, Pe
   const PetscInt    *idx, *diag;
 
   PetscFunctionBegin;
+  if (a->threads.sor_multicolor && !(flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER))) {
+    PetscCall(MatSOR_SeqAIJ_Threads(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (a->inode.use && a->inode.checked && omega == 1.0 && fshift == 0.0) {
     PetscCall(MatSOR_SeqAIJ_Inode(A, bb, omega, flag, fshift, its, lits, xx));
     PetscFunctionReturn(PETSC_SUCCESS);
@@ -4296,8 +4369,10 @@ PetscErrorCode MatMatMultSymbolic_SeqDense_SeqAIJ(Mat A, Mat B, PetscReal fill,
    MATSEQAIJ - MATSEQAIJ = "seqaij" - A matrix type to be used for sequential sparse matrices,
    based on compressed sparse row format.
 
-   Options Database Key:
-. -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+   Options Database Keys:
++ -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+. -mat_aij_threads <n> - use n OpenMP threads in `MatMult()`, `MatMultAdd()`, `MatMultTranspose()`, `MatSOR()` and in the triangular solves of the ILU and ICC factors of the matrix, requires PETSc configured with OpenMP
+- -mat_aij_sor_multicolor - `MatSOR()` relaxes the unknowns in the order of a distance-1 coloring of the matrix graph, the rows of one color are relaxed concurrently
 
    Level: beginner
 
@@ -4796,6 +4871,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqsbaij_C", MatConvert_SeqAIJ_SeqSBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqbaij_C", MatConvert_SeqAIJ_SeqBAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijperm_C", MatConvert_SeqAIJ_SeqAIJPERM));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijcompressed_C", MatConvert_SeqAIJ_SeqAIJCompressed));
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijmixed_C", MatConvert_SeqAIJ_SeqAIJMixed));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijsell_C", MatConvert_SeqAIJ_SeqAIJSELL));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaij_seqaijmkl_C", MatConvert_SeqAIJ_SeqAIJMKL));
@@ -4840,6 +4917,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetPreallocationCOO_C", MatSetPreallocationCOO_SeqAIJ));
   PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatSetValuesCOO_C", MatSetValuesCOO_SeqAIJ));
   PetscCall(MatCreate_SeqAIJ_Inode(B));
+  PetscCall(MatCreate_SeqAIJ_Threads(B));
   PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
   PetscCall(MatSeqAIJSetTypeFromOptions(B)); /* this allows changing the matrix subtype to say MATSEQAIJPERM */
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -4916,6 +4994,10 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C, Mat A, MatDuplicateOption cpva
     c->free_a             = PETSC_TRUE;
     c->free_ij            = PETSC_TRUE;
 
+    c->threads.n              = a->threads.n;
+    c->threads.sor_multicolor = a->threads.sor_multicolor;
+    C->ops->getvecs           = A->ops->getvecs;
+
     c->rmax  = a->rmax;
     c->nz    = a->nz;
     c->maxnz = a->nz; /* Since we allocate exactly the right amount */
@@ -4977,10 +5059,79 @@ PetscErrorCode MatLoad_SeqAIJ(Mat newMat, PetscViewer viewer)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+static PetscErrorCode MatLoad_SeqAIJ_Binary_NativeArray(PetscViewer viewer, void *data, size_t len)
+{
+  size_t off, n;
+
+  PetscFunctionBegin;
+  PetscCall(PetscViewerBinaryAlign(viewer, PETSC_MEMALIGN));
+  for (off = 0; off < len; off += n) {
+    n = PetscMin(len - off, (size_t)PETSC_MAX_INT);
+    PetscCall(PetscViewerBinaryRead(viewer, (char *)data + off, (PetscInt)n, NULL, PETSC_CHAR));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Loads a matrix stored with MATRIX_BINARY_FORMAT_AIJ_NATIVE, see MatView_SeqAIJ_Binary_Native(). When the file has the native byte
+  order and is mapped with -viewer_binary_mmap the matrix uses its arrays in place and keeps a reference to the mapping,
+  otherwise they are read, and byte swapped if needed.
+*/
+static PetscErrorCode MatLoad_SeqAIJ_Binary_Native(Mat mat, PetscViewer viewer, PetscInt nz, PetscBool swap)
+{
+  Mat_SeqAIJ  *a = (Mat_SeqAIJ *)mat->data;
+  PetscInt     m = mat->rmap->n, i, *ai = NULL, *aj = NULL;
+  PetscScalar *aa = NULL;
+  PetscObject  mapping = NULL;
+
+  PetscFunctionBegin;
+  if (!swap && nz > 0) {
+    PetscCall(PetscViewerBinaryAlign(viewer, PETSC_MEMALIGN));
+    PetscCall(PetscViewerBinaryReadMapped(viewer, (void **)&ai, m + 1, PETSC_INT, &mapping));
+  }
+  if (ai) {
+    PetscCall(PetscViewerBinaryAlign(viewer, PETSC_MEMALIGN));
+    PetscCall(PetscViewerBinaryReadMapped(viewer, (void **)&aj, nz, PETSC_INT, &mapping));
+    PetscCall(PetscViewerBinaryAlign(viewer, PETSC_MEMALIGN));
+    if (aj) PetscCall(PetscViewerBinaryReadMapped(viewer, (void **)&aa, nz, PETSC_SCALAR, &mapping));
+    PetscCheck(aj && aa, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Matrix data in file is truncated");
+    PetscCall(PetscObjectCompose((PetscObject)mat, "MatLoad_Binary_Mapping", mapping));
+    PetscCall(PetscInfo(mat, "Row offsets, column indices and values in the mapped file\n"));
+  } else {
+    PetscCall(PetscMalloc3(nz, &aa, nz, &aj, m + 1, &ai));
+    PetscCall(MatLoad_SeqAIJ_Binary_NativeArray(viewer, ai, (size_t)(m + 1) * sizeof(PetscInt)));
+    PetscCall(MatLoad_SeqAIJ_Binary_NativeArray(viewer, aj, (size_t)nz * sizeof(PetscInt)));
+    PetscCall(MatLoad_SeqAIJ_Binary_NativeArray(viewer, aa, (size_t)nz * sizeof(PetscScalar)));
+    if (swap) {
+      PetscCall(PetscByteSwap(ai, PETSC_INT, m + 1));
+      PetscCall(PetscByteSwap(aj, PETSC_INT, nz));
+      PetscCall(PetscByteSwap(aa, PETSC_SCALAR, nz));
+      PetscCall(PetscInfo(mat, "Converted the matrix stored in native format to the byte order of this machine\n"));
+    }
+  }
+  PetscCheck(ai[0] == 0 && ai[m] == nz, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Inconsistent matrix data in file: nonzeros = %" PetscInt_FMT ", last row offset = %" PetscInt_FMT, nz, ai[m]);
+
+  /* replace the arrays of the matrix, as MatCreateSeqAIJWithArrays() does */
+  PetscCall(MatSeqXAIJFreeAIJ(mat, &a->a, &a->j, &a->i));
+  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(mat, MAT_SKIP_ALLOCATION, NULL));
+  if (!a->imax) PetscCall(PetscMalloc1(m, &a->imax));
+  if (!a->ilen) PetscCall(PetscMalloc1(m, &a->ilen));
+  a->i     = ai;
+  a->j     = aj;
+  a->a     = aa;
+  a->maxnz = nz;
+  for (i = 0; i < m; i++) a->ilen[i] = a->imax[i] = ai[i + 1] - ai[i];
+  a->singlemalloc = mapping ? PETSC_FALSE : PETSC_TRUE;
+  a->free_a       = mapping ? PETSC_FALSE : PETSC_TRUE;
+  a->free_ij      = mapping ? PETSC_FALSE : PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode MatLoad_SeqAIJ_Binary(Mat mat, PetscViewer viewer)
 {
   Mat_SeqAIJ *a = (Mat_SeqAIJ *)mat->data;
-  PetscInt    header[4], *rowlens, M, N, nz, sum, rows, cols, i;
+  PetscInt    header[4], layout[3], *rowlens, M, N, nz, sum, rows, cols, i;
+  PetscBool   native, swap = PETSC_FALSE;
 
   PetscFunctionBegin;
   PetscCall(PetscViewerSetUp(viewer));
@@ -4993,7 +5144,15 @@ PetscErrorCode MatLoad_SeqAIJ_Binary(Mat mat, PetscViewer viewer)
   nz = header[3];
   PetscCheck(M >= 0, PetscObjectComm((PetscObject)viewer), PETSC_ERR_FILE_UNEXPECTED, "Matrix row size (%" PetscInt_FMT ") in file is negative", M);
   PetscCheck(N >= 0, PetscObjectComm((PetscObject)viewer), PETSC_ERR_FILE_UNEXPECTED, "Matrix column size (%" PetscInt_FMT ") in file is negative", N);
-  PetscCheck(nz >= 0, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Matrix stored in special format on disk, cannot load as SeqAIJ");
+  PetscCheck(nz >= 0 || nz == MATRIX_BINARY_FORMAT_AIJ_NATIVE, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Matrix stored in special format on disk, cannot load as SeqAIJ");
+  native = (nz == MATRIX_BINARY_FORMAT_AIJ_NATIVE) ? PETSC_TRUE : PETSC_FALSE;
+  if (native) {
+    PetscCall(PetscViewerBinaryRead(viewer, layout, 3, NULL, PETSC_INT));
+    nz = layout[0];
+    swap = (layout[1] ? PETSC_TRUE : PETSC_FALSE) == PetscBinaryBigEndian() ? PETSC_FALSE : PETSC_TRUE;
+    PetscCheck(nz >= 0, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Number of nonzeros (%" PetscInt_FMT ") in file is negative", nz);
+    PetscCheck(layout[2] == (PetscInt)sizeof(PetscScalar), PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Matrix stored in native format with %" PetscInt_FMT " byte scalars, PETSc is configured with %d byte scalars", layout[2], (int)sizeof(PetscScalar));
+  }
 
   /* set block sizes from the viewer's .info file */
   PetscCall(MatLoad_Binary_BlockSizes(mat, viewer));
@@ -5009,28 +5168,32 @@ PetscErrorCode MatLoad_SeqAIJ_Binary(Mat mat, PetscViewer viewer)
   PetscCall(MatGetSize(mat, &rows, &cols));
   PetscCheck(M == rows && N == cols, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Matrix in file of different sizes (%" PetscInt_FMT ", %" PetscInt_FMT ") than the input matrix (%" PetscInt_FMT ", %" PetscInt_FMT ")", M, N, rows, cols);
 
-  /* read in row lengths */
-  PetscCall(PetscMalloc1(M, &rowlens));
-  PetscCall(PetscViewerBinaryRead(viewer, rowlens, M, NULL, PETSC_INT));
-  /* check if sum(rowlens) is same as nz */
-  sum = 0;
-  for (i = 0; i < M; i++) sum += rowlens[i];
-  PetscCheck(sum == nz, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Inconsistent matrix data in file: nonzeros = %" PetscInt_FMT ", sum-row-lengths = %" PetscInt_FMT, nz, sum);
-  /* preallocate and check sizes */
-  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(mat, 0, rowlens));
-  PetscCall(MatGetSize(mat, &rows, &cols));
-  PetscCheck(M == rows && N == cols, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Matrix in file of different length (%" PetscInt_FMT ", %" PetscInt_FMT ") than the input matrix (%" PetscInt_FMT ", %" PetscInt_FMT ")", M, N, rows, cols);
-  /* store row lengths */
-  PetscCall(PetscArraycpy(a->ilen, rowlens, M));
-  PetscCall(PetscFree(rowlens));
-
-  /* fill in "i" row pointers */
-  a->i[0] = 0;
-  for (i = 0; i < M; i++) a->i[i + 1] = a->i[i] + a->ilen[i];
-  /* read in "j" column indices */
-  PetscCall(PetscViewerBinaryRead(viewer, a->j, nz, NULL, PETSC_INT));
-  /* read in "a" nonzero values */
-  PetscCall(PetscViewerBinaryRead(viewer, a->a, nz, NULL, PETSC_SCALAR));
+  if (native) {
+    PetscCall(MatLoad_SeqAIJ_Binary_Native(mat, viewer, nz, swap));
+  } else {
+    /* read in row lengths */
+    PetscCall(PetscMalloc1(M, &rowlens));
+    PetscCall(PetscViewerBinaryRead(viewer, rowlens, M, NULL, PETSC_INT));
+    /* check if sum(rowlens) is same as nz */
+    sum = 0;
+    for (i = 0; i < M; i++) sum += rowlens[i];
+    PetscCheck(sum == nz, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Inconsistent matrix data in file: nonzeros = %" PetscInt_FMT ", sum-row-lengths = %" PetscInt_FMT, nz, sum);
+    /* preallocate and check sizes */
+    PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(mat, 0, rowlens));
+    PetscCall(MatGetSize(mat, &rows, &cols));
+    PetscCheck(M == rows && N == cols, PETSC_COMM_SELF, PETSC_ERR_FILE_UNEXPECTED, "Matrix in file of different length (%" PetscInt_FMT ", %" PetscInt_FMT ") than the input matrix (%" PetscInt_FMT ", %" PetscInt_FMT ")", M, N, rows, cols);
+    /* store row lengths */
+    PetscCall(PetscArraycpy(a->ilen, rowlens, M));
+    PetscCall(PetscFree(rowlens));
+
+    /* fill in "i" row pointers */
+    a->i[0] = 0;
+    for (i = 0; i < M; i++) a->i[i + 1] = a->i[i] + a->ilen[i];
+    /* read in "j" column indices */
+    PetscCall(PetscViewerBinaryRead(viewer, a->j, nz, NULL, PETSC_INT));
+    /* read in "a" nonzero values */
+    PetscCall(PetscViewerBinaryRead(viewer, a->a, nz, NULL, PETSC_SCALAR));
+  }
 
   PetscCall(MatAssemblyBegin(mat, MAT_FINAL_ASSEMBLY));
   PetscCall(MatAssemblyEnd(mat, MAT_FINAL_ASSEMBLY));
@@ -5442,6 +5605,8 @@ PetscErrorCode MatSeqAIJRegisterAll(void)
 
   PetscCall(MatSeqAIJRegister(MATSEQAIJCRL, MatConvert_SeqAIJ_SeqAIJCRL));
   PetscCall(MatSeqAIJRegister(MATSEQAIJPERM, MatConvert_SeqAIJ_SeqAIJPERM));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJCOMPRESSED, MatConvert_SeqAIJ_SeqAIJCompressed));
+  PetscCall(MatSeqAIJRegister(MATSEQAIJMIXED, MatConvert_SeqAIJ_SeqAIJMixed));
   PetscCall(MatSeqAIJRegister(MATSEQAIJSELL, MatConvert_SeqAIJ_SeqAIJSELL));
 #if defined(PETSC_HAVE_MKL_SPARSE)
   PetscCall(MatSeqAIJRegister(MATSEQAIJMKL, MatConvert_SeqAIJ_SeqAIJMKL));
@@ -135,6 +135,55 @@ typedef struct {
   PetscObjectState mat_nonzerostate; /* non-zero state when inodes were checked for */
 } Mat_SeqAIJ_Inode;
 
+/* Entries added with MAT_THREAD_SAFE_ADD by one thread outside the current nonzero pattern, see aijthreads.c */
+typedef struct {
+  PetscInt     n, size; /* number of stashed entries and allocated length of the arrays */
+  PetscInt    *rows, *cols;
+  PetscScalar *vals;
+} Mat_SeqAIJ_ThreadStash;
+
+/*
+   Level schedule of the triangular solves of a factored matrix, see aijthreads.c: the rows of level l of the forward (k = 0)
+   and backward (k = 1) substitutions, rows[k][lstart[k][l]] to rows[k][lstart[k][l+1]-1], depend only on rows of lower levels
+*/
+typedef struct {
+  PetscInt  nt;                  /* number of threads used by the solves */
+  PetscInt  nlevels[2];          /* number of levels of the forward and backward substitutions */
+  PetscInt *lstart[2], *rows[2]; /* rows of each level */
+  PetscInt *ti, *trow, *tpos;    /* ICC only, the nonzeros of column k of U are in rows trow[ti[k]:ti[k+1]] at positions tpos[] of a->j */
+} Mat_SeqAIJ_Levels;
+
+PETSC_INTERN PetscErrorCode MatSeqAIJLevelsDestroy(Mat_SeqAIJ_Levels **);
+
+/* Info about the thread row partition helper class for SeqAIJ, see aijthreads.c */
+typedef struct {
+  PetscInt                n;                /* number of threads used by the matrix kernels, set with -mat_aij_threads */
+  PetscInt               *rstart;           /* thread t processes rows [rstart[t], rstart[t+1]), balanced by the number of nonzeros */
+  PetscScalar            *work;             /* per-thread reduction buffers for MatMultTransposeAdd(), (n-1) times the number of columns */
+  PetscObjectState        mat_nonzerostate; /* nonzero state when the partition was computed */
+  PetscInt                nstash;           /* number of per-thread stashes, nonzero when MAT_THREAD_SAFE_ADD is set */
+  Mat_SeqAIJ_ThreadStash *stash;            /* stash[t] is only written by the thread with OpenMP thread number t */
+  Mat_SeqAIJ_Levels      *levels;           /* for factored matrices, level schedule of the triangular solves */
+  PetscBool               sor_multicolor;   /* MatSOR() sweeps the rows color by color, set with -mat_aij_sor_multicolor */
+  Mat_SeqAIJ_Levels      *colors;           /* rows of color c in rows[0][lstart[0][c]:lstart[0][c+1]], from a distance-1 coloring */
+  PetscObjectState        colorstate;       /* nonzero state when the coloring was computed */
+} Mat_SeqAIJ_Threads;
+
+PETSC_INTERN PetscErrorCode MatCreate_SeqAIJ_Threads(Mat);
+PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Threads(Mat);
+PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Threads(Mat, MatAssemblyType);
+PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ_Threads(Mat, MatOption, PetscBool);
+PETSC_INTERN PetscErrorCode MatCreateVecs_SeqAIJ_Threads(Mat, Vec *, Vec *);
+PETSC_INTERN PetscErrorCode MatSetValues_SeqAIJ_ThreadSafe(Mat, PetscInt, const PetscInt[], PetscInt, const PetscInt[], const PetscScalar[], InsertMode);
+PETSC_INTERN PetscErrorCode MatSeqAIJMergeThreadStash_Private(Mat);
+PETSC_INTERN PetscErrorCode MatMult_SeqAIJ_Threads(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_Threads(Mat, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ_Threads(Mat, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Threads(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
+PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Threads(Mat, Mat);
+PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ_Threads(Mat, Mat);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Threads(Mat, Vec, Vec);
+
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat, PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat, MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
@@ -148,8 +197,9 @@ PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat, PetscScalar **);
 
 typedef struct {
   SEQAIJHEADER(MatScalar);
-  Mat_SeqAIJ_Inode inode;
-  MatScalar       *saved_values; /* location for stashing nonzero values of matrix */
+  Mat_SeqAIJ_Inode   inode;
+  Mat_SeqAIJ_Threads threads;
+  MatScalar         *saved_values; /* location for stashing nonzero values of matrix */
 
   PetscScalar *idiag, *mdiag, *ssor_work; /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
   PetscBool    idiagvalid;                /* current idiag[] and mdiag[] are valid */
@@ -282,6 +332,7 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqAIJ_Inode(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTranspose_SeqAIJ(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
+PETSC_INTERN PetscErrorCode MatInvertDiagonal_SeqAIJ(Mat, PetscScalar, PetscScalar);
 PETSC_INTERN PetscErrorCode MatSOR_SeqAIJ_Inode(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
 
 PETSC_INTERN PetscErrorCode MatSetOption_SeqAIJ(Mat, MatOption, PetscBool);
@@ -407,6 +458,8 @@ PETSC_INTERN PetscErrorCode MatConvert_AIJ_ScaLAPACK(Mat, MatType, MatReuse, Mat
 #endif
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJPERM(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJCompressed(Mat, MatType, MatReuse, Mat *);
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMixed(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJSELL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMKL(Mat, MatType, MatReuse, Mat *);
 PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJViennaCL(Mat, MatType, MatReuse, Mat *);
@@ -0,0 +1,385 @@
+
+/*
+  Defines basic operations for the MATSEQAIJCOMPRESSED matrix class.
+  This class is derived from the MATSEQAIJ class and retains the
+  compressed row storage, but augments it with a copy of the column
+  indices stored as the first column of each row plus an 8 or 16 bit
+  offset for each nonzero. For matrices with a small bandwidth, for example
+  after a reordering with MATORDERINGRCM, this cuts the index traffic of
+  the bandwidth limited kernels by a factor two to eight.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <stdint.h>
+
+typedef struct {
+  PetscObjectState nonzerostate; /* used to determine if the nonzero structure has changed and hence the offsets need updating */
+  PetscInt         width;        /* bytes per column offset, 1 or 2, or 0 if the bandwidth is too large and the MATSEQAIJ kernels are used */
+  PetscInt        *base;         /* first column of each row */
+  void            *offset;       /* column minus base of each nonzero, uint8_t or uint16_t */
+} Mat_SeqAIJCompressed;
+
+/* dot product of n values v with x at the columns given by the offsets d[0..n) from x */
+#define MatSeqAIJCompressedDot(sum, x, v, d, n) \
+  do { \
+    for (PetscInt _k = 0; _k < (n); _k++) sum += (v)[_k] * (x)[(d)[_k]]; \
+  } while (0)
+
+static inline PetscScalar MatSeqAIJCompressedRowDot(const Mat_SeqAIJCompressed *c, const PetscScalar *x, const MatScalar *aa, PetscInt row, PetscInt start, PetscInt end)
+{
+  const PetscScalar *xb  = x + c->base[row];
+  PetscScalar        sum = 0.0;
+
+  if (c->width == 1) MatSeqAIJCompressedDot(sum, xb, aa + start, (const uint8_t *)c->offset + start, end - start);
+  else MatSeqAIJCompressedDot(sum, xb, aa + start, (const uint16_t *)c->offset + start, end - start);
+  return sum;
+}
+
+static PetscErrorCode MatSeqAIJCompressedDestroy_Private(Mat_SeqAIJCompressed *c)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscFree(c->base));
+  PetscCall(PetscFree(c->offset));
+  c->width = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSeqAIJCompressed_create_offsets(Mat A)
+{
+  Mat_SeqAIJ           *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJCompressed *c = (Mat_SeqAIJCompressed *)A->spptr;
+  PetscInt              m = A->rmap->n, nz = a->i[m], i, k, bw = 0;
+
+  PetscFunctionBegin;
+  if (c->nonzerostate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS); /* offsets exist and match current nonzero structure */
+  c->nonzerostate = A->nonzerostate;
+  PetscCall(MatSeqAIJCompressedDestroy_Private(c));
+
+  /* the columns of each row are sorted, so the largest offset is between the last and the first one */
+  for (i = 0; i < m; i++) {
+    if (a->i[i + 1] > a->i[i]) bw = PetscMax(bw, a->j[a->i[i + 1] - 1] - a->j[a->i[i]]);
+  }
+  if (bw > UINT16_MAX) {
+    PetscCall(PetscInfo(A, "Largest row bandwidth %" PetscInt_FMT " does not fit in 16 bits, using the MATSEQAIJ kernels\n", bw));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  c->width = bw > UINT8_MAX ? 2 : 1;
+  PetscCall(PetscMalloc1(m, &c->base));
+  PetscCall(PetscMalloc(nz * c->width, &c->offset));
+  for (i = 0; i < m; i++) {
+    c->base[i] = a->i[i + 1] > a->i[i] ? a->j[a->i[i]] : 0;
+    for (k = a->i[i]; k < a->i[i + 1]; k++) {
+      if (c->width == 1) ((uint8_t *)c->offset)[k] = (uint8_t)(a->j[k] - c->base[i]);
+      else ((uint16_t *)c->offset)[k] = (uint16_t)(a->j[k] - c->base[i]);
+    }
+  }
+  PetscCall(PetscInfo(A, "Column indices stored as %" PetscInt_FMT " bit offsets, largest row bandwidth %" PetscInt_FMT "\n", 8 * c->width, bw));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_SeqAIJCompressed(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ           *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJCompressed *c = (Mat_SeqAIJCompressed *)A->spptr;
+  const PetscScalar    *x;
+  PetscScalar          *y;
+  const MatScalar      *aa;
+  PetscInt              m = A->rmap->n, i;
+
+  PetscFunctionBegin;
+  if (!c->width) {
+    PetscCall(MatMult_SeqAIJ(A, xx, yy));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayWrite(yy, &y));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (i = 0; i < m; i++) y[i] = MatSeqAIJCompressedRowDot(c, x, aa, i, a->i[i], a->i[i + 1]);
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayWrite(yy, &y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJCompressed(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ           *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJCompressed *c = (Mat_SeqAIJCompressed *)A->spptr;
+  const PetscScalar    *x;
+  PetscScalar          *y, *z;
+  const MatScalar      *aa;
+  PetscInt              m = A->rmap->n, i;
+
+  PetscFunctionBegin;
+  if (!c->width) {
+    PetscCall(MatMultAdd_SeqAIJ(A, xx, yy, zz));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (i = 0; i < m; i++) z[i] = y[i] + MatSeqAIJCompressedRowDot(c, x, aa, i, a->i[i], a->i[i + 1]);
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Same as MatSOR_SeqAIJ() for the local forward, backward and symmetric sweeps, the other variants are passed to it
+*/
+static PetscErrorCode MatSOR_SeqAIJCompressed(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ           *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJCompressed *c = (Mat_SeqAIJCompressed *)A->spptr;
+  PetscScalar          *x, sum, *t;
+  const MatScalar      *idiag, *mdiag, *aa;
+  const PetscScalar    *b, *xb;
+  PetscInt              m = A->rmap->n, i;
+  const PetscInt       *diag, *ai = a->i;
+
+  PetscFunctionBegin;
+  if (!c->width || flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || (flag & SOR_EISENSTAT)) {
+    PetscCall(MatSOR_SeqAIJ(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  its = its * lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  /* We count flops by assuming the upper triangular and lower triangular parts have the same number of nonzeros */
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        sum  = b[i] - MatSeqAIJCompressedRowDot(c, x, aa, i, ai[i], diag[i]);
+        t[i] = sum;
+        x[i] = sum * idiag[i];
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        sum = xb[i] - MatSeqAIJCompressedRowDot(c, x, aa, i, diag[i] + 1, ai[i + 1]);
+        if (xb == b) {
+          x[i] = sum * idiag[i];
+        } else {
+          x[i] = (1 - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        sum  = b[i] - MatSeqAIJCompressedRowDot(c, x, aa, i, ai[i], diag[i]);
+        t[i] = sum; /* save application of the lower-triangular part */
+        sum -= MatSeqAIJCompressedRowDot(c, x, aa, i, diag[i] + 1, ai[i + 1]);
+        x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        if (xb == b) { /* whole matrix (no checkpointing available) */
+          sum  = b[i] - MatSeqAIJCompressedRowDot(c, x, aa, i, ai[i], ai[i + 1]);
+          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          sum  = xb[i] - MatSeqAIJCompressedRowDot(c, x, aa, i, diag[i] + 1, ai[i + 1]);
+          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        PetscCall(PetscLogFlops(2.0 * a->nz));
+      } else {
+        PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJCompressed(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* the kernels do not use inodes, so do not let MatAssemblyEnd_SeqAIJ() install its inode versions */
+  a->inode.use = PETSC_FALSE;
+  PetscCall(MatAssemblyEnd_SeqAIJ(A, mode));
+  PetscCall(MatSeqAIJCompressed_create_offsets(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJCompressed_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJCOMPRESSED to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat                   B = *newmat;
+  Mat_SeqAIJCompressed *c;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  c = (Mat_SeqAIJCompressed *)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->sor         = MatSOR_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijcompressed_seqaij_C", NULL));
+
+  PetscCall(MatSeqAIJCompressedDestroy_Private(c));
+  PetscCall(PetscFree(B->spptr));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJCompressed(Mat A)
+{
+  Mat_SeqAIJCompressed *c = (Mat_SeqAIJCompressed *)A->spptr;
+
+  PetscFunctionBegin;
+  if (c) { /* If MatHeaderMerge() was used then this matrix will not have a spptr. */
+    PetscCall(MatSeqAIJCompressedDestroy_Private(c));
+    PetscCall(PetscFree(A->spptr));
+  }
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijcompressed_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_SeqAIJCompressed(Mat A, MatDuplicateOption op, Mat *M)
+{
+  PetscFunctionBegin;
+  PetscCall(MatDuplicate_SeqAIJ(A, op, M));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJCompressed(*M, MATSEQAIJCOMPRESSED, MAT_INPLACE_MATRIX, M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJCompressed converts a SeqAIJ matrix into a
+ * SeqAIJCompressed matrix. This routine is called by the MatCreate_SeqAIJCompressed()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJCompressed one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJCompressed(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat                   B = *newmat;
+  Mat_SeqAIJCompressed *c;
+  PetscBool             sametype;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&c));
+  B->spptr = (void *)c;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJCompressed;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJCompressed;
+  B->ops->destroy     = MatDestroy_SeqAIJCompressed;
+  B->ops->mult        = MatMult_SeqAIJCompressed;
+  B->ops->multadd     = MatMultAdd_SeqAIJCompressed;
+  B->ops->sor         = MatSOR_SeqAIJCompressed;
+
+  c->nonzerostate = -1; /* this will trigger the generation of the offsets the first time through MatAssembly() */
+  /* If A has already been assembled, compute the offsets. The inode kernels may have been installed, so remove them. */
+  if (A->assembled) {
+    ((Mat_SeqAIJ *)B->data)->inode.use = PETSC_FALSE;
+    PetscCall(MatSeqAIJCompressed_create_offsets(B));
+  }
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijcompressed_seqaij_C", MatConvert_SeqAIJCompressed_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJCOMPRESSED));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATSEQAIJCOMPRESSED - "seqaijcompressed" - A sequential sparse matrix type that stores, in addition to the `MATSEQAIJ`
+   format, the column indices as the first column of each row plus one 8 or 16 bit offset per nonzero.
+
+   Options Database Key:
+. -mat_type seqaijcompressed - sets the matrix type to `MATSEQAIJCOMPRESSED` during a call to `MatSetFromOptions()`
+
+   Level: intermediate
+
+   Notes:
+   `MatMult()`, `MatMultAdd()` and `MatSOR()` read the offsets instead of the full column indices, which reduces their memory
+   traffic for matrices whose rows have a small bandwidth, for example after a reordering with `MATORDERINGRCM`. The offsets
+   use 8 bits if no row spans more than 256 columns, 16 bits if no row spans more than 65536 columns, otherwise the
+   `MATSEQAIJ` kernels are used.
+
+   All other operations are inherited from `MATSEQAIJ`. An assembled `MATSEQAIJ` matrix can be converted with `MatConvert()`.
+
+.seealso: [](chapter_matrices), `Mat`, `MatCreateSeqAIJCompressed()`, `MATSEQAIJ`, `MATSEQAIJPERM`, `MATSEQAIJSELL`, `MatConvert()`, `MatGetOrdering()`
+M*/
+
+/*@C
+   MatCreateSeqAIJCompressed - Creates a sparse matrix of type `MATSEQAIJCOMPRESSED`.
+   This type inherits from `MATSEQAIJ`, but also stores its column indices as a base
+   column per row and short offsets, which makes the bandwidth limited matrix-vector
+   product and relaxation faster for matrices with a small bandwidth.
+
+   Collective
+
+   Input Parameters:
++  comm - MPI communicator, set to `PETSC_COMM_SELF`
+.  m - number of rows
+.  n - number of columns
+.  nz - number of nonzeros per row (same for all rows), ignored if `nnz` is given
+-  nnz - array containing the number of nonzeros in the various rows (possibly different for each row) or `NULL`
+
+   Output Parameter:
+.  A - the matrix
+
+   Level: intermediate
+
+.seealso: [](chapter_matrices), `Mat`, `MATSEQAIJCOMPRESSED`, `MatCreate()`, `MatCreateSeqAIJ()`, `MatSetValues()`
+@*/
+PetscErrorCode MatCreateSeqAIJCompressed(MPI_Comm comm, PetscInt m, PetscInt n, PetscInt nz, const PetscInt nnz[], Mat *A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatCreate(comm, A));
+  PetscCall(MatSetSizes(*A, m, n, m, n));
+  PetscCall(MatSetType(*A, MATSEQAIJCOMPRESSED));
+  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(*A, nz, nnz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJCompressed(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJCompressed(A, MATSEQAIJCOMPRESSED, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
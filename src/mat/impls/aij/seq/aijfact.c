@@ -604,6 +604,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo *info
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
+  PetscCall(MatLUFactorNumeric_SeqAIJ_Threads(C, A));
 
   PetscCall(PetscLogFlops(C->cmap->n));
 
@@ -2150,6 +2151,7 @@ PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat B, Mat A, const MatFactorInfo
     B->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1;
     B->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1;
   }
+  PetscCall(MatCholeskyFactorNumeric_SeqAIJ_Threads(B, A));
 
   C->assembled    = PETSC_TRUE;
   C->preallocated = PETSC_TRUE;
@@ -0,0 +1,353 @@
+
+/*
+  Defines basic operations for the MATSEQAIJMIXED matrix class.
+  This class is derived from the MATSEQAIJ class, but maintains a "shadow"
+  copy of the matrix values in single precision, which is used by the
+  bandwidth limited MatMult(), MatMultAdd() and MatSOR(). The vectors and
+  all other operations remain in the precision of PetscScalar.
+*/
+
+#include <../src/mat/impls/aij/seq/aij.h>
+
+typedef float MatScalarSingle;
+
+typedef struct {
+  MatScalarSingle *a;     /* the values of the matrix rounded to single precision */
+  PetscInt         nz;    /* length of a */
+  PetscObjectState state; /* state of the matrix when the values were last rounded */
+} Mat_SeqAIJMixed;
+
+static inline PetscScalar MatSeqAIJMixedRowDot(const MatScalarSingle *v, const PetscInt *idx, const PetscScalar *x, PetscInt n)
+{
+  PetscScalar sum = 0.0;
+
+  for (PetscInt k = 0; k < n; k++) sum += (PetscScalar)v[k] * x[idx[k]];
+  return sum;
+}
+
+/* Round the values to single precision if and only if needed.
+ * We track the ObjectState to determine when this needs to be done. */
+static PetscErrorCode MatSeqAIJMixed_update_values(Mat A)
+{
+  Mat_SeqAIJ       *a     = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMixed  *mixed = (Mat_SeqAIJMixed *)A->spptr;
+  const MatScalar  *aa;
+  PetscObjectState  state;
+  PetscInt          nz = a->i[A->rmap->n];
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectStateGet((PetscObject)A, &state));
+  if (mixed->a && mixed->state == state) PetscFunctionReturn(PETSC_SUCCESS);
+
+  if (nz != mixed->nz || !mixed->a) {
+    PetscCall(PetscFree(mixed->a));
+    PetscCall(PetscMalloc1(nz, &mixed->a));
+    mixed->nz = nz;
+  }
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  for (PetscInt k = 0; k < nz; k++) mixed->a[k] = (MatScalarSingle)PetscRealPart(aa[k]);
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(PetscObjectStateGet((PetscObject)A, &mixed->state));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMult_SeqAIJMixed(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMixed   *mixed;
+  const PetscScalar *x;
+  PetscScalar       *y;
+  const PetscInt    *ai = a->i, *aj = a->j;
+  PetscInt           m  = A->rmap->n;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJMixed_update_values(A));
+  mixed = (Mat_SeqAIJMixed *)A->spptr;
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayWrite(yy, &y));
+  for (PetscInt i = 0; i < m; i++) y[i] = MatSeqAIJMixedRowDot(mixed->a + ai[i], aj + ai[i], x, ai[i + 1] - ai[i]);
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayWrite(yy, &y));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatMultAdd_SeqAIJMixed(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMixed   *mixed;
+  const PetscScalar *x;
+  PetscScalar       *y, *z;
+  const PetscInt    *ai = a->i, *aj = a->j;
+  PetscInt           m  = A->rmap->n;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJMixed_update_values(A));
+  mixed = (Mat_SeqAIJMixed *)A->spptr;
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  for (PetscInt i = 0; i < m; i++) z[i] = y[i] + MatSeqAIJMixedRowDot(mixed->a + ai[i], aj + ai[i], x, ai[i + 1] - ai[i]);
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Same as MatSOR_SeqAIJ() for the local forward, backward and symmetric sweeps, the other variants are passed to it.
+   The off-diagonal entries are read in single precision, the inverse of the diagonal is the one of MATSEQAIJ.
+*/
+static PetscErrorCode MatSOR_SeqAIJMixed(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqAIJMixed   *mixed;
+  PetscScalar       *x, sum, *t;
+  const MatScalar   *idiag, *mdiag;
+  MatScalarSingle   *v;
+  const PetscScalar *b, *xb;
+  PetscInt           m = A->rmap->n, i;
+  const PetscInt    *diag, *ai = a->i, *aj = a->j;
+
+  PetscFunctionBegin;
+  if (flag == SOR_APPLY_UPPER || flag == SOR_APPLY_LOWER || (flag & SOR_EISENSTAT)) {
+    PetscCall(MatSOR_SeqAIJ(A, bb, omega, flag, fshift, its, lits, xx));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(MatSeqAIJMixed_update_values(A));
+  mixed = (Mat_SeqAIJMixed *)A->spptr;
+  v     = mixed->a;
+  its   = its * lits;
+
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  /* We count flops by assuming the upper triangular and lower triangular parts have the same number of nonzeros */
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        sum  = b[i] - MatSeqAIJMixedRowDot(v + ai[i], aj + ai[i], x, diag[i] - ai[i]);
+        t[i] = sum;
+        x[i] = sum * idiag[i];
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        sum = xb[i] - MatSeqAIJMixedRowDot(v + diag[i] + 1, aj + diag[i] + 1, x, ai[i + 1] - diag[i] - 1);
+        if (xb == b) {
+          x[i] = sum * idiag[i];
+        } else {
+          x[i] = (1 - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i = 0; i < m; i++) {
+        sum  = b[i] - MatSeqAIJMixedRowDot(v + ai[i], aj + ai[i], x, diag[i] - ai[i]);
+        t[i] = sum; /* save application of the lower-triangular part */
+        sum -= MatSeqAIJMixedRowDot(v + diag[i] + 1, aj + diag[i] + 1, x, ai[i + 1] - diag[i] - 1);
+        x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+      }
+      xb = t;
+      PetscCall(PetscLogFlops(2.0 * a->nz));
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i = m - 1; i >= 0; i--) {
+        if (xb == b) { /* whole matrix (no checkpointing available) */
+          sum  = b[i] - MatSeqAIJMixedRowDot(v + ai[i], aj + ai[i], x, ai[i + 1] - ai[i]);
+          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          sum  = xb[i] - MatSeqAIJMixedRowDot(v + diag[i] + 1, aj + diag[i] + 1, x, ai[i + 1] - diag[i] - 1);
+          x[i] = (1. - omega) * x[i] + sum * idiag[i]; /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        PetscCall(PetscLogFlops(2.0 * a->nz));
+      } else {
+        PetscCall(PetscLogFlops(a->nz)); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJMixed(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(PETSC_SUCCESS);
+
+  /* the kernels do not use inodes, so do not let MatAssemblyEnd_SeqAIJ() install its inode versions */
+  a->inode.use = PETSC_FALSE;
+  PetscCall(MatAssemblyEnd_SeqAIJ(A, mode));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJMixed_SeqAIJ(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  /* This routine is only called to convert a MATSEQAIJMIXED to its base PETSc type, */
+  /* so we will ignore 'MatType type'. */
+  Mat              B = *newmat;
+  Mat_SeqAIJMixed *mixed;
+
+  PetscFunctionBegin;
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  mixed = (Mat_SeqAIJMixed *)B->spptr;
+
+  /* Reset the original function pointers. */
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJ;
+  B->ops->destroy     = MatDestroy_SeqAIJ;
+  B->ops->duplicate   = MatDuplicate_SeqAIJ;
+  B->ops->mult        = MatMult_SeqAIJ;
+  B->ops->multadd     = MatMultAdd_SeqAIJ;
+  B->ops->sor         = MatSOR_SeqAIJ;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijmixed_seqaij_C", NULL));
+
+  PetscCall(PetscFree(mixed->a));
+  PetscCall(PetscFree(B->spptr));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJ));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDestroy_SeqAIJMixed(Mat A)
+{
+  Mat_SeqAIJMixed *mixed = (Mat_SeqAIJMixed *)A->spptr;
+
+  PetscFunctionBegin;
+  if (mixed) { /* If MatHeaderMerge() was used then this matrix will not have a spptr. */
+    PetscCall(PetscFree(mixed->a));
+    PetscCall(PetscFree(A->spptr));
+  }
+  PetscCall(PetscObjectChangeTypeName((PetscObject)A, MATSEQAIJ));
+  PetscCall(PetscObjectComposeFunction((PetscObject)A, "MatConvert_seqaijmixed_seqaij_C", NULL));
+  PetscCall(MatDestroy_SeqAIJ(A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatDuplicate_SeqAIJMixed(Mat A, MatDuplicateOption op, Mat *M)
+{
+  PetscFunctionBegin;
+  PetscCall(MatDuplicate_SeqAIJ(A, op, M));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(*M, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, M));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* MatConvert_SeqAIJ_SeqAIJMixed converts a SeqAIJ matrix into a
+ * SeqAIJMixed matrix. This routine is called by the MatCreate_SeqAIJMixed()
+ * routine, but can also be used to convert an assembled SeqAIJ matrix
+ * into a SeqAIJMixed one. */
+PETSC_INTERN PetscErrorCode MatConvert_SeqAIJ_SeqAIJMixed(Mat A, MatType type, MatReuse reuse, Mat *newmat)
+{
+  Mat              B = *newmat;
+  Mat_SeqAIJMixed *mixed;
+  PetscBool        sametype;
+
+  PetscFunctionBegin;
+  PetscCheck(!PetscDefined(USE_COMPLEX), PetscObjectComm((PetscObject)A), PETSC_ERR_SUP, "MATSEQAIJMIXED is not supported for complex scalars");
+  if (reuse == MAT_INITIAL_MATRIX) PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &B));
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, type, &sametype));
+  if (sametype) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscNew(&mixed));
+  B->spptr = (void *)mixed;
+
+  /* Disable use of the inode routines so that the MATSEQAIJMIXED ones will be used instead.
+   * This happens in MatAssemblyEnd_SeqAIJMixed() as well, but the assembly end may not be called, so set it here, too. */
+  ((Mat_SeqAIJ *)B->data)->inode.use = PETSC_FALSE;
+
+  /* Set function pointers for methods that we inherit from AIJ but override. */
+  B->ops->duplicate   = MatDuplicate_SeqAIJMixed;
+  B->ops->assemblyend = MatAssemblyEnd_SeqAIJMixed;
+  B->ops->destroy     = MatDestroy_SeqAIJMixed;
+  B->ops->mult        = MatMult_SeqAIJMixed;
+  B->ops->multadd     = MatMultAdd_SeqAIJMixed;
+  B->ops->sor         = MatSOR_SeqAIJMixed;
+
+  PetscCall(PetscObjectComposeFunction((PetscObject)B, "MatConvert_seqaijmixed_seqaij_C", MatConvert_SeqAIJMixed_SeqAIJ));
+
+  PetscCall(PetscObjectChangeTypeName((PetscObject)B, MATSEQAIJMIXED));
+  *newmat = B;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*MC
+   MATSEQAIJMIXED - "seqaijmixed" - A sequential sparse matrix type that keeps, in addition to the `MATSEQAIJ` format,
+   a copy of its values in single precision, which is used by `MatMult()`, `MatMultAdd()` and `MatSOR()`.
+
+   Options Database Key:
+. -mat_type seqaijmixed - sets the matrix type to `MATSEQAIJMIXED` during a call to `MatSetFromOptions()`
+
+   Level: intermediate
+
+   Notes:
+   The vectors, the sums and the inverse of the diagonal used by `MatSOR()` remain in the precision of `PetscScalar`,
+   only the matrix entries are read in single precision, which roughly halves the memory traffic of the values in these
+   operations. This is intended for preconditioner matrices passed to, for example, `PCSOR` or the smoothers of `PCMG`
+   with `KSPSetOperators()`, where the rounding of the matrix entries does not affect the accuracy of the solution.
+
+   The single precision values are updated lazily, the first time one of these operations is called after the matrix has changed.
+   All other operations, such as `MatMultTranspose()` or `MatGetDiagonal()`, use the `MATSEQAIJ` values.
+
+   Only real scalars are supported.
+
+.seealso: [](chapter_matrices), `Mat`, `MATAIJMIXED`, `MATMPIAIJMIXED`, `MatCreateSeqAIJMixed()`, `MATSEQAIJ`, `MatConvert()`
+M*/
+
+/*@C
+   MatCreateSeqAIJMixed - Creates a sparse matrix of type `MATSEQAIJMIXED`.
+   This type inherits from `MATSEQAIJ`, but also keeps a single precision copy
+   of its values that is used by `MatMult()`, `MatMultAdd()` and `MatSOR()`.
+
+   Collective
+
+   Input Parameters:
++  comm - MPI communicator, set to `PETSC_COMM_SELF`
+.  m - number of rows
+.  n - number of columns
+.  nz - number of nonzeros per row (same for all rows), ignored if `nnz` is given
+-  nnz - array containing the number of nonzeros in the various rows (possibly different for each row) or `NULL`
+
+   Output Parameter:
+.  A - the matrix
+
+   Level: intermediate
+
+.seealso: [](chapter_matrices), `Mat`, `MATSEQAIJMIXED`, `MatCreateMPIAIJMixed()`, `MatCreate()`, `MatCreateSeqAIJ()`, `MatSetValues()`
+@*/
+PetscErrorCode MatCreateSeqAIJMixed(MPI_Comm comm, PetscInt m, PetscInt n, PetscInt nz, const PetscInt nnz[], Mat *A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatCreate(comm, A));
+  PetscCall(MatSetSizes(*A, m, n, m, n));
+  PetscCall(MatSetType(*A, MATSEQAIJMIXED));
+  PetscCall(MatSeqAIJSetPreallocation_SeqAIJ(*A, nz, nnz));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMixed(Mat A)
+{
+  PetscFunctionBegin;
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatConvert_SeqAIJ_SeqAIJMixed(A, MATSEQAIJMIXED, MAT_INPLACE_MATRIX, &A));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
@@ -0,0 +1,821 @@
+/*
+    Thread parallel matrix-vector products for the SeqAIJ matrix format.
+
+    The rows are split into contiguous chunks with about the same number of nonzeros, thread t always processes
+    chunk t so that, together with the first-touch placement of a->a and a->j done at assembly, the matrix entries
+    a thread streams through live on its own NUMA domain.
+
+    With MAT_THREAD_SAFE_ADD, MatSetValues() may be called concurrently by the OpenMP threads: values for entries
+    already in the nonzero pattern are added atomically in place, the other entries are kept in a stash owned by the
+    calling thread and merged into the matrix at MatAssemblyEnd().
+
+    The triangular solves of the LU/ILU and Cholesky/ICC factors are level scheduled: at each numeric factorization
+    the rows are grouped into levels such that a row only depends on rows of lower levels, the rows of one level are then
+    solved concurrently with a barrier between levels. The sums are accumulated in the same order as in the sequential
+    solves, so the results are identical.
+
+    With -mat_aij_sor_multicolor, MatSOR() relaxes the rows in the order of a distance-1 coloring of the graph of A + A^T:
+    the rows of one color are not coupled to each other and are relaxed concurrently, with a barrier between colors. This
+    is Gauss-Seidel/SOR in the multicolor ordering of the unknowns, not in the natural one, but the result does not
+    depend on the number of threads.
+*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/sbaij/seq/sbaij.h>
+#include <petsc/private/vecimpl.h>
+#if defined(PETSC_HAVE_OPENMP)
+  #include <omp.h>
+#endif
+
+PetscErrorCode MatCreate_SeqAIJ_Threads(Mat B)
+{
+  Mat_SeqAIJ *b = (Mat_SeqAIJ *)B->data;
+  PetscInt    n = 1;
+  PetscBool   flg;
+
+  PetscFunctionBegin;
+  b->threads.n                = 1;
+  b->threads.rstart           = NULL;
+  b->threads.work             = NULL;
+  b->threads.mat_nonzerostate = -1;
+  b->threads.nstash           = 0;
+  b->threads.stash            = NULL;
+  b->threads.levels           = NULL;
+  b->threads.sor_multicolor   = PETSC_FALSE;
+  b->threads.colors           = NULL;
+  b->threads.colorstate       = -1;
+
+  PetscOptionsBegin(PetscObjectComm((PetscObject)B), ((PetscObject)B)->prefix, "Options for SEQAIJ matrix", "Mat");
+  PetscCall(PetscOptionsInt("-mat_aij_threads", "Number of threads used in MatMult() and MatMultTranspose(), PETSC_DECIDE uses -omp_num_threads", NULL, n, &n, &flg));
+  PetscCall(PetscOptionsBool("-mat_aij_sor_multicolor", "Relax the rows color by color in MatSOR(), concurrently within a color", "MatSOR", b->threads.sor_multicolor, &b->threads.sor_multicolor, NULL));
+  PetscOptionsEnd();
+  if (flg) {
+#if defined(PETSC_HAVE_OPENMP)
+    if (n == PETSC_DECIDE) n = PetscNumOMPThreads;
+    PetscCheck(n >= 1, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of threads %" PetscInt_FMT " must be positive", n);
+    b->threads.n = n;
+    if (n > 1) B->ops->getvecs = MatCreateVecs_SeqAIJ_Threads;
+#else
+    if (n != 1) PetscCall(PetscInfo(B, "Ignoring -mat_aij_threads %" PetscInt_FMT " since PETSc was not configured with OpenMP\n", n));
+#endif
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatSeqAIJThreadStashDestroy_Private(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  for (PetscInt t = 0; t < a->threads.nstash; t++) PetscCall(PetscFree3(a->threads.stash[t].rows, a->threads.stash[t].cols, a->threads.stash[t].vals));
+  PetscCall(PetscFree(a->threads.stash));
+  a->threads.nstash = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatDestroy_SeqAIJ_Threads(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+
+  PetscFunctionBegin;
+  PetscCall(PetscFree(a->threads.rstart));
+  PetscCall(PetscFree(a->threads.work));
+  a->threads.mat_nonzerostate = -1;
+  PetscCall(MatSeqAIJThreadStashDestroy_Private(A));
+  PetscCall(MatSeqAIJLevelsDestroy(&a->threads.levels));
+  PetscCall(MatSeqAIJLevelsDestroy(&a->threads.colors));
+  a->threads.colorstate = -1;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Splits the rows into a->threads.n chunks of roughly equal cost, where the cost of a row is its number of nonzeros
+   plus one for the write of the result. Only recomputed when the nonzero structure changes.
+*/
+static PetscErrorCode MatSeqAIJThreadsSetUp_Private(Mat A, PetscBool *changed)
+{
+  Mat_SeqAIJ *a  = (Mat_SeqAIJ *)A->data;
+  PetscInt    nt = a->threads.n, m = A->rmap->n, r, t;
+  PetscCount  total;
+
+  PetscFunctionBegin;
+  if (changed) *changed = PETSC_FALSE;
+  if (a->threads.rstart && a->threads.mat_nonzerostate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!a->threads.rstart) PetscCall(PetscMalloc1(nt + 1, &a->threads.rstart));
+  PetscCall(PetscFree(a->threads.work));
+  total                = (PetscCount)a->i[m] + m;
+  a->threads.rstart[0] = 0;
+  for (r = 0, t = 1; r < m && t < nt; r++) {
+    while (t < nt && (PetscCount)a->i[r] + r >= (total * t) / nt) a->threads.rstart[t++] = r;
+  }
+  for (; t <= nt; t++) a->threads.rstart[t] = m;
+  a->threads.mat_nonzerostate = A->nonzerostate;
+  if (changed) *changed = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Moves a->a and a->j into freshly allocated arrays whose pages are first touched by the thread that will use them
+   in MatMult_SeqAIJ_Threads(). Only done for matrices that own their arrays, arrays provided by the user are left alone.
+*/
+static PetscErrorCode MatSeqAIJThreadsFirstTouch_Private(Mat A)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ *)A->data;
+  PetscInt         m = A->rmap->n, nt = a->threads.n, maxnz = a->maxnz, t;
+  const PetscInt  *rstart = a->threads.rstart, *ai, *aj = a->j;
+  const MatScalar *aa = a->a;
+  PetscInt        *new_i, *new_j;
+  MatScalar       *new_a;
+  PetscBool        isseqaij;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompare((PetscObject)A, MATSEQAIJ, &isseqaij));
+  if (!isseqaij || A->structure_only || !a->nz || a->parent) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!a->singlemalloc && !(a->free_a && a->free_ij)) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscMalloc1(maxnz, &new_a));
+  PetscCall(PetscMalloc1(maxnz, &new_j));
+  PetscCall(PetscMalloc1(m + 1, &new_i));
+  PetscCall(PetscArraycpy(new_i, a->i, m + 1));
+  ai = new_i;
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (t = 0; t < nt; t++) {
+    PetscInt k, kstart = ai[rstart[t]], kend = ai[rstart[t + 1]];
+
+    for (k = kstart; k < kend; k++) {
+      new_a[k] = aa[k];
+      new_j[k] = aj[k];
+    }
+  }
+  PetscCall(MatSeqXAIJFreeAIJ(A, &a->a, &a->j, &a->i));
+  a->a            = new_a;
+  a->j            = new_j;
+  a->i            = new_i;
+  a->singlemalloc = PETSC_FALSE;
+  a->free_a       = PETSC_TRUE;
+  a->free_ij      = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatAssemblyEnd_SeqAIJ_Threads(Mat A, MatAssemblyType mode)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+  PetscBool   changed;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY || a->threads.n <= 1) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatSeqAIJThreadsSetUp_Private(A, &changed));
+  if (changed) {
+    PetscCall(MatSeqAIJThreadsFirstTouch_Private(A));
+    PetscCall(PetscInfo(A, "Using %" PetscInt_FMT " threads for the matrix-vector products\n", a->threads.n));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatCreateVec_SeqAIJ_Threads_Private(Mat A, PetscLayout map, PetscInt bs, const PetscInt rstart[], Vec *v)
+{
+  PetscFunctionBegin;
+  PetscCall(VecCreate(PetscObjectComm((PetscObject)A), v));
+  PetscCall(VecSetSizes(*v, map->n, PETSC_DETERMINE));
+  PetscCall(VecSetBlockSize(*v, bs));
+  PetscCall(VecSetType(*v, A->defaultvectype));
+#if defined(PETSC_HAVE_VIENNACL) || defined(PETSC_HAVE_CUDA) || defined(PETSC_HAVE_HIP)
+  if (A->boundtocpu && A->bindingpropagates) {
+    PetscCall(VecSetBindingPropagates(*v, PETSC_TRUE));
+    PetscCall(VecBindToCPU(*v, PETSC_TRUE));
+  }
+#endif
+  PetscCall(PetscLayoutReference(map, &(*v)->map));
+  PetscCall(VecThreadsSetPartition_Private(*v, ((Mat_SeqAIJ *)A->data)->threads.n, rstart));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Like the default MatCreateVecs() but the vectors use the threads of the matrix and are split like its rows, so that a
+   thread applies the vector kernels to the entries its rows of MatMult() write and, for square matrices, mostly read.
+   The partition is only known once the matrix is assembled, before that the vectors are split into equal chunks.
+*/
+PetscErrorCode MatCreateVecs_SeqAIJ_Threads(Mat A, Vec *right, Vec *left)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ *)A->data;
+  const PetscInt *rstart;
+  PetscInt        rbs, cbs;
+
+  PetscFunctionBegin;
+  if (A->assembled && a->threads.n > 1) PetscCall(MatSeqAIJThreadsSetUp_Private(A, NULL));
+  rstart = A->assembled ? a->threads.rstart : NULL;
+  PetscCall(MatGetBlockSizes(A, &rbs, &cbs));
+  if (right) PetscCall(MatCreateVec_SeqAIJ_Threads_Private(A, A->cmap, cbs, A->cmap->n == A->rmap->n ? rstart : NULL, right));
+  if (left) PetscCall(MatCreateVec_SeqAIJ_Threads_Private(A, A->rmap, rbs, rstart, left));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMult_SeqAIJ_Threads(Mat A, Vec xx, Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  const PetscInt    *ai = a->i, *aj = a->j, *rstart;
+  const MatScalar   *a_a;
+  const PetscScalar *x;
+  PetscScalar       *y;
+  PetscInt           t, nt = a->threads.n;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJThreadsSetUp_Private(A, NULL));
+  rstart = a->threads.rstart;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayWrite(yy, &y));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (t = 0; t < nt; t++) {
+    PetscInt         i, n;
+    const PetscInt  *idx;
+    const MatScalar *aa;
+    PetscScalar      sum;
+
+    for (i = rstart[t]; i < rstart[t + 1]; i++) {
+      n   = ai[i + 1] - ai[i];
+      idx = aj + ai[i];
+      aa  = a_a + ai[i];
+      sum = 0.0;
+      PetscSparseDensePlusDot(sum, x, aa, idx, n);
+      y[i] = sum;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz - a->nonzerorowcnt));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayWrite(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultAdd_SeqAIJ_Threads(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  const PetscInt    *ai = a->i, *aj = a->j, *rstart;
+  const MatScalar   *a_a;
+  const PetscScalar *x;
+  PetscScalar       *y, *z;
+  PetscInt           t, nt = a->threads.n;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJThreadsSetUp_Private(A, NULL));
+  rstart = a->threads.rstart;
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (t = 0; t < nt; t++) {
+    PetscInt         i, n;
+    const PetscInt  *idx;
+    const MatScalar *aa;
+    PetscScalar      sum;
+
+    for (i = rstart[t]; i < rstart[t + 1]; i++) {
+      n   = ai[i + 1] - ai[i];
+      idx = aj + ai[i];
+      aa  = a_a + ai[i];
+      sum = y[i];
+      PetscSparseDensePlusDot(sum, x, aa, idx, n);
+      z[i] = sum;
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Thread 0 accumulates directly into y, the other threads into their own zeroed buffer in a->threads.work;
+   the buffers are then summed into y with the columns split among the threads.
+*/
+PetscErrorCode MatMultTransposeAdd_SeqAIJ_Threads(Mat A, Vec xx, Vec zz, Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  const PetscInt    *ai = a->i, *aj = a->j, *rstart;
+  const MatScalar   *a_a;
+  const PetscScalar *x;
+  PetscScalar       *y, *work;
+  PetscInt           nt = a->threads.n, n = A->cmap->n;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJThreadsSetUp_Private(A, NULL));
+  rstart = a->threads.rstart;
+  if (!a->threads.work) PetscCall(PetscMalloc1((nt - 1) * n, &a->threads.work));
+  work = a->threads.work;
+  if (zz != yy) PetscCall(VecCopy(zz, yy));
+  PetscCall(MatSeqAIJGetArrayRead(A, &a_a));
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArray(yy, &y));
+  PetscPragmaOMP(parallel num_threads(nt))
+  {
+    PetscInt     tid = 0, nth = 1, t, i, j, s;
+    PetscScalar *w, alpha;
+
+#if defined(PETSC_HAVE_OPENMP)
+    tid = omp_get_thread_num();
+    nth = omp_get_num_threads();
+#endif
+    w = tid ? work + (tid - 1) * n : y;
+    if (tid) {
+      for (j = 0; j < n; j++) w[j] = 0.0;
+    }
+    for (t = tid; t < nt; t += nth) {
+      for (i = rstart[t]; i < rstart[t + 1]; i++) {
+        alpha = x[i];
+        for (j = ai[i]; j < ai[i + 1]; j++) w[aj[j]] += alpha * a_a[j];
+      }
+    }
+    PetscPragmaOMP(barrier)
+    PetscPragmaOMP(for schedule(static))
+    for (j = 0; j < n; j++) {
+      for (s = 0; s < nth - 1; s++) y[j] += work[s * n + j];
+    }
+  }
+  PetscCall(PetscLogFlops(2.0 * a->nz));
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArray(yy, &y));
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &a_a));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatSetOption_SeqAIJ_Threads(Mat A, MatOption op, PetscBool flg)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+  PetscBool   isseqaij;
+
+  PetscFunctionBegin;
+  PetscCheck(op == MAT_THREAD_SAFE_ADD, PETSC_COMM_SELF, PETSC_ERR_SUP, "Unknown option %d", op);
+  if (flg) {
+    PetscInt n = 1;
+
+    PetscCall(PetscObjectTypeCompare((PetscObject)A, MATSEQAIJ, &isseqaij));
+    PetscCheck(isseqaij, PETSC_COMM_SELF, PETSC_ERR_SUP, "MAT_THREAD_SAFE_ADD is not supported for matrix type %s", ((PetscObject)A)->type_name);
+    PetscCheck(!A->structure_only, PETSC_COMM_SELF, PETSC_ERR_SUP, "MAT_THREAD_SAFE_ADD is not supported with MAT_STRUCTURE_ONLY");
+#if defined(PETSC_HAVE_OPENMP)
+    PetscCheck(!omp_in_parallel(), PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "MAT_THREAD_SAFE_ADD must be set outside of an OpenMP parallel region");
+    n = omp_get_max_threads();
+#endif
+    if (a->threads.nstash < n) {
+      PetscCall(MatSeqAIJMergeThreadStash_Private(A));
+      PetscCall(MatSeqAIJThreadStashDestroy_Private(A));
+      PetscCall(PetscCalloc1(n, &a->threads.stash));
+      a->threads.nstash = n;
+    }
+    A->ops->setvalues = MatSetValues_SeqAIJ_ThreadSafe;
+    PetscCall(PetscInfo(A, "Thread safe MatSetValues() with ADD_VALUES for up to %" PetscInt_FMT " threads\n", n));
+  } else {
+    PetscCall(MatSeqAIJMergeThreadStash_Private(A));
+    PetscCall(MatSeqAIJThreadStashDestroy_Private(A));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static inline void MatSeqAIJAtomicAdd_Private(MatScalar *a, PetscScalar v)
+{
+#if defined(PETSC_USE_COMPLEX)
+  PetscReal *ar = (PetscReal *)a;
+
+  PetscPragmaOMP(atomic update)
+  ar[0] += PetscRealPart(v);
+  PetscPragmaOMP(atomic update)
+  ar[1] += PetscImaginaryPart(v);
+#else
+  PetscPragmaOMP(atomic update)
+  *a += v;
+#endif
+}
+
+static PetscErrorCode MatSeqAIJThreadStashGrow_Private(Mat_SeqAIJ_ThreadStash *stash)
+{
+  PetscInt     size = PetscMax(2 * stash->size, 1024);
+  PetscInt    *rows, *cols;
+  PetscScalar *vals;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc3(size, &rows, size, &cols, size, &vals));
+  PetscCall(PetscArraycpy(rows, stash->rows, stash->n));
+  PetscCall(PetscArraycpy(cols, stash->cols, stash->n));
+  PetscCall(PetscArraycpy(vals, stash->vals, stash->n));
+  PetscCall(PetscFree3(stash->rows, stash->cols, stash->vals));
+  stash->rows = rows;
+  stash->cols = cols;
+  stash->vals = vals;
+  stash->size = size;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   The nonzero pattern (a->i, a->j and a->ilen) is only read here, so any number of threads may add values at the
+   same time. Only growing a stash, which allocates memory, is serialized.
+*/
+PetscErrorCode MatSetValues_SeqAIJ_ThreadSafe(Mat A, PetscInt m, const PetscInt im[], PetscInt n, const PetscInt in[], const PetscScalar v[], InsertMode is)
+{
+  Mat_SeqAIJ             *a  = (Mat_SeqAIJ *)A->data;
+  const PetscInt         *ai = a->i, *aj = a->j, *ailen = a->ilen;
+  MatScalar              *aa = a->a;
+  Mat_SeqAIJ_ThreadStash *stash;
+  PetscInt                k, l, row, col, low, high, t, tid = 0;
+  PetscScalar             value = 0.0;
+
+  PetscFunctionBegin;
+  PetscCheck(is == ADD_VALUES, PETSC_COMM_SELF, PETSC_ERR_SUP, "Only ADD_VALUES is supported with MAT_THREAD_SAFE_ADD");
+#if defined(PETSC_HAVE_OPENMP)
+  tid = omp_get_thread_num();
+#endif
+  PetscCheck(tid < a->threads.nstash, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Thread %" PetscInt_FMT " beyond the %" PetscInt_FMT " threads available when MAT_THREAD_SAFE_ADD was set", tid, a->threads.nstash);
+  stash = &a->threads.stash[tid];
+  for (k = 0; k < m; k++) { /* loop over added rows */
+    row = im[k];
+    if (row < 0) continue;
+    PetscCheck(row < A->rmap->n, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Row too large: row %" PetscInt_FMT " max %" PetscInt_FMT, row, A->rmap->n - 1);
+    for (l = 0; l < n; l++) { /* loop over added columns */
+      col = in[l];
+      if (col < 0) continue;
+      PetscCheck(col < A->cmap->n, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Column too large: col %" PetscInt_FMT " max %" PetscInt_FMT, col, A->cmap->n - 1);
+      if (v) value = a->roworiented ? v[l + k * n] : v[k + l * m];
+      if (value == 0.0 && a->ignorezeroentries && row != col) continue;
+
+      low  = ai[row];
+      high = ai[row] + ailen[row];
+      while (high - low > 5) {
+        t = (low + high) / 2;
+        if (aj[t] > col) high = t;
+        else low = t;
+      }
+      for (t = low; t < high; t++) {
+        if (aj[t] >= col) break;
+      }
+      if (t < high && aj[t] == col) {
+        MatSeqAIJAtomicAdd_Private(aa + t, value);
+        continue;
+      }
+      if (a->nonew == 1) continue;
+      PetscCheck(a->nonew != -1, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Inserting a new nonzero at (%" PetscInt_FMT ",%" PetscInt_FMT ") in the matrix", row, col);
+      if (stash->n == stash->size) {
+        PetscErrorCode ierr;
+
+        PetscPragmaOMP(critical(MatSeqAIJThreadStash))
+        ierr = MatSeqAIJThreadStashGrow_Private(stash);
+        PetscCall(ierr);
+      }
+      stash->rows[stash->n] = row;
+      stash->cols[stash->n] = col;
+      stash->vals[stash->n] = value;
+      stash->n++;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Adds the stashed entries of all the threads with the regular MatSetValues_SeqAIJ(), which may allocate new nonzeros */
+PetscErrorCode MatSeqAIJMergeThreadStash_Private(Mat A)
+{
+  Mat_SeqAIJ *a = (Mat_SeqAIJ *)A->data;
+  PetscInt    t, k, nstashed = 0;
+
+  PetscFunctionBegin;
+  for (t = 0; t < a->threads.nstash; t++) {
+    Mat_SeqAIJ_ThreadStash *stash = &a->threads.stash[t];
+
+    for (k = 0; k < stash->n; k++) PetscCall(MatSetValues_SeqAIJ(A, 1, &stash->rows[k], 1, &stash->cols[k], &stash->vals[k], ADD_VALUES));
+    nstashed += stash->n;
+    stash->n = 0;
+  }
+  if (nstashed) PetscCall(PetscInfo(A, "Merged %" PetscInt_FMT " stashed entries outside the nonzero pattern\n", nstashed));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatSeqAIJLevelsDestroy(Mat_SeqAIJ_Levels **levels)
+{
+  PetscFunctionBegin;
+  if (!*levels) PetscFunctionReturn(PETSC_SUCCESS);
+  for (PetscInt k = 0; k < 2; k++) PetscCall(PetscFree2((*levels)->lstart[k], (*levels)->rows[k]));
+  PetscCall(PetscFree3((*levels)->ti, (*levels)->trow, (*levels)->tpos));
+  PetscCall(PetscFree(*levels));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Groups the rows by level, level[i] is the level of row i, rows of the same level are kept in increasing order */
+static PetscErrorCode MatSeqAIJLevelsBucket_Private(Mat_SeqAIJ_Levels *levels, PetscInt k, PetscInt n, const PetscInt level[])
+{
+  PetscInt nlevels = 0, i, *lstart, *rows;
+
+  PetscFunctionBegin;
+  for (i = 0; i < n; i++) nlevels = PetscMax(nlevels, level[i] + 1);
+  PetscCall(PetscFree2(levels->lstart[k], levels->rows[k]));
+  PetscCall(PetscCalloc2(nlevels + 1, &levels->lstart[k], n, &levels->rows[k]));
+  lstart = levels->lstart[k];
+  rows   = levels->rows[k];
+  for (i = 0; i < n; i++) lstart[level[i] + 1]++;
+  for (i = 0; i < nlevels; i++) lstart[i + 1] += lstart[i];
+  for (i = 0; i < n; i++) rows[lstart[level[i]]++] = i;
+  for (i = nlevels; i > 0; i--) lstart[i] = lstart[i - 1];
+  lstart[0]          = 0;
+  levels->nlevels[k] = nlevels;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Computes the level schedule of the solves of the LU factor B of A when A uses several threads and switches B to the
+   threaded solve. The L part of row i is in bj[bi[i]:bi[i+1]], the U part, without the diagonal, in bj[bdiag[i+1]+1:bdiag[i]].
+*/
+PetscErrorCode MatLUFactorNumeric_SeqAIJ_Threads(Mat B, Mat A)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data, *b = (Mat_SeqAIJ *)B->data;
+  const PetscInt     n = B->rmap->n, *bi = b->i, *bj = b->j, *bdiag = b->diag;
+  Mat_SeqAIJ_Levels *levels;
+  PetscInt          *level, i, j, lev;
+
+  PetscFunctionBegin;
+  if (a->threads.n <= 1 || !n) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!b->threads.levels) PetscCall(PetscNew(&b->threads.levels));
+  levels     = b->threads.levels;
+  levels->nt = a->threads.n;
+  PetscCall(PetscMalloc1(n, &level));
+  for (i = 0; i < n; i++) {
+    for (lev = 0, j = bi[i]; j < bi[i + 1]; j++) lev = PetscMax(lev, level[bj[j]] + 1);
+    level[i] = lev;
+  }
+  PetscCall(MatSeqAIJLevelsBucket_Private(levels, 0, n, level));
+  for (i = n - 1; i >= 0; i--) {
+    for (lev = 0, j = bdiag[i + 1] + 1; j < bdiag[i]; j++) lev = PetscMax(lev, level[bj[j]] + 1);
+    level[i] = lev;
+  }
+  PetscCall(MatSeqAIJLevelsBucket_Private(levels, 1, n, level));
+  PetscCall(PetscFree(level));
+  B->ops->solve = MatSolve_SeqAIJ_Threads;
+  PetscCall(PetscInfo(B, "Level scheduled solves with %" PetscInt_FMT " threads, %" PetscInt_FMT " forward and %" PetscInt_FMT " backward levels for %" PetscInt_FMT " rows\n", levels->nt, levels->nlevels[0], levels->nlevels[1], n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatSolve_SeqAIJ_Threads(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqAIJ              *a      = (Mat_SeqAIJ *)A->data;
+  const Mat_SeqAIJ_Levels *levels = a->threads.levels;
+  const PetscInt           n = A->rmap->n, *ai = a->i, *aj = a->j, *adiag = a->diag;
+  const PetscInt          *r, *c;
+  const MatScalar         *aa = a->a;
+  const PetscScalar       *b;
+  PetscScalar             *x, *tmp = a->solve_work;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArrayWrite(xx, &x));
+  PetscCall(ISGetIndices(a->row, &r));
+  PetscCall(ISGetIndices(a->col, &c));
+  PetscPragmaOMP(parallel num_threads(levels->nt))
+  {
+    PetscInt         l, p, i, nz;
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscScalar      sum;
+
+    /* forward solve the lower triangular */
+    for (l = 0; l < levels->nlevels[0]; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (p = levels->lstart[0][l]; p < levels->lstart[0][l + 1]; p++) {
+        i   = levels->rows[0][p];
+        nz  = ai[i + 1] - ai[i];
+        v   = aa + ai[i];
+        vi  = aj + ai[i];
+        sum = b[r[i]];
+        PetscSparseDenseMinusDot(sum, tmp, v, vi, nz);
+        tmp[i] = sum;
+      }
+    }
+    /* backward solve the upper triangular */
+    for (l = 0; l < levels->nlevels[1]; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (p = levels->lstart[1][l]; p < levels->lstart[1][l + 1]; p++) {
+        i   = levels->rows[1][p];
+        v   = aa + adiag[i + 1] + 1;
+        vi  = aj + adiag[i + 1] + 1;
+        nz  = adiag[i] - adiag[i + 1] - 1;
+        sum = tmp[i];
+        PetscSparseDenseMinusDot(sum, tmp, v, vi, nz);
+        x[c[i]] = tmp[i] = sum * v[nz]; /* v[nz] = aa[adiag[i]] */
+      }
+    }
+  }
+  PetscCall(ISRestoreIndices(a->row, &r));
+  PetscCall(ISRestoreIndices(a->col, &c));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArrayWrite(xx, &x));
+  PetscCall(PetscLogFlops(2.0 * a->nz - A->cmap->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Same as MatLUFactorNumeric_SeqAIJ_Threads() for the Cholesky factor B, in MATSEQSBAIJ format, of A. Row k of U is
+   stored in bj[bi[k]:bi[k+1]-1] followed by the inverse of the diagonal entry. The forward substitution with U^T
+   gathers along the columns of U, whose structure is computed here.
+*/
+PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ_Threads(Mat B, Mat A)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ *)A->data;
+  Mat_SeqSBAIJ      *b = (Mat_SeqSBAIJ *)B->data;
+  const PetscInt     n = B->rmap->n, *bi = b->i, *bj = b->j;
+  Mat_SeqAIJ_Levels *levels;
+  PetscInt          *level, *ti, *trow, *tpos, j, k, lev;
+
+  PetscFunctionBegin;
+  if (a->threads.n <= 1 || !n) PetscFunctionReturn(PETSC_SUCCESS);
+  if (!b->levels) PetscCall(PetscNew(&b->levels));
+  levels     = b->levels;
+  levels->nt = a->threads.n;
+  PetscCall(PetscFree3(levels->ti, levels->trow, levels->tpos));
+  PetscCall(PetscCalloc3(n + 1, &levels->ti, bi[n] - n, &levels->trow, bi[n] - n, &levels->tpos));
+  ti   = levels->ti;
+  trow = levels->trow;
+  tpos = levels->tpos;
+  for (k = 0; k < n; k++) {
+    for (j = bi[k]; j < bi[k + 1] - 1; j++) ti[bj[j] + 1]++;
+  }
+  for (k = 0; k < n; k++) ti[k + 1] += ti[k];
+  for (k = 0; k < n; k++) { /* rows in increasing order in each column, the order in which MatSolve_SeqSBAIJ_1() adds them */
+    for (j = bi[k]; j < bi[k + 1] - 1; j++) {
+      trow[ti[bj[j]]]   = k;
+      tpos[ti[bj[j]]++] = j;
+    }
+  }
+  for (k = n; k > 0; k--) ti[k] = ti[k - 1];
+  ti[0] = 0;
+
+  PetscCall(PetscMalloc1(n, &level));
+  for (k = 0; k < n; k++) {
+    for (lev = 0, j = ti[k]; j < ti[k + 1]; j++) lev = PetscMax(lev, level[trow[j]] + 1);
+    level[k] = lev;
+  }
+  PetscCall(MatSeqAIJLevelsBucket_Private(levels, 0, n, level));
+  for (k = n - 1; k >= 0; k--) {
+    for (lev = 0, j = bi[k]; j < bi[k + 1] - 1; j++) lev = PetscMax(lev, level[bj[j]] + 1);
+    level[k] = lev;
+  }
+  PetscCall(MatSeqAIJLevelsBucket_Private(levels, 1, n, level));
+  PetscCall(PetscFree(level));
+  B->ops->solve          = MatSolve_SeqSBAIJ_1_Threads;
+  B->ops->solvetranspose = MatSolve_SeqSBAIJ_1_Threads;
+  PetscCall(PetscInfo(B, "Level scheduled solves with %" PetscInt_FMT " threads, %" PetscInt_FMT " forward and %" PetscInt_FMT " backward levels for %" PetscInt_FMT " rows\n", levels->nt, levels->nlevels[0], levels->nlevels[1], n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatSolve_SeqSBAIJ_1_Threads(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqSBAIJ            *a      = (Mat_SeqSBAIJ *)A->data;
+  const Mat_SeqAIJ_Levels *levels = a->levels;
+  const PetscInt           mbs = a->mbs, *ai = a->i, *aj = a->j, *adiag = a->diag;
+  const PetscInt          *ti = levels->ti, *trow = levels->trow, *tpos = levels->tpos, *rp;
+  const MatScalar         *aa = a->a;
+  const PetscScalar       *b;
+  PetscScalar             *x, *t = a->solve_work;
+
+  PetscFunctionBegin;
+  if (!mbs) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(ISGetIndices(a->row, &rp));
+  PetscPragmaOMP(parallel num_threads(levels->nt))
+  {
+    PetscInt         l, p, k, j, nz;
+    const PetscInt  *vj;
+    const MatScalar *v;
+    PetscScalar      sum;
+
+    /* solve U^T*y = perm(b) by forward substitution, the scaling by D^{-1} is applied in the backward substitution */
+    for (l = 0; l < levels->nlevels[0]; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (p = levels->lstart[0][l]; p < levels->lstart[0][l + 1]; p++) {
+        k   = levels->rows[0][p];
+        sum = b[rp[k]];
+        for (j = ti[k]; j < ti[k + 1]; j++) sum += aa[tpos[j]] * t[trow[j]];
+        t[k] = sum;
+      }
+    }
+    /* solve U*perm(x) = D^{-1}*y by back substitution */
+    for (l = 0; l < levels->nlevels[1]; l++) {
+      PetscPragmaOMP(for schedule(static))
+      for (p = levels->lstart[1][l]; p < levels->lstart[1][l + 1]; p++) {
+        k   = levels->rows[1][p];
+        v   = aa + adiag[k] - 1;
+        vj  = aj + adiag[k] - 1;
+        nz  = ai[k + 1] - ai[k] - 1;
+        sum = t[k] * aa[adiag[k]];
+        for (j = 0; j < nz; j++) sum += v[-j] * t[vj[-j]];
+        x[rp[k]] = t[k] = sum;
+      }
+    }
+  }
+  PetscCall(ISRestoreIndices(a->row, &rp));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(PetscLogFlops(4.0 * a->nz - 3.0 * mbs));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Groups the rows by color for MatSOR_SeqAIJ_Threads(), with a greedy distance-1 coloring of the graph of A + A^T so that
+   the rows of one color do not reference each other. Only recomputed when the nonzero structure changes.
+*/
+static PetscErrorCode MatSeqAIJThreadsColor_Private(Mat A)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ *)A->data;
+  Mat                    G = A;
+  MatColoring            mc;
+  ISColoring             iscoloring;
+  const ISColoringValue *colors;
+  PetscInt               n, nc, i, *color;
+  PetscBool              set, flg;
+
+  PetscFunctionBegin;
+  if (a->threads.colors && a->threads.colorstate == A->nonzerostate) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(MatIsStructurallySymmetricKnown(A, &set, &flg));
+  if (!set || !flg) {
+    PetscCall(MatTranspose(A, MAT_INITIAL_MATRIX, &G));
+    PetscCall(MatAXPY(G, 1.0, A, DIFFERENT_NONZERO_PATTERN));
+  }
+  PetscCall(MatColoringCreate(G, &mc));
+  PetscCall(MatColoringSetType(mc, MATCOLORINGGREEDY));
+  PetscCall(MatColoringSetDistance(mc, 1));
+  PetscCall(MatColoringSetWeightType(mc, MAT_COLORING_WEIGHT_LEXICAL));
+  PetscCall(MatColoringApply(mc, &iscoloring));
+  PetscCall(MatColoringDestroy(&mc));
+  if (G != A) PetscCall(MatDestroy(&G));
+
+  PetscCall(ISColoringGetColors(iscoloring, &n, &nc, &colors));
+  PetscCall(PetscMalloc1(n, &color));
+  for (i = 0; i < n; i++) color[i] = colors[i];
+  if (!a->threads.colors) PetscCall(PetscNew(&a->threads.colors));
+  a->threads.colors->nt = a->threads.n;
+  PetscCall(MatSeqAIJLevelsBucket_Private(a->threads.colors, 0, n, color));
+  PetscCall(PetscFree(color));
+  PetscCall(ISColoringDestroy(&iscoloring));
+  a->threads.colorstate = A->nonzerostate;
+  PetscCall(PetscInfo(A, "Multicolor SOR with %" PetscInt_FMT " threads, %" PetscInt_FMT " colors for %" PetscInt_FMT " rows\n", a->threads.n, a->threads.colors->nlevels[0], n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Forward and backward SOR sweeps in the multicolor ordering, see the top of this file. Since the rows of a color are not
+   coupled, updating x in place gives the same result as the sequential sweep of the permuted matrix. The Eisenstat and
+   SOR_APPLY_UPPER variants are handled by MatSOR_SeqAIJ() in the natural ordering.
+*/
+PetscErrorCode MatSOR_SeqAIJ_Threads(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqAIJ              *a = (Mat_SeqAIJ *)A->data;
+  const Mat_SeqAIJ_Levels *colors;
+  const PetscInt          *ai = a->i, *aj = a->j;
+  const MatScalar         *aa, *idiag, *mdiag;
+  const PetscScalar       *b;
+  PetscScalar             *x;
+  const PetscBool          forward  = (flag & (SOR_FORWARD_SWEEP | SOR_LOCAL_FORWARD_SWEEP)) ? PETSC_TRUE : PETSC_FALSE;
+  const PetscBool          backward = (flag & (SOR_BACKWARD_SWEEP | SOR_LOCAL_BACKWARD_SWEEP)) ? PETSC_TRUE : PETSC_FALSE;
+
+  PetscFunctionBegin;
+  PetscCall(MatSeqAIJThreadsColor_Private(A));
+  colors = a->threads.colors;
+  its    = its * lits;
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) PetscCall(MatInvertDiagonal_SeqAIJ(A, omega, fshift));
+  a->fshift = fshift;
+  a->omega  = omega;
+  idiag     = a->idiag;
+  mdiag     = a->mdiag;
+
+  if (flag & SOR_ZERO_INITIAL_GUESS) PetscCall(VecSet(xx, 0.0));
+  PetscCall(MatSeqAIJGetArrayRead(A, &aa));
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscPragmaOMP(parallel num_threads(colors->nt))
+  {
+    const PetscInt   nc = colors->nlevels[0], *lstart = colors->lstart[0], *rows = colors->rows[0];
+    PetscInt         k, s, c, p, i, nz;
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscScalar      sum;
+
+    for (k = 0; k < its; k++) {
+      /* colors 0 to nc-1 for the forward sweep, then nc-1 to 0 for the backward sweep */
+      for (s = 0; s < 2 * nc; s++) {
+        if (s < nc ? !forward : !backward) continue;
+        c = s < nc ? s : 2 * nc - 1 - s;
+        PetscPragmaOMP(for schedule(static))
+        for (p = lstart[c]; p < lstart[c + 1]; p++) {
+          i   = rows[p];
+          nz  = ai[i + 1] - ai[i];
+          v   = aa + ai[i];
+          vi  = aj + ai[i];
+          sum = b[i];
+          PetscSparseDenseMinusDot(sum, x, v, vi, nz);
+          x[i] = (1. - omega) * x[i] + (sum + mdiag[i] * x[i]) * idiag[i]; /* omega in idiag */
+        }
+      }
+    }
+  }
+  PetscCall(MatSeqAIJRestoreArrayRead(A, &aa));
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(PetscLogFlops(2.0 * a->nz * its * ((forward ? 1 : 0) + (backward ? 1 : 0))));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
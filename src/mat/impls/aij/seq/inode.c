@@ -1947,6 +1947,7 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B, Mat A, const MatFactorInfo
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
+  PetscCall(MatLUFactorNumeric_SeqAIJ_Threads(C, A));
 
   PetscCall(PetscLogFlops(C->cmap->n));
 
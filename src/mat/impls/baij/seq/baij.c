@@ -767,7 +767,7 @@ PetscErrorCode MatSOR_SeqBAIJ(Mat A, Vec bb, PetscReal omega, MatSORType flag, P
         s[4] = xb[i2 + 4];
         s[5] = xb[i2 + 5];
         s[6] = xb[i2 + 6];
-        PetscKernel_v_gets_A_times_w_7(x, idiag, b);
+        PetscKernel_v_gets_A_times_w_7(xw, idiag, s);
         x[i2]     = xw[0];
         x[i2 + 1] = xw[1];
         x[i2 + 2] = xw[2];
@@ -3271,8 +3271,23 @@ PetscErrorCode MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B, PetscInt bs, PetscInt n
     }
   }
   B->ops->sor = MatSOR_SeqBAIJ;
-  b->mbs      = mbs;
-  b->nbs      = nbs;
+  if (!flg && bs >= 2 && bs <= 8) {
+    PetscBool avx2 = PETSC_FALSE;
+
+    PetscCall(PetscOptionsGetBool(NULL, ((PetscObject)B)->prefix, "-mat_baij_avx2", &avx2, NULL));
+    if (avx2) {
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+      B->ops->mult    = MatMult_SeqBAIJ_N_AVX2;
+      B->ops->multadd = MatMultAdd_SeqBAIJ_N_AVX2;
+      B->ops->sor     = MatSOR_SeqBAIJ_N_AVX2;
+      PetscCall(PetscInfo((PetscObject)B, "Using AVX2 for MatMult and MatSOR for BAIJ for blocksize %" PetscInt_FMT "\n", bs));
+#else
+      PetscCall(PetscInfo((PetscObject)B, "AVX2 BAIJ kernels not available, PETSc must be compiled with -mavx2 -mfma and double precision real scalars\n"));
+#endif
+    }
+  }
+  b->mbs = mbs;
+  b->nbs = nbs;
   if (!skipallocation) {
     if (!b->imax) {
       PetscCall(PetscMalloc2(mbs, &b->imax, mbs, &b->ilen));
@@ -3434,7 +3449,9 @@ PetscErrorCode MatSeqBAIJRestoreArray(Mat A, PetscScalar **array)
 
    Options Database Keys:
 + -mat_type seqbaij - sets the matrix type to `MATSEQBAIJ` during a call to `MatSetFromOptions()`
-- -mat_baij_mult_version version - indicate the version of the matrix-vector product to use (0 often indicates using BLAS)
+. -mat_baij_mult_version version - indicate the version of the matrix-vector product to use (0 often indicates using BLAS)
+- -mat_baij_avx2 - use the AVX2 kernels for `MatMult()`, `MatMultAdd()`, `MatSOR()` and, with the natural ordering, `MatSolve()` for block sizes 2 to 8,
+                   requires PETSc compiled with `-mavx2 -mfma` and double precision real scalars
 
    Level: beginner
 
@@ -243,6 +243,13 @@ PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_7(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_9_AVX2(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_11(Mat, Vec, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_N(Mat, Vec, Vec, Vec);
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+PETSC_INTERN PetscErrorCode MatMult_SeqBAIJ_N_AVX2(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatMultAdd_SeqBAIJ_N_AVX2(Mat, Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqBAIJ_N_NaturalOrdering_AVX2(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqBAIJ_NaturalOrdering_AVX2(Mat, Mat, const MatFactorInfo *);
+PETSC_INTERN PetscErrorCode MatSOR_SeqBAIJ_N_AVX2(Mat, Vec, PetscReal, MatSORType, PetscReal, PetscInt, PetscInt, Vec);
+#endif
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetNumericFactorization_inplace(Mat, PetscBool);
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetNumericFactorization(Mat, PetscBool);
 
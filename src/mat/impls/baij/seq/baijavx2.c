@@ -0,0 +1,313 @@
+/*
+    AVX2 kernels for MatMult(), MatMultAdd(), MatSolve() and MatSOR() of SeqBAIJ matrices with block size 2 to 8.
+
+    A column of a block is held in at most two registers (rows 0-3 and rows 4-7), the rows past the block size are
+    masked off. The inline kernels are always called with a literal block size, so the compiler generates one fully
+    unrolled copy per block size.
+*/
+#include <../src/mat/impls/baij/seq/baij.h>
+
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+  #include <immintrin.h>
+
+/* mask with the first k (possibly <= 0 or >= 4) lanes set */
+static inline __m256i MatSeqBAIJMask_AVX2(PetscInt k)
+{
+  return _mm256_cmpgt_epi64(_mm256_set1_epi64x(k), _mm256_set_epi64x(3, 2, 1, 0));
+}
+
+static inline __m256d MatSeqBAIJLoad0_AVX2(PetscInt bs, const PetscScalar *p, __m256i m0)
+{
+  return bs >= 4 ? _mm256_loadu_pd(p) : _mm256_maskload_pd(p, m0);
+}
+
+static inline __m256d MatSeqBAIJLoad1_AVX2(PetscInt bs, const PetscScalar *p, __m256i m1)
+{
+  return bs == 8 ? _mm256_loadu_pd(p + 4) : _mm256_maskload_pd(p + 4, m1);
+}
+
+static inline void MatSeqBAIJStore_AVX2(PetscInt bs, PetscScalar *p, __m256i m0, __m256i m1, __m256d z0, __m256d z1)
+{
+  if (bs >= 4) _mm256_storeu_pd(p, z0);
+  else _mm256_maskstore_pd(p, m0, z0);
+  if (bs == 8) _mm256_storeu_pd(p + 4, z1);
+  else if (bs > 4) _mm256_maskstore_pd(p + 4, m1, z1);
+}
+
+/* (z0,z1) += v*x where v is a bs x bs block stored by columns */
+static inline void MatSeqBAIJBlockMultAdd_AVX2(PetscInt bs, const MatScalar *v, const PetscScalar *x, __m256i m0, __m256i m1, __m256d *z0, __m256d *z1)
+{
+  PetscInt c;
+
+  for (c = 0; c < bs; c++) {
+    const __m256d w = _mm256_set1_pd(x[c]);
+
+    *z0 = _mm256_fmadd_pd(MatSeqBAIJLoad0_AVX2(bs, v + c * bs, m0), w, *z0);
+    if (bs > 4) *z1 = _mm256_fmadd_pd(MatSeqBAIJLoad1_AVX2(bs, v + c * bs, m1), w, *z1);
+  }
+}
+
+/* (z0,z1) -= v*x where v is a bs x bs block stored by columns */
+static inline void MatSeqBAIJBlockMultSub_AVX2(PetscInt bs, const MatScalar *v, const PetscScalar *x, __m256i m0, __m256i m1, __m256d *z0, __m256d *z1)
+{
+  PetscInt c;
+
+  for (c = 0; c < bs; c++) {
+    const __m256d w = _mm256_set1_pd(x[c]);
+
+    *z0 = _mm256_fnmadd_pd(MatSeqBAIJLoad0_AVX2(bs, v + c * bs, m0), w, *z0);
+    if (bs > 4) *z1 = _mm256_fnmadd_pd(MatSeqBAIJLoad1_AVX2(bs, v + c * bs, m1), w, *z1);
+  }
+}
+
+/* x[0:bs] = d*(z0,z1) where d is a bs x bs block stored by columns */
+static inline void MatSeqBAIJBlockSolveDiag_AVX2(PetscInt bs, const MatScalar *d, PetscScalar *x, __m256i m0, __m256i m1, __m256d z0, __m256d z1)
+{
+  PetscScalar s[8];
+  __m256d     r0 = _mm256_setzero_pd(), r1 = _mm256_setzero_pd();
+
+  _mm256_storeu_pd(s, z0);
+  _mm256_storeu_pd(s + 4, z1);
+  MatSeqBAIJBlockMultAdd_AVX2(bs, d, s, m0, m1, &r0, &r1);
+  MatSeqBAIJStore_AVX2(bs, x, m0, m1, r0, r1);
+}
+
+/* z = y + A*x (or z = A*x if y is NULL) over the block rows given by ii[] and ridx[] */
+static inline void MatMultAdd_SeqBAIJ_AVX2_Kernel(PetscInt bs, PetscInt mbs, const PetscInt *ii, const PetscInt *ridx, const PetscInt *aj, const MatScalar *aa, const PetscScalar *x, const PetscScalar *y, PetscScalar *z)
+{
+  const PetscInt bs2 = bs * bs;
+  const __m256i  m0 = MatSeqBAIJMask_AVX2(bs), m1 = MatSeqBAIJMask_AVX2(bs - 4);
+  PetscInt       i, j, row;
+  __m256d        z0, z1;
+
+  for (i = 0; i < mbs; i++) {
+    row = ridx ? ridx[i] : i;
+    if (y) {
+      z0 = MatSeqBAIJLoad0_AVX2(bs, y + bs * row, m0);
+      z1 = bs > 4 ? MatSeqBAIJLoad1_AVX2(bs, y + bs * row, m1) : _mm256_setzero_pd();
+    } else {
+      z0 = _mm256_setzero_pd();
+      z1 = _mm256_setzero_pd();
+    }
+    PetscPrefetchBlock(aj + ii[i + 1], ii[i + 1] - ii[i], 0, PETSC_PREFETCH_HINT_NTA);                    /* Indices for the next row (assumes same size as this one) */
+    PetscPrefetchBlock(aa + bs2 * ii[i + 1], bs2 * (ii[i + 1] - ii[i]), 0, PETSC_PREFETCH_HINT_NTA); /* Entries for the next row */
+    for (j = ii[i]; j < ii[i + 1]; j++) MatSeqBAIJBlockMultAdd_AVX2(bs, aa + bs2 * j, x + bs * aj[j], m0, m1, &z0, &z1);
+    MatSeqBAIJStore_AVX2(bs, z + bs * row, m0, m1, z0, z1);
+  }
+}
+
+  #define MatSeqBAIJBlockSizeSwitch_AVX2(bs, kernel, ...) \
+    do { \
+      switch (bs) { \
+      case 2: \
+        kernel(2, __VA_ARGS__); \
+        break; \
+      case 3: \
+        kernel(3, __VA_ARGS__); \
+        break; \
+      case 4: \
+        kernel(4, __VA_ARGS__); \
+        break; \
+      case 5: \
+        kernel(5, __VA_ARGS__); \
+        break; \
+      case 6: \
+        kernel(6, __VA_ARGS__); \
+        break; \
+      case 7: \
+        kernel(7, __VA_ARGS__); \
+        break; \
+      case 8: \
+        kernel(8, __VA_ARGS__); \
+        break; \
+      default: \
+        SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP, "No AVX2 kernel for block size %" PetscInt_FMT, (PetscInt)(bs)); \
+      } \
+    } while (0)
+
+PetscErrorCode MatMult_SeqBAIJ_N_AVX2(Mat A, Vec xx, Vec zz)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ *)A->data;
+  const PetscScalar *x;
+  PetscScalar       *z;
+  const PetscInt    *ii = a->i, *ridx = NULL;
+  PetscInt           mbs = a->mbs, bs = A->rmap->bs;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayWrite(zz, &z));
+  if (a->compressedrow.use) {
+    mbs  = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    PetscCall(PetscArrayzero(z, bs * a->mbs));
+  }
+  MatSeqBAIJBlockSizeSwitch_AVX2(bs, MatMultAdd_SeqBAIJ_AVX2_Kernel, mbs, ii, ridx, a->j, a->a, x, NULL, z);
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayWrite(zz, &z));
+  PetscCall(PetscLogFlops(2.0 * a->nz * a->bs2 - bs * a->nonzerorowcnt));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode MatMultAdd_SeqBAIJ_N_AVX2(Mat A, Vec xx, Vec yy, Vec zz)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ *)A->data;
+  const PetscScalar *x;
+  PetscScalar       *y, *z;
+  const PetscInt    *ii = a->i, *ridx = NULL;
+  PetscInt           mbs = a->mbs, bs = A->rmap->bs;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xx, &x));
+  PetscCall(VecGetArrayPair(yy, zz, &y, &z));
+  if (a->compressedrow.use) {
+    mbs  = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    if (y != z) PetscCall(PetscArraycpy(z, y, bs * a->mbs));
+  }
+  MatSeqBAIJBlockSizeSwitch_AVX2(bs, MatMultAdd_SeqBAIJ_AVX2_Kernel, mbs, ii, ridx, a->j, a->a, x, y, z);
+  PetscCall(VecRestoreArrayRead(xx, &x));
+  PetscCall(VecRestoreArrayPair(yy, zz, &y, &z));
+  PetscCall(PetscLogFlops(2.0 * a->nz * a->bs2));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* triangular solves for the factored matrix in the natural ordering, see MatSolve_SeqBAIJ_N_NaturalOrdering() */
+static inline void MatSolve_SeqBAIJ_NaturalOrdering_AVX2_Kernel(PetscInt bs, PetscInt n, const PetscInt *ai, const PetscInt *aj, const PetscInt *adiag, const MatScalar *aa, const PetscScalar *b, PetscScalar *x)
+{
+  const PetscInt bs2 = bs * bs;
+  const __m256i  m0 = MatSeqBAIJMask_AVX2(bs), m1 = MatSeqBAIJMask_AVX2(bs - 4);
+  PetscInt       i, k;
+  __m256d        s0, s1;
+
+  /* forward solve the lower triangular */
+  for (i = 0; i < n; i++) {
+    s0 = MatSeqBAIJLoad0_AVX2(bs, b + bs * i, m0);
+    s1 = bs > 4 ? MatSeqBAIJLoad1_AVX2(bs, b + bs * i, m1) : _mm256_setzero_pd();
+    for (k = ai[i]; k < ai[i + 1]; k++) MatSeqBAIJBlockMultSub_AVX2(bs, aa + bs2 * k, x + bs * aj[k], m0, m1, &s0, &s1);
+    MatSeqBAIJStore_AVX2(bs, x + bs * i, m0, m1, s0, s1);
+  }
+  /* backward solve the upper triangular, the diagonal blocks are stored inverted */
+  for (i = n - 1; i >= 0; i--) {
+    s0 = MatSeqBAIJLoad0_AVX2(bs, x + bs * i, m0);
+    s1 = bs > 4 ? MatSeqBAIJLoad1_AVX2(bs, x + bs * i, m1) : _mm256_setzero_pd();
+    for (k = adiag[i + 1] + 1; k < adiag[i]; k++) MatSeqBAIJBlockMultSub_AVX2(bs, aa + bs2 * k, x + bs * aj[k], m0, m1, &s0, &s1);
+    MatSeqBAIJBlockSolveDiag_AVX2(bs, aa + bs2 * adiag[i], x + bs * i, m0, m1, s0, s1);
+  }
+}
+
+PetscErrorCode MatSolve_SeqBAIJ_N_NaturalOrdering_AVX2(Mat A, Vec bb, Vec xx)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ *)A->data;
+  const PetscScalar *b;
+  PetscScalar       *x;
+  PetscInt           bs = A->rmap->bs;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(bb, &b));
+  PetscCall(VecGetArray(xx, &x));
+  MatSeqBAIJBlockSizeSwitch_AVX2(bs, MatSolve_SeqBAIJ_NaturalOrdering_AVX2_Kernel, a->mbs, a->i, a->j, a->diag, a->a, b, x);
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(PetscLogFlops(2.0 * (a->bs2) * (a->nz) - A->rmap->bs * A->cmap->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   Sets up the numeric factorization for the block size and switches MatSolve() to the AVX2 kernel afterwards,
+   only used for the natural ordering
+*/
+PetscErrorCode MatLUFactorNumeric_SeqBAIJ_NaturalOrdering_AVX2(Mat B, Mat A, const MatFactorInfo *info)
+{
+  PetscFunctionBegin;
+  switch (A->rmap->bs) {
+  case 2:
+    PetscCall(MatLUFactorNumeric_SeqBAIJ_2_NaturalOrdering(B, A, info));
+    break;
+  case 3:
+    PetscCall(MatLUFactorNumeric_SeqBAIJ_3_NaturalOrdering(B, A, info));
+    break;
+  case 4:
+    PetscCall(MatLUFactorNumeric_SeqBAIJ_4_NaturalOrdering(B, A, info));
+    break;
+  case 5:
+    PetscCall(MatLUFactorNumeric_SeqBAIJ_5_NaturalOrdering(B, A, info));
+    break;
+  case 6:
+    PetscCall(MatLUFactorNumeric_SeqBAIJ_6_NaturalOrdering(B, A, info));
+    break;
+  case 7:
+    PetscCall(MatLUFactorNumeric_SeqBAIJ_7_NaturalOrdering(B, A, info));
+    break;
+  default:
+    PetscCall(MatLUFactorNumeric_SeqBAIJ_N(B, A, info));
+    break;
+  }
+  B->ops->solve = MatSolve_SeqBAIJ_N_NaturalOrdering_AVX2;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   One Gauss-Seidel sweep over the block rows; with a zero initial guess only the blocks whose x values have already
+   been computed in this sweep are used.
+*/
+static inline void MatSOR_SeqBAIJ_AVX2_Kernel(PetscInt bs, PetscInt m, PetscBool forward, PetscBool zeroguess, const PetscInt *ai, const PetscInt *aj, const PetscInt *diag, const MatScalar *aa, const MatScalar *idiag, const PetscScalar *b, PetscScalar *x)
+{
+  const PetscInt bs2 = bs * bs;
+  const __m256i  m0 = MatSeqBAIJMask_AVX2(bs), m1 = MatSeqBAIJMask_AVX2(bs - 4);
+  PetscInt       i, k, kstart, kend;
+  __m256d        s0, s1;
+
+  for (PetscInt ii = 0; ii < m; ii++) {
+    i      = forward ? ii : m - 1 - ii;
+    s0     = MatSeqBAIJLoad0_AVX2(bs, b + bs * i, m0);
+    s1     = bs > 4 ? MatSeqBAIJLoad1_AVX2(bs, b + bs * i, m1) : _mm256_setzero_pd();
+    kstart = (zeroguess && !forward) ? diag[i] + 1 : ai[i];
+    kend   = (zeroguess && forward) ? diag[i] : ai[i + 1];
+    for (k = kstart; k < kend; k++) {
+      if (k == diag[i]) continue;
+      MatSeqBAIJBlockMultSub_AVX2(bs, aa + bs2 * k, x + bs * aj[k], m0, m1, &s0, &s1);
+    }
+    MatSeqBAIJBlockSolveDiag_AVX2(bs, idiag + bs2 * i, x + bs * i, m0, m1, s0, s1);
+  }
+}
+
+PetscErrorCode MatSOR_SeqBAIJ_N_AVX2(Mat A, Vec bb, PetscReal omega, MatSORType flag, PetscReal fshift, PetscInt its, PetscInt lits, Vec xx)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ *)A->data;
+  PetscScalar       *x;
+  const PetscScalar *b;
+  PetscInt           m = a->mbs, bs = A->rmap->bs, it;
+  PetscBool          zeroguess = (flag & SOR_ZERO_INITIAL_GUESS) ? PETSC_TRUE : PETSC_FALSE;
+
+  PetscFunctionBegin;
+  its = its * lits;
+  PetscCheck(!(flag & SOR_EISENSTAT), PETSC_COMM_SELF, PETSC_ERR_SUP, "No support yet for Eisenstat");
+  PetscCheck(its > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Relaxation requires global its %" PetscInt_FMT " and local its %" PetscInt_FMT " both positive", its, lits);
+  PetscCheck(!fshift, PETSC_COMM_SELF, PETSC_ERR_SUP, "No support for diagonal shift");
+  PetscCheck(omega == 1.0, PETSC_COMM_SELF, PETSC_ERR_SUP, "No support for non-trivial relaxation factor");
+  PetscCheck(!(flag & SOR_APPLY_UPPER) && !(flag & SOR_APPLY_LOWER), PETSC_COMM_SELF, PETSC_ERR_SUP, "No support for applying upper or lower triangular parts");
+
+  if (!a->idiagvalid) PetscCall(MatInvertBlockDiagonal(A, NULL));
+  if (!m) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(VecGetArray(xx, &x));
+  PetscCall(VecGetArrayRead(bb, &b));
+  for (it = 0; it < its; it++) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      MatSeqBAIJBlockSizeSwitch_AVX2(bs, MatSOR_SeqBAIJ_AVX2_Kernel, m, PETSC_TRUE, zeroguess, a->i, a->j, a->diag, a->a, a->idiag, b, x);
+      PetscCall(PetscLogFlops(zeroguess ? 1.0 * a->bs2 * a->nz : 2.0 * a->bs2 * a->nz));
+      zeroguess = PETSC_FALSE;
+    }
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      MatSeqBAIJBlockSizeSwitch_AVX2(bs, MatSOR_SeqBAIJ_AVX2_Kernel, m, PETSC_FALSE, zeroguess, a->i, a->j, a->diag, a->a, a->idiag, b, x);
+      PetscCall(PetscLogFlops(zeroguess ? 1.0 * a->bs2 * a->nz : 2.0 * a->bs2 * a->nz));
+      zeroguess = PETSC_FALSE;
+    }
+  }
+  PetscCall(VecRestoreArray(xx, &x));
+  PetscCall(VecRestoreArrayRead(bb, &b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
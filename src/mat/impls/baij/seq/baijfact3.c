@@ -11,6 +11,20 @@
 PetscErrorCode MatSeqBAIJSetNumericFactorization(Mat fact, PetscBool natural)
 {
   PetscFunctionBegin;
+  if (natural && fact->rmap->bs >= 2 && fact->rmap->bs <= 8) {
+    PetscBool avx2 = PETSC_FALSE;
+
+    PetscCall(PetscOptionsGetBool(NULL, ((PetscObject)fact)->prefix, "-mat_baij_avx2", &avx2, NULL));
+    if (avx2) {
+#if defined(PETSC_HAVE_IMMINTRIN_H) && defined(__AVX2__) && defined(__FMA__) && defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX) && !defined(PETSC_USE_64BIT_INDICES)
+      fact->ops->lufactornumeric = MatLUFactorNumeric_SeqBAIJ_NaturalOrdering_AVX2;
+      PetscCall(PetscInfo((PetscObject)fact, "Using AVX2 for MatSolve for BAIJ for blocksize %" PetscInt_FMT "\n", fact->rmap->bs));
+      PetscFunctionReturn(PETSC_SUCCESS);
+#else
+      PetscCall(PetscInfo((PetscObject)fact, "AVX2 BAIJ kernel not available for MatSolve, PETSc must be compiled with -mavx2 -mfma and double precision real scalars\n"));
+#endif
+    }
+  }
   if (natural) {
     switch (fact->rmap->bs) {
     case 1:
@@ -193,6 +193,7 @@ PetscErrorCode MatDestroy_SeqSBAIJ(Mat A)
   PetscCall(PetscFree(a->saved_values));
   if (a->free_jshort) PetscCall(PetscFree(a->jshort));
   PetscCall(PetscFree(a->inew));
+  PetscCall(MatSeqAIJLevelsDestroy(&a->levels));
   PetscCall(MatDestroy(&a->parent));
   PetscCall(PetscFree(A->data));
 
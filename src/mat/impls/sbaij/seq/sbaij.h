@@ -12,18 +12,19 @@
 typedef struct {
   SEQAIJHEADER(MatScalar);
   SEQBAIJHEADER;
-  PetscInt        *inew;               /* pointer to beginning of each row of reordered matrix */
-  PetscInt        *jnew;               /* column values: jnew + i[k] is start of row k */
-  MatScalar       *anew;               /* nonzero diagonal and superdiagonal elements of reordered matrix */
-  PetscScalar     *solves_work;        /* work space used in MatSolves */
-  PetscInt         solves_work_n;      /* size of solves_work */
-  PetscInt        *a2anew;             /* map used for symm permutation */
-  PetscBool        permute;            /* if true, a non-trivial permutation is used for factorization */
-  PetscBool        ignore_ltriangular; /* if true, ignore the lower triangular values inserted by users */
-  PetscBool        getrow_utriangular; /* if true, MatGetRow_SeqSBAIJ() is enabled to get the upper part of the row */
-  Mat_SeqAIJ_Inode inode;
-  unsigned short  *jshort;
-  PetscBool        free_jshort;
+  PetscInt          *inew;               /* pointer to beginning of each row of reordered matrix */
+  PetscInt          *jnew;               /* column values: jnew + i[k] is start of row k */
+  MatScalar         *anew;               /* nonzero diagonal and superdiagonal elements of reordered matrix */
+  PetscScalar       *solves_work;        /* work space used in MatSolves */
+  PetscInt           solves_work_n;      /* size of solves_work */
+  PetscInt          *a2anew;             /* map used for symm permutation */
+  PetscBool          permute;            /* if true, a non-trivial permutation is used for factorization */
+  PetscBool          ignore_ltriangular; /* if true, ignore the lower triangular values inserted by users */
+  PetscBool          getrow_utriangular; /* if true, MatGetRow_SeqSBAIJ() is enabled to get the upper part of the row */
+  Mat_SeqAIJ_Inode   inode;
+  unsigned short    *jshort;
+  PetscBool          free_jshort;
+  Mat_SeqAIJ_Levels *levels;             /* level schedule of the threaded solves of an ICC factor of a MATSEQAIJ, see aijthreads.c */
 } Mat_SeqSBAIJ;
 
 PETSC_INTERN PetscErrorCode MatCholeskyFactorSymbolic_SeqSBAIJ(Mat, Mat, IS, const MatFactorInfo *);
@@ -114,6 +115,7 @@ PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqSBAIJ_7(Mat, Mat, const
 PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_N_inplace(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_1_inplace(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_1(Mat, Vec, Vec);
+PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_1_Threads(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_2_inplace(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_3_inplace(Mat, Vec, Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_4_inplace(Mat, Vec, Vec);
@@ -35,6 +35,9 @@ PETSC_EXTERN PetscErrorCode MatCreate_Composite(Mat);
 
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJPERM(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJPERM(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJCompressed(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJMixed(Mat);
+PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJMixed(Mat);
 
 PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJSELL(Mat);
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJSELL(Mat);
@@ -143,6 +146,12 @@ PetscErrorCode MatRegisterAll(void)
   PetscCall(MatRegister(MATMPIAIJPERM, MatCreate_MPIAIJPERM));
   PetscCall(MatRegister(MATSEQAIJPERM, MatCreate_SeqAIJPERM));
 
+  PetscCall(MatRegister(MATSEQAIJCOMPRESSED, MatCreate_SeqAIJCompressed));
+
+  PetscCall(MatRegisterRootName(MATAIJMIXED, MATSEQAIJMIXED, MATMPIAIJMIXED));
+  PetscCall(MatRegister(MATMPIAIJMIXED, MatCreate_MPIAIJMixed));
+  PetscCall(MatRegister(MATSEQAIJMIXED, MatCreate_SeqAIJMixed));
+
   PetscCall(MatRegisterRootName(MATAIJSELL, MATSEQAIJSELL, MATMPIAIJSELL));
   PetscCall(MatRegister(MATMPIAIJSELL, MatCreate_MPIAIJSELL));
   PetscCall(MatRegister(MATSEQAIJSELL, MatCreate_SeqAIJSELL));
@@ -38,6 +38,7 @@ PetscLogEvent MAT_CUSPARSECopyToGPU, MAT_CUSPARSECopyFromGPU, MAT_CUSPARSEGenera
 PetscLogEvent MAT_HIPSPARSECopyToGPU, MAT_HIPSPARSECopyFromGPU, MAT_HIPSPARSEGenerateTranspose, MAT_HIPSPARSESolveAnalysis;
 PetscLogEvent MAT_PreallCOO, MAT_SetVCOO;
 PetscLogEvent MAT_SetValuesBatch;
+PetscLogEvent MAT_MatrixPowers;
 PetscLogEvent MAT_ViennaCLCopyToGPU;
 PetscLogEvent MAT_DenseCopyToGPU, MAT_DenseCopyFromGPU;
 PetscLogEvent MAT_Merge, MAT_Residual, MAT_SetRandom;
@@ -2748,6 +2749,75 @@ PetscErrorCode MatMultAdd(Mat mat, Vec v1, Vec v2, Vec v3)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+    MatMatrixPowers -  Computes the powers y[k] = A^(k+1) x for k = 0, ..., s - 1.
+
+    Neighbor-wise Collective
+
+    Input Parameters:
++   mat - the matrix
+.   s - the number of powers
+-   x - the vector to be multiplied
+
+    Output Parameter:
+.   y - the s results
+
+    Level: advanced
+
+    Notes:
+    The matrix must be square with the same row and column layouts, and none of the vectors `y` can be `x`.
+
+    For `MATMPIAIJ` the rows within distance s of the local rows in the graph of the matrix are gathered once, with
+    `MatIncreaseOverlap()` and `MatCreateSubMatrices()`, and the powers are then computed with a single exchange of the
+    ghost values of `x` instead of one per product. The products on the ghost rows are computed redundantly by the
+    neighboring processes, so this pays off when the cost of the messages dominates, that is for small local problems
+    or a high network latency. The ghost region is kept with the matrix and only rebuilt when its nonzero structure or
+    s change. Other matrix types call `MatMult()` s times.
+
+    This is the building block of s-step Krylov methods such as `KSPCAGMRES`.
+
+.seealso: [](chapter_matrices), `Mat`, `MatMult()`, `MatIncreaseOverlap()`, `KSPCAGMRES`
+@*/
+PetscErrorCode MatMatrixPowers(Mat mat, PetscInt s, Vec x, Vec y[])
+{
+  PetscErrorCode (*f)(Mat, PetscInt, Vec, Vec[]);
+  PetscBool cong;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat, MAT_CLASSID, 1);
+  PetscValidType(mat, 1);
+  PetscValidLogicalCollectiveInt(mat, s, 2);
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 3);
+  VecCheckAssembled(x);
+  PetscCheck(s >= 0, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_OUTOFRANGE, "Number of powers %" PetscInt_FMT " cannot be negative", s);
+  if (s) PetscValidPointer(y, 4);
+  for (PetscInt k = 0; k < s; k++) {
+    PetscValidHeaderSpecific(y[k], VEC_CLASSID, 4);
+    PetscCheck(x != y[k], PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_IDN, "x and y[%" PetscInt_FMT "] must be different vectors", k);
+    PetscCheck(mat->rmap->n == y[k]->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec y[%" PetscInt_FMT "]: local dim %" PetscInt_FMT " %" PetscInt_FMT, k, mat->rmap->n, y[k]->map->n);
+  }
+  PetscCheck(mat->assembled, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for unassembled matrix");
+  PetscCheck(!mat->factortype, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Not for factored matrix");
+  PetscCheck(mat->cmap->n == x->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Mat mat,Vec x: local dim %" PetscInt_FMT " %" PetscInt_FMT, mat->cmap->n, x->map->n);
+  MatCheckPreallocated(mat, 1);
+  PetscCall(MatHasCongruentLayouts(mat, &cong));
+  PetscCheck(cong, PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_SIZ, "Matrix must have the same row and column layouts");
+  if (!s) PetscFunctionReturn(PETSC_SUCCESS);
+
+  PetscCall(PetscObjectQueryFunction((PetscObject)mat, "MatMatrixPowers_C", &f));
+  PetscCall(PetscLogEventBegin(MAT_MatrixPowers, mat, x, 0, 0));
+  PetscCall(VecLockReadPush(x));
+  if (f) PetscCall((*f)(mat, s, x, y));
+  else {
+    PetscCall(MatMult(mat, x, y[0]));
+    for (PetscInt k = 1; k < s; k++) PetscCall(MatMult(mat, y[k - 1], y[k]));
+  }
+  PetscCall(VecLockReadPop(x));
+  PetscCall(PetscLogEventEnd(MAT_MatrixPowers, mat, x, 0, 0));
+  for (PetscInt k = 0; k < s; k++) PetscCall(PetscObjectStateIncrease((PetscObject)y[k]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    MatMultTransposeAdd - Computes v3 = v2 + A' * v1.
 
@@ -5798,7 +5868,8 @@ PetscErrorCode MatAssemblyEnd(Mat mat, MatAssemblyType type)
         performance for very large process counts.
 -    `MAT_SUBSET_OFF_PROC_ENTRIES` - you know that the first assembly after setting this flag will set a superset
         of the off-process entries required for all subsequent assemblies. This avoids a rendezvous step in the MatAssembly
-        functions, instead sending only neighbor messages.
+        functions, instead sending only neighbor messages. With the option `-matstash_persistent` the messages of that first
+        assembly are also kept, subsequent assemblies then send them with persistent MPI requests without sorting the stash.
 
    Level: intermediate
 
@@ -5862,6 +5933,12 @@ PetscErrorCode MatAssemblyEnd(Mat mat, MatAssemblyType type)
                      single call to `MatSetValues()`, preallocation is perfect, row oriented, `INSERT_VALUES` is used. Common
                      with finite difference schemes with non-periodic boundary conditions.
 
+   `MAT_THREAD_SAFE_ADD` - for `MATSEQAIJ`, `MatSetValues()` with `ADD_VALUES` may be called concurrently by several OpenMP
+        threads, for example in a threaded finite element assembly loop. Entries already in the nonzero structure are
+        added atomically, the others are kept in a stash per thread and inserted during `MatAssemblyEnd()`, so it is most
+        effective after the first assembly. Must be set outside of any OpenMP parallel region and requires PETSc configured
+        with `--with-threadsafety`.
+
    Developer Note:
    `MAT_SYMMETRY_ETERNAL`, `MAT_STRUCTURAL_SYMMETRY_ETERNAL`, and `MAT_SPD_ETERNAL` are used by `MatAssemblyEnd()` and in other
    places where otherwise the value of `MAT_SYMMETRIC`, `MAT_STRUCTURAL_SYMMETRIC` or `MAT_SPD` would need to be changed back
@@ -5892,7 +5969,7 @@ PetscErrorCode MatSetOption(Mat mat, MatOption op, PetscBool flg)
     mat->assembly_subset = flg;
     if (!mat->assembly_subset) { /* See the same logic in VecAssembly wrt VEC_SUBSET_OFF_PROC_ENTRIES */
 #if !defined(PETSC_HAVE_MPIUNI)
-      PetscCall(MatStashScatterDestroy_BTS(&mat->stash));
+      if (mat->stash.size) PetscCall(MatStashScatterDestroy_BTS(&mat->stash)); /* the stash is only created by parallel matrix types */
 #endif
       mat->stash.first_assembly_done = PETSC_FALSE;
     }
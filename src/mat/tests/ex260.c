@@ -0,0 +1,116 @@
+static char help[] = "Tests the threaded MatMult(), MatMultAdd() and MatMultTranspose() of MATSEQAIJ (-mat_aij_threads).\n\n";
+
+#include <petscmat.h>
+
+int main(int argc, char **args)
+{
+  Mat         A, B;
+  Vec         x, y, xt, yt;
+  PetscInt    m = 53, n = 41, i, k, nnz, col;
+  PetscScalar dot, dott;
+  PetscReal   nrm, err;
+  PetscBool   flg;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+
+  /* A uses the serial kernels, B the threaded ones through its options prefix */
+  PetscCall(MatCreate(PETSC_COMM_SELF, &A));
+  PetscCall(MatSetSizes(A, m, n, m, n));
+  PetscCall(MatSetType(A, MATSEQAIJ));
+  PetscCall(MatSeqAIJSetPreallocation(A, 9, NULL));
+  PetscCall(MatCreate(PETSC_COMM_SELF, &B));
+  PetscCall(MatSetOptionsPrefix(B, "thr_"));
+  PetscCall(MatSetSizes(B, m, n, m, n));
+  PetscCall(MatSetType(B, MATSEQAIJ));
+  PetscCall(MatSeqAIJSetPreallocation(B, 9, NULL));
+
+  /* rows of varying length, including empty ones, so the partition is not uniform */
+  for (i = 0; i < m; i++) {
+    nnz = (i * 7) % 10;
+    for (k = 0; k < nnz && k < n; k++) {
+      PetscScalar v = 1.0 + i + 0.5 * k;
+
+      col = (i * 3 + k * 5) % n;
+      PetscCall(MatSetValue(A, i, col, v, ADD_VALUES));
+      PetscCall(MatSetValue(B, i, col, v, ADD_VALUES));
+    }
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(MatEqual(A, B, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Matrices differ after assembly");
+  PetscCall(MatMultEqual(A, B, 3, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatMult()");
+  PetscCall(MatMultAddEqual(A, B, 3, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatMultAdd()");
+  PetscCall(MatMultTransposeEqual(A, B, 3, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatMultTranspose()");
+  PetscCall(MatMultTransposeAddEqual(A, B, 3, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatMultTransposeAdd()");
+
+  /* reassembling with the same nonzero pattern must keep the partition, a new nonzero must recompute it */
+  PetscCall(MatScale(A, 2.0));
+  PetscCall(MatScale(B, 2.0));
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(MatSetOption(B, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscCall(MatSetValue(A, m - 1, 0, 3.0, ADD_VALUES));
+  PetscCall(MatSetValue(B, m - 1, 0, 3.0, ADD_VALUES));
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatMultEqual(A, B, 3, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatMult() after reassembly");
+  PetscCall(MatMultTransposeAddEqual(A, B, 3, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatMultTransposeAdd() after reassembly");
+
+  /* the vectors of B use its threads and, for the rows, its row partition; their kernels must match the serial ones */
+  PetscCall(MatCreateVecs(A, &x, &y));
+  PetscCall(MatCreateVecs(B, &xt, &yt));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(VecCopy(x, xt));
+  PetscCall(MatMult(A, x, y));
+  PetscCall(MatMult(B, xt, yt));
+  PetscCall(VecDot(y, y, &dot));
+  PetscCall(VecDot(yt, yt, &dott));
+  PetscCheck(PetscAbsScalar(dot - dott) <= 100 * PETSC_MACHINE_EPSILON * PetscAbsScalar(dot), PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in VecDot() of the vectors of the threaded matrix");
+  PetscCall(VecNorm(y, NORM_2, &nrm));
+  PetscCall(VecAXPY(yt, -1.0, y));
+  PetscCall(VecNorm(yt, NORM_2, &err));
+  PetscCheck(err <= 100 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatMult() with the vectors of the threaded matrix");
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&xt));
+  PetscCall(VecDestroy(&yt));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/empty.out
+      args: -thr_mat_aij_threads {{1 2 3 8}}
+
+   test:
+      suffix: 2
+      output_file: output/empty.out
+      args: -thr_mat_aij_threads 8 -m 3 -n 100
+
+   # the left vector gets the row partition, the right one is not square with the rows
+   test:
+      suffix: vecs
+      args: -thr_mat_aij_threads 3 -info :vec
+      filter: grep -o "Using 3 threads with .*" | sort -u
+
+TEST*/
@@ -0,0 +1,151 @@
+static char help[] = "Benchmarks and checks the AVX2 MATSEQBAIJ kernels (-mat_baij_avx2) against the default ones.\n\
+Use -log_view to compare the MatMult, MatMultAdd, MatSOR and MatSolve events in the two stages.\n\
+  -bs <bs>      : block size, 2 to 8\n\
+  -n <n>        : number of block rows of the 2d grid in each direction\n\
+  -trial <its>  : number of times each operation is repeated\n\n";
+
+#include <petscmat.h>
+
+/* block 5-point stencil on an n x n grid with random blocks, made block diagonally dominant */
+static PetscErrorCode CreateMatrix(PetscInt bs, PetscInt n, const char prefix[], PetscRandom rand, Mat *A)
+{
+  PetscInt     i, j, k, row, cols[5], nc;
+  PetscScalar *vals;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatCreate(PETSC_COMM_SELF, A));
+  PetscCall(MatSetOptionsPrefix(*A, prefix));
+  PetscCall(MatSetSizes(*A, bs * n * n, bs * n * n, bs * n * n, bs * n * n));
+  PetscCall(MatSetType(*A, MATSEQBAIJ));
+  PetscCall(MatSeqBAIJSetPreallocation(*A, bs, 5, NULL));
+  PetscCall(MatSetOption(*A, MAT_ROW_ORIENTED, PETSC_FALSE));
+  PetscCall(PetscMalloc1(5 * bs * bs, &vals));
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < n; j++) {
+      row = i * n + j;
+      nc  = 0;
+      if (i > 0) cols[nc++] = row - n;
+      if (j > 0) cols[nc++] = row - 1;
+      cols[nc++] = row;
+      if (j < n - 1) cols[nc++] = row + 1;
+      if (i < n - 1) cols[nc++] = row + n;
+      PetscCall(PetscRandomSetSeed(rand, (unsigned long)(row + 1)));
+      PetscCall(PetscRandomSeed(rand));
+      for (k = 0; k < nc * bs * bs; k++) PetscCall(PetscRandomGetValue(rand, &vals[k]));
+      /* make the diagonal block dominant */
+      for (k = 0; k < nc; k++) {
+        if (cols[k] == row) {
+          for (PetscInt l = 0; l < bs; l++) vals[k * bs * bs + l * bs + l] += 5.0 * bs;
+        }
+      }
+      PetscCall(MatSetValuesBlocked(*A, 1, &row, nc, cols, vals, INSERT_VALUES));
+    }
+  }
+  PetscCall(PetscFree(vals));
+  PetscCall(MatAssemblyBegin(*A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* runs each operation trial times, the last results are returned in y[] */
+static PetscErrorCode RunKernels(Mat A, const char prefix[], PetscInt trial, Vec x, Vec y[4])
+{
+  Mat           F;
+  MatFactorInfo info;
+  IS            row, col;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatGetFactor(A, MATSOLVERPETSC, MAT_FACTOR_ILU, &F));
+  PetscCall(MatSetOptionsPrefix(F, prefix));
+  PetscCall(MatFactorInfoInitialize(&info));
+  info.fill = 1.0;
+  PetscCall(MatGetOrdering(A, MATORDERINGNATURAL, &row, &col));
+  PetscCall(MatILUFactorSymbolic(F, A, row, col, &info));
+  PetscCall(MatLUFactorNumeric(F, A, &info));
+  for (PetscInt t = 0; t < trial; t++) {
+    PetscCall(MatMult(A, x, y[0]));
+    PetscCall(MatMultAdd(A, x, x, y[1]));
+    PetscCall(MatSOR(A, x, 1.0, SOR_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS, 0.0, 2, 1, y[2]));
+    PetscCall(MatSolve(F, x, y[3]));
+  }
+  PetscCall(ISDestroy(&row));
+  PetscCall(ISDestroy(&col));
+  PetscCall(MatDestroy(&F));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat           A, B;
+  Vec           x, y[4], z[4];
+  PetscRandom   rand;
+  PetscInt      bs = 5, n = 20, trial = 1, i;
+  PetscReal     nrm, err;
+  PetscLogStage stage[2];
+  const char   *names[4] = {"MatMult", "MatMultAdd", "MatSOR", "MatSolve"};
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-trial", &trial, NULL));
+  PetscCall(PetscLogStageRegister("Reference", &stage[0]));
+  PetscCall(PetscLogStageRegister("AVX2", &stage[1]));
+
+  PetscCall(PetscRandomCreate(PETSC_COMM_SELF, &rand));
+  PetscCall(PetscRandomSetInterval(rand, -1.0, 1.0));
+  PetscCall(PetscRandomSetFromOptions(rand));
+  /* B gets the AVX2 kernels with -avx2_mat_baij_avx2 */
+  PetscCall(CreateMatrix(bs, n, NULL, rand, &A));
+  PetscCall(CreateMatrix(bs, n, "avx2_", rand, &B));
+  PetscCall(MatCreateVecs(A, &x, NULL));
+  PetscCall(PetscRandomSetSeed(rand, 42));
+  PetscCall(PetscRandomSeed(rand));
+  PetscCall(VecSetRandom(x, rand));
+  for (i = 0; i < 4; i++) {
+    PetscCall(VecDuplicate(x, &y[i]));
+    PetscCall(VecDuplicate(x, &z[i]));
+  }
+
+  PetscCall(PetscLogStagePush(stage[0]));
+  PetscCall(RunKernels(A, NULL, trial, x, y));
+  PetscCall(PetscLogStagePop());
+  PetscCall(PetscLogStagePush(stage[1]));
+  PetscCall(RunKernels(B, "avx2_", trial, x, z));
+  PetscCall(PetscLogStagePop());
+
+  for (i = 0; i < 4; i++) {
+    PetscCall(VecNorm(y[i], NORM_INFINITY, &nrm));
+    PetscCall(VecAXPY(z[i], -1.0, y[i]));
+    PetscCall(VecNorm(z[i], NORM_INFINITY, &err));
+    if (err > 100 * PETSC_MACHINE_EPSILON * PetscMax(nrm, 1.0)) PetscCall(PetscPrintf(PETSC_COMM_SELF, "%s differs by %g\n", names[i], (double)err));
+  }
+
+  for (i = 0; i < 4; i++) {
+    PetscCall(VecDestroy(&y[i]));
+    PetscCall(VecDestroy(&z[i]));
+  }
+  PetscCall(VecDestroy(&x));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscRandomDestroy(&rand));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: avx2
+      requires: defined(PETSC_HAVE_AVX2_FMA) double !complex !defined(PETSC_USE_64BIT_INDICES)
+      output_file: output/empty.out
+      args: -bs {{2 3 4 5 6 7 8}} -n 6 -avx2_mat_baij_avx2
+
+   # without AVX2 the option must be reported and the default kernels used
+   test:
+      suffix: noavx2
+      requires: !defined(PETSC_HAVE_AVX2_FMA)
+      args: -bs 4 -n 6 -avx2_mat_baij_avx2 -info :mat
+      filter: grep -c "AVX2 BAIJ kernel"
+
+TEST*/
@@ -0,0 +1,91 @@
+static char help[] = "Tests MatSetValues() called concurrently by OpenMP threads on a MATSEQAIJ with MAT_THREAD_SAFE_ADD.\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode AddElement(Mat A, PetscInt n, PetscInt e)
+{
+  PetscInt    idx[2] = {e, e + 1};
+  PetscScalar Ke[4]  = {1.0 + e, -1.0, -1.0, 1.0 + e};
+
+  PetscFunctionBeginUser;
+  PetscCall(MatSetValues(A, 2, idx, 2, idx, Ke, ADD_VALUES));
+  /* some longer range couplings */
+  if (e % 5 == 0 && e + 3 < n) PetscCall(MatSetValue(A, e, e + 3, 0.5, ADD_VALUES));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   assembles a 1d finite element stiffness matrix, the elements are distributed among nthreads threads. With serialize
+   the calls to MatSetValues() are made one at a time, but still from different threads and thus into different stashes,
+   which does not require PETSc configured with --with-threadsafety
+*/
+static PetscErrorCode AssembleElements(Mat A, PetscInt n, PetscInt nthreads, PetscBool serialize)
+{
+  int ierr = 0; /* the first error of any thread */
+
+  PetscFunctionBeginUser;
+  PetscPragmaOMP(parallel for num_threads(nthreads) schedule(static, 7) reduction(|:ierr))
+  for (PetscInt e = 0; e < n - 1; e++) {
+    if (ierr) continue;
+    if (serialize) {
+      PetscPragmaOMP(critical)
+      ierr = (int)AddElement(A, n, e);
+    } else ierr = (int)AddElement(A, n, e);
+  }
+  PetscCall((PetscErrorCode)ierr);
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat       A, B;
+  PetscInt  n = 100, nthreads = 1, it;
+  PetscBool flg, serialize = PETSC_FALSE;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nthreads", &nthreads, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-serialize", &serialize, NULL));
+
+  PetscCall(MatCreateSeqAIJ(PETSC_COMM_SELF, n, n, 4, NULL, &A));
+  PetscCall(MatCreateSeqAIJ(PETSC_COMM_SELF, n, n, 4, NULL, &B));
+  PetscCall(MatSetOption(B, MAT_THREAD_SAFE_ADD, PETSC_TRUE));
+  /* the first assembly goes through the stashes, the next ones add in place */
+  for (it = 0; it < 3; it++) {
+    PetscCall(MatZeroEntries(A));
+    PetscCall(MatZeroEntries(B));
+    PetscCall(AssembleElements(A, n, 1, PETSC_FALSE));
+    PetscCall(AssembleElements(B, n, nthreads, serialize));
+    PetscCall(MatEqual(A, B, &flg));
+    PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Matrices differ after assembly %" PetscInt_FMT, it);
+  }
+  PetscCall(MatSetOption(B, MAT_THREAD_SAFE_ADD, PETSC_FALSE));
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/empty.out
+
+   test:
+      suffix: 2
+      requires: openmp threadsafety
+      output_file: output/empty.out
+      args: -nthreads 4 -n 1000 -omp_num_threads 4
+
+   test:
+      suffix: serialize
+      requires: openmp
+      args: -nthreads 4 -n 1000 -omp_num_threads 4 -serialize -info :mat
+      filter: grep -c "Merged"
+
+TEST*/
@@ -0,0 +1,100 @@
+static char help[] = "Tests repeated assemblies with off-process entries, MAT_SUBSET_OFF_PROC_ENTRIES and -matstash_persistent.\n\n";
+
+#include <petscmat.h>
+
+/* each process sets a band of rows starting in the middle of its own rows, so part of it lands on the next process */
+static PetscErrorCode SetValues(Mat A, PetscInt it, InsertMode mode)
+{
+  PetscInt    rstart, rend, M, bs, i, row, cols[3];
+  PetscScalar vals[3];
+
+  PetscFunctionBeginUser;
+  PetscCall(MatGetSize(A, &M, NULL));
+  PetscCall(MatGetOwnershipRange(A, &rstart, &rend));
+  PetscCall(MatGetBlockSize(A, &bs));
+  for (i = (rstart + rend) / 2; i < (rstart + rend) / 2 + (rend - rstart); i++) {
+    row = i % M;
+    /* after the first assembly, skip some of the entries to check that a subset is also communicated properly */
+    if (it > 0 && (row + it) % 4 == 0) continue;
+    cols[0] = (row + M - bs) % M;
+    cols[1] = row;
+    cols[2] = (row + bs) % M;
+    vals[0] = -1.0 - it;
+    vals[1] = 4.0 + row + it;
+    vals[2] = -1.0 + 0.5 * it;
+    PetscCall(MatSetValues(A, 1, &row, 3, cols, vals, mode));
+    /* a second contribution to the same entries, so the stash has duplicates to add */
+    if (mode == ADD_VALUES) PetscCall(MatSetValues(A, 1, &row, 3, cols, vals, mode));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode CreateMatrix(PetscInt n, PetscInt bs, Mat *A)
+{
+  PetscFunctionBeginUser;
+  PetscCall(MatCreate(PETSC_COMM_WORLD, A));
+  PetscCall(MatSetSizes(*A, n * bs, n * bs, PETSC_DETERMINE, PETSC_DETERMINE));
+  PetscCall(MatSetBlockSize(*A, bs));
+  PetscCall(MatSetFromOptions(*A));
+  PetscCall(MatSetUp(*A));
+  PetscCall(MatSetOption(*A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat        A, B;
+  PetscInt   n = 8, bs = 1, it;
+  PetscBool  flg;
+  InsertMode mode;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+
+  /* A is assembled the default way, B with MAT_SUBSET_OFF_PROC_ENTRIES, persistent with -matstash_persistent */
+  PetscCall(CreateMatrix(n, bs, &A));
+  PetscCall(CreateMatrix(n, bs, &B));
+  PetscCall(MatSetOption(B, MAT_SUBSET_OFF_PROC_ENTRIES, PETSC_TRUE));
+  for (it = 0; it < 5; it++) {
+    mode = it % 2 ? INSERT_VALUES : ADD_VALUES;
+    if (mode == ADD_VALUES) {
+      PetscCall(MatZeroEntries(A));
+      PetscCall(MatZeroEntries(B));
+    }
+    PetscCall(SetValues(A, it, mode));
+    PetscCall(SetValues(B, it, mode));
+    PetscCall(MatEqual(A, B, &flg));
+    PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Matrices differ after assembly %" PetscInt_FMT, it);
+  }
+  /* back to the default assembly */
+  PetscCall(MatSetOption(B, MAT_SUBSET_OFF_PROC_ENTRIES, PETSC_FALSE));
+  PetscCall(SetValues(A, 0, ADD_VALUES));
+  PetscCall(SetValues(B, 0, ADD_VALUES));
+  PetscCall(MatEqual(A, B, &flg));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Matrices differ after unsetting MAT_SUBSET_OFF_PROC_ENTRIES");
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 3}}
+      output_file: output/empty.out
+      args: -mat_type {{mpiaij mpibaij}} -matstash_persistent {{0 1}}
+
+   test:
+      suffix: 2
+      nsize: 4
+      output_file: output/empty.out
+      args: -mat_type baij -bs 2 -matstash_persistent
+
+TEST*/
@@ -0,0 +1,160 @@
+static char help[] = "Tests MatLoad() of MATSEQAIJ matrices from a binary file mapped into memory with -viewer_binary_mmap,\n\
+and MatLoad() in parallel of matrices written with PETSC_VIEWER_NATIVE.\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CreateMatrix(PetscInt m, PetscInt n, PetscInt shift, Mat *A)
+{
+  PetscInt i, k, col;
+
+  PetscFunctionBeginUser;
+  PetscCall(MatCreateSeqAIJ(PETSC_COMM_SELF, m, n, 4, NULL, A));
+  for (i = 0; i < m; i++) {
+    for (k = 0; k < (i + shift) % 4; k++) {
+      col = (i * 3 + k * 7) % n;
+      PetscCall(MatSetValue(*A, i, col, 1.0 + i - 0.25 * k, ADD_VALUES));
+    }
+  }
+  PetscCall(MatAssemblyBegin(*A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* a matrix written by the first process with PETSC_VIEWER_NATIVE is in the default format, so it can be loaded in parallel */
+static PetscErrorCode TestLoadNative(Mat A)
+{
+  Mat         B, *Bseq;
+  PetscViewer viewer;
+  PetscMPIInt rank;
+  PetscInt    M, N;
+  IS          isrow, iscol;
+  PetscBool   flg;
+  const char  filename[] = "ex264_native.dat";
+
+  PetscFunctionBeginUser;
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  if (rank == 0) {
+    /* with a prefix so that -viewer_binary_mmap does not apply */
+    PetscCall(PetscViewerCreate(PETSC_COMM_SELF, &viewer));
+    PetscCall(PetscViewerSetOptionsPrefix(viewer, "native_"));
+    PetscCall(PetscViewerSetType(viewer, PETSCVIEWERBINARY));
+    PetscCall(PetscViewerFileSetMode(viewer, FILE_MODE_WRITE));
+    PetscCall(PetscViewerFileSetName(viewer, filename));
+    PetscCall(PetscViewerPushFormat(viewer, PETSC_VIEWER_NATIVE));
+    PetscCall(MatView(A, viewer));
+    PetscCall(PetscViewerPopFormat(viewer));
+    PetscCall(PetscViewerDestroy(&viewer));
+  }
+  PetscCallMPI(MPI_Barrier(PETSC_COMM_WORLD));
+  PetscCall(PetscViewerCreate(PETSC_COMM_WORLD, &viewer));
+  PetscCall(PetscViewerSetOptionsPrefix(viewer, "native_"));
+  PetscCall(PetscViewerSetType(viewer, PETSCVIEWERBINARY));
+  PetscCall(PetscViewerFileSetMode(viewer, FILE_MODE_READ));
+  PetscCall(PetscViewerFileSetName(viewer, filename));
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &B));
+  PetscCall(MatSetType(B, MATAIJ));
+  PetscCall(MatLoad(B, viewer));
+  PetscCall(PetscViewerDestroy(&viewer));
+  PetscCall(MatGetSize(A, &M, &N));
+  PetscCall(ISCreateStride(PETSC_COMM_SELF, M, 0, 1, &isrow));
+  PetscCall(ISCreateStride(PETSC_COMM_SELF, N, 0, 1, &iscol));
+  PetscCall(MatCreateSubMatrices(B, 1, &isrow, &iscol, MAT_INITIAL_MATRIX, &Bseq));
+  PetscCall(MatEqual(A, Bseq[0], &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Matrix loaded in parallel differs");
+  PetscCall(MatDestroySubMatrices(1, &Bseq));
+  PetscCall(ISDestroy(&isrow));
+  PetscCall(ISDestroy(&iscol));
+  PetscCall(MatDestroy(&B));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat         A[3], B[3];
+  Vec         x, y;
+  PetscViewer viewer;
+  PetscMPIInt rank;
+  PetscInt    i, it;
+  PetscBool   flg;
+  char        filename[PETSC_MAX_PATH_LEN];
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCall(PetscSNPrintf(filename, sizeof(filename), "ex264_%d.dat", rank));
+
+  /* two matrices in the native format with mmap, which can be used from the mapped file, one in the default format, and a vector */
+  PetscCall(CreateMatrix(17, 13, 0, &A[0]));
+  PetscCall(CreateMatrix(10, 21, 1, &A[1]));
+  PetscCall(CreateMatrix(9, 7, 2, &A[2]));
+  PetscCall(MatCreateVecs(A[0], &x, NULL));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(PetscViewerCreate(PETSC_COMM_SELF, &viewer));
+  PetscCall(PetscViewerSetType(viewer, PETSCVIEWERBINARY));
+  PetscCall(PetscViewerFileSetMode(viewer, FILE_MODE_WRITE));
+  PetscCall(PetscViewerBinarySetUseMmap(viewer, PETSC_TRUE));
+  PetscCall(PetscViewerFileSetName(viewer, filename));
+  PetscCall(PetscViewerPushFormat(viewer, PETSC_VIEWER_NATIVE));
+  for (i = 0; i < 2; i++) PetscCall(MatView(A[i], viewer));
+  PetscCall(PetscViewerPopFormat(viewer));
+  PetscCall(MatView(A[2], viewer));
+  PetscCall(VecView(x, viewer));
+  PetscCall(PetscViewerDestroy(&viewer));
+
+  /* load twice, the second time checks that changing the first loaded matrices did not change the file */
+  for (it = 0; it < 2; it++) {
+    PetscCall(PetscViewerBinaryOpen(PETSC_COMM_SELF, filename, FILE_MODE_READ, &viewer));
+    for (i = 0; i < 3; i++) {
+      PetscCall(MatCreate(PETSC_COMM_SELF, &B[i]));
+      PetscCall(MatSetType(B[i], MATSEQAIJ));
+      PetscCall(MatLoad(B[i], viewer));
+    }
+    PetscCall(VecCreate(PETSC_COMM_SELF, &y));
+    PetscCall(VecLoad(y, viewer));
+    /* the matrices must outlive the viewer */
+    PetscCall(PetscViewerDestroy(&viewer));
+    for (i = 0; i < 3; i++) {
+      PetscCall(MatEqual(A[i], B[i], &flg));
+      PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Loaded matrix %" PetscInt_FMT " differs", i);
+      PetscCall(MatMultEqual(A[i], B[i], 2, &flg));
+      PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "MatMult() of loaded matrix %" PetscInt_FMT " differs", i);
+    }
+    PetscCall(VecEqual(x, y, &flg));
+    PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Loaded vector differs");
+    for (i = 0; i < 3; i++) {
+      PetscCall(MatScale(B[i], 2.0));
+      PetscCall(MatSetOption(B[i], MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+      PetscCall(MatSetValue(B[i], 0, 0, 1.0, ADD_VALUES));
+      PetscCall(MatAssemblyBegin(B[i], MAT_FINAL_ASSEMBLY));
+      PetscCall(MatAssemblyEnd(B[i], MAT_FINAL_ASSEMBLY));
+      PetscCall(MatDestroy(&B[i]));
+    }
+    PetscCall(VecDestroy(&y));
+  }
+  PetscCall(TestLoadNative(A[0]));
+
+  for (i = 0; i < 3; i++) PetscCall(MatDestroy(&A[i]));
+  PetscCall(VecDestroy(&x));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/empty.out
+      args: -viewer_binary_mmap {{0 1}}
+
+   test:
+      suffix: mapped
+      requires: defined(PETSC_HAVE_MMAP) defined(PETSC_USE_INFO)
+      args: -viewer_binary_mmap -info :mat
+      filter: grep -c "in the mapped file"
+
+   test:
+      suffix: native_parallel
+      nsize: 2
+      output_file: output/empty.out
+
+TEST*/
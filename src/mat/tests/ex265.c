@@ -0,0 +1,118 @@
+static char help[] = "Tests MatMult(), MatMultAdd() and MatSOR() of MATSEQAIJCOMPRESSED against MATSEQAIJ.\n\n";
+
+#include <petscmat.h>
+
+/* relaxes with A and B from the same initial guess and compares the results */
+static PetscErrorCode CheckSOR(Mat A, Mat B, Vec b, Vec x, MatSORType flag, PetscInt its)
+{
+  Vec       xa, xb;
+  PetscReal nrm;
+
+  PetscFunctionBeginUser;
+  PetscCall(VecDuplicate(x, &xa));
+  PetscCall(VecDuplicate(x, &xb));
+  PetscCall(VecCopy(x, xa));
+  PetscCall(VecCopy(x, xb));
+  PetscCall(MatSOR(A, b, 1.1, flag, 0.0, its, 1, xa));
+  PetscCall(MatSOR(B, b, 1.1, flag, 0.0, its, 1, xb));
+  PetscCall(VecAXPY(xb, -1.0, xa));
+  PetscCall(VecNorm(xb, NORM_INFINITY, &nrm));
+  PetscCheck(nrm < 100 * PETSC_MACHINE_EPSILON, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatSOR() type %d: %g", (int)flag, (double)nrm);
+  PetscCall(VecDestroy(&xa));
+  PetscCall(VecDestroy(&xb));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat        A, P, B;
+  Vec        x, b;
+  IS         rperm, cperm;
+  PetscInt   n = 10, i, j, k, row, col;
+  PetscBool  rcm = PETSC_TRUE, flg;
+  MatSORType flags[] = {SOR_LOCAL_FORWARD_SWEEP, SOR_LOCAL_BACKWARD_SWEEP, SOR_LOCAL_SYMMETRIC_SWEEP, SOR_EISENSTAT};
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-rcm", &rcm, NULL));
+
+  /* 5 point Laplacian on an n x n grid, the natural ordering is scrambled so that RCM has something to do */
+  PetscCall(MatCreateSeqAIJ(PETSC_COMM_SELF, n * n, n * n, 5, NULL, &A));
+  for (i = 0; i < n; i++) {
+    for (j = 0; j < n; j++) {
+      row = ((i * n + j) * 7) % (n * n);
+      PetscCall(MatSetValue(A, row, row, 4.0 + 0.1 * i, INSERT_VALUES));
+      for (k = 0; k < 4; k++) {
+        PetscInt ii = i + (k == 0) - (k == 1), jj = j + (k == 2) - (k == 3);
+
+        if (ii < 0 || ii >= n || jj < 0 || jj >= n) continue;
+        col = ((ii * n + jj) * 7) % (n * n);
+        PetscCall(MatSetValue(A, row, col, -1.0 - 0.01 * k, INSERT_VALUES));
+      }
+    }
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  if (rcm) {
+    PetscCall(MatGetOrdering(A, MATORDERINGRCM, &rperm, &cperm));
+    PetscCall(MatPermute(A, rperm, cperm, &P));
+    PetscCall(ISDestroy(&rperm));
+    PetscCall(ISDestroy(&cperm));
+  } else { /* too wide for 16 bit offsets */
+    PetscCall(MatDuplicate(A, MAT_COPY_VALUES, &P));
+  }
+
+  PetscCall(MatConvert(P, MATSEQAIJCOMPRESSED, MAT_INITIAL_MATRIX, &B));
+  PetscCall(MatCreateVecs(P, &x, &b));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(VecSetRandom(b, NULL));
+  for (k = 0; k < 2; k++) {
+    PetscCall(MatMultEqual(P, B, 3, &flg));
+    PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatMult()");
+    PetscCall(MatMultAddEqual(P, B, 3, &flg));
+    PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatMultAdd()");
+    for (i = 0; i < (PetscInt)PETSC_STATIC_ARRAY_LENGTH(flags); i++) {
+      PetscCall(CheckSOR(P, B, b, x, flags[i], 2));
+      PetscCall(CheckSOR(P, B, b, x, (MatSORType)(flags[i] | SOR_ZERO_INITIAL_GUESS), 1));
+    }
+    /* a new nonzero far from the diagonal changes the pattern and must rebuild the offsets */
+    PetscCall(MatSetOption(P, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+    PetscCall(MatSetOption(B, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+    PetscCall(MatSetValue(P, 0, n * n - 1, 0.5, INSERT_VALUES));
+    PetscCall(MatSetValue(B, 0, n * n - 1, 0.5, INSERT_VALUES));
+    PetscCall(MatAssemblyBegin(P, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(P, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyBegin(B, MAT_FINAL_ASSEMBLY));
+    PetscCall(MatAssemblyEnd(B, MAT_FINAL_ASSEMBLY));
+  }
+  PetscCall(MatDestroy(&B));
+
+  /* convert back */
+  PetscCall(MatConvert(P, MATSEQAIJCOMPRESSED, MAT_INITIAL_MATRIX, &B));
+  PetscCall(MatConvert(B, MATSEQAIJ, MAT_INPLACE_MATRIX, &B));
+  PetscCall(MatEqual(P, B, &flg));
+  PetscCheck(flg, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatConvert() back to MATSEQAIJ");
+
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&P));
+  PetscCall(MatDestroy(&B));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&b));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/empty.out
+      args: -n {{10 40}}
+
+   test:
+      suffix: 2
+      output_file: output/empty.out
+      args: -n 300 -rcm 0
+
+TEST*/
@@ -0,0 +1,93 @@
+static char help[] = "Tests MatMatrixPowers() against repeated MatMult().\n\n";
+
+#include <petscmat.h>
+
+static PetscErrorCode CheckPowers(Mat A, PetscInt s, Vec x, Vec *y, Vec *z)
+{
+  PetscReal nrm, err;
+
+  PetscFunctionBegin;
+  PetscCall(MatMatrixPowers(A, s, x, y));
+  for (PetscInt k = 0; k < s; k++) {
+    PetscCall(MatMult(A, k ? z[k - 1] : x, z[k]));
+    PetscCall(VecNorm(z[k], NORM_INFINITY, &nrm));
+    PetscCall(VecAXPY(z[k], -1.0, y[k]));
+    PetscCall(VecNorm(z[k], NORM_INFINITY, &err));
+    PetscCheck(err <= 100 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Wrong power %" PetscInt_FMT " of %" PetscInt_FMT ": error %g", k + 1, s, (double)err);
+    PetscCall(VecAXPY(z[k], 1.0, y[k]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat      A;
+  Vec      x, *y, *z;
+  PetscInt n = 12, s = 3, Istart, Iend, Ii, i, j;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-s", &s, NULL));
+
+  /* nonsymmetric 5 point stencil on an n x n grid */
+  PetscCall(MatCreate(PETSC_COMM_WORLD, &A));
+  PetscCall(MatSetSizes(A, PETSC_DECIDE, PETSC_DECIDE, n * n, n * n));
+  PetscCall(MatSetFromOptions(A));
+  PetscCall(MatSeqAIJSetPreallocation(A, 5, NULL));
+  PetscCall(MatMPIAIJSetPreallocation(A, 5, NULL, 5, NULL));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (Ii = Istart; Ii < Iend; Ii++) {
+    i = Ii / n;
+    j = Ii - i * n;
+    if (i > 0) PetscCall(MatSetValue(A, Ii, Ii - n, -1.0, INSERT_VALUES));
+    if (i < n - 1) PetscCall(MatSetValue(A, Ii, Ii + n, -0.5, INSERT_VALUES));
+    if (j > 0) PetscCall(MatSetValue(A, Ii, Ii - 1, -0.75, INSERT_VALUES));
+    if (j < n - 1) PetscCall(MatSetValue(A, Ii, Ii + 1, -0.25, INSERT_VALUES));
+    PetscCall(MatSetValue(A, Ii, Ii, 1.0, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(MatCreateVecs(A, &x, NULL));
+  PetscCall(VecDuplicateVecs(x, s + 1, &y));
+  PetscCall(VecDuplicateVecs(x, s + 1, &z));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(CheckPowers(A, s, x, y, z));
+
+  /* new values reuse the ghost region, a deeper one is built for more powers */
+  PetscCall(MatScale(A, 2.0));
+  PetscCall(MatShift(A, 1.0));
+  PetscCall(CheckPowers(A, s, x, y, z));
+  PetscCall(CheckPowers(A, s + 1, x, y, z));
+
+  /* a new nonzero far from the diagonal changes the ghost region */
+  PetscCall(MatSetOption(A, MAT_NEW_NONZERO_ALLOCATION_ERR, PETSC_FALSE));
+  if (Istart < Iend) PetscCall(MatSetValue(A, Istart, n * n - 1 - Istart, 0.5, INSERT_VALUES));
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(CheckPowers(A, s + 1, x, y, z));
+
+  PetscCall(VecDestroyVecs(s + 1, &y));
+  PetscCall(VecDestroyVecs(s + 1, &z));
+  PetscCall(VecDestroy(&x));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 2 5}}
+      output_file: output/empty.out
+      args: -s {{1 3}}
+
+   test:
+      suffix: 2
+      nsize: 3
+      output_file: output/empty.out
+      args: -n 4 -s 6
+
+TEST*/
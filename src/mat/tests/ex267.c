@@ -0,0 +1,144 @@
+static char help[] = "Tests the level scheduled MatSolve() of the ILU and ICC factors of MATSEQAIJ (-mat_aij_threads).\n\n";
+
+#include <petscmat.h>
+
+/* Creates the 5-point Laplacian on an m x m grid with dof unknowns per point, the couplings are nonsymmetric unless symm is set */
+static PetscErrorCode CreateMatrix(PetscInt m, PetscInt dof, PetscBool symm, const char *prefix, Mat *A)
+{
+  PetscInt n = m * m * dof, i, j, c, d, row;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreate(PETSC_COMM_SELF, A));
+  PetscCall(MatSetOptionsPrefix(*A, prefix));
+  PetscCall(MatSetSizes(*A, n, n, n, n));
+  PetscCall(MatSetType(*A, MATSEQAIJ));
+  PetscCall(MatSeqAIJSetPreallocation(*A, 5 * dof, NULL));
+  for (i = 0; i < m; i++) {
+    for (j = 0; j < m; j++) {
+      for (c = 0; c < dof; c++) {
+        row = (i * m + j) * dof + c;
+        for (d = 0; d < dof; d++) { /* all the unknowns of a point are coupled so that the rows form inodes */
+          PetscReal s = c == d ? 1.0 : 0.1;
+
+          PetscCall(MatSetValue(*A, row, (i * m + j) * dof + d, c == d ? 4.0 * dof : -0.1, INSERT_VALUES));
+          if (i > 0) PetscCall(MatSetValue(*A, row, ((i - 1) * m + j) * dof + d, -s, INSERT_VALUES));
+          if (i < m - 1) PetscCall(MatSetValue(*A, row, ((i + 1) * m + j) * dof + d, -s, INSERT_VALUES));
+          if (j > 0) PetscCall(MatSetValue(*A, row, (i * m + j - 1) * dof + d, symm ? -s : -1.5 * s, INSERT_VALUES));
+          if (j < m - 1) PetscCall(MatSetValue(*A, row, (i * m + j + 1) * dof + d, symm ? -s : -0.5 * s, INSERT_VALUES));
+        }
+      }
+    }
+  }
+  PetscCall(MatAssemblyBegin(*A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Factors A and B, identical except for the number of threads, twice and checks that the solves agree */
+static PetscErrorCode TestFactor(Mat A, Mat B, MatFactorType ftype, MatOrderingType otype, PetscInt levels)
+{
+  Mat           FA, FB;
+  IS            row, col;
+  MatFactorInfo info;
+  Vec           b, xa, xb;
+  PetscReal     nrm, err;
+
+  PetscFunctionBegin;
+  PetscCall(MatFactorInfoInitialize(&info));
+  info.levels = levels;
+  info.fill   = 1.0;
+  PetscCall(MatGetOrdering(A, otype, &row, &col));
+  PetscCall(MatGetFactor(A, MATSOLVERPETSC, ftype, &FA));
+  PetscCall(MatGetFactor(B, MATSOLVERPETSC, ftype, &FB));
+  if (ftype == MAT_FACTOR_ILU) {
+    PetscCall(MatILUFactorSymbolic(FA, A, row, col, &info));
+    PetscCall(MatILUFactorSymbolic(FB, B, row, col, &info));
+  } else {
+    PetscCall(MatICCFactorSymbolic(FA, A, row, &info));
+    PetscCall(MatICCFactorSymbolic(FB, B, row, &info));
+  }
+  PetscCall(MatCreateVecs(A, &xa, &b));
+  PetscCall(VecDuplicate(xa, &xb));
+  PetscCall(VecSetRandom(b, NULL));
+  for (PetscInt k = 0; k < 2; k++) {
+    if (k) { /* numeric refactorization with new values and the same nonzero pattern */
+      PetscCall(MatShift(A, 1.0));
+      PetscCall(MatShift(B, 1.0));
+    }
+    if (ftype == MAT_FACTOR_ILU) {
+      PetscCall(MatLUFactorNumeric(FA, A, &info));
+      PetscCall(MatLUFactorNumeric(FB, B, &info));
+    } else {
+      PetscCall(MatCholeskyFactorNumeric(FA, A, &info));
+      PetscCall(MatCholeskyFactorNumeric(FB, B, &info));
+    }
+    PetscCall(MatSolve(FA, b, xa));
+    PetscCall(MatSolve(FB, b, xb));
+    /* the sums are in the same order as in MatSolve_SeqAIJ() but not as in MatSolve_SeqAIJ_Inode() */
+    PetscCall(VecNorm(xa, NORM_INFINITY, &nrm));
+    PetscCall(VecAXPY(xb, -1.0, xa));
+    PetscCall(VecNorm(xb, NORM_INFINITY, &err));
+    PetscCheck(err <= 100.0 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in MatSolve() of the %s factor with %s ordering %g", MatFactorTypes[ftype], otype, (double)err);
+  }
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&xa));
+  PetscCall(VecDestroy(&xb));
+  PetscCall(MatDestroy(&FA));
+  PetscCall(MatDestroy(&FB));
+  PetscCall(ISDestroy(&row));
+  PetscCall(ISDestroy(&col));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat      A, B;
+  PetscInt m = 12, dof = 1, levels = 1;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-dof", &dof, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-levels", &levels, NULL));
+
+  /* A uses the sequential solves, B the level scheduled ones through its options prefix */
+  PetscCall(CreateMatrix(m, dof, PETSC_FALSE, NULL, &A));
+  PetscCall(CreateMatrix(m, dof, PETSC_FALSE, "thr_", &B));
+  PetscCall(TestFactor(A, B, MAT_FACTOR_ILU, MATORDERINGNATURAL, levels));
+  PetscCall(TestFactor(A, B, MAT_FACTOR_ILU, MATORDERINGRCM, levels));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+
+  PetscCall(CreateMatrix(m, dof, PETSC_TRUE, NULL, &A));
+  PetscCall(CreateMatrix(m, dof, PETSC_TRUE, "thr_", &B));
+  PetscCall(TestFactor(A, B, MAT_FACTOR_ICC, MATORDERINGNATURAL, levels));
+  PetscCall(TestFactor(A, B, MAT_FACTOR_ICC, MATORDERINGRCM, levels));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      output_file: output/empty.out
+      args: -thr_mat_aij_threads 1 -levels {{0 2}}
+
+   # each of the 8 numeric factorizations of B installs the level scheduled solves
+   test:
+      suffix: threads
+      requires: openmp
+      output_file: output/ex267_threads.out
+      args: -thr_mat_aij_threads {{2 3}} -levels {{0 2}} -info :mat
+      filter: grep -c "Level scheduled solves"
+
+   test:
+      suffix: inode
+      requires: openmp
+      output_file: output/ex267_threads.out
+      args: -thr_mat_aij_threads 4 -dof 3 -m 5 -info :mat
+      filter: grep -c "Level scheduled solves"
+
+TEST*/
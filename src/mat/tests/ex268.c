@@ -0,0 +1,82 @@
+static char help[] = "Tests MATCOARSENLUBY: the aggregates cover the graph and the selected vertices do not depend on the number of processes.\n\n";
+
+#include <petscmat.h>
+#include <petscmatcoarsen.h>
+
+int main(int argc, char **args)
+{
+  Mat               A;
+  MatCoarsen        crs;
+  PetscCoarsenData *agg_lists;
+  IS                mis;
+  PetscCDIntNd     *pos;
+  const PetscInt   *sel;
+  PetscInt          m = 20, n, Istart, Iend, row, i, j, k, nsel, sz, cnt[3] = {0, 0, 0}, gcnt[3];
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+  n = m * m;
+
+  /* graph of the 5-point stencil on an m x m grid */
+  PetscCall(MatCreateAIJ(PETSC_COMM_WORLD, PETSC_DECIDE, PETSC_DECIDE, n, n, 5, NULL, 4, NULL, &A));
+  PetscCall(MatGetOwnershipRange(A, &Istart, &Iend));
+  for (row = Istart; row < Iend; row++) {
+    i = row / m;
+    j = row % m;
+    PetscCall(MatSetValue(A, row, row, 4.0, INSERT_VALUES));
+    if (i > 0) PetscCall(MatSetValue(A, row, row - m, -1.0, INSERT_VALUES));
+    if (i < m - 1) PetscCall(MatSetValue(A, row, row + m, -1.0, INSERT_VALUES));
+    if (j > 0) PetscCall(MatSetValue(A, row, row - 1, -1.0, INSERT_VALUES));
+    if (j < m - 1) PetscCall(MatSetValue(A, row, row + 1, -1.0, INSERT_VALUES));
+  }
+  PetscCall(MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY));
+
+  PetscCall(MatCoarsenCreate(PETSC_COMM_WORLD, &crs));
+  PetscCall(MatCoarsenSetType(crs, MATCOARSENLUBY));
+  PetscCall(MatCoarsenSetFromOptions(crs));
+  PetscCall(MatCoarsenSetAdjacency(crs, A));
+  PetscCall(MatCoarsenSetStrictAggs(crs, PETSC_TRUE));
+  PetscCall(MatCoarsenApply(crs));
+  PetscCall(MatCoarsenViewFromOptions(crs, NULL, "-mat_coarsen_view"));
+  PetscCall(MatCoarsenGetData(crs, &agg_lists));
+
+  /* number of aggregates, sum of the global indices of their roots and number of aggregated vertices */
+  PetscCall(PetscCDGetMIS(agg_lists, &mis));
+  PetscCall(ISGetLocalSize(mis, &nsel));
+  PetscCall(ISGetIndices(mis, &sel));
+  for (k = 0; k < nsel; k++) {
+    PetscCall(PetscCDGetHeadPos(agg_lists, sel[k], &pos));
+    PetscCall(PetscCDIntNdGetID(pos, &row));
+    PetscCheck(row == Istart + sel[k], PETSC_COMM_SELF, PETSC_ERR_PLIB, "The aggregate %" PetscInt_FMT " does not start with its root", Istart + sel[k]);
+    PetscCall(PetscCDSizeAt(agg_lists, sel[k], &sz));
+    cnt[0]++;
+    cnt[1] += row;
+    cnt[2] += sz;
+  }
+  PetscCall(ISRestoreIndices(mis, &sel));
+  PetscCall(ISDestroy(&mis));
+  PetscCall(MPIU_Allreduce(cnt, gcnt, 3, MPIU_INT, MPI_SUM, PETSC_COMM_WORLD));
+  PetscCheck(gcnt[2] == n, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "The aggregates contain %" PetscInt_FMT " of the %" PetscInt_FMT " vertices", gcnt[2], n);
+  PetscCall(PetscPrintf(PETSC_COMM_WORLD, "%" PetscInt_FMT " aggregates, sum of the roots %" PetscInt_FMT "\n", gcnt[0], gcnt[1]));
+
+  PetscCall(PetscCDDestroy(agg_lists));
+  PetscCall(MatCoarsenDestroy(&crs));
+  PetscCall(MatDestroy(&A));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2 3}}
+      output_file: output/ex268_1.out
+
+   test:
+      suffix: view
+      nsize: 2
+      args: -m 4 -mat_coarsen_view
+
+TEST*/
@@ -0,0 +1,147 @@
+static char help[] = "Tests the multicolor MatSOR() of MATSEQAIJ (-mat_aij_sor_multicolor): it matches the sequential MatSOR() of the matrix permuted to the multicolor ordering.\n\n";
+
+#include <petscmat.h>
+
+/* Creates a nonsymmetric operator on an m x m grid, the diagonal couplings make its nonzero structure nonsymmetric as well */
+static PetscErrorCode CreateMatrix(PetscInt m, const char *prefix, Mat *A)
+{
+  PetscInt n = m * m, i, j, row;
+
+  PetscFunctionBegin;
+  PetscCall(MatCreate(PETSC_COMM_SELF, A));
+  PetscCall(MatSetOptionsPrefix(*A, prefix));
+  PetscCall(MatSetSizes(*A, n, n, n, n));
+  PetscCall(MatSetType(*A, MATSEQAIJ));
+  PetscCall(MatSeqAIJSetPreallocation(*A, 6, NULL));
+  for (i = 0; i < m; i++) {
+    for (j = 0; j < m; j++) {
+      row = i * m + j;
+      PetscCall(MatSetValue(*A, row, row, 6.0, INSERT_VALUES));
+      if (i > 0) PetscCall(MatSetValue(*A, row, row - m, -1.0, INSERT_VALUES));
+      if (i < m - 1) PetscCall(MatSetValue(*A, row, row + m, -1.0, INSERT_VALUES));
+      if (j > 0) PetscCall(MatSetValue(*A, row, row - 1, -1.5, INSERT_VALUES));
+      if (j < m - 1) PetscCall(MatSetValue(*A, row, row + 1, -0.5, INSERT_VALUES));
+      if (i < m - 1 && j < m - 1) PetscCall(MatSetValue(*A, row, row + m + 1, -0.25, INSERT_VALUES));
+    }
+  }
+  PetscCall(MatAssemblyBegin(*A, MAT_FINAL_ASSEMBLY));
+  PetscCall(MatAssemblyEnd(*A, MAT_FINAL_ASSEMBLY));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* The rows of A in the order in which the multicolor MatSOR() relaxes them: by color, in increasing order within a color */
+static PetscErrorCode GetColorOrdering(Mat A, IS *perm)
+{
+  Mat         G;
+  MatColoring mc;
+  ISColoring  iscoloring;
+  IS         *is;
+  PetscInt    n, nc, c, len, k = 0, *idx;
+
+  PetscFunctionBegin;
+  PetscCall(MatTranspose(A, MAT_INITIAL_MATRIX, &G));
+  PetscCall(MatAXPY(G, 1.0, A, DIFFERENT_NONZERO_PATTERN));
+  PetscCall(MatColoringCreate(G, &mc));
+  PetscCall(MatColoringSetType(mc, MATCOLORINGGREEDY));
+  PetscCall(MatColoringSetDistance(mc, 1));
+  PetscCall(MatColoringSetWeightType(mc, MAT_COLORING_WEIGHT_LEXICAL));
+  PetscCall(MatColoringApply(mc, &iscoloring));
+  PetscCall(ISColoringGetIS(iscoloring, PETSC_USE_POINTER, &nc, &is));
+  PetscCall(MatGetLocalSize(A, &n, NULL));
+  PetscCall(PetscMalloc1(n, &idx));
+  for (c = 0; c < nc; c++) {
+    const PetscInt *rows;
+
+    PetscCall(ISGetLocalSize(is[c], &len));
+    PetscCall(ISGetIndices(is[c], &rows));
+    PetscCall(PetscArraycpy(idx + k, rows, len));
+    PetscCall(ISRestoreIndices(is[c], &rows));
+    k += len;
+  }
+  PetscCall(ISCreateGeneral(PETSC_COMM_SELF, k, idx, PETSC_OWN_POINTER, perm));
+  PetscCall(ISColoringRestoreIS(iscoloring, PETSC_USE_POINTER, &is));
+  PetscCall(ISColoringDestroy(&iscoloring));
+  PetscCall(MatColoringDestroy(&mc));
+  PetscCall(MatDestroy(&G));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* y[k] = x[perm[k]] */
+static PetscErrorCode PermuteVec(IS perm, Vec x, Vec y)
+{
+  const PetscInt    *p;
+  const PetscScalar *xa;
+  PetscScalar       *ya;
+  PetscInt           n;
+
+  PetscFunctionBegin;
+  PetscCall(ISGetLocalSize(perm, &n));
+  PetscCall(ISGetIndices(perm, &p));
+  PetscCall(VecGetArrayRead(x, &xa));
+  PetscCall(VecGetArrayWrite(y, &ya));
+  for (PetscInt k = 0; k < n; k++) ya[k] = xa[p[k]];
+  PetscCall(VecRestoreArrayRead(x, &xa));
+  PetscCall(VecRestoreArrayWrite(y, &ya));
+  PetscCall(ISRestoreIndices(perm, &p));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Mat        A, B, P;
+  IS         perm;
+  Vec        b, x, pb, px, y;
+  PetscInt   m = 12, k;
+  PetscReal  nrm, err;
+  MatSORType flags[]  = {(MatSORType)(SOR_FORWARD_SWEEP | SOR_ZERO_INITIAL_GUESS), SOR_BACKWARD_SWEEP, SOR_SYMMETRIC_SWEEP, SOR_LOCAL_SYMMETRIC_SWEEP};
+  PetscReal  omegas[] = {1.0, 1.3, 0.8, 1.0};
+  PetscInt   its[]    = {1, 2, 1, 3};
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-m", &m, NULL));
+
+  /* A uses the sequential MatSOR(), B the multicolor one through its options prefix */
+  PetscCall(CreateMatrix(m, NULL, &A));
+  PetscCall(CreateMatrix(m, "mc_", &B));
+  PetscCall(GetColorOrdering(A, &perm));
+  PetscCall(MatPermute(A, perm, perm, &P));
+  PetscCall(MatCreateVecs(A, &x, &b));
+  PetscCall(VecDuplicate(x, &pb));
+  PetscCall(VecDuplicate(x, &px));
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecSetRandom(b, NULL));
+  PetscCall(PermuteVec(perm, b, pb));
+
+  for (k = 0; k < (PetscInt)PETSC_STATIC_ARRAY_LENGTH(flags); k++) {
+    PetscCall(VecSetRandom(x, NULL));
+    PetscCall(PermuteVec(perm, x, px));
+    PetscCall(MatSOR(B, b, omegas[k], flags[k], 0.0, its[k], 1, x));
+    PetscCall(MatSOR(P, pb, omegas[k], flags[k], 0.0, its[k], 1, px));
+    PetscCall(PermuteVec(perm, x, y));
+    PetscCall(VecNorm(px, NORM_INFINITY, &nrm));
+    PetscCall(VecAXPY(y, -1.0, px));
+    PetscCall(VecNorm(y, NORM_INFINITY, &err));
+    PetscCheck(err <= 100.0 * PETSC_MACHINE_EPSILON * nrm, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Multicolor MatSOR() with flag %d differs from the sequential one of the permuted matrix %g", (int)flags[k], (double)(err / nrm));
+  }
+
+  PetscCall(VecDestroy(&b));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&pb));
+  PetscCall(VecDestroy(&px));
+  PetscCall(VecDestroy(&y));
+  PetscCall(ISDestroy(&perm));
+  PetscCall(MatDestroy(&A));
+  PetscCall(MatDestroy(&B));
+  PetscCall(MatDestroy(&P));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      output_file: output/empty.out
+      args: -mc_mat_aij_sor_multicolor -mc_mat_aij_threads {{1 2 3}}
+
+TEST*/
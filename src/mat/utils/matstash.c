@@ -1,5 +1,7 @@
 
 #include <petsc/private/matimpl.h>
+#include <petsc/private/hashmapij.h>
+#include <petsc/private/mpiutils.h>
 
 #define DEFAULT_STASH_SIZE 10000
 
@@ -76,8 +78,11 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm, PetscInt bs, MatStash *stas
   stash->nprocessed  = 0;
   stash->reproduce   = PETSC_FALSE;
   stash->blocktype   = MPI_DATATYPE_NULL;
+  stash->persistent  = PETSC_FALSE;
+  stash->plan        = NULL;
 
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_reproduce", &stash->reproduce, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_persistent", &stash->persistent, NULL));
 #if !defined(PETSC_HAVE_MPIUNI)
   flg = PETSC_FALSE;
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-matstash_legacy", &flg, NULL));
@@ -812,6 +817,132 @@ static PetscErrorCode MatStashBTSRecv_Private(MPI_Comm comm, const PetscMPIInt t
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   With -matstash_persistent and MAT_SUBSET_OFF_PROC_ENTRIES the blocks sent and received in the first assembly are
+   frozen into a plan: every later assembly sends the same blocks, in the same order, with persistent requests on
+   preallocated buffers. Stashed values are added directly into their block, located with a hash of (row, col), so no
+   sorting, rendezvous or buffer sizing is done after the first assembly. Blocks that receive no value are sent with
+   a negative column and skipped by the receiver.
+*/
+struct _n_MatStashPlan {
+  PetscInt       nsendblocks, nrecvblocks;
+  PetscInt      *rows;    /* row of each block in sendbuf */
+  PetscHMapIJ    blocks;  /* (row, col) to the index of its block in sendbuf */
+  char          *sendbuf; /* blocks to send, ordered by destination rank as in sendframes[] */
+  char          *recvbuf;
+  MatStashFrame *recvframes;
+};
+
+/* Called at the end of the first assembly, while sendframes[] and recvframes[] still describe its messages */
+static PetscErrorCode MatStashPlanCreate_Private(MatStash *stash)
+{
+  MatStashPlan plan;
+  PetscInt     i, k, b;
+  PetscMPIInt  tag;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&plan));
+  for (i = 0; i < stash->nsendranks; i++) plan->nsendblocks += stash->sendframes[i].count;
+  for (i = 0; i < stash->nrecvranks; i++) plan->nrecvblocks += stash->recvframes[i].count;
+  PetscCall(PetscMalloc1(plan->nsendblocks, &plan->rows));
+  PetscCall(PetscMalloc2(plan->nsendblocks * stash->blocktype_size, &plan->sendbuf, plan->nrecvblocks * stash->blocktype_size, &plan->recvbuf));
+  PetscCall(PetscMalloc1(stash->nrecvranks, &plan->recvframes));
+  PetscCall(PetscHMapIJCreateWithSize(plan->nsendblocks, &plan->blocks));
+  PetscCall(PetscCommGetNewTag(stash->comm, &tag));
+  for (i = 0, b = 0; i < stash->nsendranks; i++) {
+    char *buffer = &plan->sendbuf[b * stash->blocktype_size];
+
+    for (k = 0; k < stash->sendframes[i].count; k++, b++) {
+      MatStashBlock *block = (MatStashBlock *)&((char *)stash->sendframes[i].buffer)[k * stash->blocktype_size];
+      PetscHashIJKey key;
+
+      key.i         = block->row < 0 ? -(block->row + 1) : block->row;
+      key.j         = block->col;
+      plan->rows[b] = key.i;
+      PetscCall(PetscHMapIJSet(plan->blocks, key, b));
+    }
+    PetscCallMPI(MPIU_Send_init(buffer, stash->sendframes[i].count, stash->blocktype, stash->sendranks[i], tag, stash->comm, &stash->sendreqs[i]));
+  }
+  for (i = 0, b = 0; i < stash->nrecvranks; i++) {
+    plan->recvframes[i].buffer  = &plan->recvbuf[b * stash->blocktype_size];
+    plan->recvframes[i].count   = stash->recvframes[i].count;
+    plan->recvframes[i].pending = 0;
+    PetscCallMPI(MPIU_Recv_init(plan->recvframes[i].buffer, plan->recvframes[i].count, stash->blocktype, stash->recvranks[i], tag, stash->comm, &stash->recvreqs[i]));
+    b += plan->recvframes[i].count;
+  }
+  stash->plan = plan;
+  PetscCall(PetscInfo(NULL, "Persistent stash communication with %d send and %d receive ranks, %" PetscInt_FMT " and %" PetscInt_FMT " blocks\n", stash->nsendranks, stash->nrecvranks, plan->nsendblocks, plan->nrecvblocks));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatStashPlanDestroy_Private(MatStash *stash)
+{
+  MatStashPlan plan = stash->plan;
+  PetscInt     i;
+
+  PetscFunctionBegin;
+  if (!plan) PetscFunctionReturn(PETSC_SUCCESS);
+  for (i = 0; i < stash->nsendranks; i++) PetscCallMPI(MPI_Request_free(&stash->sendreqs[i]));
+  for (i = 0; i < stash->nrecvranks; i++) PetscCallMPI(MPI_Request_free(&stash->recvreqs[i]));
+  PetscCall(PetscHMapIJDestroy(&plan->blocks));
+  PetscCall(PetscFree(plan->rows));
+  PetscCall(PetscFree2(plan->sendbuf, plan->recvbuf));
+  PetscCall(PetscFree(plan->recvframes));
+  PetscCall(PetscFree(stash->plan));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode MatStashScatterBegin_BTS_Persistent(Mat mat, MatStash *stash)
+{
+  MatStashPlan       plan = stash->plan;
+  PetscInt           bs2  = stash->bs * stash->bs, b, i, l;
+  PetscMatStashSpace space;
+  MatStashBlock     *block;
+
+  PetscFunctionBegin;
+  for (b = 0; b < plan->nsendblocks; b++) {
+    block      = (MatStashBlock *)&plan->sendbuf[b * stash->blocktype_size];
+    block->row = plan->rows[b];
+    block->col = -1;
+  }
+  for (space = stash->space_head; space; space = space->next) {
+    for (i = 0; i < space->local_used; i++) {
+      const PetscScalar *vals = &space->val[i * bs2];
+      PetscHashIJKey     key;
+
+      key.i = space->idx[i];
+      key.j = space->idy[i];
+      PetscCall(PetscHMapIJGet(plan->blocks, key, &b));
+      PetscCheck(b >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "MAT_SUBSET_OFF_PROC_ENTRIES and -matstash_persistent set, but entry (%" PetscInt_FMT ",%" PetscInt_FMT ") not communicated in initial assembly", key.i, key.j);
+      block = (MatStashBlock *)&plan->sendbuf[b * stash->blocktype_size];
+      if (block->col < 0 || mat->insertmode == INSERT_VALUES) {
+        block->col = key.j;
+        PetscCall(PetscArraycpy(block->vals, vals, bs2));
+      } else {
+        for (l = 0; l < bs2; l++) block->vals[l] += vals[l];
+      }
+    }
+  }
+  if (mat->insertmode == INSERT_VALUES) { /* Encode insertmode on the outgoing messages as in MatStashScatterBegin_BTS() */
+    for (b = 0; b < plan->nsendblocks; b++) {
+      block      = (MatStashBlock *)&plan->sendbuf[b * stash->blocktype_size];
+      block->row = -(block->row + 1);
+    }
+  }
+  PetscCallMPI(MPI_Startall_irecv(plan->nrecvblocks, stash->blocktype, stash->nrecvranks, stash->recvreqs));
+  PetscCallMPI(MPI_Startall_isend(plan->nsendblocks, stash->blocktype, stash->nsendranks, stash->sendreqs));
+
+  stash->recvframes       = plan->recvframes;
+  stash->use_status       = PETSC_FALSE;
+  stash->recvframe_active = NULL;
+  stash->recvframe_i      = 0;
+  stash->some_i           = 0;
+  stash->some_count       = 0;
+  stash->recvcount        = 0;
+  stash->insertmode       = &mat->insertmode;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*
  * owners[] contains the ownership ranges; may be indexed by either blocks or scalars
  */
@@ -826,6 +957,13 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat, MatStash *stash, PetscIn
     PetscCall(MPIU_Allreduce((PetscEnum *)&mat->insertmode, (PetscEnum *)&addv, 1, MPIU_ENUM, MPI_BOR, PetscObjectComm((PetscObject)mat)));
     PetscCheck(addv != (ADD_VALUES | INSERT_VALUES), PetscObjectComm((PetscObject)mat), PETSC_ERR_ARG_WRONGSTATE, "Some processors inserted others added");
   }
+  if (stash->plan) {
+    if (mat->assembly_subset) {
+      PetscCall(MatStashScatterBegin_BTS_Persistent(mat, stash));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    PetscCall(MatStashPlanDestroy_Private(stash)); /* MAT_SUBSET_OFF_PROC_ENTRIES was unset, go back to the dynamic path */
+  }
 
   PetscCall(MatStashBlockTypeSetUp(stash));
   PetscCall(MatStashSortCompress_Private(stash, mat->insertmode));
@@ -925,6 +1063,7 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash, PetscMPIInt *n
 
   PetscFunctionBegin;
   *flg = 0;
+next_block:
   while (!stash->recvframe_active || stash->recvframe_i == stash->recvframe_count) {
     if (stash->some_i == stash->some_count) {
       if (stash->recvcount == stash->nrecvranks) PetscFunctionReturn(PETSC_SUCCESS); /* Done */
@@ -946,13 +1085,14 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash, PetscMPIInt *n
     stash->recvcount++;
     stash->recvframe_i = 0;
   }
-  *n    = 1;
   block = (MatStashBlock *)&((char *)stash->recvframe_active->buffer)[stash->recvframe_i * stash->blocktype_size];
+  stash->recvframe_i++;
+  if (block->col < 0) goto next_block; /* Block of a persistent plan that received no value */
+  *n = 1;
   if (block->row < 0) block->row = -(block->row + 1);
   *row = &block->row;
   *col = &block->col;
   *val = block->vals;
-  stash->recvframe_i++;
   *flg = 1;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -962,6 +1102,7 @@ static PetscErrorCode MatStashScatterEnd_BTS(MatStash *stash)
   PetscFunctionBegin;
   PetscCallMPI(MPI_Waitall(stash->nsendranks, stash->sendreqs, MPI_STATUSES_IGNORE));
   if (stash->first_assembly_done) { /* Reuse the communication contexts, so consolidate and reset segrecvblocks  */
+    if (stash->persistent && !stash->plan) PetscCall(MatStashPlanCreate_Private(stash));
     PetscCall(PetscSegBufferExtractInPlace(stash->segrecvblocks, NULL));
   } else { /* No reuse, so collect everything. */
     PetscCall(MatStashScatterDestroy_BTS(stash));
@@ -991,6 +1132,7 @@ static PetscErrorCode MatStashScatterEnd_BTS(MatStash *stash)
 PetscErrorCode MatStashScatterDestroy_BTS(MatStash *stash)
 {
   PetscFunctionBegin;
+  PetscCall(MatStashPlanDestroy_Private(stash));
   PetscCall(PetscSegBufferDestroy(&stash->segsendblocks));
   PetscCall(PetscSegBufferDestroy(&stash->segrecvframe));
   stash->recvframes = NULL;
@@ -1107,6 +1107,13 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       filter: head -n 2
       filter_output: head -n 2
 
+   test:
+      suffix: gamg_esteig
+      nsize: 2
+      requires: !single defined(PETSC_USE_INFO)
+      args: -da_refine 2 -snes_monitor_short -ksp_converged_reason -ksp_type fgmres -pc_type gamg -pc_gamg_recompute_esteig 1 -mg_levels_ksp_max_it 3 -info :pc
+      filter: grep -c "recompute eigen estimates"
+
    test:
       suffix: cuda_1
       nsize: 1
@@ -1176,6 +1183,13 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
      args: -log_view -log_view_memory -da_refine 4
      filter: grep MatFDColorSetUp | wc -w | xargs  -I % sh -c "expr % \> 21"
 
+   # only checks the output of -log_view, the counters are checked in src/sys/tutorials/ex3.c
+   test:
+     suffix: logviewhwcounters
+     requires: defined(PETSC_USE_LOG) !defined(PETSC_HAVE_THREADSAFETY)
+     args: -log_view -log_view_hwcounters -da_refine 3
+     filter: grep -c "^MatMult "
+
    test:
      suffix: fs
      args: -pc_type fieldsplit -da_refine 3  -all_ksp_monitor -fieldsplit_y_velocity_pc_type lu  -fieldsplit_temperature_pc_type lu -fieldsplit_x_velocity_pc_type lu  -snes_view
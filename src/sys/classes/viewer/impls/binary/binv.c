@@ -1,4 +1,11 @@
 #include <petsc/private/viewerimpl.h> /*I   "petscviewer.h"   I*/
+#if defined(PETSC_HAVE_MMAP)
+  #include <sys/mman.h>
+  #include <errno.h>
+  #if defined(PETSC_HAVE_UNISTD_H)
+    #include <unistd.h>
+  #endif
+#endif
 
 /*
    This needs to start the same as PetscViewer_Socket.
@@ -13,17 +20,24 @@ typedef struct {
   MPI_File   mfsub; /* subviewer support */
   MPI_Offset moff;
 #endif
-  char         *filename;            /* file name */
-  PetscFileMode filemode;            /* read/write/append mode */
-  FILE         *fdes_info;           /* optional file containing info on binary file*/
-  PetscBool     storecompressed;     /* gzip the write binary file when closing it*/
-  char         *ogzfilename;         /* gzip can be run after the filename has been updated */
-  PetscBool     skipinfo;            /* Don't create info file for writing; don't use for reading */
-  PetscBool     skipoptions;         /* don't use PETSc options database when loading */
-  PetscBool     matlabheaderwritten; /* if format is PETSC_VIEWER_BINARY_MATLAB has the MATLAB .info header been written yet */
-  PetscBool     setfromoptionscalled;
+  char          *filename;            /* file name */
+  PetscFileMode  filemode;            /* read/write/append mode */
+  FILE          *fdes_info;           /* optional file containing info on binary file*/
+  PetscBool      storecompressed;     /* gzip the write binary file when closing it*/
+  char          *ogzfilename;         /* gzip can be run after the filename has been updated */
+  PetscBool      skipinfo;            /* Don't create info file for writing; don't use for reading */
+  PetscBool      skipoptions;         /* don't use PETSc options database when loading */
+  PetscBool      matlabheaderwritten; /* if format is PETSC_VIEWER_BINARY_MATLAB has the MATLAB .info header been written yet */
+  PetscBool      setfromoptionscalled;
+  PetscBool      usemmap;             /* map the file into memory when reading */
+  PetscContainer mapping;             /* the mapped file, shared with the objects whose arrays point into it */
 } PetscViewer_Binary;
 
+typedef struct {
+  void  *addr;
+  size_t len;
+} PetscViewerBinaryMapping;
+
 static PetscErrorCode PetscViewerBinaryClearFunctionList(PetscViewer v)
 {
   PetscFunctionBegin;
@@ -36,6 +50,8 @@ static PetscErrorCode PetscViewerBinaryClearFunctionList(PetscViewer v)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetSkipInfo_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetSkipInfo_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetInfoPointer_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMmap_C", NULL));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMmap_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerFileGetName_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerFileSetName_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerFileGetMode_C", NULL));
@@ -328,6 +344,87 @@ static PetscErrorCode PetscViewerBinaryGetUseMPIIO_Binary(PetscViewer viewer, Pe
 }
 #endif
 
+/*@
+    PetscViewerBinarySetUseMmap - Sets a binary viewer to map the file into memory with `mmap()` when reading. Must be called
+        before `PetscViewerFileSetName()`
+
+    Logically Collective
+
+    Input Parameters:
++   viewer - the `PetscViewer`; must be a `PETSCVIEWERBINARY`
+-   use - `PETSC_TRUE` means the file will be mapped
+
+    Options Database Key:
+.   -viewer_binary_mmap - Flag for mapping the file into memory
+
+    Level: advanced
+
+    Notes:
+    The file is mapped read-only and nothing is converted in the mapping, so only data stored in native byte order can be used
+    from it. `MatView()` of a `MATSEQAIJ` matrix to a viewer set with this function and the `PETSC_VIEWER_NATIVE` format stores its
+    arrays in native byte order, aligned in the file, and `MatLoad()` of such a matrix sets the row offsets, column indices and
+    values of the matrix to point directly into the mapping instead of reading them; matrices in the default format are read as
+    usual. Matrices written this way can only be loaded into `MATSEQAIJ` matrices. The mapping is released when the viewer and all
+    the objects using it are destroyed.
+
+    This is ignored if MPI-IO is used, or if `mmap()` is not available.
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinaryGetUseMmap()`, `PetscViewerBinaryReadMapped()`, `PetscViewerBinarySetUseMPIIO()`,
+          `PetscViewerBinaryOpen()`, `MatLoad()`
+@*/
+PetscErrorCode PetscViewerBinarySetUseMmap(PetscViewer viewer, PetscBool use)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidLogicalCollectiveBool(viewer, use, 2);
+  PetscTryMethod(viewer, "PetscViewerBinarySetUseMmap_C", (PetscViewer, PetscBool), (viewer, use));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscViewerBinarySetUseMmap_Binary(PetscViewer viewer, PetscBool use)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+
+  PetscFunctionBegin;
+  PetscCheck(!viewer->setupcalled || vbinary->usemmap == use, PetscObjectComm((PetscObject)viewer), PETSC_ERR_ORDER, "Cannot change mmap to %s after setup", PetscBools[use]);
+  vbinary->usemmap = use;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+    PetscViewerBinaryGetUseMmap - Returns `PETSC_TRUE` if the binary viewer maps the file into memory when reading.
+
+    Not Collective
+
+    Input Parameter:
+.   viewer - `PetscViewer` context, obtained from `PetscViewerBinaryOpen()`; must be a `PETSCVIEWERBINARY`
+
+    Output Parameter:
+.   use - `PETSC_TRUE` if the file is mapped
+
+    Level: advanced
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinarySetUseMmap()`, `PetscViewerBinaryOpen()`
+@*/
+PetscErrorCode PetscViewerBinaryGetUseMmap(PetscViewer viewer, PetscBool *use)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(viewer, PETSC_VIEWER_CLASSID, 1);
+  PetscValidBoolPointer(use, 2);
+  *use = PETSC_FALSE;
+  PetscTryMethod(viewer, "PetscViewerBinaryGetUseMmap_C", (PetscViewer, PetscBool *), (viewer, use));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscViewerBinaryGetUseMmap_Binary(PetscViewer viewer, PetscBool *use)
+{
+  PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
+
+  PetscFunctionBegin;
+  *use = vbinary->usemmap;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
     PetscViewerBinarySetFlowControl - Sets how many messages are allowed to outstanding at the same time during parallel IO reads/writes
 
@@ -752,6 +849,7 @@ static PetscErrorCode PetscViewerFileClose_BinarySTDIO(PetscViewer v)
   PetscViewer_Binary *vbinary = (PetscViewer_Binary *)v->data;
 
   PetscFunctionBegin;
+  PetscCall(PetscContainerDestroy(&vbinary->mapping));
   if (vbinary->fdes != -1) {
     PetscCall(PetscBinaryClose(vbinary->fdes));
     vbinary->fdes = -1;
@@ -842,7 +940,8 @@ static PetscErrorCode PetscViewerDestroy_Binary(PetscViewer v)
 .    -viewer_binary_skip_info - true to skip opening an info file
 .    -viewer_binary_skip_options - true to not use options database while creating viewer
 .    -viewer_binary_skip_header - true to skip output object headers to the file
--    -viewer_binary_mpiio - true to use MPI-IO for input and output to the file (more scalable for large problems)
+.    -viewer_binary_mpiio - true to use MPI-IO for input and output to the file (more scalable for large problems)
+-    -viewer_binary_mmap - true to map the file into memory when reading, see `PetscViewerBinarySetUseMmap()`
 
    Level: beginner
 
@@ -944,6 +1043,132 @@ PetscErrorCode PetscViewerBinaryRead(PetscViewer viewer, void *data, PetscInt nu
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@C
+   PetscViewerBinaryReadMapped - reads from a binary file mapped into memory by returning a pointer into the mapping
+
+   Collective
+
+   Input Parameters:
++  viewer - the binary viewer
+.  num - number of items of data to read
+-  dtype - type of data to read, `PETSC_INT`, `PETSC_REAL` or `PETSC_SCALAR`
+
+   Output Parameters:
++  data - location of the data in the mapping, or `NULL` if it cannot be read this way
+-  mapping - the object owning the mapping, the caller must reference it (for example with `PetscObjectCompose()`)
+             to use data after the viewer is closed
+
+   Level: developer
+
+   Notes:
+   The data can be read this way only when the viewer was created with `PetscViewerBinarySetUseMmap()`, it lives on a single MPI
+   process, and the data is aligned in the file, see `PetscViewerBinaryAlign()`. When `data` is `NULL` nothing was read and the
+   caller must use `PetscViewerBinaryRead()`.
+
+   Unlike `PetscViewerBinaryRead()`, the data is returned as stored in the file, without converting its byte order, so it must have
+   been written in native byte order.
+
+   The pages holding the data are copy-on-write, so the data may be modified without changing the file, and a page is only
+   copied when it is modified.
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinarySetUseMmap()`, `PetscViewerBinaryRead()`
+@*/
+PetscErrorCode PetscViewerBinaryReadMapped(PetscViewer viewer, void **data, PetscInt num, PetscDataType dtype, PetscObject *mapping)
+{
+  PetscViewer_Binary *vbinary;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(viewer, PETSC_VIEWER_CLASSID, 1, PETSCVIEWERBINARY);
+  PetscValidPointer(data, 2);
+  PetscValidPointer(mapping, 5);
+  PetscCall(PetscViewerSetUp(viewer));
+  vbinary  = (PetscViewer_Binary *)viewer->data;
+  *data    = NULL;
+  *mapping = NULL;
+#if defined(PETSC_HAVE_MMAP)
+  if (vbinary->mapping && num > 0 && (dtype == PETSC_INT || dtype == PETSC_REAL || dtype == PETSC_SCALAR)) {
+    PetscViewerBinaryMapping *map;
+    PetscMPIInt               size;
+    size_t                    typesize, align = dtype == PETSC_INT ? sizeof(PetscInt) : sizeof(PetscReal), page = (size_t)sysconf(_SC_PAGESIZE), start, end;
+    off_t                     off;
+
+    PetscCallMPI(MPI_Comm_size(PetscObjectComm((PetscObject)viewer), &size));
+    if (size > 1) PetscFunctionReturn(PETSC_SUCCESS);
+  #if defined(PETSC_USE_REAL___FLOAT128)
+    if (dtype != PETSC_INT) PetscFunctionReturn(PETSC_SUCCESS); /* the file may store doubles, see -binary_read_double */
+  #endif
+    PetscCall(PetscDataTypeGetSize(dtype, &typesize));
+    PetscCall(PetscContainerGetPointer(vbinary->mapping, (void **)&map));
+    PetscCall(PetscBinarySeek(vbinary->fdes, 0, PETSC_BINARY_SEEK_CUR, &off));
+    if ((size_t)off % align || (size_t)off + (size_t)num * typesize > map->len) PetscFunctionReturn(PETSC_SUCCESS);
+    /* the file is mapped read-only, the pages of the data become private copy-on-write pages */
+    start = (size_t)off / page * page;
+    end   = ((size_t)off + (size_t)num * typesize + page - 1) / page * page;
+    PetscCheck(!mprotect((char *)map->addr + start, end - start, PROT_READ | PROT_WRITE), PETSC_COMM_SELF, PETSC_ERR_SYS, "mprotect() failed, errno %d", errno);
+    *data = (char *)map->addr + off;
+    PetscCall(PetscBinarySeek(vbinary->fdes, (off_t)((size_t)num * typesize), PETSC_BINARY_SEEK_CUR, &off));
+    *mapping = (PetscObject)vbinary->mapping;
+  }
+#endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   PetscViewerBinaryAlign - writes, or skips when reading, zero bytes up to the next offset in the file that is a multiple of `align`
+
+   Collective
+
+   Input Parameters:
++  viewer - the binary viewer
+-  align - alignment in bytes
+
+   Level: developer
+
+   Note:
+   Calling it at the same place when writing and reading some data lets `PetscViewerBinaryReadMapped()` return that data.
+
+.seealso: [](sec_viewers), `PETSCVIEWERBINARY`, `PetscViewerBinaryReadMapped()`, `PetscViewerBinaryRead()`, `PetscViewerBinaryWrite()`
+@*/
+PetscErrorCode PetscViewerBinaryAlign(PetscViewer viewer, PetscInt align)
+{
+  PetscViewer_Binary *vbinary;
+  PetscMPIInt         rank;
+  PetscInt64          off = 0;
+  PetscInt            pad;
+  char               *zeros;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecificType(viewer, PETSC_VIEWER_CLASSID, 1, PETSCVIEWERBINARY);
+  PetscValidLogicalCollectiveInt(viewer, align, 2);
+  PetscCheck(align > 0, PetscObjectComm((PetscObject)viewer), PETSC_ERR_ARG_OUTOFRANGE, "Alignment %" PetscInt_FMT " must be positive", align);
+  PetscCall(PetscViewerSetUp(viewer));
+  vbinary = (PetscViewer_Binary *)viewer->data;
+  PetscCallMPI(MPI_Comm_rank(PetscObjectComm((PetscObject)viewer), &rank));
+#if defined(PETSC_HAVE_MPIIO)
+  if (vbinary->usempiio) {
+    off = (PetscInt64)vbinary->moff;
+  } else {
+#endif
+    if (rank == 0) {
+      off_t pos;
+
+      /* files opened for appending are written at their end */
+      PetscCall(PetscBinarySeek(vbinary->fdes, 0, vbinary->filemode == FILE_MODE_READ ? PETSC_BINARY_SEEK_CUR : PETSC_BINARY_SEEK_END, &pos));
+      off = (PetscInt64)pos;
+    }
+#if defined(PETSC_HAVE_MPIIO)
+  }
+#endif
+  PetscCallMPI(MPI_Bcast(&off, 1, MPIU_INT64, 0, PetscObjectComm((PetscObject)viewer)));
+  pad = (PetscInt)((align - off % align) % align);
+  if (!pad) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscCalloc1(pad, &zeros));
+  if (vbinary->filemode == FILE_MODE_READ) PetscCall(PetscViewerBinaryRead(viewer, zeros, pad, NULL, PETSC_CHAR));
+  else PetscCall(PetscViewerBinaryWrite(viewer, zeros, pad, PETSC_CHAR));
+  PetscCall(PetscFree(zeros));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
    PetscViewerBinaryWrite - writes to a binary file, only from the first MPI rank
 
@@ -1353,6 +1578,43 @@ static PetscErrorCode PetscViewerFileSetUp_BinaryMPIIO(PetscViewer viewer)
 }
 #endif
 
+#if defined(PETSC_HAVE_MMAP)
+static PetscErrorCode PetscViewerBinaryMappingDestroy_Private(void *ctx)
+{
+  PetscViewerBinaryMapping *map = (PetscViewerBinaryMapping *)ctx;
+
+  PetscFunctionBegin;
+  PetscCheck(!munmap(map->addr, map->len), PETSC_COMM_SELF, PETSC_ERR_SYS, "munmap() failed, errno %d", errno);
+  PetscCall(PetscFree(map));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscViewerFileSetUp_BinaryMmap(PetscViewer viewer)
+{
+  PetscViewer_Binary       *vbinary = (PetscViewer_Binary *)viewer->data;
+  PetscViewerBinaryMapping *map;
+  off_t                     len, off;
+  void                     *addr;
+
+  PetscFunctionBegin;
+  PetscCall(PetscBinarySeek(vbinary->fdes, 0, PETSC_BINARY_SEEK_END, &len));
+  PetscCall(PetscBinarySeek(vbinary->fdes, 0, PETSC_BINARY_SEEK_SET, &off));
+  if (!len) PetscFunctionReturn(PETSC_SUCCESS);
+  addr = mmap(NULL, (size_t)len, PROT_READ, MAP_PRIVATE, vbinary->fdes, 0);
+  if (addr == MAP_FAILED) {
+    PetscCall(PetscInfo(viewer, "Could not map file %s, errno %d, reading it instead\n", vbinary->filename, errno));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscNew(&map));
+  map->addr = addr;
+  map->len  = (size_t)len;
+  PetscCall(PetscContainerCreate(PETSC_COMM_SELF, &vbinary->mapping));
+  PetscCall(PetscContainerSetPointer(vbinary->mapping, map));
+  PetscCall(PetscContainerSetUserDestroy(vbinary->mapping, PetscViewerBinaryMappingDestroy_Private));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 static PetscErrorCode PetscViewerFileSetUp_BinarySTDIO(PetscViewer viewer)
 {
   PetscViewer_Binary *vbinary = (PetscViewer_Binary *)viewer->data;
@@ -1393,6 +1655,9 @@ static PetscErrorCode PetscViewerFileSetUp_BinarySTDIO(PetscViewer viewer)
       if (!found) mode = FILE_MODE_WRITE;
     }
     PetscCall(PetscBinaryOpen(fname, mode, &vbinary->fdes));
+#if defined(PETSC_HAVE_MMAP)
+    if (vbinary->usemmap && mode == FILE_MODE_READ) PetscCall(PetscViewerFileSetUp_BinaryMmap(viewer));
+#endif
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -1487,6 +1752,7 @@ static PetscErrorCode PetscViewerSetFromOptions_Binary(PetscViewer viewer, Petsc
 #else
   PetscCall(PetscOptionsBool("-viewer_binary_mpiio", "Use MPI-IO functionality to write/read binary file (NOT AVAILABLE)", "PetscViewerBinarySetUseMPIIO", PETSC_FALSE, NULL, NULL));
 #endif
+  PetscCall(PetscOptionsBool("-viewer_binary_mmap", "Map the binary file into memory when reading", "PetscViewerBinarySetUseMmap", binary->usemmap, &binary->usemmap, NULL));
   PetscOptionsHeadEnd();
   binary->setfromoptionscalled = PETSC_TRUE;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -1547,6 +1813,8 @@ PETSC_EXTERN PetscErrorCode PetscViewerCreate_Binary(PetscViewer v)
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetSkipInfo_C", PetscViewerBinaryGetSkipInfo_Binary));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetSkipInfo_C", PetscViewerBinarySetSkipInfo_Binary));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetInfoPointer_C", PetscViewerBinaryGetInfoPointer_Binary));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinaryGetUseMmap_C", PetscViewerBinaryGetUseMmap_Binary));
+  PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerBinarySetUseMmap_C", PetscViewerBinarySetUseMmap_Binary));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerFileGetName_C", PetscViewerFileGetName_Binary));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerFileSetName_C", PetscViewerFileSetName_Binary));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscViewerFileGetMode_C", PetscViewerFileGetMode_Binary));
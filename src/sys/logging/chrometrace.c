@@ -0,0 +1,275 @@
+/*
+     Records the begin and end time of every PETSc event into a buffer of bounded size on each MPI rank
+   and writes them at the end of the run as a Chrome trace, the JSON format read by chrome://tracing
+   and https://ui.perfetto.dev
+*/
+#include <petsc/private/logimpl.h> /*I "petsclog.h" I*/
+#include <petsctime.h>
+
+#if defined(PETSC_USE_LOG)
+
+typedef struct {
+  PetscLogDouble begin, end; /* times relative to petsc_BaseTime */
+  PetscLogDouble flops;      /* flops performed inside the event */
+  PetscLogEvent  event;
+  int            stage;
+} PetscChromeTraceRecord;
+
+typedef struct {
+  PetscChromeTraceRecord *records; /* ring buffer, once full the oldest records are overwritten */
+  PetscInt                size;    /* maximum number of records, the buffer grows up to it */
+  PetscInt                alloc;   /* number of records currently allocated */
+  PetscInt                head, count;
+  PetscInt64              dropped;
+  int                     maxevents; /* length of the per event arrays below */
+  int                    *depth;     /* nesting level of each event, only the outermost begin/end pair is recorded */
+  PetscLogDouble         *begin, *flops;
+} PetscChromeTrace;
+
+static PetscChromeTrace *chrometrace = NULL;
+
+/* the buffer starts small and is doubled as records are added, so short runs do not pay for the maximum size */
+#define PETSC_CHROME_TRACE_INITIAL_SIZE 4096
+
+static PetscErrorCode PetscChromeTraceGrow(void)
+{
+  PetscChromeTrace       *ct = chrometrace;
+  PetscChromeTraceRecord *records;
+  PetscInt                alloc = PetscMin(2 * ct->alloc, ct->size);
+
+  PetscFunctionBegin;
+  /* the buffer has not wrapped around yet, so the records are contiguous from the start */
+  PetscCall(PetscMalloc1(alloc, &records));
+  PetscCall(PetscArraycpy(records, ct->records, ct->count));
+  PetscCall(PetscFree(ct->records));
+  ct->records = records;
+  ct->alloc   = alloc;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscChromeTraceEnsureEvents(PetscLogEvent event)
+{
+  PetscChromeTrace *ct = chrometrace;
+  int               maxevents;
+  int              *depth;
+  PetscLogDouble   *begin, *flops;
+
+  PetscFunctionBegin;
+  if (event < ct->maxevents) PetscFunctionReturn(PETSC_SUCCESS);
+  maxevents = PetscMax(2 * ct->maxevents, event + 1);
+  PetscCall(PetscCalloc3(maxevents, &depth, maxevents, &begin, maxevents, &flops));
+  PetscCall(PetscArraycpy(depth, ct->depth, ct->maxevents));
+  PetscCall(PetscArraycpy(begin, ct->begin, ct->maxevents));
+  PetscCall(PetscArraycpy(flops, ct->flops, ct->maxevents));
+  PetscCall(PetscFree3(ct->depth, ct->begin, ct->flops));
+  ct->depth     = depth;
+  ct->begin     = begin;
+  ct->flops     = flops;
+  ct->maxevents = maxevents;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscLogEventBeginChromeTrace(PetscLogEvent event, int t, PetscObject o1, PetscObject o2, PetscObject o3, PetscObject o4)
+{
+  PetscChromeTrace *ct = chrometrace;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBeginDefault(event, t, o1, o2, o3, o4));
+  if (event >= ct->maxevents) PetscCall(PetscChromeTraceEnsureEvents(event));
+  if (ct->depth[event]++) PetscFunctionReturn(PETSC_SUCCESS);
+  ct->flops[event] = petsc_TotalFlops;
+  PetscCall(PetscTime(&ct->begin[event]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscLogEventEndChromeTrace(PetscLogEvent event, int t, PetscObject o1, PetscObject o2, PetscObject o3, PetscObject o4)
+{
+  PetscChromeTrace       *ct = chrometrace;
+  PetscChromeTraceRecord *rec;
+  PetscLogDouble          end;
+
+  PetscFunctionBegin;
+  PetscCall(PetscTime(&end));
+  PetscCall(PetscLogEventEndDefault(event, t, o1, o2, o3, o4));
+  /* events that were begun before tracing was turned on are not recorded */
+  if (event >= ct->maxevents || !ct->depth[event]) PetscFunctionReturn(PETSC_SUCCESS);
+  if (--ct->depth[event]) PetscFunctionReturn(PETSC_SUCCESS);
+  if (ct->head == ct->alloc && ct->alloc < ct->size) PetscCall(PetscChromeTraceGrow());
+  if (ct->head == ct->alloc) ct->head = 0;
+  rec        = &ct->records[ct->head];
+  rec->begin = ct->begin[event] - petsc_BaseTime;
+  rec->end   = end - petsc_BaseTime;
+  rec->flops = petsc_TotalFlops - ct->flops[event];
+  rec->event = event;
+  rec->stage = petsc_stageLog->curStage;
+  ct->head++;
+  if (ct->count < ct->size) ct->count++;
+  else ct->dropped++;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscLogChromeTraceBegin - Turns on recording of the begin and end time of every event in a form that can be
+  written as a Chrome trace with `PetscLogChromeTraceDump()`
+
+  Logically Collective on `PETSC_COMM_WORLD`
+
+  Input Parameter:
+. n - number of events kept on each MPI rank, or `PETSC_DECIDE` for the default of 1048576
+
+  Options Database Keys:
++ -log_chrome_trace [filename] - Activates `PetscLogChromeTraceBegin()` and writes the trace in `PetscFinalize()`, the default file is petsc_trace.json
+- -log_chrome_trace_size <n> - number of events kept on each rank
+
+  Level: advanced
+
+  Notes:
+  The times are kept in a buffer that starts small and is doubled as needed up to `n` events, so recording an event costs two timer calls
+  on top of the default logging. When the buffer is full the oldest events are overwritten, the trace then covers the last `n` events of
+  the run and `PetscLogView()` and `PetscLogChromeTraceDump()` print a warning with the number of dropped events.
+  Only the outermost begin and end of recursively nested calls of the same event are recorded.
+
+  This also does the default logging so that `PetscLogView()` may be used as well.
+
+  The trace shows one process for each MPI rank, the per-iteration timelines of events such as `MatMult()`, `PCApply()` and `VecScatterBegin()`
+  make load imbalance visible. The times are taken relative to `PetscInitialize()`, where all the ranks synchronize, so they are comparable
+  across ranks up to the drift of the clocks.
+
+.seealso: [](ch_profiling), `PetscLogChromeTraceDump()`, `PetscLogDefaultBegin()`, `PetscLogTraceBegin()`, `PetscLogView()`
+@*/
+PetscErrorCode PetscLogChromeTraceBegin(PetscInt n)
+{
+  PetscFunctionBegin;
+  if (!chrometrace) {
+    if (n == PETSC_DECIDE || n == PETSC_DEFAULT) n = 1048576;
+    PetscCheck(n > 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of events %" PetscInt_FMT " must be positive", n);
+    PetscCall(PetscNew(&chrometrace));
+    chrometrace->size  = n;
+    chrometrace->alloc = PetscMin(n, PETSC_CHROME_TRACE_INITIAL_SIZE);
+    PetscCall(PetscMalloc1(chrometrace->alloc, &chrometrace->records));
+  }
+  PetscCall(PetscLogSet(PetscLogEventBeginChromeTrace, PetscLogEventEndChromeTrace));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscLogChromeTraceEnd(void)
+{
+  PetscFunctionBegin;
+  if (!chrometrace) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFree(chrometrace->records));
+  PetscCall(PetscFree3(chrometrace->depth, chrometrace->begin, chrometrace->flops));
+  PetscCall(PetscFree(chrometrace));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* the total number of events dropped on all ranks, zero if no trace is being recorded */
+PetscErrorCode PetscLogChromeTraceGetDropped(MPI_Comm comm, PetscInt64 *dropped)
+{
+  PetscInt64 dr = chrometrace ? chrometrace->dropped : 0;
+
+  PetscFunctionBegin;
+  PetscCall(MPIU_Allreduce(&dr, dropped, 1, MPIU_INT64, MPI_SUM, comm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscChromeTraceWriteRecords(FILE *fd, PetscMPIInt rank, PetscInt n, const PetscChromeTraceRecord *records)
+{
+  PetscStageLog    stageLog = petsc_stageLog;
+  PetscEventRegLog eventLog = stageLog->eventLog;
+  PetscClassRegLog classLog = stageLog->classLog;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < n; i++) {
+    const PetscChromeTraceRecord *rec  = &records[i];
+    const char                   *name = "Unknown", *cat = "PETSc", *stage = "Unknown";
+
+    if (rec->event < eventLog->numEvents) {
+      name = eventLog->eventInfo[rec->event].name;
+      for (int c = 0; c < classLog->numClasses; c++) {
+        if (classLog->classInfo[c].classid == eventLog->eventInfo[rec->event].classid) {
+          cat = classLog->classInfo[c].name;
+          break;
+        }
+      }
+    }
+    if (rec->stage >= 0 && rec->stage < stageLog->numStages) stage = stageLog->stageInfo[rec->stage].name;
+    /* Chrome traces use microseconds */
+    PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":%d,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f,\"args\":{\"flops\":%.0f,\"stage\":\"%s\"}}", name, cat, rank, 1.e6 * rec->begin, 1.e6 * (rec->end - rec->begin), rec->flops, stage));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+  PetscLogChromeTraceDump - Writes the events recorded since `PetscLogChromeTraceBegin()` to a file in the Chrome trace JSON format
+
+  Collective on `PETSC_COMM_WORLD`
+
+  Input Parameter:
+. filename - the name of the file, or `NULL` for petsc_trace.json
+
+  Level: advanced
+
+  Notes:
+  The file is written by the first rank, the records of the other ranks are sent to it one rank at a time. It can be viewed with
+  chrome://tracing or https://ui.perfetto.dev
+
+  The event names are those registered on the first rank, so all the ranks must register the same events in the same order.
+
+  This is called by `PetscFinalize()` when the option -log_chrome_trace is given.
+
+.seealso: [](ch_profiling), `PetscLogChromeTraceBegin()`, `PetscLogDump()`, `PetscLogView()`
+@*/
+PetscErrorCode PetscLogChromeTraceDump(const char filename[])
+{
+  PetscChromeTrace       *ct = chrometrace;
+  PetscChromeTraceRecord *records;
+  PetscMPIInt             rank, size, cnt, tag;
+  PetscInt64              n, dropped = 0;
+  char                    fname[PETSC_MAX_PATH_LEN];
+  FILE                   *fd = NULL;
+  MPI_Comm                comm;
+
+  PetscFunctionBegin;
+  PetscCheck(ct, PETSC_COMM_SELF, PETSC_ERR_ORDER, "Must call PetscLogChromeTraceBegin() or use -log_chrome_trace before calling this routine");
+  PetscCall(PetscCommDuplicate(PETSC_COMM_WORLD, &comm, &tag));
+  PetscCallMPI(MPI_Comm_rank(comm, &rank));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  /* put the records in chronological order */
+  PetscCall(PetscMalloc1(ct->count, &records));
+  if (!ct->dropped) PetscCall(PetscArraycpy(records, ct->records, ct->count));
+  else {
+    PetscCall(PetscArraycpy(records, ct->records + ct->head, ct->size - ct->head));
+    PetscCall(PetscArraycpy(records + ct->size - ct->head, ct->records, ct->head));
+  }
+  PetscCall(PetscLogChromeTraceGetDropped(comm, &dropped));
+  if (dropped) PetscCall(PetscPrintf(comm, "WARNING! The Chrome trace buffers were too small, the first %" PetscInt64_FMT " events were dropped, increase -log_chrome_trace_size\n", dropped));
+  PetscCall(PetscFixFilename(filename && filename[0] ? filename : "petsc_trace.json", fname));
+  PetscCall(PetscFOpen(comm, fname, "w", &fd));
+  if (rank == 0) {
+    PetscCheck(fd, PETSC_COMM_SELF, PETSC_ERR_FILE_OPEN, "Cannot open file: %s", fname);
+    PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, "{\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped\":%" PetscInt64_FMT "},\"traceEvents\":[\n", dropped));
+    PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":0,\"args\":{\"name\":\"rank 0\"}}"));
+    PetscCall(PetscChromeTraceWriteRecords(fd, 0, ct->count, records));
+    for (PetscMPIInt r = 1; r < size; r++) {
+      PetscCall(PetscFree(records));
+      PetscCallMPI(MPI_Recv(&n, 1, MPIU_INT64, r, tag, comm, MPI_STATUS_IGNORE));
+      PetscCall(PetscMalloc1(n, &records));
+      PetscCall(PetscMPIIntCast(n * sizeof(PetscChromeTraceRecord), &cnt));
+      PetscCallMPI(MPI_Recv(records, cnt, MPI_BYTE, r, tag, comm, MPI_STATUS_IGNORE));
+      PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, ",\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"args\":{\"name\":\"rank %d\"}}", r, r));
+      PetscCall(PetscChromeTraceWriteRecords(fd, r, (PetscInt)n, records));
+    }
+    PetscCall(PetscFPrintf(PETSC_COMM_SELF, fd, "\n]}\n"));
+  } else {
+    n = ct->count;
+    PetscCall(PetscMPIIntCast(n * sizeof(PetscChromeTraceRecord), &cnt));
+    PetscCallMPI(MPI_Send(&n, 1, MPIU_INT64, 0, tag, comm));
+    PetscCallMPI(MPI_Send(records, cnt, MPI_BYTE, 0, tag, comm));
+  }
+  PetscCall(PetscFree(records));
+  PetscCall(PetscFClose(comm, fd));
+  PetscCall(PetscCommDestroy(&comm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#endif
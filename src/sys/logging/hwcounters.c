@@ -0,0 +1,126 @@
+/*
+     Reads the hardware performance counters of the processor (cycles, instructions and last level cache misses)
+   through the Linux perf_event_open() system call so that they can be accumulated for each event and stage
+*/
+#include <petsc/private/logimpl.h> /*I "petsclog.h" I*/
+
+#if defined(PETSC_USE_LOG)
+
+  #if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+    #include <linux/perf_event.h>
+    #include <sys/syscall.h>
+    #include <sys/ioctl.h>
+    #include <unistd.h>
+    #include <errno.h>
+
+    #define PETSC_LOG_HW_NUM 3
+
+static int hwleader = -1;                                            /* group leader, reading it returns all the counters at once */
+static int hwfd[PETSC_LOG_HW_NUM], hwidx[PETSC_LOG_HW_NUM], hwnum = 0; /* open counters, in the order they are returned by read() */
+
+  #endif
+
+/*@C
+  PetscLogHWCountersBegin - Turns on the collection of hardware performance counters for each event and stage
+
+  Logically Collective on `PETSC_COMM_WORLD`
+
+  Options Database Key:
+. -log_view_hwcounters - Collect the counters and display them with `-log_view`
+
+  Level: advanced
+
+  Notes:
+  The number of CPU cycles, the number of instructions retired and the number of last level cache misses are obtained from the Linux
+  `perf_event_open()` system call, no additional package is needed. They are displayed by `PetscLogView()` as the instructions per cycle (IPC),
+  the number of cache misses and the memory bandwidth estimated from the cache misses times the cache line size. This bandwidth is a lower
+  bound since the lines loaded by the hardware prefetchers and the write backs are not counted as misses. A high bandwidth
+  together with a low IPC indicates an event bound by the memory bandwidth, a low bandwidth and a low IPC an event bound by the memory latency
+  or one whose traffic is mostly prefetched.
+
+  The counters that the processor or the kernel do not provide, for example inside virtual machines or when
+  /proc/sys/kernel/perf_event_paranoid does not allow user space measurements, are silently skipped, see `PetscInfo()` for the reason.
+  Only the thread that calls this routine is measured, threads started by OpenMP are not included.
+
+  This must be called after `PetscLogDefaultBegin()` and before the events of interest are executed. Reading the counters costs a system call
+  at each event begin and end.
+
+.seealso: [](ch_profiling), `PetscLogView()`, `PetscLogDefaultBegin()`, `PetscLogEventGetPerfInfo()`
+@*/
+PetscErrorCode PetscLogHWCountersBegin(void)
+{
+  PetscFunctionBegin;
+  if (PetscLogHWCounters) PetscFunctionReturn(PETSC_SUCCESS);
+  #if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  {
+    const unsigned long long config[PETSC_LOG_HW_NUM] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CACHE_MISSES};
+    const char              *names[PETSC_LOG_HW_NUM]  = {"cycles", "instructions", "cache misses"};
+
+    for (int i = 0; i < PETSC_LOG_HW_NUM; i++) {
+      struct perf_event_attr attr;
+      int                    fd;
+
+      PetscCall(PetscMemzero(&attr, sizeof(attr)));
+      attr.size           = sizeof(attr);
+      attr.type           = PERF_TYPE_HARDWARE;
+      attr.config         = config[i];
+      attr.disabled       = hwleader < 0 ? 1 : 0;
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      attr.read_format    = PERF_FORMAT_GROUP;
+      fd                  = (int)syscall(__NR_perf_event_open, &attr, 0, -1, hwleader, 0);
+      if (fd < 0) {
+        PetscCall(PetscInfo(NULL, "Unable to open the hardware counter for %s: %s\n", names[i], strerror(errno)));
+        continue;
+      }
+      if (hwleader < 0) hwleader = fd;
+      hwfd[hwnum]    = fd;
+      hwidx[hwnum++] = i;
+    }
+    if (!hwnum) {
+      PetscCall(PetscInfo(NULL, "No hardware counters available, they will not be logged\n"));
+      PetscFunctionReturn(PETSC_SUCCESS);
+    }
+    PetscCheck(!ioctl(hwleader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP), PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to reset the hardware counters: %s", strerror(errno));
+    PetscCheck(!ioctl(hwleader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP), PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to enable the hardware counters: %s", strerror(errno));
+    PetscCall(PetscInfo(NULL, "Logging %d hardware counters\n", hwnum));
+    PetscLogHWCounters = PETSC_TRUE;
+  }
+  #else
+  PetscCall(PetscInfo(NULL, "Hardware counters require Linux perf_event_open(), they will not be logged\n"));
+  #endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   PetscLogHWCountersGet - Gets the current values of the counters, cycles, instructions and cache misses, in that order;
+   the counters that are not available are zero
+*/
+PetscErrorCode PetscLogHWCountersGet(PetscLogDouble values[])
+{
+  PetscFunctionBegin;
+  values[0] = values[1] = values[2] = 0.0;
+  #if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  if (hwnum) {
+    unsigned long long buf[1 + PETSC_LOG_HW_NUM];
+
+    PetscCheck(read(hwleader, buf, sizeof(buf)) > 0, PETSC_COMM_SELF, PETSC_ERR_SYS, "Unable to read the hardware counters: %s", strerror(errno));
+    for (unsigned long long i = 0; i < buf[0]; i++) values[hwidx[i]] = (PetscLogDouble)buf[1 + i];
+  }
+  #endif
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscLogHWCountersEnd(void)
+{
+  PetscFunctionBegin;
+  #if defined(PETSC_HAVE_LINUX_PERF_EVENT_H)
+  for (int i = hwnum - 1; i >= 0; i--) (void)close(hwfd[i]);
+  hwnum    = 0;
+  hwleader = -1;
+  #endif
+  PetscLogHWCounters = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+#endif
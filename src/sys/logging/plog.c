@@ -215,6 +215,8 @@ PETSC_INTERN PetscErrorCode PetscLogFinalize(void)
   PetscCall(PetscFree(petsc_actions));
   PetscCall(PetscFree(petsc_objects));
   PetscCall(PetscLogNestedEnd());
+  PetscCall(PetscLogChromeTraceEnd());
+  PetscCall(PetscLogHWCountersEnd());
   PetscCall(PetscLogSet(NULL, NULL));
 
   /* Resetting phase */
@@ -1474,6 +1476,7 @@ PetscErrorCode PetscLogView_CSV(PetscViewer viewer)
   int                 numStages, numEvents, stage, event;
   MPI_Comm            comm = PetscObjectComm((PetscObject)viewer);
   PetscMPIInt         rank, size;
+  PetscBool           hwcounters;
 
   PetscFunctionBegin;
   PetscCallMPI(MPI_Comm_size(comm, &size));
@@ -1484,19 +1487,23 @@ PetscErrorCode PetscLogView_CSV(PetscViewer viewer)
   locTotalTime -= petsc_BaseTime;
   PetscCall(PetscLogGetStageLog(&stageLog));
   PetscCallMPI(MPI_Allreduce(&stageLog->numStages, &numStages, 1, MPI_INT, MPI_MAX, comm));
+  PetscCallMPI(MPI_Allreduce(&PetscLogHWCounters, &hwcounters, 1, MPIU_BOOL, MPI_LOR, comm));
   PetscCall(PetscMallocGetMaximumUsage(&maxMem));
   PetscCall(PetscViewerASCIIPushSynchronized(viewer));
-  PetscCall(PetscViewerASCIIPrintf(viewer, "Stage Name,Event Name,Rank,Count,Time,Num Messages,Message Length,Num Reductions,FLOP,dof0,dof1,dof2,dof3,dof4,dof5,dof6,dof7,e0,e1,e2,e3,e4,e5,e6,e7,%d\n", size));
+  PetscCall(PetscViewerASCIIPrintf(viewer, "Stage Name,Event Name,Rank,Count,Time,Num Messages,Message Length,Num Reductions,FLOP,%sdof0,dof1,dof2,dof3,dof4,dof5,dof6,dof7,e0,e1,e2,e3,e4,e5,e6,e7,%d\n", hwcounters ? "Cycles,Instructions,LLC Misses," : "", size));
   PetscCall(PetscViewerFlush(viewer));
   for (stage = 0; stage < numStages; stage++) {
     PetscEventPerfInfo *stageInfo = &stageLog->stageInfo[stage].perfInfo;
 
-    PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "%s,summary,%d,1,%g,%g,%g,%g,%g\n", stageLog->stageInfo[stage].name, rank, stageInfo->time, stageInfo->numMessages, stageInfo->messageLength, stageInfo->numReductions, stageInfo->flops));
+    PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "%s,summary,%d,1,%g,%g,%g,%g,%g", stageLog->stageInfo[stage].name, rank, stageInfo->time, stageInfo->numMessages, stageInfo->messageLength, stageInfo->numReductions, stageInfo->flops));
+    if (hwcounters) PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, ",%g,%g,%g", stageInfo->hwCycles, stageInfo->hwInstructions, stageInfo->hwCacheMisses));
+    PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "\n"));
     PetscCallMPI(MPI_Allreduce(&stageLog->stageInfo[stage].eventLog->numEvents, &numEvents, 1, MPI_INT, MPI_MAX, comm));
     for (event = 0; event < numEvents; event++) {
       eventInfo = &stageLog->stageInfo[stage].eventLog->eventInfo[event];
       PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, "%s,%s,%d,%d,%g,%g,%g,%g,%g", stageLog->stageInfo[stage].name, stageLog->eventLog->eventInfo[event].name, rank, eventInfo->count, eventInfo->time, eventInfo->numMessages, eventInfo->messageLength,
                                                    eventInfo->numReductions, eventInfo->flops));
+      if (hwcounters) PetscCall(PetscViewerASCIISynchronizedPrintf(viewer, ",%g,%g,%g", eventInfo->hwCycles, eventInfo->hwInstructions, eventInfo->hwCacheMisses));
       if (eventInfo->dof[0] >= 0.) {
         PetscInt d, e;
 
@@ -1511,6 +1518,18 @@ PetscErrorCode PetscLogView_CSV(PetscViewer viewer)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* prints the hardware counters columns of PetscLogView_Default(), the counters are summed over all processes */
+static PetscErrorCode PetscLogViewHWCounters(MPI_Comm comm, FILE *fd, const PetscLogDouble hwtot[], PetscLogDouble time)
+{
+  PetscLogDouble ipc = 0.0, bandwidth = 0.0;
+
+  PetscFunctionBegin;
+  if (hwtot[0] > 0.0) ipc = hwtot[1] / hwtot[0];
+  if (time > 0.0) bandwidth = hwtot[2] * PETSC_LEVEL1_DCACHE_LINESIZE / time;
+  PetscCall(PetscFPrintf(comm, fd, " %8.2e %4.2f %8.2e %6.2f", hwtot[0], ipc, hwtot[2], bandwidth / 1.0e9));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 static PetscErrorCode PetscLogViewWarnSync(MPI_Comm comm, FILE *fd)
 {
   PetscFunctionBegin;
@@ -1608,6 +1627,26 @@ static PetscErrorCode PetscLogViewWarnGpuTime(MPI_Comm comm, FILE *fd)
   #endif
 }
 
+static PetscErrorCode PetscLogViewWarnChromeTrace(MPI_Comm comm, FILE *fd)
+{
+  PetscInt64 dropped;
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogChromeTraceGetDropped(comm, &dropped));
+  if (!dropped) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscFPrintf(comm, fd, "\n\n"));
+  PetscCall(PetscFPrintf(comm, fd, "      ##########################################################\n"));
+  PetscCall(PetscFPrintf(comm, fd, "      #                                                        #\n"));
+  PetscCall(PetscFPrintf(comm, fd, "      #                       WARNING!!!                       #\n"));
+  PetscCall(PetscFPrintf(comm, fd, "      #                                                        #\n"));
+  PetscCall(PetscFPrintf(comm, fd, "      #   The Chrome trace buffers were too small, the first   #\n"));
+  PetscCall(PetscFPrintf(comm, fd, "      #   events of the run were dropped from the trace.       #\n"));
+  PetscCall(PetscFPrintf(comm, fd, "      #   Increase -log_chrome_trace_size to keep them.        #\n"));
+  PetscCall(PetscFPrintf(comm, fd, "      #                                                        #\n"));
+  PetscCall(PetscFPrintf(comm, fd, "      ##########################################################\n\n\n"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode PetscLogView_Default(PetscViewer viewer)
 {
   FILE               *fd;
@@ -1625,6 +1664,8 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   PetscLogDouble      fracStageTime, fracStageFlops, fracStageMess, fracStageMessLen, fracStageRed;
   PetscLogDouble      min, max, tot, ratio, avg, x, y;
   PetscLogDouble      minf, maxf, totf, ratf, mint, maxt, tott, ratt, ratC, totm, totml, totr, mal, malmax, emalmax;
+  PetscLogDouble      hw[3], hwtot[3];
+  PetscBool           hwcounters;
   #if defined(PETSC_HAVE_DEVICE)
   PetscLogEvent  KSP_Solve, SNES_Solve, TS_Step, TAO_Solve; /* These need to be fixed to be some events registered with certain objects */
   PetscLogDouble cct, gct, csz, gsz, gmaxt, gflops, gflopr, fracgflops;
@@ -1652,6 +1693,8 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   /* Get the total elapsed time */
   PetscCall(PetscTime(&locTotalTime));
   locTotalTime -= petsc_BaseTime;
+  /* the processes where the hardware counters could not be opened contribute zeros */
+  PetscCallMPI(MPI_Allreduce(&PetscLogHWCounters, &hwcounters, 1, MPIU_BOOL, MPI_LOR, comm));
 
   PetscCall(PetscFPrintf(comm, fd, "****************************************************************************************************************************************************************\n"));
   PetscCall(PetscFPrintf(comm, fd, "***                                WIDEN YOUR WINDOW TO 160 CHARACTERS.  Use 'enscript -r -fCourier9' to print this document                                 ***\n"));
@@ -1661,6 +1704,7 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   PetscCall(PetscLogViewWarnDebugging(comm, fd));
   PetscCall(PetscLogViewWarnNoGpuAwareMpi(comm, fd));
   PetscCall(PetscLogViewWarnGpuTime(comm, fd));
+  PetscCall(PetscLogViewWarnChromeTrace(comm, fd));
   PetscCall(PetscGetArchType(arch, sizeof(arch)));
   PetscCall(PetscGetHostName(hostname, sizeof(hostname)));
   PetscCall(PetscGetUserName(username, sizeof(username)));
@@ -1789,8 +1833,11 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
     PetscCallMPI(MPI_Allreduce(localStageVisible, stageVisible, numStages, MPIU_BOOL, MPI_LAND, comm));
     for (stage = 0; stage < numStages; stage++) {
       if (stageUsed[stage]) {
-        PetscCall(PetscFPrintf(comm, fd, "\nSummary of Stages:   ----- Time ------  ----- Flop ------  --- Messages ---  -- Message Lengths --  -- Reductions --\n"));
-        PetscCall(PetscFPrintf(comm, fd, "                        Avg     %%Total     Avg     %%Total    Count   %%Total     Avg         %%Total    Count   %%Total\n"));
+        PetscCall(PetscFPrintf(comm, fd, "\nSummary of Stages:   ----- Time ------  ----- Flop ------  --- Messages ---  -- Message Lengths --  -- Reductions --"));
+        if (hwcounters) PetscCall(PetscFPrintf(comm, fd, " ----- Hardware Counters -----"));
+        PetscCall(PetscFPrintf(comm, fd, "\n                        Avg     %%Total     Avg     %%Total    Count   %%Total     Avg         %%Total    Count   %%Total"));
+        if (hwcounters) PetscCall(PetscFPrintf(comm, fd, "   Cycles  IPC  LLCMiss   GB/s"));
+        PetscCall(PetscFPrintf(comm, fd, "\n"));
         break;
       }
     }
@@ -1803,6 +1850,11 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
         PetscCallMPI(MPI_Allreduce(&stageInfo[stage].perfInfo.numMessages, &mess, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         PetscCallMPI(MPI_Allreduce(&stageInfo[stage].perfInfo.messageLength, &messLen, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         PetscCallMPI(MPI_Allreduce(&stageInfo[stage].perfInfo.numReductions, &red, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
+        if (hwcounters) {
+          hw[0] = stageInfo[stage].perfInfo.hwCycles;
+          hw[1] = stageInfo[stage].perfInfo.hwInstructions;
+          hw[2] = stageInfo[stage].perfInfo.hwCacheMisses;
+        }
         name = stageInfo[stage].name;
       } else {
         PetscCallMPI(MPI_Allreduce(&zero, &stageTime, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
@@ -1810,8 +1862,10 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
         PetscCallMPI(MPI_Allreduce(&zero, &mess, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         PetscCallMPI(MPI_Allreduce(&zero, &messLen, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         PetscCallMPI(MPI_Allreduce(&zero, &red, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
+        hw[0] = hw[1] = hw[2] = 0.0;
         name = "";
       }
+      if (hwcounters) PetscCallMPI(MPI_Allreduce(hw, hwtot, 3, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
       mess *= 0.5;
       messLen *= 0.5;
       red /= size;
@@ -1828,7 +1882,9 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
       else fracLength = 0.0;
       if (numReductions != 0.0) fracReductions = red / numReductions;
       else fracReductions = 0.0;
-      PetscCall(PetscFPrintf(comm, fd, "%2d: %15s: %6.4e %5.1f%%  %6.4e %5.1f%%  %5.3e %5.1f%%  %5.3e      %5.1f%%  %5.3e %5.1f%%\n", stage, name, stageTime / size, 100.0 * fracTime, flops, 100.0 * fracFlops, mess, 100.0 * fracMessages, avgMessLen, 100.0 * fracLength, red, 100.0 * fracReductions));
+      PetscCall(PetscFPrintf(comm, fd, "%2d: %15s: %6.4e %5.1f%%  %6.4e %5.1f%%  %5.3e %5.1f%%  %5.3e      %5.1f%%  %5.3e %5.1f%%", stage, name, stageTime / size, 100.0 * fracTime, flops, 100.0 * fracFlops, mess, 100.0 * fracMessages, avgMessLen, 100.0 * fracLength, red, 100.0 * fracReductions));
+      if (hwcounters) PetscCall(PetscLogViewHWCounters(comm, fd, hwtot, stageTime / size));
+      PetscCall(PetscFPrintf(comm, fd, "\n"));
     }
   }
 
@@ -1847,6 +1903,11 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   PetscCall(PetscFPrintf(comm, fd, "      %%M - percent messages in this phase     %%L - percent message lengths in this phase\n"));
   PetscCall(PetscFPrintf(comm, fd, "      %%R - percent reductions in this phase\n"));
   PetscCall(PetscFPrintf(comm, fd, "   Total Mflop/s: 10e-6 * (sum of flop over all processors)/(max time over all processors)\n"));
+  if (hwcounters) {
+    PetscCall(PetscFPrintf(comm, fd, "   Cycles: sum of CPU cycles over all processors   IPC: instructions per cycle\n"));
+    PetscCall(PetscFPrintf(comm, fd, "   LLCMiss: sum of last level cache misses over all processors\n"));
+    PetscCall(PetscFPrintf(comm, fd, "   GB/s: 10e-9 * (LLCMiss * %d bytes cache line)/(max time over all processors, average time for stages), a lower bound as prefetches are not counted\n", PETSC_LEVEL1_DCACHE_LINESIZE));
+  }
   if (PetscLogMemory) {
     PetscCall(PetscFPrintf(comm, fd, "   Malloc Mbytes: Memory allocated and kept during event (sum over all calls to event). May be negative\n"));
     PetscCall(PetscFPrintf(comm, fd, "   EMalloc Mbytes: extra memory allocated during event and then freed (maximum over all calls to events). Never negative\n"));
@@ -1868,18 +1929,21 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   /* Report events */
   PetscCall(PetscFPrintf(comm, fd, "Event                Count      Time (sec)     Flop                              --- Global ---  --- Stage ----  Total"));
   if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, "  Malloc EMalloc MMalloc RMI"));
+  if (hwcounters) PetscCall(PetscFPrintf(comm, fd, " ----- Hardware Counters -----"));
   #if defined(PETSC_HAVE_DEVICE)
   PetscCall(PetscFPrintf(comm, fd, "   GPU    - CpuToGpu -   - GpuToCpu - GPU"));
   #endif
   PetscCall(PetscFPrintf(comm, fd, "\n"));
   PetscCall(PetscFPrintf(comm, fd, "                   Max Ratio  Max     Ratio   Max  Ratio  Mess   AvgLen  Reduct  %%T %%F %%M %%L %%R  %%T %%F %%M %%L %%R Mflop/s"));
   if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, " Mbytes Mbytes Mbytes Mbytes"));
+  if (hwcounters) PetscCall(PetscFPrintf(comm, fd, "   Cycles  IPC  LLCMiss   GB/s"));
   #if defined(PETSC_HAVE_DEVICE)
   PetscCall(PetscFPrintf(comm, fd, " Mflop/s Count   Size   Count   Size  %%F"));
   #endif
   PetscCall(PetscFPrintf(comm, fd, "\n"));
   PetscCall(PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------"));
   if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, "-----------------------------"));
+  if (hwcounters) PetscCall(PetscFPrintf(comm, fd, "------------------------------"));
   #if defined(PETSC_HAVE_DEVICE)
   PetscCall(PetscFPrintf(comm, fd, "---------------------------------------"));
   #endif
@@ -1951,6 +2015,12 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
           PetscCallMPI(MPI_Allreduce(&eventInfo[event].mallocIncrease, &malmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
           PetscCallMPI(MPI_Allreduce(&eventInfo[event].mallocIncreaseEvent, &emalmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         }
+        if (hwcounters) {
+          hw[0] = eventInfo[event].hwCycles;
+          hw[1] = eventInfo[event].hwInstructions;
+          hw[2] = eventInfo[event].hwCacheMisses;
+          PetscCallMPI(MPI_Allreduce(hw, hwtot, 3, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
+        }
   #if defined(PETSC_HAVE_DEVICE)
         PetscCallMPI(MPI_Allreduce(&eventInfo[event].CpuToGpuCount, &cct, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         PetscCallMPI(MPI_Allreduce(&eventInfo[event].GpuToCpuCount, &gct, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
@@ -1981,6 +2051,10 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
           PetscCallMPI(MPI_Allreduce(&zero, &malmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
           PetscCallMPI(MPI_Allreduce(&zero, &emalmax, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         }
+        if (hwcounters) {
+          hw[0] = hw[1] = hw[2] = 0.0;
+          PetscCallMPI(MPI_Allreduce(hw, hwtot, 3, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
+        }
   #if defined(PETSC_HAVE_DEVICE)
         PetscCallMPI(MPI_Allreduce(&zero, &cct, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
         PetscCallMPI(MPI_Allreduce(&zero, &gct, 1, MPIU_PETSCLOGDOUBLE, MPI_SUM, comm));
@@ -2047,6 +2121,7 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
         else
           PetscCall(PetscFPrintf(comm, fd, "%-16s %7d %3.1f %5.4e %3.1f %3.2e %3.1f %2.1e %2.1e %2.1e %2.0f %2.0f %2.0f %2.0f %2.0f %3.0f %2.0f %2.0f %2.0f %2.0f %5.0f", name, maxC, ratC, maxt, ratt, maxf, ratf, totm, totml, totr, 100.0 * fracTime, 100.0 * fracFlops, 100.0 * fracMess, 100.0 * fracMessLen, 100.0 * fracRed, 100.0 * fracStageTime, 100.0 * fracStageFlops, 100.0 * fracStageMess, 100.0 * fracStageMessLen, 100.0 * fracStageRed, PetscAbs(flopr) / 1.0e6));
         if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, " %5.0f   %5.0f   %5.0f   %5.0f", mal / 1.0e6, emalmax / 1.0e6, malmax / 1.0e6, mem / 1.0e6));
+        if (hwcounters) PetscCall(PetscLogViewHWCounters(comm, fd, hwtot, maxt));
   #if defined(PETSC_HAVE_DEVICE)
         if (totf != 0.0) fracgflops = gflops / totf;
         else fracgflops = 0.0;
@@ -2062,6 +2137,7 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   /* Memory usage and object creation */
   PetscCall(PetscFPrintf(comm, fd, "------------------------------------------------------------------------------------------------------------------------"));
   if (PetscLogMemory) PetscCall(PetscFPrintf(comm, fd, "-----------------------------"));
+  if (hwcounters) PetscCall(PetscFPrintf(comm, fd, "------------------------------"));
   #if defined(PETSC_HAVE_DEVICE)
   PetscCall(PetscFPrintf(comm, fd, "---------------------------------------"));
   #endif
@@ -2173,6 +2249,7 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
   PetscCall(PetscFPrintf(comm, fd, "\n"));
   PetscCall(PetscLogViewWarnNoGpuAwareMpi(comm, fd));
   PetscCall(PetscLogViewWarnDebugging(comm, fd));
+  PetscCall(PetscLogViewWarnChromeTrace(comm, fd));
   PetscCall(PetscFPTrapPop());
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -2191,6 +2268,7 @@ PetscErrorCode PetscLogView_Default(PetscViewer viewer)
 .  -log_view :filename.xml:ascii_xml - Saves a summary of the logging information in a nested format (see below for how to view it)
 .  -log_view :filename.txt:ascii_flamegraph - Saves logging information in a format suitable for visualising as a Flame Graph (see below for how to view it)
 .  -log_view_memory - Also display memory usage in each event
+.  -log_view_hwcounters - Also display the hardware counters (cycles, instructions per cycle, cache misses and memory bandwidth) of each event, see `PetscLogHWCountersBegin()`
 .  -log_view_gpu_time - Also display time in each event for GPU kernels (Note this may slow the computation)
 .  -log_all - Saves a file Log.rank for each MPI rank with details of each step of the computation
 -  -log_trace [filename] - Displays a trace of what each process is doing
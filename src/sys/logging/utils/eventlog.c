@@ -12,7 +12,8 @@
 #endif
 
 PetscBool PetscLogSyncOn = PETSC_FALSE;
-PetscBool PetscLogMemory = PETSC_FALSE;
+PetscBool PetscLogMemory     = PETSC_FALSE;
+PetscBool PetscLogHWCounters = PETSC_FALSE;
 #if defined(PETSC_HAVE_DEVICE)
 PetscBool PetscLogGpuTraffic = PETSC_FALSE;
 #endif
@@ -175,6 +176,9 @@ PetscErrorCode PetscEventPerfInfoClear(PetscEventPerfInfo *eventInfo)
   eventInfo->numMessages   = 0.0;
   eventInfo->messageLength = 0.0;
   eventInfo->numReductions = 0.0;
+  eventInfo->hwCycles       = 0.0;
+  eventInfo->hwInstructions = 0.0;
+  eventInfo->hwCacheMisses  = 0.0;
 #if defined(PETSC_HAVE_DEVICE)
   eventInfo->CpuToGpuCount = 0.0;
   eventInfo->GpuToCpuCount = 0.0;
@@ -254,6 +258,9 @@ PetscErrorCode PetscEventPerfInfoAdd(PetscEventPerfInfo *eventInfo, PetscEventPe
   outInfo->mallocSpace += eventInfo->mallocSpace;
   outInfo->mallocIncreaseEvent += eventInfo->mallocIncreaseEvent;
   outInfo->mallocIncrease += eventInfo->mallocIncrease;
+  outInfo->hwCycles += eventInfo->hwCycles;
+  outInfo->hwInstructions += eventInfo->hwInstructions;
+  outInfo->hwCacheMisses += eventInfo->hwCacheMisses;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -863,6 +870,13 @@ PetscErrorCode PetscLogEventBeginDefault(PetscLogEvent event, int t, PetscObject
     eventInfo->mallocIncrease -= usage;
     PetscCall(PetscMallocPushMaximumUsage((int)event));
   }
+  if (PetscLogHWCounters) {
+    PetscLogDouble hw[3];
+    PetscCall(PetscLogHWCountersGet(hw));
+    eventInfo->hwCycles -= hw[0];
+    eventInfo->hwInstructions -= hw[1];
+    eventInfo->hwCacheMisses -= hw[2];
+  }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -923,6 +937,13 @@ PetscErrorCode PetscLogEventEndDefault(PetscLogEvent event, int t, PetscObject o
     PetscCall(PetscMallocGetMaximumUsage(&usage));
     eventInfo->mallocIncrease += usage; /* MMalloc */
   }
+  if (PetscLogHWCounters) {
+    PetscLogDouble hw[3];
+    PetscCall(PetscLogHWCountersGet(hw));
+    eventInfo->hwCycles += hw[0];
+    eventInfo->hwInstructions += hw[1];
+    eventInfo->hwCacheMisses += hw[2];
+  }
 #if defined(PETSC_HAVE_THREADSAFETY)
   PetscCall(PetscSpinlockLock(&PetscLogSpinLock));
   PetscCall(PetscEventPerfInfoAdd(eventInfo, eventLog->eventInfo + event));
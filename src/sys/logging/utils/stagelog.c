@@ -201,6 +201,20 @@ PetscErrorCode PetscStageLogRegister(PetscStageLog stageLog, const char sname[],
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Adds (sign 1) or subtracts (sign -1) the current hardware counters, see PetscLogHWCountersBegin() */
+static inline PetscErrorCode PetscStageLogAddHWCounters(PetscEventPerfInfo *perfInfo, PetscLogDouble sign)
+{
+  PetscLogDouble hw[3];
+
+  PetscFunctionBegin;
+  if (!PetscLogHWCounters) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscLogHWCountersGet(hw));
+  perfInfo->hwCycles += sign * hw[0];
+  perfInfo->hwInstructions += sign * hw[1];
+  perfInfo->hwCacheMisses += sign * hw[2];
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
   PetscStageLogPush - This function pushes a stage on the stack.
 
@@ -254,6 +268,7 @@ PetscErrorCode PetscStageLogPush(PetscStageLog stageLog, int stage)
       stageLog->stageInfo[curStage].perfInfo.numMessages += petsc_irecv_ct + petsc_isend_ct + petsc_recv_ct + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+      PetscCall(PetscStageLogAddHWCounters(&stageLog->stageInfo[curStage].perfInfo, 1.0));
     }
   }
   /* Activate the stage */
@@ -269,6 +284,7 @@ PetscErrorCode PetscStageLogPush(PetscStageLog stageLog, int stage)
     stageLog->stageInfo[stage].perfInfo.numMessages -= petsc_irecv_ct + petsc_isend_ct + petsc_recv_ct + petsc_send_ct;
     stageLog->stageInfo[stage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[stage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+    PetscCall(PetscStageLogAddHWCounters(&stageLog->stageInfo[stage].perfInfo, -1.0));
   }
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -317,6 +333,7 @@ PetscErrorCode PetscStageLogPop(PetscStageLog stageLog)
     stageLog->stageInfo[curStage].perfInfo.numMessages += petsc_irecv_ct + petsc_isend_ct + petsc_recv_ct + petsc_send_ct;
     stageLog->stageInfo[curStage].perfInfo.messageLength += petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
     stageLog->stageInfo[curStage].perfInfo.numReductions += petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+    PetscCall(PetscStageLogAddHWCounters(&stageLog->stageInfo[curStage].perfInfo, 1.0));
   }
   PetscCall(PetscIntStackEmpty(stageLog->stack, &empty));
   if (!empty) {
@@ -328,6 +345,7 @@ PetscErrorCode PetscStageLogPop(PetscStageLog stageLog)
       stageLog->stageInfo[curStage].perfInfo.numMessages -= petsc_irecv_ct + petsc_isend_ct + petsc_recv_ct + petsc_send_ct;
       stageLog->stageInfo[curStage].perfInfo.messageLength -= petsc_irecv_len + petsc_isend_len + petsc_recv_len + petsc_send_len;
       stageLog->stageInfo[curStage].perfInfo.numReductions -= petsc_allreduce_ct + petsc_gather_ct + petsc_scatter_ct;
+      PetscCall(PetscStageLogAddHWCounters(&stageLog->stageInfo[curStage].perfInfo, -1.0));
     }
     stageLog->curStage = curStage;
   } else stageLog->curStage = -1;
@@ -556,6 +556,18 @@ PETSC_INTERN PetscErrorCode PetscOptionsCheckInitial_Private(const char help[])
     PetscCall(PetscOptionsGetReal(NULL, NULL, "-log_threshold", &threshold, &flg1));
     if (flg1) PetscCall(PetscLogSetThreshold((PetscLogDouble)threshold, NULL));
   }
+
+  PetscCall(PetscOptionsHasName(NULL, NULL, "-log_chrome_trace", &flg1));
+  if (flg1) {
+    PetscInt n = PETSC_DECIDE;
+
+    PetscCheck(!flg4 || (format != PETSC_VIEWER_ASCII_XML && format != PETSC_VIEWER_ASCII_FLAMEGRAPH), comm, PETSC_ERR_SUP, "-log_chrome_trace cannot be used with nested -log_view formats");
+    PetscCall(PetscOptionsGetInt(NULL, NULL, "-log_chrome_trace_size", &n, NULL));
+    PetscCall(PetscLogChromeTraceBegin(n));
+  }
+  flg1 = PETSC_FALSE;
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-log_view_hwcounters", &flg1, NULL));
+  if (flg1) PetscCall(PetscLogHWCountersBegin());
 #endif
 
   PetscCall(PetscOptionsGetBool(NULL, NULL, "-saws_options", &PetscOptionsPublish, NULL));
@@ -605,6 +617,9 @@ PETSC_INTERN PetscErrorCode PetscOptionsCheckInitial_Private(const char help[])
     PetscCall((*PetscHelpPrintf)(comm, " -get_total_flops: total flops over all processors\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -log_view [:filename:[format]]: logging objects and events\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -log_trace [filename]: prints trace of all PETSc calls\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_chrome_trace [filename]: saves a Chrome trace (JSON) of all PETSc events at the end of the run\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_chrome_trace_size <n>: number of events kept on each rank for -log_chrome_trace\n"));
+    PetscCall((*PetscHelpPrintf)(comm, " -log_view_hwcounters: include the hardware counters of each event in -log_view\n"));
     PetscCall((*PetscHelpPrintf)(comm, " -log_exclude <list,of,classnames>: exclude given classes from logging\n"));
   #if defined(PETSC_HAVE_DEVICE)
     PetscCall((*PetscHelpPrintf)(comm, " -log_view_gpu_time: log the GPU time for each and event\n"));
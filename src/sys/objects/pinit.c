@@ -1181,8 +1181,11 @@ PETSC_INTERN PetscErrorCode PetscInitialize_Common(const char *prog, const char
         however it slows things down and gives a distorted view of the overall runtime.
 .  -log_trace [filename] - Print traces of all PETSc calls to the screen (useful to determine where a program
         hangs without running in the debugger).  See `PetscLogTraceBegin()`.
+.  -log_chrome_trace [filename] - Saves the begin and end times of all events in a Chrome trace (JSON) file, see `PetscLogChromeTraceBegin()`.
+.  -log_chrome_trace_size <n> - number of events kept on each rank for -log_chrome_trace
 .  -log_view [:filename:format] - Prints summary of flop and timing information to screen or file, see `PetscLogView()`.
 .  -log_view_memory - Includes in the summary from -log_view the memory used in each event, see `PetscLogView()`.
+.  -log_view_hwcounters - Includes in the summary from -log_view the hardware counters of each event, see `PetscLogHWCountersBegin()`.
 .  -log_view_gpu_time - Includes in the summary from -log_view the time used in each GPU kernel, see `PetscLogView().
 .  -log_summary [filename] - (Deprecated, use -log_view) Prints summary of flop and timing information to screen. If the filename is specified the
         summary is written to the file.  See PetscLogView().
@@ -1531,6 +1534,10 @@ PetscErrorCode PetscFinalize(void)
   PetscCall(PetscOptionsGetString(NULL, NULL, "-log_all", mname, sizeof(mname), &flg1));
   PetscCall(PetscOptionsGetString(NULL, NULL, "-log", mname, sizeof(mname), &flg2));
   if (flg1 || flg2) PetscCall(PetscLogDump(mname));
+
+  mname[0] = 0;
+  PetscCall(PetscOptionsGetString(NULL, NULL, "-log_chrome_trace", mname, sizeof(mname), &flg1));
+  if (flg1) PetscCall(PetscLogChromeTraceDump(mname));
 #endif
 
   flg1 = PETSC_FALSE;
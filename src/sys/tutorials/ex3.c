@@ -2,7 +2,7 @@
 static char help[] = "Augmenting PETSc profiling by add events.\n\
 Run this program with one of the\n\
 following options to generate logging information:  -log, -log_view,\n\
--log_all.  The PETSc routines automatically log event times and flops,\n\
+-log_all, -log_chrome_trace.  The PETSc routines automatically log event times and flops,\n\
 so this monitoring is intended solely for users to employ in application\n\
 codes.\n\n";
 
@@ -69,6 +69,17 @@ int main(int argc, char **argv)
   PetscCall(PetscSleep(0.5));
   PetscCall(PetscLogEventEnd(USER_EVENT, 0, 0, 0, 0));
 
+  /*
+     With -log_view_hwcounters the hardware counters are accumulated into the event, when
+     the processor and the kernel provide them
+  */
+  if (PetscLogHWCounters) {
+    PetscEventPerfInfo info;
+
+    PetscCall(PetscLogEventGetPerfInfo(PETSC_DETERMINE, USER_EVENT, &info));
+    PetscCheck(info.hwCycles > 0.0 && info.hwInstructions > 0.0 && info.hwCacheMisses >= 0.0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Hardware counters of the event not logged: cycles %g instructions %g cache misses %g", info.hwCycles, info.hwInstructions, info.hwCacheMisses);
+  }
+
   PetscCall(PetscFinalize());
   return 0;
 }
@@ -80,4 +91,23 @@ int main(int argc, char **argv)
 
    test:
 
+   # the counters are only checked where perf_event_open() provides them
+   test:
+     suffix: hwcounters
+     requires: !defined(PETSC_HAVE_THREADSAFETY)
+     output_file: output/ex3_1.out
+     args: -log_view :ex3_log.txt -log_view_hwcounters
+
+   # the trace must hold the three logged user events of each rank
+   test:
+     suffix: chrome_trace
+     nsize: 2
+     args: -log_chrome_trace ex3_trace.json
+     filter: grep -c -e traceEvents -e "User event" ex3_trace.json
+
+   test:
+     suffix: chrome_trace_dropped
+     nsize: 2
+     args: -log_chrome_trace ex3_trace_dropped.json -log_chrome_trace_size 2
+
 TEST*/
@@ -0,0 +1,523 @@
+#include <../src/vec/is/sf/impls/basic/sfpack.h>
+#include <../src/vec/is/sf/impls/basic/sfbasic.h>
+
+/*
+   PETSCSFHIERARCHICAL - A PetscSF that aggregates the traffic between ranks on different nodes through one leader rank per node.
+
+   Edges between ranks on the same node are handled by a basic SF (sflocal). Data on the other edges travels in three stages:
+     sfroot:   roots on every rank of the node  <->  slots[0] on the leader of the root node
+     sfleader: slots[0] on the root leader      <->  slots[1] on the leader of the leaf node
+     sfleaf:   slots[1] on the leaf leader      <->  leaves on every rank of the node
+   so each pair of nodes exchanges one message per operation instead of one per pair of ranks. There is one slot per edge,
+   hence the message volume is unchanged. The inner SFs are basic and can be configured with the options prefix hierarchical_.
+
+   Begin does not wait for any stage. A stage is started when the previous one has completed, which is tested without blocking
+   for the operations of all hierarchical SFs in every Begin and End, so End only waits for its own operation and operations on
+   different SFs may be started and completed in any order on different ranks. The stages of the operations of an SF go through
+   each inner SF one after another, in the order in which the operations were started, and each inner SF of a stage has its own
+   communicator, so that the messages of its links match on all ranks whatever the time at which the stages are started.
+
+   Data in device memory and PetscSFFetchAndOp() fall back to the basic implementation.
+*/
+
+typedef struct _n_PetscSFHierLink *PetscSFHierLink;
+struct _n_PetscSFHierLink {
+  PetscSF         sf; /* The SF of the operation, whose inner SFs do the stages */
+  MPI_Datatype    unit;
+  const void     *rootdata, *leafdata; /* Keys to find the link at the end of the operation */
+  char           *slots[2];            /* Staging buffers on leaders, on the root and the leaf side */
+  size_t          size;                /* Capacity (in bytes) of the staging buffers */
+  PetscBool       reduce;              /* Reduction, otherwise broadcast */
+  MPI_Op          op;
+  PetscInt        stage;   /* Current stage, 3 once the operation is done */
+  PetscBool       started; /* Whether the current stage is in flight */
+  PetscSFHierLink next;    /* In the available or in use links of sf, the in use ones from the last started */
+  PetscSFHierLink inext;   /* In the operations in flight on all hierarchical SFs */
+};
+
+/* Operations started and not yet completed by their End on all hierarchical SFs */
+static PetscSFHierLink PetscSFHierInFlight = NULL;
+
+typedef struct {
+  SFBASICHEADER;
+  PetscSF         sflocal;   /* Edges within a node */
+  PetscSF         sfroot;    /* Roots on the node to the root slots on its leader */
+  PetscSF         sfleader;  /* Root slots to leaf slots, between leaders */
+  PetscSF         sfleaf;    /* Leaf slots on the leader to leaves on the node */
+  MPI_Comm        comms[3];  /* Communicators of sfroot, sfleader and sfleaf */
+  PetscInt        nslots[2]; /* Number of root and leaf slots on this rank, zero unless a leader */
+  PetscSFHierLink links[2];  /* Available links and links of operations in flight */
+} PetscSF_Hierarchical;
+
+/*
+  The inner SFs of the stages get their own communicator, since they are started at different times on different ranks, and must not
+  communicate through shared memory, since their completion is tested through the MPI requests of their links
+*/
+static PetscErrorCode PetscSFHierCreateInner(PetscSF sf, MPI_Comm *stagecomm, PetscInt nroots, PetscInt nleaves, PetscInt *ilocal, PetscSFNode *iremote, PetscSF *inner)
+{
+  MPI_Comm    comm = PetscObjectComm((PetscObject)sf);
+  const char *prefix;
+
+  PetscFunctionBegin;
+  if (stagecomm) {
+    PetscCallMPI(MPI_Comm_dup(comm, stagecomm));
+    comm = *stagecomm;
+  }
+  PetscCall(PetscSFCreate(comm, inner));
+  PetscCall(PetscObjectGetOptionsPrefix((PetscObject)sf, &prefix));
+  PetscCall(PetscObjectSetOptionsPrefix((PetscObject)*inner, prefix));
+  PetscCall(PetscObjectAppendOptionsPrefix((PetscObject)*inner, "hierarchical_"));
+  PetscCall(PetscSFSetType(*inner, PETSCSFBASIC));
+  PetscCall(PetscSFSetFromOptions(*inner));
+  if (stagecomm) ((PetscSF_Basic *)(*inner)->data)->use_shm = PETSC_FALSE;
+  PetscCall(PetscSFSetGraph(*inner, nroots, nleaves, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(*inner));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFSetUp_Hierarchical(PetscSF sf)
+{
+  PetscSF_Hierarchical *dat = (PetscSF_Hierarchical *)sf->data;
+  MPI_Comm              comm, shmcomm;
+  PetscShmComm          pshmcomm;
+  PetscMPIInt           shmrank, shmsize, leader, lrank, tag, nA = 0, nB = 0, nlocal = 0, offA = 0, offB = 0, *cnt = NULL, *displs = NULL, grank;
+  PetscInt              nranks, ndranks, niranks, ndiranks, i, j, k, s, *ilocal, *idx, *slotidx = NULL, *pairs, *sendpairs;
+  const PetscMPIInt    *ranks, *iranks;
+  const PetscInt       *roffset, *rmine, *rremote, *ioffset, *irootloc;
+  PetscSFNode          *iremote, *gathered = NULL;
+  MPI_Request          *reqs;
+  PetscBool            *offnode, *ioffnode;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFSetUp_Basic(sf));
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  PetscCall(PetscShmCommGet(comm, &pshmcomm));
+  PetscCall(PetscShmCommGetMpiShmComm(pshmcomm, &shmcomm));
+  PetscCallMPI(MPI_Comm_rank(shmcomm, &shmrank));
+  PetscCallMPI(MPI_Comm_size(shmcomm, &shmsize));
+  PetscCall(PetscShmCommLocalToGlobal(pshmcomm, 0, &leader));
+  PetscCall(PetscSFGetLeafInfo_Basic(sf, &nranks, &ndranks, &ranks, &roffset, &rmine, &rremote));
+  PetscCall(PetscSFGetRootInfo_Basic(sf, &niranks, &ndiranks, &iranks, &ioffset, &irootloc));
+
+  /* Classify the edges, those to distinguished ranks (i.e., self) always stay on the node */
+  PetscCall(PetscMalloc2(nranks, &offnode, niranks, &ioffnode));
+  for (i = 0; i < nranks; i++) {
+    offnode[i] = PETSC_FALSE;
+    if (i >= ndranks) {
+      PetscCall(PetscShmCommGlobalToLocal(pshmcomm, ranks[i], &lrank));
+      offnode[i] = lrank == MPI_PROC_NULL ? PETSC_TRUE : PETSC_FALSE;
+    }
+    if (offnode[i]) nB += (PetscMPIInt)(roffset[i + 1] - roffset[i]);
+    else nlocal += (PetscMPIInt)(roffset[i + 1] - roffset[i]);
+  }
+  for (i = 0; i < niranks; i++) {
+    ioffnode[i] = PETSC_FALSE;
+    if (i >= ndiranks) {
+      PetscCall(PetscShmCommGlobalToLocal(pshmcomm, iranks[i], &lrank));
+      ioffnode[i] = lrank == MPI_PROC_NULL ? PETSC_TRUE : PETSC_FALSE;
+    }
+    if (ioffnode[i]) nA += (PetscMPIInt)(ioffset[i + 1] - ioffset[i]);
+  }
+
+  /* The slots of the ranks on a node are stored on their leader one after another */
+  PetscCallMPI(MPI_Exscan(&nA, &offA, 1, MPI_INT, MPI_SUM, shmcomm));
+  PetscCallMPI(MPI_Exscan(&nB, &offB, 1, MPI_INT, MPI_SUM, shmcomm));
+  if (!shmrank) offA = offB = 0;
+  if (!shmrank) PetscCall(PetscMalloc2(shmsize, &cnt, shmsize + 1, &displs));
+
+  /* sfroot: the leader gathers the off-node root indices of its node and reads them from their owners */
+  PetscCall(PetscMalloc1(nA, &idx));
+  for (i = ndiranks, k = 0; i < niranks; i++)
+    if (ioffnode[i])
+      for (j = ioffset[i]; j < ioffset[i + 1]; j++) idx[k++] = irootloc[j];
+  PetscCallMPI(MPI_Gather(&nA, 1, MPI_INT, cnt, 1, MPI_INT, 0, shmcomm));
+  if (!shmrank) {
+    for (displs[0] = 0, i = 0; i < shmsize; i++) displs[i + 1] = displs[i] + cnt[i];
+    dat->nslots[0] = displs[shmsize];
+    PetscCall(PetscMalloc1(dat->nslots[0], &slotidx));
+  }
+  PetscCallMPI(MPI_Gatherv(idx, nA, MPIU_INT, slotidx, cnt, displs, MPIU_INT, 0, shmcomm));
+  PetscCall(PetscFree(idx));
+  PetscCall(PetscMalloc1(dat->nslots[0], &iremote));
+  if (!shmrank) {
+    for (i = 0; i < shmsize; i++) {
+      PetscCall(PetscShmCommLocalToGlobal(pshmcomm, (PetscMPIInt)i, &grank));
+      for (s = displs[i]; s < displs[i + 1]; s++) {
+        iremote[s].rank  = grank;
+        iremote[s].index = slotidx[s];
+      }
+    }
+  }
+  PetscCall(PetscFree(slotidx));
+  PetscCall(PetscSFHierCreateInner(sf, &dat->comms[0], sf->nroots, dat->nslots[0], NULL, iremote, &dat->sfroot));
+
+  /* Tell every off-node leaf rank where the slots of its edges live */
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag));
+  PetscCall(PetscMalloc3(2 * (niranks - ndiranks), &sendpairs, 2 * (nranks - ndranks), &pairs, (niranks - ndiranks) + (nranks - ndranks), &reqs));
+  for (i = ndranks, k = 0; i < nranks; i++) {
+    if (offnode[i]) PetscCallMPI(MPI_Irecv(&pairs[2 * (i - ndranks)], 2, MPIU_INT, ranks[i], tag, comm, &reqs[k++]));
+  }
+  for (i = ndiranks, s = offA; i < niranks; i++) {
+    if (!ioffnode[i]) continue;
+    sendpairs[2 * (i - ndiranks)]     = leader;
+    sendpairs[2 * (i - ndiranks) + 1] = s;
+    s += ioffset[i + 1] - ioffset[i];
+    PetscCallMPI(MPI_Isend(&sendpairs[2 * (i - ndiranks)], 2, MPIU_INT, iranks[i], tag, comm, &reqs[k++]));
+  }
+  PetscCallMPI(MPI_Waitall((PetscMPIInt)k, reqs, MPI_STATUSES_IGNORE));
+
+  /* sflocal and sfleaf: leaves read on-node roots directly and off-node ones from consecutive slots on their leader */
+  PetscCall(PetscMalloc1(nlocal, &ilocal));
+  PetscCall(PetscMalloc1(nlocal, &iremote));
+  for (i = 0, k = 0; i < nranks; i++) {
+    if (offnode[i]) continue;
+    for (j = roffset[i]; j < roffset[i + 1]; j++, k++) {
+      ilocal[k]        = rmine[j];
+      iremote[k].rank  = ranks[i];
+      iremote[k].index = rremote[j];
+    }
+  }
+  PetscCall(PetscSFHierCreateInner(sf, NULL, sf->nroots, nlocal, ilocal, iremote, &dat->sflocal));
+
+  PetscCall(PetscMalloc1(nB, &ilocal));
+  PetscCall(PetscMalloc1(nB, &iremote));
+  PetscCall(PetscMalloc1(nB, &gathered)); /* For each leaf slot, the root slot it reads */
+  for (i = ndranks, k = 0; i < nranks; i++) {
+    if (!offnode[i]) continue;
+    for (j = roffset[i]; j < roffset[i + 1]; j++, k++) {
+      ilocal[k]         = rmine[j];
+      iremote[k].rank   = leader;
+      iremote[k].index  = offB + k;
+      gathered[k].rank  = pairs[2 * (i - ndranks)];
+      gathered[k].index = pairs[2 * (i - ndranks) + 1] + j - roffset[i];
+    }
+  }
+  PetscCall(PetscFree3(sendpairs, pairs, reqs));
+  PetscCallMPI(MPI_Gather(&nB, 1, MPI_INT, cnt, 1, MPI_INT, 0, shmcomm));
+  if (!shmrank) {
+    for (displs[0] = 0, i = 0; i < shmsize; i++) {
+      cnt[i] *= 2;
+      displs[i + 1] = displs[i] + cnt[i];
+    }
+    dat->nslots[1] = displs[shmsize] / 2;
+  }
+  PetscCall(PetscSFHierCreateInner(sf, &dat->comms[2], dat->nslots[1], nB, ilocal, iremote, &dat->sfleaf));
+
+  /* sfleader: leaf slots on my leader read root slots on the leaders of the root ranks */
+  PetscCall(PetscMalloc1(dat->nslots[1], &iremote));
+  PetscCallMPI(MPI_Gatherv(gathered, 2 * nB, MPIU_INT, iremote, cnt, displs, MPIU_INT, 0, shmcomm));
+  PetscCall(PetscFree(gathered));
+  PetscCall(PetscSFHierCreateInner(sf, &dat->comms[1], dat->nslots[0], dat->nslots[1], NULL, iremote, &dat->sfleader));
+
+  PetscCall(PetscFree2(cnt, displs));
+  PetscCall(PetscFree2(offnode, ioffnode));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReset_Hierarchical(PetscSF sf)
+{
+  PetscSF_Hierarchical *dat  = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierLink       link = dat->links[0], next;
+
+  PetscFunctionBegin;
+  PetscCheck(!dat->links[1], PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding operation has not been completed");
+  for (; link; link = next) {
+    next = link->next;
+    PetscCall(PetscFree2(link->slots[0], link->slots[1]));
+    PetscCall(PetscFree(link));
+  }
+  dat->links[0] = NULL;
+  PetscCall(PetscSFDestroy(&dat->sflocal));
+  PetscCall(PetscSFDestroy(&dat->sfroot));
+  PetscCall(PetscSFDestroy(&dat->sfleader));
+  PetscCall(PetscSFDestroy(&dat->sfleaf));
+  for (PetscInt i = 0; i < 3; i++) {
+    if (dat->comms[i] != MPI_COMM_NULL) PetscCallMPI(MPI_Comm_free(&dat->comms[i]));
+  }
+  dat->nslots[0] = dat->nslots[1] = 0;
+  PetscCall(PetscSFReset_Basic(sf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFDestroy_Hierarchical(PetscSF sf)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscSFReset_Hierarchical(sf));
+  PetscCall(PetscFree(sf->data));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Get a link with staging buffers large enough for unit and put it in the inuse list and in the operations in flight */
+static PetscErrorCode PetscSFHierLinkGet(PetscSF sf, MPI_Datatype unit, const void *rootdata, const void *leafdata, PetscBool reduce, MPI_Op op, PetscSFHierLink *mylink)
+{
+  PetscSF_Hierarchical *dat = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierLink       link, *p;
+  MPI_Aint              lb, extent;
+  size_t                size;
+
+  PetscFunctionBegin;
+  PetscCallMPI(MPI_Type_get_extent(unit, &lb, &extent));
+  /* Allocate at least one unit so that buffers of different links never compare equal */
+  size = (size_t)extent * (size_t)PetscMax(PetscMax(dat->nslots[0], dat->nslots[1]), 1);
+  for (p = &dat->links[0]; (link = *p); p = &link->next) {
+    if (link->size >= size) {
+      *p = link->next;
+      break;
+    }
+  }
+  if (!link) {
+    PetscCall(PetscNew(&link));
+    PetscCall(PetscMalloc2(size, &link->slots[0], size, &link->slots[1]));
+    link->size = size;
+  }
+  link->sf            = sf;
+  link->unit          = unit;
+  link->rootdata      = rootdata;
+  link->leafdata      = leafdata;
+  link->reduce        = reduce;
+  link->op            = op;
+  link->stage         = 0;
+  link->started       = PETSC_FALSE;
+  link->next          = dat->links[1];
+  dat->links[1]       = link;
+  link->inext         = PetscSFHierInFlight;
+  PetscSFHierInFlight = link;
+  *mylink             = link;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Find the link of an operation started by the hierarchical code path, NULL if there is none */
+static PetscErrorCode PetscSFHierLinkFind(PetscSF sf, MPI_Datatype unit, const void *rootdata, const void *leafdata, PetscSFHierLink *mylink)
+{
+  PetscSF_Hierarchical *dat = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierLink       link;
+
+  PetscFunctionBegin;
+  for (link = dat->links[1]; link; link = link->next) {
+    if (link->unit == unit && link->rootdata == rootdata && link->leafdata == leafdata) break;
+  }
+  *mylink = link;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  The inner SF of the stage in flight of an operation, with its root and leaf buffers. A broadcast goes through sfroot, sfleader and
+  sfleaf, a reduction through the same SFs in reverse order. Every slot has exactly one leaf, so only the last stage applies op.
+*/
+static PetscErrorCode PetscSFHierLinkGetStage(PetscSFHierLink link, PetscSF *inner, void **rootbuf, void **leafbuf, MPI_Op *op)
+{
+  PetscSF_Hierarchical *dat = (PetscSF_Hierarchical *)link->sf->data;
+
+  PetscFunctionBegin;
+  switch (link->reduce ? 2 - link->stage : link->stage) {
+  case 0:
+    *inner   = dat->sfroot;
+    *rootbuf = (void *)link->rootdata;
+    *leafbuf = link->slots[0];
+    break;
+  case 1:
+    *inner   = dat->sfleader;
+    *rootbuf = link->slots[0];
+    *leafbuf = link->slots[1];
+    break;
+  default:
+    *inner   = dat->sfleaf;
+    *rootbuf = link->slots[1];
+    *leafbuf = (void *)link->leafdata;
+  }
+  *op = link->stage == 2 ? link->op : MPI_REPLACE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFHierLinkBeginStage(PetscSFHierLink link)
+{
+  PetscSF inner;
+  void   *rootbuf, *leafbuf;
+  MPI_Op  op;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFHierLinkGetStage(link, &inner, &rootbuf, &leafbuf, &op));
+  if (link->reduce) PetscCall(PetscSFReduceWithMemTypeBegin(inner, link->unit, PETSC_MEMTYPE_HOST, leafbuf, PETSC_MEMTYPE_HOST, rootbuf, op));
+  else PetscCall(PetscSFBcastWithMemTypeBegin(inner, link->unit, PETSC_MEMTYPE_HOST, rootbuf, PETSC_MEMTYPE_HOST, leafbuf, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Create the links of the inner SFs of the stages for the unit of an operation when it starts, since creating a link gets a new tag
+  from the communicator, which must happen in the same order on all ranks and not when the stages are started. As the stages of the
+  operations of an SF go through each inner SF one after another, one link per unit is then enough.
+*/
+static PetscErrorCode PetscSFHierLinkCreateStages(PetscSFHierLink link)
+{
+  PetscSF        inner;
+  PetscSF_Basic *bas;
+  PetscSFLink    ilink;
+  void          *rootbuf, *leafbuf;
+  MPI_Op         op;
+  PetscBool      match;
+
+  PetscFunctionBegin;
+  for (link->stage = 0; link->stage < 3; link->stage++) {
+    PetscCall(PetscSFHierLinkGetStage(link, &inner, &rootbuf, &leafbuf, &op));
+    bas   = (PetscSF_Basic *)inner->data;
+    match = PETSC_FALSE;
+    for (ilink = bas->avail; ilink && !match; ilink = ilink->next) PetscCall(MPIPetsc_Type_compare(link->unit, ilink->unit, &match));
+    for (ilink = bas->inuse; ilink && !match; ilink = ilink->next) PetscCall(MPIPetsc_Type_compare(link->unit, ilink->unit, &match));
+    if (match) continue;
+    PetscCall(PetscSFLinkCreate(inner, link->unit, PETSC_MEMTYPE_HOST, rootbuf, PETSC_MEMTYPE_HOST, leafbuf, op, link->reduce ? PETSCSF_REDUCE : PETSCSF_BCAST, &ilink));
+    PetscCall(PetscSFLinkGetInUse(inner, link->unit, rootbuf, leafbuf, PETSC_OWN_POINTER, &ilink));
+    PetscCall(PetscSFLinkReclaim(inner, &ilink));
+  }
+  link->stage = 0;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+  Complete, without blocking, the stages in flight of all hierarchical operations whose messages have arrived and start their next
+  stages. A stage of an operation is started once the previous operation of its SF, next in the in use list, is done with it.
+*/
+static PetscErrorCode PetscSFHierProgress(void)
+{
+  PetscSFHierLink  link;
+  PetscSFLink      ilink;
+  PetscSF          inner;
+  PetscSF_Basic   *bas;
+  PetscSFDirection direction;
+  void            *rootbuf, *leafbuf;
+  MPI_Op           op;
+  PetscMPIInt      done;
+
+  PetscFunctionBegin;
+  for (link = PetscSFHierInFlight; link; link = link->inext) {
+    while (link->stage < 3) {
+      if (!link->started) {
+        if (link->next && link->next->stage <= link->stage) break;
+        PetscCall(PetscSFHierLinkBeginStage(link));
+        link->started = PETSC_TRUE;
+      }
+      PetscCall(PetscSFHierLinkGetStage(link, &inner, &rootbuf, &leafbuf, &op));
+      PetscCall(PetscSFLinkGetInUse(inner, link->unit, rootbuf, leafbuf, PETSC_USE_POINTER, &ilink));
+      bas       = (PetscSF_Basic *)inner->data;
+      direction = link->reduce ? PETSCSF_LEAF2ROOT : PETSCSF_ROOT2LEAF;
+      PetscCallMPI(MPI_Testall(bas->nrootreqs, ilink->rootreqs[direction][ilink->rootmtype_mpi][ilink->rootdirect_mpi], &done, MPI_STATUSES_IGNORE));
+      if (done) PetscCallMPI(MPI_Testall(inner->nleafreqs, ilink->leafreqs[direction][ilink->leafmtype_mpi][ilink->leafdirect_mpi], &done, MPI_STATUSES_IGNORE));
+      if (!done) break;
+      /* The requests are complete, so End does not wait */
+      if (link->reduce) PetscCall(PetscSFReduceEnd(inner, link->unit, leafbuf, rootbuf, op));
+      else PetscCall(PetscSFBcastEnd(inner, link->unit, rootbuf, leafbuf, op));
+      link->stage++;
+      link->started = PETSC_FALSE;
+    }
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Wait for the operation of link to be done, making progress on all the others, and move it to the avail list */
+static PetscErrorCode PetscSFHierLinkComplete(PetscSFHierLink link)
+{
+  PetscSF_Hierarchical *dat = (PetscSF_Hierarchical *)link->sf->data;
+  PetscSFHierLink      *p;
+
+  PetscFunctionBegin;
+  while (link->stage < 3) PetscCall(PetscSFHierProgress());
+  p = &PetscSFHierInFlight;
+  while (*p != link) p = &(*p)->inext;
+  *p = link->inext;
+  p  = &dat->links[1];
+  while (*p != link) p = &(*p)->next;
+  *p            = link->next;
+  link->next    = dat->links[0];
+  dat->links[0] = link;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastBegin_Hierarchical(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
+{
+  PetscSF_Hierarchical *dat = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierLink       link;
+
+  PetscFunctionBegin;
+  if (PetscMemTypeDevice(rootmtype) || PetscMemTypeDevice(leafmtype)) {
+    PetscCall(PetscSFBcastBegin_Basic(sf, unit, rootmtype, rootdata, leafmtype, leafdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFHierLinkGet(sf, unit, rootdata, leafdata, PETSC_FALSE, op, &link));
+  PetscCall(PetscSFHierLinkCreateStages(link));
+  PetscCall(PetscSFBcastWithMemTypeBegin(dat->sflocal, unit, PETSC_MEMTYPE_HOST, rootdata, PETSC_MEMTYPE_HOST, leafdata, op));
+  PetscCall(PetscSFHierProgress());
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBcastEnd_Hierarchical(PetscSF sf, MPI_Datatype unit, const void *rootdata, void *leafdata, MPI_Op op)
+{
+  PetscSF_Hierarchical *dat = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierLink       link;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFHierLinkFind(sf, unit, rootdata, leafdata, &link));
+  if (!link) {
+    PetscCall(PetscSFBcastEnd_Basic(sf, unit, rootdata, leafdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFHierLinkComplete(link));
+  PetscCall(PetscSFBcastEnd(dat->sflocal, unit, rootdata, leafdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceBegin_Hierarchical(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op)
+{
+  PetscSF_Hierarchical *dat = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierLink       link;
+
+  PetscFunctionBegin;
+  if (PetscMemTypeDevice(rootmtype) || PetscMemTypeDevice(leafmtype)) {
+    PetscCall(PetscSFReduceBegin_Basic(sf, unit, leafmtype, leafdata, rootmtype, rootdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFHierLinkGet(sf, unit, rootdata, leafdata, PETSC_TRUE, op, &link));
+  PetscCall(PetscSFHierLinkCreateStages(link));
+  PetscCall(PetscSFReduceWithMemTypeBegin(dat->sflocal, unit, PETSC_MEMTYPE_HOST, leafdata, PETSC_MEMTYPE_HOST, rootdata, op));
+  PetscCall(PetscSFHierProgress());
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFReduceEnd_Hierarchical(PetscSF sf, MPI_Datatype unit, const void *leafdata, void *rootdata, MPI_Op op)
+{
+  PetscSF_Hierarchical *dat = (PetscSF_Hierarchical *)sf->data;
+  PetscSFHierLink       link;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSFHierLinkFind(sf, unit, rootdata, leafdata, &link));
+  if (!link) {
+    PetscCall(PetscSFReduceEnd_Basic(sf, unit, leafdata, rootdata, op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFHierLinkComplete(link));
+  PetscCall(PetscSFReduceEnd(dat->sflocal, unit, leafdata, rootdata, op));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFCreate_Hierarchical(PetscSF sf)
+{
+  PetscSF_Hierarchical *dat;
+
+  PetscFunctionBegin;
+  sf->ops->CreateEmbeddedRootSF = PetscSFCreateEmbeddedRootSF_Basic;
+  sf->ops->FetchAndOpBegin      = PetscSFFetchAndOpBegin_Basic;
+  sf->ops->FetchAndOpEnd        = PetscSFFetchAndOpEnd_Basic;
+  sf->ops->GetLeafRanks         = PetscSFGetLeafRanks_Basic;
+  sf->ops->View                 = PetscSFView_Basic;
+
+  sf->ops->SetUp       = PetscSFSetUp_Hierarchical;
+  sf->ops->Reset       = PetscSFReset_Hierarchical;
+  sf->ops->Destroy     = PetscSFDestroy_Hierarchical;
+  sf->ops->BcastBegin  = PetscSFBcastBegin_Hierarchical;
+  sf->ops->BcastEnd    = PetscSFBcastEnd_Hierarchical;
+  sf->ops->ReduceBegin = PetscSFReduceBegin_Hierarchical;
+  sf->ops->ReduceEnd   = PetscSFReduceEnd_Hierarchical;
+
+  PetscCall(PetscNew(&dat));
+  for (PetscInt i = 0; i < 3; i++) dat->comms[i] = MPI_COMM_NULL;
+  sf->data = (void *)dat;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
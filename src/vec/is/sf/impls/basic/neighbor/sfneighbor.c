@@ -18,6 +18,7 @@ typedef struct {
   PetscSFAint  *rootdispls, *leafdispls; /* displs for non-distinguished ranks */
   PetscMPIInt  *rootweights, *leafweights;
   PetscInt      rootdegree, leafdegree;
+  PetscBool     persistent; /* Use MPI-4 persistent neighborhood collectives? */
 } PetscSF_Neighbor;
 
 /*===================================================================================*/
@@ -74,12 +75,40 @@ static PetscErrorCode PetscSFGetDistComm_Neighbor(PetscSF sf, PetscSFDirection d
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/* Start the neighborhood alltoallv of a link in the given direction. With persistent collectives, the request is initialized
+   on first use and bound to the link's own buffers (see PetscSFSetUp_Neighbor()), so later calls only need MPI_Start().
+   Requests are kept in the root request slot of the link, as neighborhood collectives need only one per direction.
+*/
+static PetscErrorCode PetscSFStartAlltoallv_Neighbor(PetscSF sf, PetscSFLink link, PetscSFDirection direction, const void *sendbuf, const PetscSFCount *sendcounts, const PetscSFAint *senddispls, void *recvbuf, const PetscSFCount *recvcounts, const PetscSFAint *recvdispls, MPI_Comm distcomm, MPI_Request *req)
+{
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor *)sf->data;
+
+  PetscFunctionBegin;
+  /* OpenMPI-3.0 ran into error with rootdegree = leafdegree = 0, so we skip the call in this case */
+  if (!dat->rootdegree && !dat->leafdegree) PetscFunctionReturn(PETSC_SUCCESS);
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+  if (dat->persistent) {
+    PetscBool *inited = &link->rootreqsinited[direction][link->rootmtype_mpi][link->rootdirect_mpi];
+
+    if (!*inited) {
+      PetscCallMPI(MPIU_Neighbor_alltoallv_init(sendbuf, sendcounts, senddispls, link->unit, recvbuf, recvcounts, recvdispls, link->unit, distcomm, MPI_INFO_NULL, req));
+      *inited = PETSC_TRUE;
+    }
+    PetscCallMPI(MPI_Start(req));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+#endif
+  PetscCallMPI(MPIU_Ineighbor_alltoallv(sendbuf, sendcounts, senddispls, link->unit, recvbuf, recvcounts, recvdispls, link->unit, distcomm, req));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*===================================================================================*/
 /*              Implementations of SF public APIs                                    */
 /*===================================================================================*/
 static PetscErrorCode PetscSFSetUp_Neighbor(PetscSF sf)
 {
   PetscSF_Neighbor *dat = (PetscSF_Neighbor *)sf->data;
+  PetscSF_Basic    *bas = (PetscSF_Basic *)sf->data;
   PetscInt          i, j, nrootranks, ndrootranks, nleafranks, ndleafranks;
   const PetscInt   *rootoffset, *leafoffset;
   PetscMPIInt       m, n;
@@ -96,6 +125,14 @@ static PetscErrorCode PetscSFSetUp_Neighbor(PetscSF sf)
   sf->nleafreqs       = 0;
   dat->nrootreqs      = 1;
 
+  /* A persistent collective is bound to its buffers and must be initialized in the same order on all ranks. If root/leafdata
+     were passed to MPI directly, a rank would have to re-initialize it on its own whenever the user's arrays moved, so always
+     go through the buffers of the link instead */
+  if (dat->persistent) {
+    bas->rootcontig[PETSCSF_REMOTE] = PETSC_FALSE;
+    sf->leafcontig[PETSCSF_REMOTE]  = PETSC_FALSE;
+  }
+
   /* Only setup MPI displs/counts for non-distinguished ranks. Distinguished ranks use shared memory */
   PetscCall(PetscMalloc6(m, &dat->rootdispls, m, &dat->rootcounts, m, &dat->rootweights, n, &dat->leafdispls, n, &dat->leafcounts, n, &dat->leafweights));
 
@@ -138,6 +175,7 @@ static PetscErrorCode PetscSFReset_Neighbor(PetscSF sf)
 
   PetscFunctionBegin;
   PetscCheck(!dat->inuse, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding operation has not been completed");
+  PetscCall(PetscSFReset_Basic(sf)); /* Common part. Destroying the links first frees persistent requests still referring to the arrays and communicators below */
   PetscCall(PetscFree6(dat->rootdispls, dat->rootcounts, dat->rootweights, dat->leafdispls, dat->leafcounts, dat->leafweights));
   for (i = 0; i < 2; i++) {
     if (dat->initialized[i]) {
@@ -145,7 +183,6 @@ static PetscErrorCode PetscSFReset_Neighbor(PetscSF sf)
       dat->initialized[i] = PETSC_FALSE;
     }
   }
-  PetscCall(PetscSFReset_Basic(sf)); /* Common part */
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -157,6 +194,19 @@ static PetscErrorCode PetscSFDestroy_Neighbor(PetscSF sf)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+static PetscErrorCode PetscSFSetFromOptions_Neighbor(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Neighbor *dat = (PetscSF_Neighbor *)sf->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Neighbor options");
+  PetscCall(PetscOptionsBool("-sf_neighbor_persistent", "Use MPI-4 persistent neighborhood collectives", "PetscSFSetFromOptions", dat->persistent, &dat->persistent, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#endif
+
 static PetscErrorCode PetscSFBcastBegin_Neighbor(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
 {
   PetscSFLink       link;
@@ -173,8 +223,7 @@ static PetscErrorCode PetscSFBcastBegin_Neighbor(PetscSF sf, MPI_Datatype unit,
   PetscCall(PetscSFGetDistComm_Neighbor(sf, PETSCSF_ROOT2LEAF, &distcomm));
   PetscCall(PetscSFLinkGetMPIBuffersAndRequests(sf, link, PETSCSF_ROOT2LEAF, &rootbuf, &leafbuf, &req, NULL));
   PetscCall(PetscSFLinkSyncStreamBeforeCallMPI(sf, link, PETSCSF_ROOT2LEAF));
-  /* OpenMPI-3.0 ran into error with rootdegree = leafdegree = 0, so we skip the call in this case */
-  if (dat->rootdegree || dat->leafdegree) PetscCallMPI(MPIU_Ineighbor_alltoallv(rootbuf, dat->rootcounts, dat->rootdispls, unit, leafbuf, dat->leafcounts, dat->leafdispls, unit, distcomm, req));
+  PetscCall(PetscSFStartAlltoallv_Neighbor(sf, link, PETSCSF_ROOT2LEAF, rootbuf, dat->rootcounts, dat->rootdispls, leafbuf, dat->leafcounts, dat->leafdispls, distcomm, req));
   PetscCall(PetscLogMPIMessages(dat->rootdegree, dat->rootcounts, unit, dat->leafdegree, dat->leafcounts, unit));
   PetscCall(PetscSFLinkScatterLocal(sf, link, PETSCSF_ROOT2LEAF, (void *)rootdata, leafdata, op));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -196,7 +245,7 @@ static inline PetscErrorCode PetscSFLeafToRootBegin_Neighbor(PetscSF sf, MPI_Dat
   PetscCall(PetscSFGetDistComm_Neighbor(sf, PETSCSF_LEAF2ROOT, &distcomm));
   PetscCall(PetscSFLinkGetMPIBuffersAndRequests(sf, link, PETSCSF_LEAF2ROOT, &rootbuf, &leafbuf, &req, NULL));
   PetscCall(PetscSFLinkSyncStreamBeforeCallMPI(sf, link, PETSCSF_LEAF2ROOT));
-  if (dat->rootdegree || dat->leafdegree) PetscCallMPI(MPIU_Ineighbor_alltoallv(leafbuf, dat->leafcounts, dat->leafdispls, unit, rootbuf, dat->rootcounts, dat->rootdispls, unit, distcomm, req));
+  PetscCall(PetscSFStartAlltoallv_Neighbor(sf, link, PETSCSF_LEAF2ROOT, leafbuf, dat->leafcounts, dat->leafdispls, rootbuf, dat->rootcounts, dat->rootdispls, distcomm, req));
   PetscCall(PetscLogMPIMessages(dat->leafdegree, dat->leafcounts, unit, dat->rootdegree, dat->rootcounts, unit));
   *out = link;
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -265,6 +314,9 @@ PETSC_INTERN PetscErrorCode PetscSFCreate_Neighbor(PetscSF sf)
   sf->ops->ReduceBegin     = PetscSFReduceBegin_Neighbor;
   sf->ops->FetchAndOpBegin = PetscSFFetchAndOpBegin_Neighbor;
   sf->ops->FetchAndOpEnd   = PetscSFFetchAndOpEnd_Neighbor;
+#if defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+  sf->ops->SetFromOptions = PetscSFSetFromOptions_Neighbor;
+#endif
 
   PetscCall(PetscNew(&dat));
   sf->data = (void *)dat;
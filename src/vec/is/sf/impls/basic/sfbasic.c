@@ -81,6 +81,7 @@ PETSC_INTERN PetscErrorCode PetscSFSetUp_Basic(PetscSF sf)
   /* Setup fields related to packing, such as rootbuflen[] */
   PetscCall(PetscSFSetUpPackFields(sf));
   PetscCall(PetscFree2(rootreqs, leafreqs));
+  if (bas->use_shm) PetscCall(PetscSFSetUp_Basic_Shm(sf));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -101,6 +102,7 @@ PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF sf)
 #if defined(PETSC_HAVE_NVSHMEM)
   PetscCall(PetscSFReset_Basic_NVSHMEM(sf));
 #endif
+  PetscCall(PetscSFReset_Basic_Shm(sf));
 
   for (; link; link = next) {
     next = link->next;
@@ -178,7 +180,19 @@ PETSC_INTERN PetscErrorCode PetscSFView_Basic(PetscSF sf, PetscViewer viewer)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode PetscSFBcastBegin_Basic(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
+static PetscErrorCode PetscSFSetFromOptions_Basic(PetscSF sf, PetscOptionItems *PetscOptionsObject)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "PetscSF Basic options");
+  PetscCall(PetscOptionsBool("-sf_basic_shared_memory", "Communicate with ranks on the same node through shared memory", "PetscSFSetFromOptions", bas->use_shm, &bas->use_shm, NULL));
+  PetscCall(PetscOptionsInt("-sf_basic_shared_memory_unit_bytes", "Largest unit (in bytes) communicated through shared memory", "PetscSFSetFromOptions", bas->shm_unitbytes, &bas->shm_unitbytes, NULL));
+  PetscOptionsHeadEnd();
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PETSC_INTERN PetscErrorCode PetscSFBcastBegin_Basic(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, const void *rootdata, PetscMemType leafmtype, void *leafdata, MPI_Op op)
 {
   PetscSFLink link = NULL;
 
@@ -224,7 +238,7 @@ static inline PetscErrorCode PetscSFLeafToRootBegin_Basic(PetscSF sf, MPI_Dataty
 }
 
 /* leaf -> root with reduction */
-static PetscErrorCode PetscSFReduceBegin_Basic(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op)
+PETSC_INTERN PetscErrorCode PetscSFReduceBegin_Basic(PetscSF sf, MPI_Datatype unit, PetscMemType leafmtype, const void *leafdata, PetscMemType rootmtype, void *rootdata, MPI_Op op)
 {
   PetscSFLink link = NULL;
 
@@ -256,7 +270,7 @@ PETSC_INTERN PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF sf, MPI_Datatyp
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
-static PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf, MPI_Datatype unit, void *rootdata, const void *leafdata, void *leafupdate, MPI_Op op)
+PETSC_INTERN PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF sf, MPI_Datatype unit, void *rootdata, const void *leafdata, void *leafupdate, MPI_Op op)
 {
   PetscSFLink link = NULL;
 
@@ -404,6 +418,7 @@ PETSC_INTERN PetscErrorCode PetscSFCreateEmbeddedRootSF_Basic(PetscSF sf, PetscI
   esf->persistent = PETSC_TRUE;
   /* Setup packing related fields */
   PetscCall(PetscSFSetUpPackFields(esf));
+  if (bas->use_shm) PetscCall(PetscSFSetUp_Basic_Shm(esf));
 
   /* Copy from PetscSFSetUp(), since this method wants to skip PetscSFSetUp(). */
 #if defined(PETSC_HAVE_CUDA)
@@ -439,6 +454,7 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
 
   PetscFunctionBegin;
   sf->ops->SetUp                = PetscSFSetUp_Basic;
+  sf->ops->SetFromOptions       = PetscSFSetFromOptions_Basic;
   sf->ops->Reset                = PetscSFReset_Basic;
   sf->ops->Destroy              = PetscSFDestroy_Basic;
   sf->ops->View                 = PetscSFView_Basic;
@@ -452,6 +468,7 @@ PETSC_EXTERN PetscErrorCode PetscSFCreate_Basic(PetscSF sf)
   sf->ops->CreateEmbeddedRootSF = PetscSFCreateEmbeddedRootSF_Basic;
 
   PetscCall(PetscNew(&dat));
-  sf->data = (void *)dat;
+  dat->shm_unitbytes = 4 * sizeof(PetscScalar);
+  sf->data           = (void *)dat;
   PetscFunctionReturn(PETSC_SUCCESS);
 }
@@ -4,6 +4,7 @@
 #include <petsc/private/sfimpl.h> /*I "petscsf.h" I*/
 
 typedef struct _n_PetscSFLink *PetscSFLink;
+typedef struct _n_PetscSFShm  *PetscSFShm;
 
 #define SFBASICHEADER \
   PetscMPIInt    niranks;          /* Number of incoming ranks (ranks accessing my roots) */ \
@@ -20,6 +21,9 @@ typedef struct _n_PetscSFLink *PetscSFLink;
   PetscSFPackOpt rootpackopt_d[2]; /* Copy of rootpackopt[] on device if needed */ \
   PetscBool      rootdups[2];      /* Indices of roots in irootloc[local/remote] have dups. Used for data-race test */ \
   PetscInt       nrootreqs;        /* Number of MPI requests */ \
+  PetscBool      use_shm;          /* Communicate with ranks on the same node through shared memory if possible */ \
+  PetscInt       shm_unitbytes;    /* Largest unit (in bytes) communicated through shared memory */ \
+  PetscSFShm     shm;              /* Shared memory window and on-node peers. NULL if not used */ \
   PetscSFLink    avail;            /* One or more entries per MPI Datatype, lazily constructed */ \
   PetscSFLink    inuse             /* Buffers being used for transactions that have not yet completed */
 
@@ -69,12 +73,18 @@ PETSC_INTERN PetscErrorCode PetscSFSetUp_Basic(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFView_Basic(PetscSF, PetscViewer);
 PETSC_INTERN PetscErrorCode PetscSFReset_Basic(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFDestroy_Basic(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFBcastBegin_Basic(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFBcastEnd_Basic(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFReduceBegin_Basic(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFReduceEnd_Basic(PetscSF, MPI_Datatype, const void *, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFFetchAndOpBegin_Basic(PetscSF, MPI_Datatype, PetscMemType, void *, PetscMemType, const void *, void *, MPI_Op);
+PETSC_INTERN PetscErrorCode PetscSFFetchAndOpEnd_Basic(PetscSF, MPI_Datatype, void *, const void *, void *, MPI_Op);
 PETSC_INTERN PetscErrorCode PetscSFCreateEmbeddedRootSF_Basic(PetscSF, PetscInt, const PetscInt *, PetscSF *);
 PETSC_INTERN PetscErrorCode PetscSFGetLeafRanks_Basic(PetscSF, PetscInt *, const PetscMPIInt **, const PetscInt **, const PetscInt **);
 
+PETSC_INTERN PetscErrorCode PetscSFSetUp_Basic_Shm(PetscSF);
+PETSC_INTERN PetscErrorCode PetscSFReset_Basic_Shm(PetscSF);
+
 #if defined(PETSC_HAVE_NVSHMEM)
 PETSC_INTERN PetscErrorCode PetscSFReset_Basic_NVSHMEM(PetscSF);
 #endif
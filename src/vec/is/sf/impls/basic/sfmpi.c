@@ -147,7 +147,7 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
   PetscSFLink     *p, link;
   PetscSFDirection direction;
   MPI_Request     *reqs = NULL;
-  PetscBool        match, rootdirect[2], leafdirect[2];
+  PetscBool        match, rootdirect[2], leafdirect[2], use_shm;
   PetscMemType     rootmtype = PetscMemTypeHost(xrootmtype) ? PETSC_MEMTYPE_HOST : PETSC_MEMTYPE_DEVICE; /* Convert to 0/1 as we will use it in subscript */
   PetscMemType     leafmtype = PetscMemTypeHost(xleafmtype) ? PETSC_MEMTYPE_HOST : PETSC_MEMTYPE_DEVICE;
   PetscMemType     rootmtype_mpi, leafmtype_mpi;   /* mtypes seen by MPI */
@@ -169,6 +169,13 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
     }
   }
 
+  /* With shared memory, the remote rootbuf (leafbuf) is packed into the window so that on-node leaves (roots) can read it */
+  PetscCall(PetscSFLinkShmCheck(sf, unit, rootmtype, leafmtype, sfop, &use_shm));
+  if (use_shm) {
+    if (sfop == PETSCSF_BCAST) rootdirect[PETSCSF_REMOTE] = PETSC_FALSE;
+    else leafdirect[PETSCSF_REMOTE] = PETSC_FALSE;
+  }
+
   if (sf->use_gpu_aware_mpi) {
     rootmtype_mpi = rootmtype;
     leafmtype_mpi = leafmtype;
@@ -227,6 +234,9 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
       }
     }
   }
+
+found:
+  /* A cached link may have been used with shared memory, so (re)set how it communicates on every invocation */
   link->StartCommunication  = PetscSFLinkStartRequests_MPI;
   link->FinishCommunication = PetscSFLinkWaitRequests_MPI;
 #if defined(PETSC_HAVE_MPIX_STREAM)
@@ -236,8 +246,6 @@ PetscErrorCode PetscSFLinkCreate_MPI(PetscSF sf, MPI_Datatype unit, PetscMemType
   }
 #endif
 
-found:
-
 #if defined(PETSC_HAVE_DEVICE)
   if ((PetscMemTypeDevice(xrootmtype) || PetscMemTypeDevice(xleafmtype)) && !link->deviceinited) {
   #if defined(PETSC_HAVE_CUDA)
@@ -305,6 +313,7 @@ found:
   link->leafmtype      = leafmtype;
   link->rootmtype_mpi  = rootmtype_mpi;
   link->leafmtype_mpi  = leafmtype_mpi;
+  if (use_shm) PetscCall(PetscSFLinkSetUp_Shm(sf, link, direction)); /* Point the packed buffer to the window and switch to shared memory communication */
 
   link->next = bas->inuse;
   bas->inuse = link;
@@ -39,7 +39,7 @@
 
    Arguments of the macro:
    +Type      Type of the basic data in an entry, i.e., int, PetscInt, PetscReal etc. It is not the type of an entry.
-   .BS        Block size for vectorization. It is a factor of bsz.
+   .BS        Block size for vectorization. It is a factor of bsz. BS=3 is only generated with EQ=1, for units like 3 PetscReals (24 bytes).
    -EQ        (bs == BS) ? 1 : 0. EQ is a compile-time const to help compiler optimizations. See below.
 
    Arguments of the Pack routine:
@@ -66,11 +66,17 @@
         u2 = u + opt->start[r] * MBS; \
         X  = opt->X[r]; \
         Y  = opt->Y[r]; \
-        for (k = 0; k < opt->dz[r]; k++) \
-          for (j = 0; j < opt->dy[r]; j++) { \
-            PetscCall(PetscArraycpy(p2, u2 + (X * Y * k + X * j) * MBS, opt->dx[r] * MBS)); \
-            p2 += opt->dx[r] * MBS; \
-          } \
+        if (opt->dx[r] == 1) { /* Strided entries, copy them with a loop of compile-time length instead of a memcpy per entry */ \
+          for (k = 0; k < opt->dz[r]; k++) \
+            for (j = 0; j < opt->dy[r]; j++, p2 += MBS) \
+              for (i = 0; i < MBS; i++) p2[i] = u2[(X * Y * k + X * j) * MBS + i]; \
+        } else { \
+          for (k = 0; k < opt->dz[r]; k++) \
+            for (j = 0; j < opt->dy[r]; j++) { \
+              PetscCall(PetscArraycpy(p2, u2 + (X * Y * k + X * j) * MBS, opt->dx[r] * MBS)); \
+              p2 += opt->dx[r] * MBS; \
+            } \
+        } \
       } \
     } else { \
       for (i = 0; i < count; i++) \
@@ -109,11 +115,17 @@
         u2 = u + opt->start[r] * MBS; \
         X  = opt->X[r]; \
         Y  = opt->Y[r]; \
-        for (k = 0; k < opt->dz[r]; k++) \
-          for (j = 0; j < opt->dy[r]; j++) { \
-            PetscCall(PetscArraycpy(u2 + (X * Y * k + X * j) * MBS, p, opt->dx[r] * MBS)); \
-            p += opt->dx[r] * MBS; \
-          } \
+        if (opt->dx[r] == 1) { /* Strided entries */ \
+          for (k = 0; k < opt->dz[r]; k++) \
+            for (j = 0; j < opt->dy[r]; j++, p += MBS) \
+              for (i = 0; i < MBS; i++) u2[(X * Y * k + X * j) * MBS + i] = p[i]; \
+        } else { \
+          for (k = 0; k < opt->dz[r]; k++) \
+            for (j = 0; j < opt->dy[r]; j++) { \
+              PetscCall(PetscArraycpy(u2 + (X * Y * k + X * j) * MBS, p, opt->dx[r] * MBS)); \
+              p += opt->dx[r] * MBS; \
+            } \
+        } \
       } \
     } else { \
       for (i = 0; i < count; i++) \
@@ -352,6 +364,7 @@
 
 DEF_IntegerType(PetscInt, 1, 1)   /* unit = 1 MPIU_INT  */
   DEF_IntegerType(PetscInt, 2, 1) /* unit = 2 MPIU_INTs */
+  DEF_IntegerType(PetscInt, 3, 1) /* unit = 3 MPIU_INTs */
   DEF_IntegerType(PetscInt, 4, 1) /* unit = 4 MPIU_INTs */
   DEF_IntegerType(PetscInt, 8, 1) /* unit = 8 MPIU_INTs */
   DEF_IntegerType(PetscInt, 1, 0) /* unit = 1*n MPIU_INTs, n>1 */
@@ -360,7 +373,7 @@ DEF_IntegerType(PetscInt, 1, 1)   /* unit = 1 MPIU_INT  */
   DEF_IntegerType(PetscInt, 8, 0) /* unit = 8*n MPIU_INTs, n>1. Routines with bigger BS are tried first. */
 
 #if defined(PETSC_USE_64BIT_INDICES) /* Do not need (though it is OK) to generate redundant functions if PetscInt is int */
-  DEF_IntegerType(int, 1, 1) DEF_IntegerType(int, 2, 1) DEF_IntegerType(int, 4, 1) DEF_IntegerType(int, 8, 1) DEF_IntegerType(int, 1, 0) DEF_IntegerType(int, 2, 0) DEF_IntegerType(int, 4, 0) DEF_IntegerType(int, 8, 0)
+  DEF_IntegerType(int, 1, 1) DEF_IntegerType(int, 2, 1) DEF_IntegerType(int, 3, 1) DEF_IntegerType(int, 4, 1) DEF_IntegerType(int, 8, 1) DEF_IntegerType(int, 1, 0) DEF_IntegerType(int, 2, 0) DEF_IntegerType(int, 4, 0) DEF_IntegerType(int, 8, 0)
 #endif
 
   /* The typedefs are used to get a typename without space that CPPJoin can handle */
@@ -370,9 +383,9 @@ DEF_IntegerType(SignedChar, 1, 1) DEF_IntegerType(SignedChar, 2, 1) DEF_IntegerT
   typedef unsigned char UnsignedChar;
 DEF_IntegerType(UnsignedChar, 1, 1) DEF_IntegerType(UnsignedChar, 2, 1) DEF_IntegerType(UnsignedChar, 4, 1) DEF_IntegerType(UnsignedChar, 8, 1) DEF_IntegerType(UnsignedChar, 1, 0) DEF_IntegerType(UnsignedChar, 2, 0) DEF_IntegerType(UnsignedChar, 4, 0) DEF_IntegerType(UnsignedChar, 8, 0)
 
-  DEF_RealType(PetscReal, 1, 1) DEF_RealType(PetscReal, 2, 1) DEF_RealType(PetscReal, 4, 1) DEF_RealType(PetscReal, 8, 1) DEF_RealType(PetscReal, 1, 0) DEF_RealType(PetscReal, 2, 0) DEF_RealType(PetscReal, 4, 0) DEF_RealType(PetscReal, 8, 0)
+  DEF_RealType(PetscReal, 1, 1) DEF_RealType(PetscReal, 2, 1) DEF_RealType(PetscReal, 3, 1) DEF_RealType(PetscReal, 4, 1) DEF_RealType(PetscReal, 8, 1) DEF_RealType(PetscReal, 1, 0) DEF_RealType(PetscReal, 2, 0) DEF_RealType(PetscReal, 4, 0) DEF_RealType(PetscReal, 8, 0)
 #if defined(PETSC_HAVE_COMPLEX)
-    DEF_ComplexType(PetscComplex, 1, 1) DEF_ComplexType(PetscComplex, 2, 1) DEF_ComplexType(PetscComplex, 4, 1) DEF_ComplexType(PetscComplex, 8, 1) DEF_ComplexType(PetscComplex, 1, 0) DEF_ComplexType(PetscComplex, 2, 0) DEF_ComplexType(PetscComplex, 4, 0) DEF_ComplexType(PetscComplex, 8, 0)
+    DEF_ComplexType(PetscComplex, 1, 1) DEF_ComplexType(PetscComplex, 2, 1) DEF_ComplexType(PetscComplex, 3, 1) DEF_ComplexType(PetscComplex, 4, 1) DEF_ComplexType(PetscComplex, 8, 1) DEF_ComplexType(PetscComplex, 1, 0) DEF_ComplexType(PetscComplex, 2, 0) DEF_ComplexType(PetscComplex, 4, 0) DEF_ComplexType(PetscComplex, 8, 0)
 #endif
 
 #define PairType(Type1, Type2) Type1##_##Type2
@@ -390,7 +403,7 @@ DEF_PairType(PairType(int, int), 1, 1) DEF_PairType(PairType(PetscInt, PetscInt)
   DEF_DumbType(char, 1, 1) DEF_DumbType(char, 2, 1) DEF_DumbType(char, 4, 1) DEF_DumbType(char, 1, 0) DEF_DumbType(char, 2, 0) DEF_DumbType(char, 4, 0)
 
     typedef int DumbInt; /* To have a different name than 'int' used above. The name is used to make routine names. */
-DEF_DumbType(DumbInt, 1, 1) DEF_DumbType(DumbInt, 2, 1) DEF_DumbType(DumbInt, 4, 1) DEF_DumbType(DumbInt, 8, 1) DEF_DumbType(DumbInt, 1, 0) DEF_DumbType(DumbInt, 2, 0) DEF_DumbType(DumbInt, 4, 0) DEF_DumbType(DumbInt, 8, 0)
+DEF_DumbType(DumbInt, 1, 1) DEF_DumbType(DumbInt, 2, 1) DEF_DumbType(DumbInt, 3, 1) DEF_DumbType(DumbInt, 4, 1) DEF_DumbType(DumbInt, 8, 1) DEF_DumbType(DumbInt, 1, 0) DEF_DumbType(DumbInt, 2, 0) DEF_DumbType(DumbInt, 4, 0) DEF_DumbType(DumbInt, 8, 0)
 
   PetscErrorCode PetscSFLinkDestroy(PetscSF sf, PetscSFLink link)
 {
@@ -610,6 +623,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
     else if (nPetscReal % 8 == 0) PackInit_RealType_PetscReal_8_0(link);
     else if (nPetscReal == 4) PackInit_RealType_PetscReal_4_1(link);
     else if (nPetscReal % 4 == 0) PackInit_RealType_PetscReal_4_0(link);
+    else if (nPetscReal == 3) PackInit_RealType_PetscReal_3_1(link);
     else if (nPetscReal == 2) PackInit_RealType_PetscReal_2_1(link);
     else if (nPetscReal % 2 == 0) PackInit_RealType_PetscReal_2_0(link);
     else if (nPetscReal == 1) PackInit_RealType_PetscReal_1_1(link);
@@ -626,6 +640,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
     else if (nPetscInt % 8 == 0) PackInit_IntegerType_PetscInt_8_0(link);
     else if (nPetscInt == 4) PackInit_IntegerType_PetscInt_4_1(link);
     else if (nPetscInt % 4 == 0) PackInit_IntegerType_PetscInt_4_0(link);
+    else if (nPetscInt == 3) PackInit_IntegerType_PetscInt_3_1(link);
     else if (nPetscInt == 2) PackInit_IntegerType_PetscInt_2_1(link);
     else if (nPetscInt % 2 == 0) PackInit_IntegerType_PetscInt_2_0(link);
     else if (nPetscInt == 1) PackInit_IntegerType_PetscInt_1_1(link);
@@ -643,6 +658,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
     else if (nInt % 8 == 0) PackInit_IntegerType_int_8_0(link);
     else if (nInt == 4) PackInit_IntegerType_int_4_1(link);
     else if (nInt % 4 == 0) PackInit_IntegerType_int_4_0(link);
+    else if (nInt == 3) PackInit_IntegerType_int_3_1(link);
     else if (nInt == 2) PackInit_IntegerType_int_2_1(link);
     else if (nInt % 2 == 0) PackInit_IntegerType_int_2_0(link);
     else if (nInt == 1) PackInit_IntegerType_int_1_1(link);
@@ -693,6 +709,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
     else if (nPetscComplex % 8 == 0) PackInit_ComplexType_PetscComplex_8_0(link);
     else if (nPetscComplex == 4) PackInit_ComplexType_PetscComplex_4_1(link);
     else if (nPetscComplex % 4 == 0) PackInit_ComplexType_PetscComplex_4_0(link);
+    else if (nPetscComplex == 3) PackInit_ComplexType_PetscComplex_3_1(link);
     else if (nPetscComplex == 2) PackInit_ComplexType_PetscComplex_2_1(link);
     else if (nPetscComplex % 2 == 0) PackInit_ComplexType_PetscComplex_2_0(link);
     else if (nPetscComplex == 1) PackInit_ComplexType_PetscComplex_1_1(link);
@@ -725,6 +742,7 @@ PetscErrorCode PetscSFLinkSetUp_Host(PetscSF sf, PetscSFLink link, MPI_Datatype
       else if (nInt % 8 == 0) PackInit_DumbType_DumbInt_8_0(link);
       else if (nInt == 4) PackInit_DumbType_DumbInt_4_1(link);
       else if (nInt % 4 == 0) PackInit_DumbType_DumbInt_4_0(link);
+      else if (nInt == 3) PackInit_DumbType_DumbInt_3_1(link);
       else if (nInt == 2) PackInit_DumbType_DumbInt_2_1(link);
       else if (nInt % 2 == 0) PackInit_DumbType_DumbInt_2_0(link);
       else if (nInt == 1) PackInit_DumbType_DumbInt_1_1(link);
@@ -246,6 +246,8 @@ PETSC_INTERN PetscErrorCode PetscSFLinkFetchAndOpLocal(PetscSF, PetscSFLink, voi
 PETSC_INTERN PetscErrorCode PetscSFSetUpPackFields(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFResetPackFields(PetscSF);
 PETSC_INTERN PetscErrorCode PetscSFLinkCreate_MPI(PetscSF, MPI_Datatype, PetscMemType, const void *, PetscMemType, const void *, MPI_Op, PetscSFOperation, PetscSFLink *);
+PETSC_INTERN PetscErrorCode PetscSFLinkShmCheck(PetscSF, MPI_Datatype, PetscMemType, PetscMemType, PetscSFOperation, PetscBool *);
+PETSC_INTERN PetscErrorCode PetscSFLinkSetUp_Shm(PetscSF, PetscSFLink, PetscSFDirection);
 
 #if defined(PETSC_HAVE_CUDA)
 PETSC_INTERN PetscErrorCode PetscSFLinkSetUp_CUDA(PetscSF, PetscSFLink, MPI_Datatype);
@@ -0,0 +1,295 @@
+/*
+   Intra-node communication of SFBasic through an MPI-3 shared memory window.
+
+   Each rank allocates a segment of the window with room for its remote rootbuf and leafbuf. For a broadcast, roots pack
+   rootdata into the rootbuf in the window; a leaf on the same node waits until the root has raised its ready flag and
+   copies its part of the peer's rootbuf into its own leafbuf, which is then unpacked as usual. Reductions are symmetric.
+   Ranks on other nodes are still communicated with through MPI_Isend/Irecv of the same buffers.
+
+   Only one operation per SF goes through the window at a time. Its sequence number is stored in the ready flag once my
+   buffer is packed, and in the done flag once I have finished reading the buffers of my peers. Before packing the next
+   operation, I wait until all on-node peers are done with the previous one. This requires that ranks on the same node
+   call the operations of a SF in the same order.
+*/
+#include <../src/vec/is/sf/impls/basic/sfpack.h>
+
+#if defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+typedef struct {
+  volatile PetscInt64 ready; /* Sequence number of the last operation whose packed buffer is ready to be read */
+  volatile PetscInt64 done;  /* Sequence number of the last operation I have finished reading my peers' buffers */
+  char                pad[48]; /* Keep the flags in their own cache line */
+} PetscSFShmFlags;
+
+typedef struct {
+  PetscSFShmFlags *flags;  /* Flags of the peer in the window, NULL if the peer is on another node */
+  char            *buf;    /* The peer's rootbuf (if it has roots of my leaves) or leafbuf (if it has leaves of my roots) */
+  PetscInt         offset; /* Offset (in units) of my part in buf */
+} PetscSFShmPeer;
+
+struct _n_PetscSFShm {
+  MPI_Win          win;
+  PetscSFShmFlags *flags;             /* My flags */
+  char            *rootbuf, *leafbuf; /* My remote rootbuf and leafbuf in the window */
+  PetscSFShmPeer  *rootpeers;         /* [nranks-ndranks] Ranks owning roots of my leaves */
+  PetscSFShmPeer  *leafpeers;         /* [niranks-ndiranks] Ranks owning leaves of my roots */
+  MPI_Request     *reqs;              /* Requests for the off-node ranks */
+  PetscMPIInt      nreqs;
+  PetscInt64       seq; /* Sequence number of the current or last operation through the window */
+  PetscBool        busy;
+};
+
+static inline size_t PetscSFShmAlign(size_t bytes)
+{
+  return ((bytes + sizeof(PetscSFShmFlags) - 1) / sizeof(PetscSFShmFlags)) * sizeof(PetscSFShmFlags);
+}
+
+PetscErrorCode PetscSFSetUp_Basic_Shm(PetscSF sf)
+{
+  PetscSF_Basic  *bas = (PetscSF_Basic *)sf->data;
+  PetscSFShm      shm;
+  PetscShmComm    pshmcomm;
+  MPI_Comm        comm, shmcomm;
+  MPI_Info        info;
+  MPI_Aint        sz;
+  PetscMPIInt     shmsize, lrank, tag[2], disp_unit, nreqs = 0;
+  PetscInt        i, j, nrootpeers = sf->nranks - sf->ndranks, nleafpeers = bas->niranks - bas->ndiranks, npeers = nrootpeers + nleafpeers, nshm = 0, *sbuf, *rbuf;
+  size_t          rootbytes, leafbytes;
+  char           *base;
+  MPI_Request    *reqs;
+  PetscSFShmPeer *peer;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  PetscCall(PetscShmCommGet(comm, &pshmcomm));
+  PetscCall(PetscShmCommGetMpiShmComm(pshmcomm, &shmcomm));
+  PetscCallMPI(MPI_Comm_size(shmcomm, &shmsize));
+  if (shmsize == 1) PetscFunctionReturn(PETSC_SUCCESS); /* Nobody to share memory with */
+
+  PetscCall(PetscNew(&shm));
+  PetscCall(PetscCalloc3(nrootpeers, &shm->rootpeers, nleafpeers, &shm->leafpeers, npeers, &shm->reqs));
+  rootbytes = PetscSFShmAlign(bas->rootbuflen[PETSCSF_REMOTE] * bas->shm_unitbytes);
+  leafbytes = PetscSFShmAlign(sf->leafbuflen[PETSCSF_REMOTE] * bas->shm_unitbytes);
+  PetscCallMPI(MPI_Info_create(&info));
+  PetscCallMPI(MPI_Info_set(info, "alloc_shared_noncontig", "true"));
+  PetscCall(MPIU_Win_allocate_shared((MPI_Aint)(sizeof(PetscSFShmFlags) + rootbytes + leafbytes), 16, info, shmcomm, &base, &shm->win));
+  PetscCallMPI(MPI_Info_free(&info));
+  PetscCallMPI(MPI_Win_lock_all(MPI_MODE_NOCHECK, shm->win));
+  shm->flags        = (PetscSFShmFlags *)base;
+  shm->flags->ready = 0;
+  shm->flags->done  = 0;
+  shm->rootbuf      = base + sizeof(PetscSFShmFlags);
+  shm->leafbuf      = shm->rootbuf + rootbytes;
+  PetscCallMPI(MPI_Win_sync(shm->win));
+
+  /* Tell on-node peers where their part is in my rootbuf or leafbuf, in pairs of (offset in units, displacement of the buffer in bytes).
+     A rank can be both a root and a leaf peer of another one, so tag[0] is used from leaves to roots and tag[1] from roots to leaves */
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag[0]));
+  PetscCall(PetscObjectGetNewTag((PetscObject)sf, &tag[1]));
+  PetscCall(PetscMalloc3(2 * npeers, &sbuf, 2 * npeers, &rbuf, 2 * npeers, &reqs));
+  for (i = 0; i < npeers; i++) {
+    const PetscBool isroot = i < nrootpeers ? PETSC_TRUE : PETSC_FALSE; /* Does the peer own roots of my leaves? */
+    PetscMPIInt     rank;
+
+    if (isroot) {
+      j               = sf->ndranks + i;
+      rank            = sf->ranks[j];
+      sbuf[2 * i]     = sf->roffset[j] - sf->roffset[sf->ndranks];
+      sbuf[2 * i + 1] = (PetscInt)(shm->leafbuf - base);
+    } else {
+      j               = bas->ndiranks + i - nrootpeers;
+      rank            = bas->iranks[j];
+      sbuf[2 * i]     = bas->ioffset[j] - bas->ioffset[bas->ndiranks];
+      sbuf[2 * i + 1] = (PetscInt)(shm->rootbuf - base);
+    }
+    PetscCall(PetscShmCommGlobalToLocal(pshmcomm, rank, &lrank));
+    if (lrank == MPI_PROC_NULL) continue;
+    PetscCallMPI(MPI_Irecv(rbuf + 2 * i, 2, MPIU_INT, rank, tag[isroot], comm, &reqs[nreqs++]));
+    PetscCallMPI(MPI_Isend(sbuf + 2 * i, 2, MPIU_INT, rank, tag[!isroot], comm, &reqs[nreqs++]));
+  }
+  PetscCallMPI(MPI_Waitall(nreqs, reqs, MPI_STATUSES_IGNORE));
+  for (i = 0; i < npeers; i++) {
+    const PetscMPIInt rank = i < nrootpeers ? sf->ranks[sf->ndranks + i] : bas->iranks[bas->ndiranks + i - nrootpeers];
+
+    PetscCall(PetscShmCommGlobalToLocal(pshmcomm, rank, &lrank));
+    if (lrank == MPI_PROC_NULL) continue;
+    peer = i < nrootpeers ? &shm->rootpeers[i] : &shm->leafpeers[i - nrootpeers];
+    PetscCall(MPIU_Win_shared_query(shm->win, lrank, &sz, &disp_unit, &base));
+    peer->flags  = (PetscSFShmFlags *)base;
+    peer->buf    = base + rbuf[2 * i + 1];
+    peer->offset = rbuf[2 * i];
+    nshm++;
+  }
+  PetscCall(PetscFree3(sbuf, rbuf, reqs));
+  /* Make sure the flags are initialized before anybody looks at them */
+  PetscCallMPI(MPI_Barrier(shmcomm));
+  PetscCallMPI(MPI_Win_sync(shm->win));
+  bas->shm = shm;
+  PetscCall(PetscInfo(sf, "Communicating with %" PetscInt_FMT " of %" PetscInt_FMT " remote ranks through shared memory\n", nshm, npeers));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscSFReset_Basic_Shm(PetscSF sf)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+  PetscSFShm     shm = bas->shm;
+
+  PetscFunctionBegin;
+  if (!shm) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCallMPI(MPI_Win_unlock_all(shm->win));
+  PetscCallMPI(MPI_Win_free(&shm->win));
+  PetscCall(PetscFree3(shm->rootpeers, shm->leafpeers, shm->reqs));
+  PetscCall(PetscFree(bas->shm));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Can the operation go through the shared memory window? The answer must be the same on all ranks of a node */
+PetscErrorCode PetscSFLinkShmCheck(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, PetscMemType leafmtype, PetscSFOperation sfop, PetscBool *use_shm)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+  PetscMPIInt    unitbytes;
+
+  PetscFunctionBegin;
+  *use_shm = PETSC_FALSE;
+  if (!bas->shm || bas->shm->busy || sfop == PETSCSF_FETCH || !PetscMemTypeHost(rootmtype) || !PetscMemTypeHost(leafmtype)) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCallMPI(MPI_Type_size(unit, &unitbytes));
+  if (unitbytes <= bas->shm_unitbytes) *use_shm = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Wait until all on-node peers are done with the operation <seq> */
+static PetscErrorCode PetscSFShmWaitDone(PetscSFShm shm, PetscInt n, const PetscSFShmPeer *peers, PetscInt64 seq)
+{
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < n; i++) {
+    if (!peers[i].flags) continue;
+    while (peers[i].flags->done < seq) PetscCallMPI(MPI_Win_sync(shm->win));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Copy my parts of the packed buffers of on-node peers to buf, whose layout is given by offset[] */
+static PetscErrorCode PetscSFShmCopyFromPeers(PetscSFShm shm, PetscSFLink link, PetscInt n, const PetscSFShmPeer *peers, const PetscInt *offset, char *buf)
+{
+  const size_t unitbytes = link->unitbytes;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < n; i++) {
+    if (!peers[i].flags) continue;
+    while (peers[i].flags->ready < shm->seq) PetscCallMPI(MPI_Win_sync(shm->win));
+    PetscCallMPI(MPI_Win_sync(shm->win));
+    PetscCall(PetscMemcpy(buf + (offset[i] - offset[0]) * unitbytes, peers[i].buf + peers[i].offset * unitbytes, (offset[i + 1] - offset[i]) * unitbytes));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Post MPI_Irecv/Isend for the off-node peers */
+static PetscErrorCode PetscSFShmPostRequests(PetscSF sf, PetscSFLink link, PetscInt n, const PetscSFShmPeer *peers, const PetscMPIInt *ranks, const PetscInt *offset, char *buf, PetscBool recv)
+{
+  PetscSFShm shm = ((PetscSF_Basic *)sf->data)->shm;
+  MPI_Comm   comm;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  for (PetscInt i = 0; i < n; i++) {
+    char    *p   = buf + (offset[i] - offset[0]) * link->unitbytes;
+    PetscInt cnt = offset[i + 1] - offset[i];
+
+    if (peers[i].flags) continue;
+    if (recv) PetscCallMPI(MPIU_Irecv(p, cnt, link->unit, ranks[i], link->tag, comm, &shm->reqs[shm->nreqs++]));
+    else PetscCallMPI(MPIU_Isend(p, cnt, link->unit, ranks[i], link->tag, comm, &shm->reqs[shm->nreqs++]));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFLinkStartCommunication_Shm(PetscSF sf, PetscSFLink link, PetscSFDirection direction)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+  PetscSFShm     shm = bas->shm;
+  const PetscInt nrootpeers = sf->nranks - sf->ndranks, nleafpeers = bas->niranks - bas->ndiranks;
+  char          *rootbuf = link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST], *leafbuf = link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST];
+
+  PetscFunctionBegin;
+  shm->nreqs = 0;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    PetscCall(PetscSFShmPostRequests(sf, link, nrootpeers, shm->rootpeers, sf->ranks + sf->ndranks, sf->roffset + sf->ndranks, leafbuf, PETSC_TRUE));
+  } else {
+    PetscCall(PetscSFShmPostRequests(sf, link, nleafpeers, shm->leafpeers, bas->iranks + bas->ndiranks, bas->ioffset + bas->ndiranks, rootbuf, PETSC_TRUE));
+  }
+  /* My packed buffer is ready */
+  PetscCallMPI(MPI_Win_sync(shm->win));
+  shm->flags->ready = shm->seq;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    PetscCall(PetscSFShmPostRequests(sf, link, nleafpeers, shm->leafpeers, bas->iranks + bas->ndiranks, bas->ioffset + bas->ndiranks, rootbuf, PETSC_FALSE));
+  } else {
+    PetscCall(PetscSFShmPostRequests(sf, link, nrootpeers, shm->rootpeers, sf->ranks + sf->ndranks, sf->roffset + sf->ndranks, leafbuf, PETSC_FALSE));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFLinkFinishCommunication_Shm(PetscSF sf, PetscSFLink link, PetscSFDirection direction)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+  PetscSFShm     shm = bas->shm;
+
+  PetscFunctionBegin;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    PetscCall(PetscSFShmCopyFromPeers(shm, link, sf->nranks - sf->ndranks, shm->rootpeers, sf->roffset + sf->ndranks, link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]));
+  } else {
+    PetscCall(PetscSFShmCopyFromPeers(shm, link, bas->niranks - bas->ndiranks, shm->leafpeers, bas->ioffset + bas->ndiranks, link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST]));
+  }
+  PetscCallMPI(MPI_Waitall(shm->nreqs, shm->reqs, MPI_STATUSES_IGNORE));
+  PetscCallMPI(MPI_Win_sync(shm->win));
+  shm->flags->done = shm->seq;
+  shm->busy        = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Start a new operation through the window, which will hold the buffer packed in the given direction */
+PetscErrorCode PetscSFLinkSetUp_Shm(PetscSF sf, PetscSFLink link, PetscSFDirection direction)
+{
+  PetscSF_Basic *bas = (PetscSF_Basic *)sf->data;
+  PetscSFShm     shm = bas->shm;
+
+  PetscFunctionBegin;
+  /* My peers might still be reading what I packed in the previous operation */
+  PetscCall(PetscSFShmWaitDone(shm, sf->nranks - sf->ndranks, shm->rootpeers, shm->seq));
+  PetscCall(PetscSFShmWaitDone(shm, bas->niranks - bas->ndiranks, shm->leafpeers, shm->seq));
+  PetscCallMPI(MPI_Win_sync(shm->win));
+  shm->seq++;
+  shm->busy = PETSC_TRUE;
+  if (direction == PETSCSF_ROOT2LEAF) {
+    if (bas->rootbuflen[PETSCSF_REMOTE]) link->rootbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] = shm->rootbuf;
+  } else {
+    if (sf->leafbuflen[PETSCSF_REMOTE]) link->leafbuf[PETSCSF_REMOTE][PETSC_MEMTYPE_HOST] = shm->leafbuf;
+  }
+  link->StartCommunication  = PetscSFLinkStartCommunication_Shm;
+  link->FinishCommunication = PetscSFLinkFinishCommunication_Shm;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+#else
+PetscErrorCode PetscSFSetUp_Basic_Shm(PetscSF sf)
+{
+  PetscFunctionBegin;
+  PetscCall(PetscInfo(sf, "Shared memory is not available, use MPI for all remote communication\n"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscSFReset_Basic_Shm(PetscSF sf)
+{
+  PetscFunctionBegin;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscSFLinkShmCheck(PetscSF sf, MPI_Datatype unit, PetscMemType rootmtype, PetscMemType leafmtype, PetscSFOperation sfop, PetscBool *use_shm)
+{
+  PetscFunctionBegin;
+  *use_shm = PETSC_FALSE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode PetscSFLinkSetUp_Shm(PetscSF sf, PetscSFLink link, PetscSFDirection direction)
+{
+  PetscFunctionBegin;
+  SETERRQ(PETSC_COMM_SELF, PETSC_ERR_SUP_SYS, "Shared memory is not available");
+}
+#endif
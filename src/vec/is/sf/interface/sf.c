@@ -2,6 +2,7 @@
 #include <petsc/private/hashseti.h>
 #include <petsc/private/viewerimpl.h>
 #include <petsc/private/hashmapi.h>
+#include <../src/vec/is/sf/impls/basic/sfpack.h> /* for the pack kernels used by PetscSFBcastBatchBegin() */
 
 #if defined(PETSC_HAVE_CUDA)
   #include <cuda_runtime.h>
@@ -27,6 +28,8 @@ void PetscSFCheckGraphSet(PetscSF, int);
 const char *const PetscSFDuplicateOptions[]     = {"CONFONLY", "RANKS", "GRAPH", "PetscSFDuplicateOption", "PETSCSF_DUPLICATE_", NULL};
 const char *const PetscSFConcatenateRootModes[] = {"local", "shared", "global", "PetscSFConcatenateRootMode", "PETSCSF_CONCATENATE_ROOTMODE_", NULL};
 
+static PetscErrorCode PetscSFResetBatches_Private(PetscSF);
+
 /*@
    PetscSFCreate - create a star forest communication context
 
@@ -134,6 +137,7 @@ PetscErrorCode PetscSFReset(PetscSF sf)
   if (sf->outgroup != MPI_GROUP_NULL) PetscCallMPI(MPI_Group_free(&sf->outgroup));
   if (sf->multi) sf->multi->multi = NULL;
   PetscCall(PetscSFDestroy(&sf->multi));
+  PetscCall(PetscSFResetBatches_Private(sf));
   PetscCall(PetscLayoutDestroy(&sf->map));
 
 #if defined(PETSC_HAVE_DEVICE)
@@ -327,6 +331,12 @@ PetscErrorCode PetscSFSetUp(PetscSF sf)
    Options Database Keys:
 +  -sf_type               - implementation type, see `PetscSFSetType()`
 .  -sf_rank_order         - sort composite points for gathers and scatters in rank order, gathers are non-deterministic otherwise
+.  -sf_basic_shared_memory - For `PETSCSFBASIC`, communicate with ranks on the same node by copying from the packed buffers they place in an MPI-3
+                             shared memory window instead of sending MPI messages (default: false). Only host data is supported; ranks on the
+                             same node must call the operations on the `PetscSF` in the same order.
+.  -sf_basic_shared_memory_unit_bytes - Operations with larger units (in bytes) use MPI (default: 4*sizeof(`PetscScalar`))
+.  -sf_neighbor_persistent - For `PETSCSFNEIGHBOR`, initialize MPI-4 persistent neighborhood collectives once per unit and direction and
+                             only start them afterwards (default: false). Root/leafdata are then always packed into buffers of the `PetscSF`.
 .  -sf_use_default_stream - Assume callers of `PetscSF` computed the input root/leafdata with the default CUDA stream. `PetscSF` will also
                             use the default stream to process data. Therefore, no stream synchronization is needed between `PetscSF` and its caller (default: true).
                             If true, this option only works with `-use_gpu_aware_mpi 1`.
@@ -1503,6 +1513,269 @@ PetscErrorCode PetscSFBcastEnd(PetscSF sf, MPI_Datatype unit, const void *rootda
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+struct _n_PetscSFBatch {
+  PetscInt      n;
+  MPI_Datatype *units;   /* [n] Datatype of each field, the key of the batch in the cache of the SF */
+  PetscSFLink  *links;   /* [n] Host pack kernels of each field */
+  size_t       *offset;  /* [n+1] Offset of each field in an entry */
+  MPI_Datatype  unit;    /* All fields of one entry, as bytes */
+  char         *rootbuf; /* Entries sent to each rank, in the order of PetscSFGetLeafRanks() */
+  char         *leafbuf; /* Entries received from each rank, in the order of PetscSFGetRootRanks() */
+  const void   *key;     /* leafdata[0] of the broadcast in progress, NULL if the batch is free */
+  PetscSFBatch  next;
+};
+
+/*
+   Batched broadcasts communicate over an SF whose roots are the edges of sf, numbered as the entries sent to each leaf rank, and whose leaves
+   are the leaves of sf, numbered as the entries received from each root rank. Both sides of the internal SF are thus contiguous and it
+   sends from and receives into the batch buffers directly. As it only moves the entries exchanged with each rank as a block of bytes, the
+   fields of these entries are stored one after the other, so that they are packed and unpacked by the pack kernels of each field.
+*/
+static PetscErrorCode PetscSFBatchSetUp_Private(PetscSF sf)
+{
+  MPI_Comm           comm;
+  const PetscMPIInt *ranks, *iranks, *branks;
+  const PetscInt    *roffset, *ioffset, *broffset, *brmine, *bioffset, *birootloc;
+  PetscMPIInt        nfrom, *fromranks;
+  PetscInt           nranks, niranks, bnranks, bniranks, i, j, l, *fromstart;
+  PetscSFNode       *bremote;
+
+  PetscFunctionBegin;
+  if (sf->batchsf) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscObjectGetComm((PetscObject)sf, &comm));
+  PetscCall(PetscSFGetRootRanks(sf, &nranks, &ranks, &roffset, NULL, NULL));
+  PetscCall(PetscSFGetLeafRanks(sf, &niranks, &iranks, &ioffset, NULL));
+  /* Tell each leaf rank where the entries it receives from this process start */
+  PetscCall(PetscCommBuildTwoSided(comm, 1, MPIU_INT, (PetscMPIInt)niranks, iranks, ioffset, &nfrom, &fromranks, &fromstart));
+  PetscCall(PetscSortMPIIntWithIntArray(nfrom, fromranks, fromstart));
+  PetscCall(PetscMalloc1(roffset[nranks], &bremote));
+  for (i = 0; i < nranks; i++) {
+    PetscCall(PetscFindMPIInt(ranks[i], nfrom, fromranks, &j));
+    PetscCheck(j >= 0, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Rank %d did not send the start of its entries", ranks[i]);
+    for (l = roffset[i]; l < roffset[i + 1]; l++) {
+      bremote[l].rank  = ranks[i];
+      bremote[l].index = fromstart[j] + l - roffset[i];
+    }
+  }
+  PetscCall(PetscFree(fromranks));
+  PetscCall(PetscFree(fromstart));
+  PetscCall(PetscSFCreate(comm, &sf->batchsf));
+  PetscCall(PetscSFSetType(sf->batchsf, PETSCSFBASIC));
+  PetscCall(PetscSFSetGraph(sf->batchsf, ioffset[niranks], roffset[nranks], NULL, PETSC_OWN_POINTER, bremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf->batchsf));
+
+  /* The packing relies on the internal SF exchanging the entries with each rank in the same order as sf */
+  PetscCall(PetscSFGetRootRanks(sf->batchsf, &bnranks, &branks, &broffset, &brmine, NULL));
+  PetscCall(PetscSFGetLeafRanks(sf->batchsf, &bniranks, NULL, &bioffset, &birootloc));
+  PetscCheck(bnranks == nranks && bniranks == niranks, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Internal SF of batched broadcasts does not have the ranks of the SF");
+  for (i = 0; i < nranks; i++) PetscCheck(branks[i] == ranks[i] && broffset[i + 1] == roffset[i + 1], PETSC_COMM_SELF, PETSC_ERR_PLIB, "Internal SF of batched broadcasts does not have the root ranks of the SF");
+  for (i = 0; i < niranks; i++) PetscCheck(bioffset[i + 1] == ioffset[i + 1], PETSC_COMM_SELF, PETSC_ERR_PLIB, "Internal SF of batched broadcasts does not have the leaf ranks of the SF");
+  for (l = 0; l < roffset[nranks]; l++) PetscCheck(brmine[l] == l, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Internal SF of batched broadcasts has noncontiguous leaves");
+  for (l = 0; l < ioffset[niranks]; l++) PetscCheck(birootloc[l] == l, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Internal SF of batched broadcasts has noncontiguous roots");
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Returns a free batch for these units from the cache of the SF, creating it if needed */
+static PetscErrorCode PetscSFBatchGet_Private(PetscSF sf, PetscInt n, const MPI_Datatype units[], PetscSFBatch *batch)
+{
+  PetscSFBatch *p, b;
+  PetscBool     match = PETSC_FALSE;
+  PetscInt      i, nedges;
+
+  PetscFunctionBegin;
+  for (p = &sf->batches; (b = *p); p = &b->next) {
+    if (b->key || b->n != n) continue;
+    for (i = 0, match = PETSC_TRUE; i < n && match; i++) PetscCall(MPIPetsc_Type_compare(units[i], b->units[i], &match));
+    if (match) break;
+  }
+  if (!b) {
+    PetscCall(PetscSFBatchSetUp_Private(sf));
+    PetscCall(PetscSFGetGraph(sf->batchsf, &nedges, NULL, NULL, NULL));
+    PetscCall(PetscNew(&b));
+    PetscCall(PetscMalloc3(n, &b->units, n, &b->links, n + 1, &b->offset));
+    b->n         = n;
+    b->offset[0] = 0;
+    for (i = 0; i < n; i++) {
+      PetscCallMPI(MPI_Type_dup(units[i], &b->units[i]));
+      PetscCall(PetscNew(&b->links[i]));
+      PetscCall(PetscSFLinkSetUp_Host(sf->batchsf, b->links[i], units[i]));
+      b->offset[i + 1] = b->offset[i] + b->links[i]->unitbytes;
+    }
+    PetscCallMPI(MPI_Type_contiguous((PetscMPIInt)b->offset[n], MPI_BYTE, &b->unit));
+    PetscCallMPI(MPI_Type_commit(&b->unit));
+    PetscCall(PetscMalloc2(nedges * b->offset[n], &b->rootbuf, sf->nleaves * b->offset[n], &b->leafbuf));
+    *p = b;
+  }
+  *batch = b;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFBatchDestroy_Private(PetscSFBatch *batch)
+{
+  PetscSFBatch b = *batch;
+
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < b->n; i++) {
+    PetscCallMPI(MPI_Type_free(&b->units[i]));
+    if (!b->links[i]->isbuiltin) PetscCallMPI(MPI_Type_free(&b->links[i]->unit));
+    PetscCall(PetscFree(b->links[i]));
+  }
+  PetscCallMPI(MPI_Type_free(&b->unit));
+  PetscCall(PetscFree2(b->rootbuf, b->leafbuf));
+  PetscCall(PetscFree3(b->units, b->links, b->offset));
+  PetscCall(PetscFree(*batch));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode PetscSFResetBatches_Private(PetscSF sf)
+{
+  PetscSFBatch next;
+
+  PetscFunctionBegin;
+  for (; sf->batches; sf->batches = next) {
+    next = sf->batches->next;
+    PetscCheck(!sf->batches->key, PetscObjectComm((PetscObject)sf), PETSC_ERR_ARG_WRONGSTATE, "Outstanding batched broadcast has not been completed");
+    PetscCall(PetscSFBatchDestroy_Private(&sf->batches));
+  }
+  PetscCall(PetscSFDestroy(&sf->batchsf));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Only broadcasts with MPI_REPLACE of host data on SFs that exchange entries with each rank like SFBasic are batched, the others are done field by field */
+static PetscErrorCode PetscSFBatchUsable_Private(PetscSF sf, PetscInt n, const void *const rootdata[], void *const leafdata[], MPI_Op op, PetscBool *usable)
+{
+  PetscMemType rootmtype, leafmtype;
+
+  PetscFunctionBegin;
+  *usable = (PetscBool)(n > 1 && op == MPI_REPLACE);
+  if (*usable) PetscCall(PetscObjectTypeCompareAny((PetscObject)sf, usable, PETSCSFBASIC, PETSCSFNEIGHBOR, ""));
+  for (PetscInt i = 0; i < n && *usable; i++) {
+    PetscCall(PetscGetMemType(rootdata[i], &rootmtype));
+    PetscCall(PetscGetMemType(leafdata[i], &leafmtype));
+    if (!PetscMemTypeHost(rootmtype) || !PetscMemTypeHost(leafmtype)) *usable = PETSC_FALSE;
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   PetscSFBcastBatchBegin - begin pointwise broadcasts of several fields on the same star forest, to be concluded with call to `PetscSFBcastBatchEnd()`
+
+   Collective
+
+   Input Parameters:
++  sf - star forest on which to communicate
+.  n - number of fields
+.  units - data type associated with each node, for each field
+.  rootdata - buffers to broadcast, one for each field
+-  op - operation to use for reduction
+
+   Output Parameter:
+.  leafdata - buffers to be reduced with values from each leaf's respective root, one for each field
+
+   Level: intermediate
+
+   Notes:
+   With `MPI_REPLACE`, data in host memory and a `PETSCSFBASIC` or `PETSCSFNEIGHBOR` star forest, the entries of all fields are packed together
+   so that a single message is sent to each process instead of one message per field, which is equivalent to, but with lower latency than,
+   calling `PetscSFBcastBegin()` for each field. Otherwise the fields are broadcast one by one.
+
+   The datatypes in `units` must be contiguous, that is have a zero lower bound and an extent equal to their size.
+
+   The arrays `units`, `rootdata` and `leafdata` must not change until `PetscSFBcastBatchEnd()` is called.
+
+   The first call builds an internal star forest, which requires communication. The buffers of the packed entries are cached on `sf` for each
+   sequence of `units`, so repeated broadcasts of the same fields allocate no memory.
+
+.seealso: `PetscSF`, `PetscSFBcastBatchEnd()`, `PetscSFBcastBegin()`
+@*/
+PetscErrorCode PetscSFBcastBatchBegin(PetscSF sf, PetscInt n, const MPI_Datatype units[], const void *const rootdata[], void *const leafdata[], MPI_Op op)
+{
+  PetscSFBatch    batch = NULL;
+  PetscBool       usable;
+  PetscInt        i, f, niranks, cnt;
+  const PetscInt *ioffset, *irootloc;
+  MPI_Aint        lb, extent;
+  PetscMPIInt     size;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  for (f = 0; f < n; f++) {
+    PetscCallMPI(MPI_Type_get_extent(units[f], &lb, &extent));
+    PetscCallMPI(MPI_Type_size(units[f], &size));
+    PetscCheck(lb == 0 && extent == size, PETSC_COMM_SELF, PETSC_ERR_SUP, "Batched broadcasts require contiguous datatypes, field %" PetscInt_FMT " has lower bound %ld, extent %ld and size %d", f, (long)lb, (long)extent, size);
+  }
+  PetscCall(PetscSFSetUp(sf));
+  PetscCall(PetscSFBatchUsable_Private(sf, n, rootdata, leafdata, op, &usable));
+  if (!usable) {
+    for (f = 0; f < n; f++) PetscCall(PetscSFBcastBegin(sf, units[f], rootdata[f], leafdata[f], op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscCall(PetscSFBatchGet_Private(sf, n, units, &batch));
+  batch->key = leafdata[0];
+  PetscCall(PetscLogEventBegin(PETSCSF_Pack, sf, 0, 0, 0));
+  PetscCall(PetscSFGetLeafRanks(sf, &niranks, NULL, &ioffset, &irootloc));
+  for (i = 0; i < niranks; i++) {
+    char *buf = batch->rootbuf + ioffset[i] * batch->offset[n];
+
+    cnt = ioffset[i + 1] - ioffset[i];
+    for (f = 0; f < n; f++) PetscCall((*batch->links[f]->h_Pack)(batch->links[f], cnt, 0, NULL, irootloc + ioffset[i], rootdata[f], buf + cnt * batch->offset[f]));
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Pack, sf, 0, 0, 0));
+  PetscCall(PetscSFBcastWithMemTypeBegin(sf->batchsf, batch->unit, PETSC_MEMTYPE_HOST, batch->rootbuf, PETSC_MEMTYPE_HOST, batch->leafbuf, MPI_REPLACE));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@C
+   PetscSFBcastBatchEnd - end broadcasts of several fields started with `PetscSFBcastBatchBegin()`
+
+   Collective
+
+   Input Parameters:
++  sf - star forest
+.  n - number of fields
+.  units - data type of each field
+.  rootdata - buffers to broadcast
+-  op - operation to use for reduction
+
+   Output Parameter:
+.  leafdata - buffers to be reduced with values from each leaf's respective root
+
+   Level: intermediate
+
+.seealso: `PetscSF`, `PetscSFBcastBatchBegin()`, `PetscSFBcastEnd()`
+@*/
+PetscErrorCode PetscSFBcastBatchEnd(PetscSF sf, PetscInt n, const MPI_Datatype units[], const void *const rootdata[], void *const leafdata[], MPI_Op op)
+{
+  PetscSFBatch    batch;
+  PetscBool       usable;
+  PetscInt        i, f, nranks, cnt;
+  const PetscInt *roffset, *rmine;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(sf, PETSCSF_CLASSID, 1);
+  PetscCall(PetscSFBatchUsable_Private(sf, n, rootdata, leafdata, op, &usable));
+  if (!usable) {
+    for (f = 0; f < n; f++) PetscCall(PetscSFBcastEnd(sf, units[f], rootdata[f], leafdata[f], op));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  for (batch = sf->batches; batch; batch = batch->next) {
+    if (batch->key == leafdata[0] && batch->n == n) break;
+  }
+  PetscCheck(batch, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Could not find the batched broadcast begun with these arguments");
+  PetscCall(PetscSFBcastEnd(sf->batchsf, batch->unit, batch->rootbuf, batch->leafbuf, MPI_REPLACE));
+  PetscCall(PetscLogEventBegin(PETSCSF_Unpack, sf, 0, 0, 0));
+  PetscCall(PetscSFGetRootRanks(sf, &nranks, NULL, &roffset, &rmine, NULL));
+  for (i = 0; i < nranks; i++) {
+    const char *buf = batch->leafbuf + roffset[i] * batch->offset[n];
+
+    cnt = roffset[i + 1] - roffset[i];
+    for (f = 0; f < n; f++) PetscCall((*batch->links[f]->h_UnpackAndInsert)(batch->links[f], cnt, 0, NULL, rmine + roffset[i], leafdata[f], buf + cnt * batch->offset[f]));
+  }
+  PetscCall(PetscLogEventEnd(PETSCSF_Unpack, sf, 0, 0, 0));
+  batch->key = NULL;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
    PetscSFReduceBegin - begin reduction of leafdata into rootdata, to be completed with call to `PetscSFReduceEnd()`
 
@@ -0,0 +1,171 @@
+static const char help[] = "Test PetscSF communication with ranks on the same node through shared memory or through node leaders against plain MPI\n\n";
+
+#include <petscsf.h>
+
+/* Compare the leaf or root data of the two SFs, entries not touched by the SF hold the same initial values */
+static PetscErrorCode CheckEqual(PetscInt n, const PetscInt *a, const PetscInt *b, const char *what, PetscInt it)
+{
+  PetscFunctionBegin;
+  for (PetscInt i = 0; i < n; i++) PetscCheck(a[i] == b[i], PETSC_COMM_SELF, PETSC_ERR_PLIB, "%s differs at %" PetscInt_FMT " in iteration %" PetscInt_FMT ": %" PetscInt_FMT " vs %" PetscInt_FMT, what, i, it, a[i], b[i]);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **argv)
+{
+  PetscSF      sf[2];
+  PetscSFNode *iremote;
+  PetscInt    *ilocal, nroots, nleaves, nleafspace, i, k, l, it, niter = 20, bs = 7;
+  PetscBool    opposite = PETSC_FALSE;
+  PetscInt    *rootdata[2], *leafdata[2], *rootdata2[2], *leafdata2[2], *rootblk[2], *leafblk[2];
+  PetscMPIInt  rank, size;
+  MPI_Datatype blk;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-niter", &niter, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-bs", &bs, NULL));
+  PetscCall(PetscOptionsGetBool(NULL, NULL, "-opposite", &opposite, NULL));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+
+  /* Every rank has leaves on the roots of every other rank, some roots are referenced several times, others not at all */
+  nroots  = 6 + rank;
+  nleaves = 0;
+  for (PetscMPIInt r = 0; r < size; r++) nleaves += 1 + (rank + 2 * r) % 5;
+  nleafspace = 2 * nleaves + 1;
+  PetscCall(PetscMalloc1(nleaves, &ilocal));
+  PetscCall(PetscMalloc1(nleaves, &iremote));
+  l = 0;
+  for (PetscMPIInt r = 0; r < size; r++) {
+    for (k = 0; k < 1 + (rank + 2 * r) % 5; k++, l++) {
+      ilocal[l]        = nleafspace - 1 - 2 * l; /* Reversed and strided leaves */
+      iremote[l].rank  = r;
+      iremote[l].index = (3 * k + rank) % (6 + r);
+    }
+  }
+
+  for (i = 0; i < 2; i++) {
+    PetscCall(PetscSFCreate(PETSC_COMM_WORLD, &sf[i]));
+    /* Only the first SF gets the command line options, the second is the reference using MPI */
+    if (i) PetscCall(PetscObjectSetOptionsPrefix((PetscObject)sf[i], "ref_"));
+    PetscCall(PetscSFSetFromOptions(sf[i]));
+    PetscCall(PetscSFSetGraph(sf[i], nroots, nleaves, ilocal, PETSC_COPY_VALUES, iremote, PETSC_COPY_VALUES));
+    PetscCall(PetscSFSetUp(sf[i]));
+    PetscCall(PetscMalloc6(nroots, &rootdata[i], nleafspace, &leafdata[i], nroots, &rootdata2[i], nleafspace, &leafdata2[i], nroots * bs, &rootblk[i], nleafspace * bs, &leafblk[i]));
+  }
+  PetscCall(PetscFree(ilocal));
+  PetscCall(PetscFree(iremote));
+  PetscCallMPI(MPI_Type_contiguous((PetscMPIInt)bs, MPIU_INT, &blk));
+  PetscCallMPI(MPI_Type_commit(&blk));
+
+  for (it = 0; it < niter; it++) {
+    for (i = 0; i < 2; i++) {
+      for (k = 0; k < nroots; k++) rootdata[i][k] = rootdata2[i][k] = 1000 * rank + 10 * k + it;
+      for (k = 0; k < nleafspace; k++) leafdata[i][k] = leafdata2[i][k] = -1 - k - it;
+      for (k = 0; k < nroots * bs; k++) rootblk[i][k] = 7 * k + rank - it;
+      for (k = 0; k < nleafspace * bs; k++) leafblk[i][k] = -k;
+
+      /* Broadcasts and reductions, with a second operation in flight on the same SF and one with a large unit */
+      PetscCall(PetscSFBcastBegin(sf[i], MPIU_INT, rootdata[i], leafdata[i], MPI_REPLACE));
+      PetscCall(PetscSFBcastBegin(sf[i], MPIU_INT, rootdata2[i], leafdata2[i], MPI_SUM));
+      PetscCall(PetscSFBcastEnd(sf[i], MPIU_INT, rootdata[i], leafdata[i], MPI_REPLACE));
+      PetscCall(PetscSFBcastBegin(sf[i], blk, rootblk[i], leafblk[i], MPI_REPLACE));
+      PetscCall(PetscSFBcastEnd(sf[i], MPIU_INT, rootdata2[i], leafdata2[i], MPI_SUM));
+      PetscCall(PetscSFBcastEnd(sf[i], blk, rootblk[i], leafblk[i], MPI_REPLACE));
+      PetscCall(PetscSFReduceBegin(sf[i], MPIU_INT, leafdata[i], rootdata2[i], MPI_SUM));
+      PetscCall(PetscSFReduceEnd(sf[i], MPIU_INT, leafdata[i], rootdata2[i], MPI_SUM));
+      PetscCall(PetscSFReduceBegin(sf[i], MPIU_INT, leafdata2[i], rootdata[i], MPI_MAX));
+      PetscCall(PetscSFReduceEnd(sf[i], MPIU_INT, leafdata2[i], rootdata[i], MPI_MAX));
+    }
+    PetscCall(CheckEqual(nleafspace, leafdata[0], leafdata[1], "Bcast with MPI_REPLACE", it));
+    PetscCall(CheckEqual(nleafspace, leafdata2[0], leafdata2[1], "Bcast with MPI_SUM", it));
+    PetscCall(CheckEqual(nleafspace * bs, leafblk[0], leafblk[1], "Bcast of blocks", it));
+    PetscCall(CheckEqual(nroots, rootdata2[0], rootdata2[1], "Reduce with MPI_SUM", it));
+    PetscCall(CheckEqual(nroots, rootdata[0], rootdata[1], "Reduce with MPI_MAX", it));
+  }
+
+  /* Two SFs of the tested type with operations started and completed in opposite orders on even and odd ranks, large units need
+     the receives of every stage to be posted while the other operation is in progress */
+  if (opposite) {
+    PetscSF   sfo[2];
+    PetscInt *rooto[2], *leafo[2];
+
+    sfo[0] = sf[0];
+    PetscCall(PetscSFDuplicate(sf[0], PETSCSF_DUPLICATE_GRAPH, &sfo[1]));
+    PetscCall(PetscSFSetUp(sfo[1]));
+    for (i = 0; i < 2; i++) {
+      PetscCall(PetscMalloc2(nroots * bs, &rooto[i], nleafspace * bs, &leafo[i]));
+      for (k = 0; k < nroots * bs; k++) rooto[i][k] = rank + k;
+      for (k = 0; k < nleafspace * bs; k++) leafo[i][k] = -k;
+    }
+    /* Use the SFs once in the same order on all ranks, since the first operation with a unit creates links with new tags */
+    for (i = 0; i < 2; i++) {
+      PetscCall(PetscSFBcastBegin(sfo[i], blk, rootblk[0], leafo[i], MPI_REPLACE));
+      PetscCall(PetscSFBcastEnd(sfo[i], blk, rootblk[0], leafo[i], MPI_REPLACE));
+      PetscCall(PetscSFReduceBegin(sfo[i], blk, leafo[i], rooto[i], MPI_SUM));
+      PetscCall(PetscSFReduceEnd(sfo[i], blk, leafo[i], rooto[i], MPI_SUM));
+    }
+    for (i = 0; i < 2; i++) {
+      for (k = 0; k < nroots * bs; k++) rooto[i][k] = rank + k;
+      for (k = 0; k < nleafspace * bs; k++) leafo[i][k] = -k;
+    }
+    for (i = 0; i < 2; i++) PetscCall(PetscSFBcastBegin(sfo[(i + rank) % 2], blk, rootblk[0], leafo[(i + rank) % 2], MPI_REPLACE));
+    for (i = 0; i < 2; i++) PetscCall(PetscSFBcastEnd(sfo[(i + rank) % 2], blk, rootblk[0], leafo[(i + rank) % 2], MPI_REPLACE));
+    for (i = 0; i < 2; i++) PetscCall(PetscSFReduceBegin(sfo[(i + rank) % 2], blk, leafo[(i + rank) % 2], rooto[(i + rank) % 2], MPI_SUM));
+    for (i = 0; i < 2; i++) PetscCall(PetscSFReduceEnd(sfo[(i + rank) % 2], blk, leafo[(i + rank) % 2], rooto[(i + rank) % 2], MPI_SUM));
+    for (i = 0; i < 2; i++) PetscCall(CheckEqual(nleafspace * bs, leafo[i], leafblk[1], "Bcast of blocks in opposite orders", i));
+    PetscCall(CheckEqual(nroots * bs, rooto[0], rooto[1], "Reduce of blocks in opposite orders", 0));
+    for (i = 0; i < 2; i++) PetscCall(PetscFree2(rooto[i], leafo[i]));
+    PetscCall(PetscSFDestroy(&sfo[1]));
+  }
+
+  PetscCallMPI(MPI_Type_free(&blk));
+  for (i = 0; i < 2; i++) {
+    PetscCall(PetscFree6(rootdata[i], leafdata[i], rootdata2[i], leafdata2[i], rootblk[i], leafblk[i]));
+    PetscCall(PetscSFDestroy(&sf[i]));
+  }
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 3 4}}
+      args: -sf_type basic -sf_basic_shared_memory
+      output_file: output/empty.out
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      suffix: 2
+      nsize: 4
+      args: -sf_type basic -sf_basic_shared_memory -sf_basic_shared_memory_unit_bytes {{0 4}} -bs {{1 7}}
+      output_file: output/empty.out
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      # all ranks look like they are on different nodes
+      suffix: 3
+      nsize: 3
+      args: -sf_type basic -sf_basic_shared_memory -noshared
+      output_file: output/empty.out
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      # with -noshared all edges to other ranks go through the node leader
+      suffix: hierarchical
+      nsize: 4
+      args: -sf_type hierarchical -noshared {{0 1}} -bs {{1 7}}
+      output_file: output/empty.out
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+   test:
+      # operations on two SFs in opposite orders on the ranks of the node, with messages too large to be sent eagerly
+      suffix: hierarchical_opposite
+      nsize: 4
+      args: -sf_type hierarchical -noshared -opposite -bs 50000 -niter 1
+      output_file: output/empty.out
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
+TEST*/
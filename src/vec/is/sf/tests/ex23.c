@@ -0,0 +1,86 @@
+static const char help[] = "Test PetscSF pack/unpack of strided roots and leaves with various unit sizes\n\n";
+
+#include <petscsf.h>
+
+int main(int argc, char **argv)
+{
+  PetscSF      sf;
+  PetscSFNode *iremote;
+  PetscInt    *ilocal, n = 10, nroots, nleafspace, rstride = 3, lstride = 2, rstart = 1, i, k, bs;
+  PetscReal   *rootdata, *leafdata;
+  PetscMPIInt  rank, size;
+  MPI_Datatype unit;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-root_stride", &rstride, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-leaf_stride", &lstride, NULL));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+
+  /* Leaves with a constant stride on each rank reference roots with another constant stride on the next rank */
+  nroots     = rstart + rstride * n;
+  nleafspace = lstride * n;
+  PetscCall(PetscMalloc1(n, &ilocal));
+  PetscCall(PetscMalloc1(n, &iremote));
+  for (i = 0; i < n; i++) {
+    ilocal[i]        = lstride * i;
+    iremote[i].rank  = (rank + 1) % size;
+    iremote[i].index = rstart + rstride * i;
+  }
+  PetscCall(PetscSFCreate(PETSC_COMM_WORLD, &sf));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetGraph(sf, nroots, n, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf));
+
+  /* Covers the specialized block sizes 1, 2, 3, 4 and 8 and the generic ones */
+  for (bs = 1; bs <= 9; bs++) {
+    if (bs > 1) {
+      PetscCallMPI(MPI_Type_contiguous((PetscMPIInt)bs, MPIU_REAL, &unit));
+      PetscCallMPI(MPI_Type_commit(&unit));
+    } else unit = MPIU_REAL;
+    PetscCall(PetscMalloc2(nroots * bs, &rootdata, nleafspace * bs, &leafdata));
+    for (k = 0; k < nroots * bs; k++) rootdata[k] = 1000 * rank + k;
+    for (k = 0; k < nleafspace * bs; k++) leafdata[k] = -1;
+    PetscCall(PetscSFBcastBegin(sf, unit, rootdata, leafdata, MPI_REPLACE));
+    PetscCall(PetscSFBcastEnd(sf, unit, rootdata, leafdata, MPI_REPLACE));
+    for (i = 0; i < nleafspace; i++) {
+      for (k = 0; k < bs; k++) {
+        PetscReal expect = i % lstride ? -1 : 1000 * ((rank + 1) % size) + (rstart + rstride * (i / lstride)) * bs + k;
+        PetscCheck(leafdata[i * bs + k] == expect, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Bcast with bs %" PetscInt_FMT ": wrong leaf %" PetscInt_FMT, bs, i);
+      }
+    }
+
+    /* Reduce the leaves back, each referenced root receives its own value once more */
+    PetscCall(PetscSFReduceBegin(sf, unit, leafdata, rootdata, MPI_SUM));
+    PetscCall(PetscSFReduceEnd(sf, unit, leafdata, rootdata, MPI_SUM));
+    for (i = 0; i < nroots; i++) {
+      for (k = 0; k < bs; k++) {
+        PetscReal orig = 1000 * rank + i * bs + k, expect = (i >= rstart && (i - rstart) % rstride == 0) ? 2 * orig : orig;
+        PetscCheck(rootdata[i * bs + k] == expect, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Reduce with bs %" PetscInt_FMT ": wrong root %" PetscInt_FMT, bs, i);
+      }
+    }
+    PetscCall(PetscFree2(rootdata, leafdata));
+    if (bs > 1) PetscCallMPI(MPI_Type_free(&unit));
+  }
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 3}}
+      args: -root_stride {{1 3}} -leaf_stride {{1 2}}
+      output_file: output/empty.out
+
+   test:
+      suffix: neighbor_persistent
+      nsize: 3
+      args: -sf_type neighbor -sf_neighbor_persistent -root_stride {{1 3}}
+      output_file: output/empty.out
+      requires: defined(PETSC_HAVE_MPI_PERSISTENT_NEIGHBORHOOD_COLLECTIVES)
+
+TEST*/
@@ -0,0 +1,149 @@
+static const char help[] = "Test PetscSFBcastBatchBegin/End() against one broadcast per field, with two batches of different datatypes in flight\n\n";
+
+#include <petscsf.h>
+
+#define NFIELDS 4
+
+int main(int argc, char **argv)
+{
+  PetscSF        sf;
+  PetscSFNode   *iremote;
+  PetscInt      *ilocal, nroots, nleaves, nleafspace, i, k, l, it, f;
+  PetscInt      *iroot, *ileaf[3];
+  PetscReal     *rroot, *rleaf[3], *vroot, *vleaf[3];
+  char          *croot, *cleaf[3];
+  PetscMPIInt    rank, size;
+  MPI_Datatype   vec3, units[NFIELDS], units2[2], padded[2];
+  PetscErrorCode ierr;
+  MPI_Op         ops[] = {MPI_REPLACE, MPI_SUM};
+  size_t         bytes[NFIELDS] = {sizeof(PetscInt), sizeof(PetscReal), 3 * sizeof(PetscReal), sizeof(char)};
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &argv, NULL, help));
+  PetscCallMPI(MPI_Comm_rank(PETSC_COMM_WORLD, &rank));
+  PetscCallMPI(MPI_Comm_size(PETSC_COMM_WORLD, &size));
+
+  /* Some roots are referenced several times, others not at all, and leaves are strided */
+  nroots  = 5 + rank;
+  nleaves = 0;
+  for (PetscMPIInt r = 0; r < size; r++) nleaves += 1 + (rank + r) % 3;
+  nleafspace = 2 * nleaves + 1;
+  PetscCall(PetscMalloc1(nleaves, &ilocal));
+  PetscCall(PetscMalloc1(nleaves, &iremote));
+  l = 0;
+  for (PetscMPIInt r = 0; r < size; r++) {
+    for (k = 0; k < 1 + (rank + r) % 3; k++, l++) {
+      ilocal[l]        = 2 * l + 1;
+      iremote[l].rank  = r;
+      iremote[l].index = (2 * k + rank) % (5 + r);
+    }
+  }
+  PetscCall(PetscSFCreate(PETSC_COMM_WORLD, &sf));
+  PetscCall(PetscSFSetFromOptions(sf));
+  PetscCall(PetscSFSetGraph(sf, nroots, nleaves, ilocal, PETSC_OWN_POINTER, iremote, PETSC_OWN_POINTER));
+  PetscCall(PetscSFSetUp(sf));
+
+  PetscCallMPI(MPI_Type_contiguous(3, MPIU_REAL, &vec3));
+  PetscCallMPI(MPI_Type_commit(&vec3));
+  units[0]  = MPIU_INT;
+  units[1]  = MPIU_REAL;
+  units[2]  = vec3;
+  units[3]  = MPI_CHAR;
+  units2[0] = vec3;
+  units2[1] = MPIU_INT;
+  PetscCall(PetscMalloc4(nroots, &iroot, nroots, &rroot, 3 * nroots, &vroot, nroots, &croot));
+  for (i = 0; i < 3; i++) PetscCall(PetscMalloc4(nleafspace, &ileaf[i], nleafspace, &rleaf[i], 3 * nleafspace, &vleaf[i], nleafspace, &cleaf[i]));
+
+  for (it = 0; it < 4; it++) {
+    const void *rootdata[NFIELDS] = {iroot, rroot, vroot, croot}, *rootdata2[2] = {vroot, iroot};
+    void       *leafdata[2][NFIELDS], *leafdata2[2];
+    MPI_Op      op = ops[it % 2];
+
+    for (k = 0; k < nroots; k++) {
+      iroot[k] = 100 * rank + k + it;
+      rroot[k] = -0.5 * iroot[k];
+      croot[k] = (char)('a' + k);
+      for (l = 0; l < 3; l++) vroot[3 * k + l] = 10 * iroot[k] + l;
+    }
+    for (i = 0; i < 3; i++) {
+      for (k = 0; k < nleafspace; k++) {
+        ileaf[i][k] = -k;
+        rleaf[i][k] = k;
+        cleaf[i][k] = 'z';
+        for (l = 0; l < 3; l++) vleaf[i][3 * k + l] = -l;
+      }
+      if (i == 2) continue;
+      leafdata[i][0] = ileaf[i];
+      leafdata[i][1] = rleaf[i];
+      leafdata[i][2] = vleaf[i];
+      leafdata[i][3] = cleaf[i];
+    }
+    leafdata2[0] = vleaf[2];
+    leafdata2[1] = ileaf[2];
+    /* MPI_SUM is not defined for MPI_CHAR, so it is only tested on the first three fields */
+    f = op == MPI_REPLACE ? NFIELDS : NFIELDS - 1;
+    PetscCall(PetscSFBcastBatchBegin(sf, f, units, rootdata, leafdata[0], op));
+    PetscCall(PetscSFBcastBatchBegin(sf, 2, units2, rootdata2, leafdata2, op));
+    for (k = 0; k < f; k++) PetscCall(PetscSFBcastBegin(sf, units[k], rootdata[k], leafdata[1][k], op));
+    for (k = 0; k < f; k++) PetscCall(PetscSFBcastEnd(sf, units[k], rootdata[k], leafdata[1][k], op));
+    PetscCall(PetscSFBcastBatchEnd(sf, f, units, rootdata, leafdata[0], op));
+    PetscCall(PetscSFBcastBatchEnd(sf, 2, units2, rootdata2, leafdata2, op));
+    for (k = 0; k < NFIELDS; k++) {
+      PetscBool same;
+
+      PetscCall(PetscMemcmp(leafdata[0][k], leafdata[1][k], nleafspace * bytes[k], &same));
+      PetscCheck(same, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Field %" PetscInt_FMT " differs in iteration %" PetscInt_FMT, k, it);
+    }
+    for (k = 0; k < 2; k++) {
+      PetscBool same;
+
+      PetscCall(PetscMemcmp(leafdata2[k], leafdata[1][k ? 0 : 2], nleafspace * bytes[k ? 0 : 2], &same));
+      PetscCheck(same, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Field %" PetscInt_FMT " of the second batch differs in iteration %" PetscInt_FMT, k, it);
+    }
+  }
+
+  /* Datatypes with holes are rejected */
+  PetscCallMPI(MPI_Type_create_resized(MPIU_INT, 0, 2 * sizeof(PetscInt), &padded[0]));
+  PetscCallMPI(MPI_Type_commit(&padded[0]));
+  padded[1] = MPIU_REAL;
+  {
+    const void *rootdata[2] = {iroot, rroot};
+    void       *leafdata[2] = {ileaf[0], rleaf[0]};
+
+    PetscCall(PetscPushErrorHandler(PetscReturnErrorHandler, NULL));
+    ierr = PetscSFBcastBatchBegin(sf, 2, padded, rootdata, leafdata, MPI_REPLACE);
+    PetscCall(PetscPopErrorHandler());
+    PetscCheck(ierr == PETSC_ERR_SUP, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Noncontiguous datatype was not rejected");
+  }
+  PetscCallMPI(MPI_Type_free(&padded[0]));
+
+  PetscCall(PetscFree4(iroot, rroot, vroot, croot));
+  for (i = 0; i < 3; i++) PetscCall(PetscFree4(ileaf[i], rleaf[i], vleaf[i], cleaf[i]));
+  PetscCallMPI(MPI_Type_free(&vec3));
+  PetscCall(PetscSFDestroy(&sf));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 3}}
+      args: -sf_type basic
+      output_file: output/empty.out
+
+   test:
+      suffix: window
+      nsize: 3
+      args: -sf_type window
+      output_file: output/empty.out
+      requires: defined(PETSC_HAVE_MPI_ONE_SIDED) defined(PETSC_HAVE_MPI_FEATURE_DYNAMIC_WINDOW)
+
+   test:
+      suffix: neighbor
+      nsize: 3
+      args: -sf_type neighbor
+      output_file: output/empty.out
+      requires: defined(PETSC_HAVE_MPI_NEIGHBORHOOD_COLLECTIVES)
+
+TEST*/
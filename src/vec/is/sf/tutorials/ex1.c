@@ -613,4 +613,12 @@ int main(int argc, char **argv)
       nsize: 4
       args: -sf_type basic -test_all -test_bcastop 0 -test_fetchandop 0
 
+   test:
+      suffix: 10_hierarchical
+      nsize: 4
+      output_file: output/ex1_10_basic.out
+      filter: sed -e "s/type: hierarchical/type: basic/g"
+      args: -sf_type hierarchical -noshared -test_all -test_bcastop 0 -test_fetchandop 0
+      requires: defined(PETSC_HAVE_MPI_PROCESS_SHARED_MEMORY)
+
 TEST*/
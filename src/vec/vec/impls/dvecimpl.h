@@ -42,8 +42,12 @@ PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMDot_Seq(Vec, PetscInt, const Vec[
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMTDot_Seq(Vec, PetscInt, const Vec[], PetscScalar *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecSet_Seq(Vec, PetscScalar);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMAXPY_Seq(Vec, PetscInt, const PetscScalar *, Vec *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMAXPYMDot_Seq(Vec, PetscInt, const PetscScalar *, Vec *, PetscScalar *, PetscReal *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecMAXPYMDot_Seq_Private(Vec, PetscInt, const PetscScalar *, Vec *, PetscScalar *, PetscReal *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecAYPX_Seq(Vec, PetscScalar, Vec);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecWAXPY_Seq(Vec, PetscScalar, Vec, Vec);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecWAXPYDotNorm_Seq(Vec, PetscScalar, Vec, Vec, Vec, PetscScalar *, PetscReal *);
+PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecWAXPYDotNorm_Seq_Private(Vec, PetscScalar, Vec, Vec, Vec, PetscScalar *, PetscReal *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecAXPBYPCZ_Seq(Vec, PetscScalar, PetscScalar, PetscScalar, Vec, Vec);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecPlaceArray_Seq(Vec, const PetscScalar *);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecResetArray_Seq(Vec);
@@ -63,4 +67,26 @@ PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecPointwiseMult_Seq(Vec, Vec, Vec);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecPointwiseDivide_Seq(Vec, Vec, Vec);
 PETSC_SINGLE_LIBRARY_INTERN PetscErrorCode VecAXPY_Seq(Vec, PetscScalar, Vec);
 
+/* Thread parallel kernels, see bvecthreads.c */
+static inline PetscInt VecThreads_Private(Vec v)
+{
+  return ((Vec_Seq *)v->data)->nthreads;
+}
+
+PETSC_INTERN PetscErrorCode VecThreadsSetUp_Private(Vec, PetscInt, const PetscInt[], PetscInt);
+PETSC_INTERN PetscErrorCode VecSetFromOptions_Threads_Private(Vec, PetscOptionItems *, PetscInt);
+PETSC_INTERN PetscErrorCode VecSet_Seq_Threads(Vec, PetscScalar);
+PETSC_INTERN PetscErrorCode VecCopy_Seq_Threads(Vec, Vec);
+PETSC_INTERN PetscErrorCode VecScale_Seq_Threads(Vec, PetscScalar);
+PETSC_INTERN PetscErrorCode VecAXPY_Seq_Threads(Vec, PetscScalar, Vec);
+PETSC_INTERN PetscErrorCode VecAYPX_Seq_Threads(Vec, PetscScalar, Vec);
+PETSC_INTERN PetscErrorCode VecWAXPY_Seq_Threads(Vec, PetscScalar, Vec, Vec);
+PETSC_INTERN PetscErrorCode VecAXPBYPCZ_Seq_Threads(Vec, PetscScalar, PetscScalar, PetscScalar, Vec, Vec);
+PETSC_INTERN PetscErrorCode VecMAXPY_Seq_Threads(Vec, PetscInt, const PetscScalar *, Vec *);
+PETSC_INTERN PetscErrorCode VecDot_Seq_Threads(Vec, Vec, PetscScalar *);
+PETSC_INTERN PetscErrorCode VecMDot_Seq_Threads(Vec, PetscInt, const Vec[], PetscScalar *);
+PETSC_INTERN PetscErrorCode VecNorm_Seq_Threads(Vec, NormType, PetscReal *);
+PETSC_INTERN PetscErrorCode VecPointwiseMult_Seq_Threads(Vec, Vec, Vec);
+PETSC_INTERN PetscErrorCode VecPointwiseApply_Seq_Threads(Vec, Vec, Vec, PetscScalar (*const)(PetscScalar, PetscScalar));
+
 #endif // PETSC_DVECIMPL_H
@@ -178,6 +178,8 @@ inline PetscErrorCode VecMPI_CUPM<T>::BindToCPU(Vec v, PetscBool usehost) noexce
 
   VecSetOp_CUPM(dot, VecDot_MPI, Dot);
   VecSetOp_CUPM(mdot, VecMDot_MPI, MDot);
+  VecSetOp_CUPM(maxpymdot, VecMAXPYMDot_MPI, nullptr);
+  VecSetOp_CUPM(waxpydotnorm, VecWAXPYDotNorm_MPI, nullptr);
   VecSetOp_CUPM(norm, VecNorm_MPI, Norm);
   VecSetOp_CUPM(tdot, VecTDot_MPI, TDot);
   VecSetOp_CUPM(resetarray, VecResetArray_MPI, base_type::template ResetArray<PETSC_MEMTYPE_HOST>);
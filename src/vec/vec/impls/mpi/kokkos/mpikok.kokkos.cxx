@@ -197,6 +197,8 @@ static PetscErrorCode VecSetOps_MPIKokkos(Vec v)
   v->ops->axpy            = VecAXPY_SeqKokkos;
   v->ops->axpby           = VecAXPBY_SeqKokkos;
   v->ops->maxpy           = VecMAXPY_SeqKokkos;
+  v->ops->maxpymdot       = NULL;
+  v->ops->waxpydotnorm    = NULL;
   v->ops->aypx            = VecAYPX_SeqKokkos;
   v->ops->axpbypcz        = VecAXPBYPCZ_SeqKokkos;
   v->ops->pointwisedivide = VecPointwiseDivide_SeqKokkos;
@@ -178,6 +178,8 @@ PetscErrorCode VecBindToCPU_MPIViennaCL(Vec vv, PetscBool bind)
     vv->ops->axpy                   = VecAXPY_Seq;
     vv->ops->axpby                  = VecAXPBY_Seq;
     vv->ops->maxpy                  = VecMAXPY_Seq;
+    vv->ops->maxpymdot              = VecMAXPYMDot_MPI;
+    vv->ops->waxpydotnorm           = VecWAXPYDotNorm_MPI;
     vv->ops->aypx                   = VecAYPX_Seq;
     vv->ops->axpbypcz               = VecAXPBYPCZ_Seq;
     vv->ops->pointwisemult          = VecPointwiseMult_Seq;
@@ -210,6 +212,8 @@ PetscErrorCode VecBindToCPU_MPIViennaCL(Vec vv, PetscBool bind)
     vv->ops->axpy            = VecAXPY_SeqViennaCL;
     vv->ops->axpby           = VecAXPBY_SeqViennaCL;
     vv->ops->maxpy           = VecMAXPY_SeqViennaCL;
+    vv->ops->maxpymdot       = NULL;
+    vv->ops->waxpydotnorm    = NULL;
     vv->ops->aypx            = VecAYPX_SeqViennaCL;
     vv->ops->axpbypcz        = VecAXPBYPCZ_SeqViennaCL;
     vv->ops->pointwisemult   = VecPointwiseMult_SeqViennaCL;
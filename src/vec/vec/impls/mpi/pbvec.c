@@ -31,6 +31,7 @@ PetscErrorCode VecDuplicate_MPI(Vec win, Vec *v)
   PetscCall(VecCreate_MPI_Private(*v, PETSC_TRUE, w->nghost, NULL));
   vw = (Vec_MPI *)(*v)->data;
   PetscCall(PetscMemcpy((*v)->ops, win->ops, sizeof(*win->ops)));
+  if (w->nthreads > 1) PetscCall(VecThreadsSetUp_Private(*v, w->nthreads, w->threadstart, win->map->n + w->nghost));
 
   /* save local representation of the parallel vector (and scatter) if it exists */
   if (w->localrep) {
@@ -348,22 +349,26 @@ PetscErrorCode VecAssemblyReset_MPI(Vec X)
 
 static PetscErrorCode VecSetFromOptions_MPI(Vec X, PetscOptionItems *PetscOptionsObject)
 {
+  Vec_MPI *x = (Vec_MPI *)X->data;
 #if !defined(PETSC_HAVE_MPIUNI)
   PetscBool flg = PETSC_FALSE, set;
+#endif
 
   PetscFunctionBegin;
   PetscOptionsHeadBegin(PetscOptionsObject, "VecMPI Options");
+#if !defined(PETSC_HAVE_MPIUNI)
   PetscCall(PetscOptionsBool("-vec_assembly_legacy", "Use MPI 1 version of assembly", "", flg, &flg, &set));
   if (set) {
     X->ops->assemblybegin = flg ? VecAssemblyBegin_MPI : VecAssemblyBegin_MPI_BTS;
     X->ops->assemblyend   = flg ? VecAssemblyEnd_MPI : VecAssemblyEnd_MPI_BTS;
   }
-  PetscOptionsHeadEnd();
 #else
-  PetscFunctionBegin;
   X->ops->assemblybegin = VecAssemblyBegin_MPI;
   X->ops->assemblyend   = VecAssemblyEnd_MPI;
 #endif
+  /* The local representation of a ghosted vector shares the array, so it cannot be moved for first touch */
+  PetscCall(VecSetFromOptions_Threads_Private(X, PetscOptionsObject, x->localrep ? 0 : X->map->n + x->nghost));
+  PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -454,7 +459,9 @@ static struct _VecOps DvOps = {PetscDesignatedInitializer(duplicate, VecDuplicat
                                PetscDesignatedInitializer(concatenate, NULL),
                                PetscDesignatedInitializer(sum, NULL),
                                PetscDesignatedInitializer(setpreallocationcoo, VecSetPreallocationCOO_MPI),
-                               PetscDesignatedInitializer(setvaluescoo, VecSetValuesCOO_MPI)};
+                               PetscDesignatedInitializer(setvaluescoo, VecSetValuesCOO_MPI),
+                               PetscDesignatedInitializer(maxpymdot, VecMAXPYMDot_MPI),
+                               PetscDesignatedInitializer(waxpydotnorm, VecWAXPYDotNorm_MPI)};
 
 /*
     VecCreate_MPI_Private - Basic create routine called by VecCreate_MPI() (i.e. VecCreateMPI()),
@@ -509,11 +516,17 @@ PetscErrorCode VecCreate_MPI_Private(Vec v, PetscBool alloc, PetscInt nghost, co
 /*MC
    VECMPI - VECMPI = "mpi" - The basic parallel vector
 
-   Options Database Key:
-. -vec_type mpi - sets the vector type to `VECMPI` during a call to `VecSetFromOptions()`
+   Options Database Keys:
++ -vec_type mpi - sets the vector type to `VECMPI` during a call to `VecSetFromOptions()`
+- -vec_threads <n> - number of OpenMP threads used by the local vector kernels, `PETSC_DECIDE` uses `-omp_num_threads`
 
   Level: beginner
 
+  Note:
+  With `-vec_threads` the local entries are split into equal contiguous chunks that are always processed by the same
+  thread and first touched by it, the setting is inherited by `VecDuplicate()`. The vectors obtained with `MatCreateVecs()`
+  from a `MATSEQAIJ` matrix using `-mat_aij_threads` are split like the rows of the matrix instead
+
 .seealso: [](chapter_vectors), `Vec`, `VecType`, `VecCreate()`, `VecSetType()`, `VecSetFromOptions()`, `VecCreateMPIWithArray()`, `VECMPI`, `VecType`, `VecCreateMPI()`, `VecCreateMPI()`
 M*/
 
@@ -34,6 +34,7 @@ PetscErrorCode VecDestroy_MPI(Vec v)
 #endif
   if (!x) PetscFunctionReturn(PETSC_SUCCESS);
   PetscCall(PetscFree(x->array_allocated));
+  PetscCall(PetscFree(x->threadstart));
 
   /* Destroy local representation of vector if it exists */
   if (x->localrep) {
@@ -26,6 +26,40 @@ PetscErrorCode VecMDot_MPI(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+PetscErrorCode VecMAXPYMDot_MPI(Vec yin, PetscInt nv, const PetscScalar *alpha, Vec *x, PetscScalar *z, PetscReal *nrm)
+{
+  PetscScalar sbuf[64], *work = sbuf;
+  PetscReal   nrm2;
+  PetscInt    n = z ? nv : 0; /* number of dot products to reduce */
+
+  PetscFunctionBegin;
+  /* the dot products and the square of the norm are reduced together, on the stack unless the basis is unusually large */
+  if (n + 1 > (PetscInt)PETSC_STATIC_ARRAY_LENGTH(sbuf)) PetscCall(PetscMalloc1(n + 1, &work));
+  PetscCall(VecMAXPYMDot_Seq_Private(yin, nv, alpha, x, z ? work : NULL, &nrm2));
+  work[n] = nrm2;
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, work, n + 1, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)yin)));
+  if (z) PetscCall(PetscArraycpy(z, work, n));
+  *nrm = PetscSqrtReal(PetscRealPart(work[n]));
+  if (work != sbuf) PetscCall(PetscFree(work));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecWAXPYDotNorm_MPI(Vec win, PetscScalar alpha, Vec xin, Vec yin, Vec zin, PetscScalar *val, PetscReal *nrm)
+{
+  PetscScalar work[2] = {0.0, 0.0};
+  PetscReal   nrm2;
+  PetscMPIInt n = 0;
+
+  PetscFunctionBegin;
+  /* the dot product and the square of the norm are reduced together */
+  PetscCall(VecWAXPYDotNorm_Seq_Private(win, alpha, xin, yin, zin, zin ? &work[n++] : NULL, nrm ? &nrm2 : NULL));
+  if (nrm) work[n++] = nrm2;
+  PetscCall(MPIU_Allreduce(MPI_IN_PLACE, work, n, MPIU_SCALAR, MPIU_SUM, PetscObjectComm((PetscObject)win)));
+  if (zin) *val = work[0];
+  if (nrm) *nrm = PetscSqrtReal(PetscRealPart(work[n - 1]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode VecMTDot_MPI(Vec xin, PetscInt nv, const Vec y[], PetscScalar *z)
 {
   PetscFunctionBegin;
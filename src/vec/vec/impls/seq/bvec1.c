@@ -30,7 +30,8 @@ static PetscErrorCode VecXDot_Seq_Private(Vec xin, Vec yin, PetscScalar *z, Pets
 PetscErrorCode VecDot_Seq(Vec xin, Vec yin, PetscScalar *z)
 {
   PetscFunctionBegin;
-  PetscCall(VecXDot_Seq_Private(xin, yin, z, BLASdot_));
+  if (VecThreads_Private(xin) > 1) PetscCall(VecDot_Seq_Threads(xin, yin, z));
+  else PetscCall(VecXDot_Seq_Private(xin, yin, z, BLASdot_));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -50,6 +51,8 @@ PetscErrorCode VecScale_Seq(Vec xin, PetscScalar alpha)
   PetscFunctionBegin;
   if (alpha == (PetscScalar)0.0) {
     PetscCall(VecSet_Seq(xin, alpha));
+  } else if (alpha != (PetscScalar)1.0 && VecThreads_Private(xin) > 1) {
+    PetscCall(VecScale_Seq_Threads(xin, alpha));
   } else if (alpha != (PetscScalar)1.0) {
     const PetscBLASInt one = 1;
     PetscBLASInt       bn;
@@ -68,7 +71,9 @@ PetscErrorCode VecAXPY_Seq(Vec yin, PetscScalar alpha, Vec xin)
 {
   PetscFunctionBegin;
   /* assume that the BLAS handles alpha == 1.0 efficiently since we have no fast code for it */
-  if (alpha != (PetscScalar)0.0) {
+  if (alpha != (PetscScalar)0.0 && VecThreads_Private(yin) > 1) {
+    PetscCall(VecAXPY_Seq_Threads(yin, alpha, xin));
+  } else if (alpha != (PetscScalar)0.0) {
     const PetscScalar *xarray;
     PetscScalar       *yarray;
     const PetscBLASInt one = 1;
@@ -124,6 +129,10 @@ PetscErrorCode VecAXPBYPCZ_Seq(Vec zin, PetscScalar alpha, PetscScalar beta, Pet
   PetscScalar       *zz;
 
   PetscFunctionBegin;
+  if (VecThreads_Private(zin) > 1) {
+    PetscCall(VecAXPBYPCZ_Seq_Threads(zin, alpha, beta, gamma, xin, yin));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(VecGetArrayRead(xin, &xx));
   PetscCall(VecGetArrayRead(yin, &yy));
   PetscCall(VecGetArray(zin, &zz));
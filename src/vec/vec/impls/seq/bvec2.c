@@ -19,6 +19,10 @@ static PetscErrorCode VecPointwiseApply_Seq(Vec win, Vec xin, Vec yin, PetscScal
   PetscScalar   *ww, *xx, *yy; /* cannot make xx or yy const since might be ww */
 
   PetscFunctionBegin;
+  if (VecThreads_Private(win) > 1) {
+    PetscCall(VecPointwiseApply_Seq_Threads(win, xin, yin, func));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(VecGetArrayRead(xin, (const PetscScalar **)&xx));
   PetscCall(VecGetArrayRead(yin, (const PetscScalar **)&yy));
   PetscCall(VecGetArray(win, &ww));
@@ -80,6 +84,10 @@ PetscErrorCode VecPointwiseMult_Seq(Vec win, Vec xin, Vec yin)
   PetscScalar *ww, *xx, *yy; /* cannot make xx or yy const since might be ww */
 
   PetscFunctionBegin;
+  if (VecThreads_Private(win) > 1) {
+    PetscCall(VecPointwiseMult_Seq_Threads(win, xin, yin));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(VecGetArrayRead(xin, (const PetscScalar **)&xx));
   PetscCall(VecGetArrayRead(yin, (const PetscScalar **)&yy));
   PetscCall(VecGetArray(win, &ww));
@@ -158,7 +166,9 @@ PetscErrorCode VecResetArray_Seq(Vec vin)
 PetscErrorCode VecCopy_Seq(Vec xin, Vec yin)
 {
   PetscFunctionBegin;
-  if (xin != yin) {
+  if (xin != yin && VecThreads_Private(yin) > 1) {
+    PetscCall(VecCopy_Seq_Threads(xin, yin));
+  } else if (xin != yin) {
     const PetscScalar *xa;
     PetscScalar       *ya;
 
@@ -198,6 +208,10 @@ PetscErrorCode VecNorm_Seq(Vec xin, NormType type, PetscReal *z)
   const PetscInt n      = xin->map->n;
 
   PetscFunctionBegin;
+  if (VecThreads_Private(xin) > 1) {
+    PetscCall(VecNorm_Seq_Threads(xin, type, z));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   if (n) {
     const PetscScalar *xx;
     const PetscBLASInt one = 1;
@@ -730,6 +744,7 @@ PetscErrorCode VecDestroy_Seq(Vec v)
   PetscCall(PetscLogObjectState((PetscObject)v, "Length=%" PetscInt_FMT, v->map->n));
 #endif
   if (vs) PetscCall(PetscFree(vs->array_allocated));
+  if (vs) PetscCall(PetscFree(vs->threadstart));
   PetscCall(VecResetPreallocationCOO_Seq(v));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscMatlabEnginePut_C", NULL));
   PetscCall(PetscObjectComposeFunction((PetscObject)v, "PetscMatlabEngineGet_C", NULL));
@@ -756,6 +771,16 @@ PetscErrorCode VecDuplicate_Seq(Vec win, Vec *V)
 
   (*V)->ops->view          = win->ops->view;
   (*V)->stash.ignorenegidx = win->stash.ignorenegidx;
+  if (VecThreads_Private(win) > 1) PetscCall(VecThreadsSetUp_Private(*V, VecThreads_Private(win), ((Vec_Seq *)win->data)->threadstart, (*V)->map->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode VecSetFromOptions_Seq(Vec v, PetscOptionItems *PetscOptionsObject)
+{
+  PetscFunctionBegin;
+  PetscOptionsHeadBegin(PetscOptionsObject, "VecSeq Options");
+  PetscCall(VecSetFromOptions_Threads_Private(v, PetscOptionsObject, v->map->n));
+  PetscOptionsHeadEnd();
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
@@ -807,7 +832,7 @@ static struct _VecOps DvOps = {
   PetscDesignatedInitializer(setlocaltoglobalmapping, NULL),
   PetscDesignatedInitializer(setvalueslocal, NULL),
   PetscDesignatedInitializer(resetarray, VecResetArray_Seq),
-  PetscDesignatedInitializer(setfromoptions, NULL),
+  PetscDesignatedInitializer(setfromoptions, VecSetFromOptions_Seq),
   PetscDesignatedInitializer(maxpointwisedivide, VecMaxPointwiseDivide_Seq),
   PetscDesignatedInitializer(pointwisemax, VecPointwiseMax_Seq),
   PetscDesignatedInitializer(pointwisemaxabs, VecPointwiseMaxAbs_Seq),
@@ -848,6 +873,8 @@ static struct _VecOps DvOps = {
   PetscDesignatedInitializer(sum, NULL),
   PetscDesignatedInitializer(setpreallocationcoo, VecSetPreallocationCOO_Seq),
   PetscDesignatedInitializer(setvaluescoo, VecSetValuesCOO_Seq),
+  PetscDesignatedInitializer(maxpymdot, VecMAXPYMDot_Seq),
+  PetscDesignatedInitializer(waxpydotnorm, VecWAXPYDotNorm_Seq),
 };
 
 /*
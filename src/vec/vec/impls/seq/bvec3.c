@@ -8,10 +8,16 @@
    VECSEQ - VECSEQ = "seq" - The basic sequential vector
 
    Options Database Keys:
-. -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
++ -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
+- -vec_threads <n> - number of OpenMP threads used by the vector kernels, `PETSC_DECIDE` uses `-omp_num_threads`
 
   Level: beginner
 
+  Note:
+  With `-vec_threads` the entries are split into equal contiguous chunks that are always processed by the same
+  thread and first touched by it, the setting is inherited by `VecDuplicate()`. The vectors obtained with `MatCreateVecs()`
+  from a `MATSEQAIJ` matrix using `-mat_aij_threads` use the threads and the row partition of the matrix instead
+
 .seealso: `VecCreate()`, `VecSetType()`, `VecSetFromOptions()`, `VecCreateSeqWithArray()`, `VECMPI`, `VecType`, `VecCreateMPI()`, `VecCreateSeq()`
 M*/
 
@@ -0,0 +1,501 @@
+/*
+    Thread parallel kernels for the host arrays of VECSEQ and VECMPI, selected with -vec_threads <n>.
+
+    The entries are split into n contiguous chunks and thread t always processes chunk t. The chunks have equal
+    length unless a partition was given with VecThreadsSetPartition_Private(), as MatCreateVecs() does for a threaded
+    SeqAIJ matrix so that a vector is split like the rows of the matrix. The array of the vector is first touched with
+    the same partition, so the entries a thread works on live on its own NUMA domain. The team of threads is kept alive
+    by the OpenMP runtime between kernels, use OMP_WAIT_POLICY=active to have the idle threads spin instead of sleep.
+    Partial reductions are combined in thread order, so the results do not depend on the scheduling.
+*/
+#include <../src/vec/vec/impls/mpi/pvecimpl.h>
+
+/* Thread t processes the entries [start, end) of the first n entries of v, the last thread also takes any entries past the partition */
+static inline void VecThreadsGetRange_Private(Vec v, PetscInt n, PetscInt t, PetscInt *start, PetscInt *end)
+{
+  const Vec_Seq *s  = (Vec_Seq *)v->data;
+  const PetscInt nt = s->nthreads;
+
+  if (s->threadstart) {
+    *start = s->threadstart[t];
+    *end   = t == nt - 1 ? n : s->threadstart[t + 1];
+  } else {
+    *start = (PetscInt)(((PetscCount)n * t) / nt);
+    *end   = (PetscInt)(((PetscCount)n * (t + 1)) / nt);
+  }
+}
+
+/*
+   Sets the number of threads of a vector and their partition of the entries, NULL for equal chunks. If the vector owns
+   its array, which has len entries, the array is reallocated and its entries are copied by the threads that will later
+   process them. Pass len = 0 to keep the array.
+*/
+PetscErrorCode VecThreadsSetUp_Private(Vec v, PetscInt nt, const PetscInt rstart[], PetscInt len)
+{
+  Vec_Seq     *s = (Vec_Seq *)v->data;
+  PetscScalar *array, *old = s->array;
+
+  PetscFunctionBegin;
+  if (rstart != s->threadstart) {
+    PetscCall(PetscFree(s->threadstart));
+    if (rstart && nt > 1) {
+      PetscCall(PetscMalloc1(nt + 1, &s->threadstart));
+      PetscCall(PetscArraycpy(s->threadstart, rstart, nt + 1));
+    }
+  }
+  s->nthreads = nt;
+  if (nt <= 1 || len <= 0 || !s->array_allocated || s->array != s->array_allocated || s->unplacedarray) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscMalloc1(len, &array));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(v, len, t, &start, &end);
+    for (PetscInt i = start; i < end; i++) array[i] = old[i];
+  }
+  PetscCall(PetscFree(s->array_allocated));
+  s->array           = array;
+  s->array_allocated = array;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*
+   VecThreadsSetPartition_Private - Makes thread t of the nt threads of the kernels of a VECSEQ or VECMPI vector process
+   the local entries [rstart[t], rstart[t+1]), or equal chunks if rstart is NULL, and first touches the array accordingly;
+   other vector types are ignored. Used by MatCreateVecs() for a threaded SeqAIJ matrix so that the vectors follow the
+   row partition of the matrix.
+*/
+PetscErrorCode VecThreadsSetPartition_Private(Vec v, PetscInt nt, const PetscInt rstart[])
+{
+  PetscBool flg;
+  PetscInt  len = v->map->n;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)v, &flg, VECSEQ, VECMPI, ""));
+  if (!flg || nt <= 1) PetscFunctionReturn(PETSC_SUCCESS);
+  if (rstart) {
+    PetscCheck(rstart[0] == 0 && rstart[nt] == v->map->n, PETSC_COMM_SELF, PETSC_ERR_ARG_SIZ, "Thread partition [%" PetscInt_FMT ", %" PetscInt_FMT ") does not match the local size %" PetscInt_FMT, rstart[0], rstart[nt], v->map->n);
+    for (PetscInt t = 0; t < nt; t++) PetscCheck(rstart[t] <= rstart[t + 1], PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Thread partition must be nondecreasing");
+  }
+  PetscCall(PetscObjectTypeCompare((PetscObject)v, VECMPI, &flg));
+  if (flg) {
+    Vec_MPI *x = (Vec_MPI *)v->data;
+
+    /* The local representation of a ghosted vector shares the array, so it cannot be moved for first touch */
+    len = x->localrep ? 0 : len + x->nghost;
+  }
+  PetscCall(VecThreadsSetUp_Private(v, nt, rstart, len));
+  PetscCall(PetscInfo(v, "Using %" PetscInt_FMT " threads with %s\n", nt, rstart ? "the given partition of the entries" : "equal chunks of entries"));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Processes -vec_threads for a vector whose own array has len entries, see VecThreadsSetUp_Private() */
+PetscErrorCode VecSetFromOptions_Threads_Private(Vec v, PetscOptionItems *PetscOptionsObject, PetscInt len)
+{
+  Vec_Seq  *s = (Vec_Seq *)v->data;
+  PetscInt  nt = PetscMax(s->nthreads, 1);
+  PetscBool flg;
+
+  PetscFunctionBegin;
+  /* Device vector types reuse the VECSEQ and VECMPI operations but keep their own arrays */
+  PetscCall(PetscObjectTypeCompareAny((PetscObject)v, &flg, VECSEQ, VECMPI, ""));
+  if (!flg) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(PetscOptionsInt("-vec_threads", "Number of threads used by the vector kernels, PETSC_DECIDE uses -omp_num_threads", "VecSetFromOptions", nt, &nt, &flg));
+  if (flg) {
+#if defined(PETSC_HAVE_OPENMP)
+    if (nt == PETSC_DECIDE) nt = PetscNumOMPThreads;
+    PetscCheck(nt >= 1, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of threads %" PetscInt_FMT " must be positive", nt);
+    if (nt != s->nthreads) PetscCall(VecThreadsSetUp_Private(v, nt, NULL, len));
+#else
+    if (nt != 1) PetscCall(PetscInfo(v, "Ignoring -vec_threads %" PetscInt_FMT " since PETSc was not configured with OpenMP\n", nt));
+#endif
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecSet_Seq_Threads(Vec xin, PetscScalar alpha)
+{
+  const PetscInt nt = VecThreads_Private(xin), n = xin->map->n;
+  PetscScalar   *xx;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayWrite(xin, &xx));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(xin, n, t, &start, &end);
+    for (PetscInt i = start; i < end; i++) xx[i] = alpha;
+  }
+  PetscCall(VecRestoreArrayWrite(xin, &xx));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecCopy_Seq_Threads(Vec xin, Vec yin)
+{
+  const PetscInt     nt = VecThreads_Private(yin), n = yin->map->n;
+  const PetscScalar *xx;
+  PetscScalar       *yy;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscCall(VecGetArray(yin, &yy));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(yin, n, t, &start, &end);
+    for (PetscInt i = start; i < end; i++) yy[i] = xx[i];
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  PetscCall(VecRestoreArray(yin, &yy));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecScale_Seq_Threads(Vec xin, PetscScalar alpha)
+{
+  const PetscInt nt = VecThreads_Private(xin), n = xin->map->n;
+  PetscScalar   *xx;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArray(xin, &xx));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(xin, n, t, &start, &end);
+    for (PetscInt i = start; i < end; i++) xx[i] *= alpha;
+  }
+  PetscCall(VecRestoreArray(xin, &xx));
+  PetscCall(PetscLogFlops(n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecAXPY_Seq_Threads(Vec yin, PetscScalar alpha, Vec xin)
+{
+  const PetscInt     nt = VecThreads_Private(yin), n = yin->map->n;
+  const PetscScalar *xx;
+  PetscScalar       *yy;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscCall(VecGetArray(yin, &yy));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(yin, n, t, &start, &end);
+    for (PetscInt i = start; i < end; i++) yy[i] += alpha * xx[i];
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  PetscCall(VecRestoreArray(yin, &yy));
+  PetscCall(PetscLogFlops(2.0 * n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* y = x + alpha y */
+PetscErrorCode VecAYPX_Seq_Threads(Vec yin, PetscScalar alpha, Vec xin)
+{
+  const PetscInt     nt = VecThreads_Private(yin), n = yin->map->n;
+  const PetscScalar *xx;
+  PetscScalar       *yy;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscCall(VecGetArray(yin, &yy));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(yin, n, t, &start, &end);
+    for (PetscInt i = start; i < end; i++) yy[i] = xx[i] + alpha * yy[i];
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  PetscCall(VecRestoreArray(yin, &yy));
+  PetscCall(PetscLogFlops(alpha == (PetscScalar)-1.0 ? n : 2.0 * n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* w = alpha x + y */
+PetscErrorCode VecWAXPY_Seq_Threads(Vec win, PetscScalar alpha, Vec xin, Vec yin)
+{
+  const PetscInt     nt = VecThreads_Private(win), n = win->map->n;
+  const PetscScalar *xx, *yy;
+  PetscScalar       *ww;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscCall(VecGetArrayRead(yin, &yy));
+  PetscCall(VecGetArray(win, &ww));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(win, n, t, &start, &end);
+    if (alpha == (PetscScalar)0.0) {
+      /* do not touch x, it may hold Inf or NaN */
+      for (PetscInt i = start; i < end; i++) ww[i] = yy[i];
+    } else if (alpha == (PetscScalar)1.0) {
+      for (PetscInt i = start; i < end; i++) ww[i] = yy[i] + xx[i];
+    } else if (alpha == (PetscScalar)-1.0) {
+      for (PetscInt i = start; i < end; i++) ww[i] = yy[i] - xx[i];
+    } else {
+      for (PetscInt i = start; i < end; i++) ww[i] = yy[i] + alpha * xx[i];
+    }
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  PetscCall(VecRestoreArrayRead(yin, &yy));
+  PetscCall(VecRestoreArray(win, &ww));
+  if (alpha == (PetscScalar)1.0 || alpha == (PetscScalar)-1.0) PetscCall(PetscLogFlops(n));
+  else if (alpha != (PetscScalar)0.0) PetscCall(PetscLogFlops(2.0 * n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* z = alpha x + beta y + gamma z */
+PetscErrorCode VecAXPBYPCZ_Seq_Threads(Vec zin, PetscScalar alpha, PetscScalar beta, PetscScalar gamma, Vec xin, Vec yin)
+{
+  const PetscInt     nt = VecThreads_Private(zin), n = zin->map->n;
+  const PetscScalar *xx, *yy;
+  PetscScalar       *zz;
+  PetscInt           flops = 4 * n;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscCall(VecGetArrayRead(yin, &yy));
+  PetscCall(VecGetArray(zin, &zz));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(zin, n, t, &start, &end);
+    if (gamma == (PetscScalar)0.0) {
+      for (PetscInt i = start; i < end; i++) zz[i] = alpha * xx[i] + beta * yy[i];
+    } else {
+      for (PetscInt i = start; i < end; i++) zz[i] = alpha * xx[i] + beta * yy[i] + gamma * zz[i];
+    }
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  PetscCall(VecRestoreArrayRead(yin, &yy));
+  PetscCall(VecRestoreArray(zin, &zz));
+  if (gamma == (PetscScalar)0.0) flops -= n;
+  else if (alpha != (PetscScalar)1.0 && gamma != (PetscScalar)1.0) flops += n;
+  PetscCall(PetscLogFlops(flops));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* x = x + sum_j alpha[j] y[j], processing the y[j] four at a time so each chunk of x is loaded once per four vectors */
+PetscErrorCode VecMAXPY_Seq_Threads(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec *y)
+{
+  const PetscInt      nt = VecThreads_Private(xin), n = xin->map->n;
+  const PetscScalar **yy;
+  PetscScalar        *xx;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(nv, &yy));
+  for (PetscInt j = 0; j < nv; j++) PetscCall(VecGetArrayRead(y[j], &yy[j]));
+  PetscCall(VecGetArray(xin, &xx));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end, j = 0;
+
+    VecThreadsGetRange_Private(xin, n, t, &start, &end);
+    for (; j + 4 <= nv; j += 4) {
+      const PetscScalar  a0 = alpha[j], a1 = alpha[j + 1], a2 = alpha[j + 2], a3 = alpha[j + 3];
+      const PetscScalar *y0 = yy[j], *y1 = yy[j + 1], *y2 = yy[j + 2], *y3 = yy[j + 3];
+
+      for (PetscInt i = start; i < end; i++) xx[i] += a0 * y0[i] + a1 * y1[i] + a2 * y2[i] + a3 * y3[i];
+    }
+    for (; j < nv; j++) {
+      const PetscScalar  a0 = alpha[j];
+      const PetscScalar *y0 = yy[j];
+
+      for (PetscInt i = start; i < end; i++) xx[i] += a0 * y0[i];
+    }
+  }
+  PetscCall(VecRestoreArray(xin, &xx));
+  for (PetscInt j = 0; j < nv; j++) PetscCall(VecRestoreArrayRead(y[j], &yy[j]));
+  PetscCall(PetscFree(yy));
+  PetscCall(PetscLogFlops(nv * 2.0 * n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* z = y^H x */
+PetscErrorCode VecDot_Seq_Threads(Vec xin, Vec yin, PetscScalar *z)
+{
+  const PetscInt     nt = VecThreads_Private(xin), n = xin->map->n;
+  const PetscScalar *xx, *yy;
+  PetscScalar       *work, sum = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(nt, &work));
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscCall(VecGetArrayRead(yin, &yy));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt    start, end;
+    PetscScalar s = 0.0;
+
+    VecThreadsGetRange_Private(xin, n, t, &start, &end);
+    for (PetscInt i = start; i < end; i++) s += xx[i] * PetscConj(yy[i]);
+    work[t] = s;
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  PetscCall(VecRestoreArrayRead(yin, &yy));
+  for (PetscInt t = 0; t < nt; t++) sum += work[t];
+  PetscCall(PetscFree(work));
+  *z = sum;
+  if (n > 0) PetscCall(PetscLogFlops(2.0 * n - 1));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* z[j] = y[j]^H x */
+PetscErrorCode VecMDot_Seq_Threads(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z)
+{
+  const PetscInt      nt = VecThreads_Private(xin), n = xin->map->n;
+  const PetscScalar  *xx, **yy;
+  PetscScalar        *work;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc2(nv, &yy, nt * nv, &work));
+  for (PetscInt j = 0; j < nv; j++) PetscCall(VecGetArrayRead(yin[j], &yy[j]));
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(xin, n, t, &start, &end);
+    for (PetscInt j = 0; j < nv; j++) {
+      const PetscScalar *yj = yy[j];
+      PetscScalar        s  = 0.0;
+
+      for (PetscInt i = start; i < end; i++) s += xx[i] * PetscConj(yj[i]);
+      work[t * nv + j] = s;
+    }
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  for (PetscInt j = 0; j < nv; j++) PetscCall(VecRestoreArrayRead(yin[j], &yy[j]));
+  for (PetscInt j = 0; j < nv; j++) {
+    PetscScalar sum = 0.0;
+
+    for (PetscInt t = 0; t < nt; t++) sum += work[t * nv + j];
+    z[j] = sum;
+  }
+  PetscCall(PetscFree2(yy, work));
+  PetscCall(PetscLogFlops(PetscMax(nv * (2.0 * n - 1), 0.0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecNorm_Seq_Threads(Vec xin, NormType type, PetscReal *z)
+{
+  const PetscInt     nt = VecThreads_Private(xin), n = xin->map->n;
+  const PetscBool    do1 = (type == NORM_1 || type == NORM_1_AND_2) ? PETSC_TRUE : PETSC_FALSE;
+  const PetscBool    do2 = (type == NORM_2 || type == NORM_FROBENIUS || type == NORM_1_AND_2) ? PETSC_TRUE : PETSC_FALSE;
+  const PetscScalar *xx;
+  PetscReal         *work, sum1 = 0.0, sum2 = 0.0, max = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(2 * nt, &work));
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt  start, end;
+    PetscReal s1 = 0.0, s2 = 0.0;
+
+    VecThreadsGetRange_Private(xin, n, t, &start, &end);
+    if (type == NORM_INFINITY) {
+      for (PetscInt i = start; i < end; i++) {
+        const PetscReal tmp = PetscAbsScalar(xx[i]);
+
+        /* check special case of tmp == NaN */
+        if ((tmp > s1) || (tmp != tmp)) {
+          s1 = tmp;
+          if (tmp != tmp) break;
+        }
+      }
+    } else {
+      if (do1) {
+        for (PetscInt i = start; i < end; i++) s1 += PetscAbsScalar(xx[i]);
+      }
+      if (do2) {
+        for (PetscInt i = start; i < end; i++) s2 += PetscRealPart(xx[i] * PetscConj(xx[i]));
+      }
+    }
+    work[2 * t]     = s1;
+    work[2 * t + 1] = s2;
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  for (PetscInt t = 0; t < nt; t++) {
+    const PetscReal s1 = work[2 * t];
+
+    if (type == NORM_INFINITY) {
+      if ((s1 > max) || (s1 != s1)) {
+        max = s1;
+        if (s1 != s1) break;
+      }
+    } else {
+      sum1 += s1;
+      sum2 += work[2 * t + 1];
+    }
+  }
+  PetscCall(PetscFree(work));
+  if (type == NORM_INFINITY) z[0] = max;
+  else if (type == NORM_1) z[0] = sum1;
+  else if (type == NORM_1_AND_2) {
+    z[0] = sum1;
+    z[1] = PetscSqrtReal(sum2);
+  } else z[0] = PetscSqrtReal(sum2);
+  if (n > 0) {
+    if (do1) PetscCall(PetscLogFlops(n - 1.0));
+    if (do2) PetscCall(PetscLogFlops(2.0 * n - 1));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecPointwiseMult_Seq_Threads(Vec win, Vec xin, Vec yin)
+{
+  const PetscInt     nt = VecThreads_Private(win), n = win->map->n;
+  const PetscScalar *xx, *yy;
+  PetscScalar       *ww;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscCall(VecGetArrayRead(yin, &yy));
+  PetscCall(VecGetArray(win, &ww));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(win, n, t, &start, &end);
+    for (PetscInt i = start; i < end; i++) ww[i] = xx[i] * yy[i];
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  PetscCall(VecRestoreArrayRead(yin, &yy));
+  PetscCall(VecRestoreArray(win, &ww));
+  PetscCall(PetscLogFlops(n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* w[i] = func(x[i], y[i]), used by VecPointwiseDivide(), VecPointwiseMax() and friends */
+PetscErrorCode VecPointwiseApply_Seq_Threads(Vec win, Vec xin, Vec yin, PetscScalar (*const func)(PetscScalar, PetscScalar))
+{
+  const PetscInt     nt = VecThreads_Private(win), n = win->map->n;
+  const PetscScalar *xx, *yy;
+  PetscScalar       *ww;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscCall(VecGetArrayRead(yin, &yy));
+  PetscCall(VecGetArray(win, &ww));
+  PetscPragmaOMP(parallel for num_threads(nt) schedule(static, 1))
+  for (PetscInt t = 0; t < nt; t++) {
+    PetscInt start, end;
+
+    VecThreadsGetRange_Private(win, n, t, &start, &end);
+    for (PetscInt i = start; i < end; i++) ww[i] = func(xx[i], yy[i]);
+  }
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  PetscCall(VecRestoreArrayRead(yin, &yy));
+  PetscCall(VecRestoreArray(win, &ww));
+  PetscCall(PetscLogFlops(n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
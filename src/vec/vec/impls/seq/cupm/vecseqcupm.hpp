@@ -333,6 +333,8 @@ inline PetscErrorCode VecSeq_CUPM<T>::BindToCPU(Vec v, PetscBool usehost) noexce
   VecSetOp_CUPM(norm, VecNorm_Seq, Norm);
   VecSetOp_CUPM(tdot, VecTDot_Seq, TDot);
   VecSetOp_CUPM(mdot, VecMDot_Seq, MDot);
+  VecSetOp_CUPM(maxpymdot, VecMAXPYMDot_Seq, nullptr);
+  VecSetOp_CUPM(waxpydotnorm, VecWAXPYDotNorm_Seq, nullptr);
   VecSetOp_CUPM(resetarray, VecResetArray_Seq, base_type::template ResetArray<PETSC_MEMTYPE_HOST>);
   VecSetOp_CUPM(placearray, VecPlaceArray_Seq, base_type::template PlaceArray<PETSC_MEMTYPE_HOST>);
   v->ops->mtdot = v->ops->mtdot_local = VecMTDot_Seq;
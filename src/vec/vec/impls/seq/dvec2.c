@@ -17,6 +17,10 @@ PetscErrorCode VecMDot_Seq(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z
   Vec               *yy = (Vec *)yin;
 
   PetscFunctionBegin;
+  if (VecThreads_Private(xin) > 1) {
+    PetscCall(VecMDot_Seq_Threads(xin, nv, yin, z));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(VecGetArrayRead(xin, &x));
   switch (nv_rem) {
   case 3:
@@ -90,6 +94,10 @@ PetscErrorCode VecMDot_Seq(Vec xin, PetscInt nv, const Vec yin[], PetscScalar *z
   const Vec         *yy = (Vec *)yin;
 
   PetscFunctionBegin;
+  if (VecThreads_Private(xin) > 1) {
+    PetscCall(VecMDot_Seq_Threads(xin, nv, yin, z));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(VecGetArrayRead(xin, &xbase));
   x = xbase;
   switch (nv_rem) {
@@ -566,6 +574,10 @@ PetscErrorCode VecSet_Seq(Vec xin, PetscScalar alpha)
   PetscScalar   *xx;
 
   PetscFunctionBegin;
+  if (VecThreads_Private(xin) > 1) {
+    PetscCall(VecSet_Seq_Threads(xin, alpha));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(VecGetArrayWrite(xin, &xx));
   if (alpha == (PetscScalar)0.0) {
     PetscCall(PetscArrayzero(xx, n));
@@ -586,6 +598,10 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec
 #endif
 
   PetscFunctionBegin;
+  if (VecThreads_Private(xin) > 1) {
+    PetscCall(VecMAXPY_Seq_Threads(xin, nv, alpha, y));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(PetscLogFlops(nv * 2.0 * n));
   PetscCall(VecGetArray(xin, &xx));
   for (PetscInt i = 0; i < j_rem; ++i) PetscCall(VecGetArrayRead(y[i], yptr + i));
@@ -613,6 +629,62 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv, const PetscScalar *alpha, Vec
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Computes y = y + sum alpha[j] x[j] followed by z[j] = y dot x[j] (if z is not NULL) and the square of the 2-norm of the
+   new y, without the reductions. The rows are processed in blocks small enough that the blocks of all the x[j] are still
+   in cache when the dot products are computed, so each x[j] is read from memory only once.
+*/
+#define VEC_MAXPYMDOT_CACHE 32768 /* number of scalars of the vectors that should fit in cache */
+
+PetscErrorCode VecMAXPYMDot_Seq_Private(Vec yin, PetscInt nv, const PetscScalar *alpha, Vec *x, PetscScalar *z, PetscReal *nrm2)
+{
+  const PetscInt      n = yin->map->n, bs = PetscMax(VEC_MAXPYMDOT_CACHE / (nv + 1), 64);
+  const PetscScalar **xx;
+  PetscScalar        *yy;
+  PetscReal           sum2 = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(PetscMalloc1(nv, &xx));
+  for (PetscInt j = 0; j < nv; j++) PetscCall(VecGetArrayRead(x[j], &xx[j]));
+  PetscCall(VecGetArray(yin, &yy));
+  if (z) PetscCall(PetscArrayzero(z, nv));
+  for (PetscInt start = 0; start < n; start += bs) {
+    const PetscInt end = PetscMin(start + bs, n);
+
+    for (PetscInt j = 0; j < nv; j++) {
+      const PetscScalar  a  = alpha[j];
+      const PetscScalar *xj = xx[j];
+
+      if (a == (PetscScalar)0.0) continue;
+      for (PetscInt i = start; i < end; i++) yy[i] += a * xj[i];
+    }
+    if (z) {
+      for (PetscInt j = 0; j < nv; j++) {
+        const PetscScalar *xj  = xx[j];
+        PetscScalar        sum = 0.0;
+
+        for (PetscInt i = start; i < end; i++) sum += yy[i] * PetscConj(xj[i]);
+        z[j] += sum;
+      }
+    }
+    for (PetscInt i = start; i < end; i++) sum2 += PetscRealPart(yy[i] * PetscConj(yy[i]));
+  }
+  PetscCall(VecRestoreArray(yin, &yy));
+  for (PetscInt j = 0; j < nv; j++) PetscCall(VecRestoreArrayRead(x[j], &xx[j]));
+  PetscCall(PetscFree(xx));
+  *nrm2 = sum2;
+  PetscCall(PetscLogFlops((z ? 4.0 : 2.0) * nv * n + 2.0 * n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecMAXPYMDot_Seq(Vec yin, PetscInt nv, const PetscScalar *alpha, Vec *x, PetscScalar *z, PetscReal *nrm)
+{
+  PetscFunctionBegin;
+  PetscCall(VecMAXPYMDot_Seq_Private(yin, nv, alpha, x, z, nrm));
+  *nrm = PetscSqrtReal(*nrm);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 #include <../src/vec/vec/impls/seq/ftn-kernels/faypx.h>
 
 PetscErrorCode VecAYPX_Seq(Vec yin, PetscScalar alpha, Vec xin)
@@ -622,6 +694,8 @@ PetscErrorCode VecAYPX_Seq(Vec yin, PetscScalar alpha, Vec xin)
     PetscCall(VecCopy(xin, yin));
   } else if (alpha == (PetscScalar)1.0) {
     PetscCall(VecAXPY_Seq(yin, alpha, xin));
+  } else if (VecThreads_Private(yin) > 1) {
+    PetscCall(VecAYPX_Seq_Threads(yin, alpha, xin));
   } else {
     const PetscInt     n = yin->map->n;
     const PetscScalar *xx;
@@ -660,6 +734,10 @@ PetscErrorCode VecWAXPY_Seq(Vec win, PetscScalar alpha, Vec xin, Vec yin)
   PetscScalar       *ww;
 
   PetscFunctionBegin;
+  if (VecThreads_Private(win) > 1) {
+    PetscCall(VecWAXPY_Seq_Threads(win, alpha, xin, yin));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
   PetscCall(VecGetArrayRead(xin, &xx));
   PetscCall(VecGetArrayRead(yin, &yy));
   PetscCall(VecGetArray(win, &ww));
@@ -686,6 +764,63 @@ PetscErrorCode VecWAXPY_Seq(Vec win, PetscScalar alpha, Vec xin, Vec yin)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*
+   Computes w = y + alpha x followed by val = w dot z (if z is not NULL) and the square of the 2-norm of the new w (if
+   nrm2 is not NULL), without the reductions, in one sweep over the vectors. w may be x or y, z may be any of them.
+*/
+PetscErrorCode VecWAXPYDotNorm_Seq_Private(Vec win, PetscScalar alpha, Vec xin, Vec yin, Vec zin, PetscScalar *val, PetscReal *nrm2)
+{
+  const PetscInt     n = win->map->n;
+  const PetscScalar *xx, *yy, *zz = NULL;
+  PetscScalar       *ww, sum = 0.0;
+  PetscReal          sum2 = 0.0;
+
+  PetscFunctionBegin;
+  PetscCall(VecGetArrayRead(xin, &xx));
+  PetscCall(VecGetArrayRead(yin, &yy));
+  if (zin) PetscCall(VecGetArrayRead(zin, &zz));
+  PetscCall(VecGetArray(win, &ww));
+  if (zz && nrm2) {
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscScalar w = yy[i] + alpha * xx[i];
+
+      ww[i] = w;
+      sum += w * PetscConj(zz[i]);
+      sum2 += PetscRealPart(w * PetscConj(w));
+    }
+  } else if (zz) {
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscScalar w = yy[i] + alpha * xx[i];
+
+      ww[i] = w;
+      sum += w * PetscConj(zz[i]);
+    }
+  } else {
+    for (PetscInt i = 0; i < n; i++) {
+      const PetscScalar w = yy[i] + alpha * xx[i];
+
+      ww[i] = w;
+      sum2 += PetscRealPart(w * PetscConj(w));
+    }
+  }
+  PetscCall(VecRestoreArray(win, &ww));
+  if (zin) PetscCall(VecRestoreArrayRead(zin, &zz));
+  PetscCall(VecRestoreArrayRead(yin, &yy));
+  PetscCall(VecRestoreArrayRead(xin, &xx));
+  if (val) *val = sum;
+  if (nrm2) *nrm2 = sum2;
+  PetscCall(PetscLogFlops(2.0 * n + (zin ? 2.0 * n : 0.0) + (nrm2 ? 2.0 * n : 0.0)));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+PetscErrorCode VecWAXPYDotNorm_Seq(Vec win, PetscScalar alpha, Vec xin, Vec yin, Vec zin, PetscScalar *val, PetscReal *nrm)
+{
+  PetscFunctionBegin;
+  PetscCall(VecWAXPYDotNorm_Seq_Private(win, alpha, xin, yin, zin, val, nrm));
+  if (nrm) *nrm = PetscSqrtReal(*nrm);
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 PetscErrorCode VecMaxPointwiseDivide_Seq(Vec xin, Vec yin, PetscReal *max)
 {
   const PetscInt     n = xin->map->n;
@@ -1201,6 +1201,8 @@ static PetscErrorCode VecBindToCPU_SeqAIJViennaCL(Vec V, PetscBool flg)
     V->ops->mdot_local      = VecMDot_Seq;
     V->ops->mtdot_local     = VecMTDot_Seq;
     V->ops->maxpy           = VecMAXPY_Seq;
+    V->ops->maxpymdot       = VecMAXPYMDot_Seq;
+    V->ops->waxpydotnorm    = VecWAXPYDotNorm_Seq;
     V->ops->mdot            = VecMDot_Seq;
     V->ops->mtdot           = VecMTDot_Seq;
     V->ops->aypx            = VecAYPX_Seq;
@@ -1230,6 +1232,8 @@ static PetscErrorCode VecBindToCPU_SeqAIJViennaCL(Vec V, PetscBool flg)
     V->ops->mdot_local      = VecMDot_SeqViennaCL;
     V->ops->mtdot_local     = VecMTDot_SeqViennaCL;
     V->ops->maxpy           = VecMAXPY_SeqViennaCL;
+    V->ops->maxpymdot       = NULL;
+    V->ops->waxpydotnorm    = NULL;
     V->ops->mdot            = VecMDot_SeqViennaCL;
     V->ops->mtdot           = VecMTDot_SeqViennaCL;
     V->ops->aypx            = VecAYPX_SeqViennaCL;
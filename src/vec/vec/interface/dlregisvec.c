@@ -193,6 +193,8 @@ PetscErrorCode VecInitializePackage(void)
   PetscCall(PetscLogEventRegister("VecAXPBYCZ", VEC_CLASSID, &VEC_AXPBYPCZ));
   PetscCall(PetscLogEventRegister("VecWAXPY", VEC_CLASSID, &VEC_WAXPY));
   PetscCall(PetscLogEventRegister("VecMAXPY", VEC_CLASSID, &VEC_MAXPY));
+  PetscCall(PetscLogEventRegister("VecMAXPYMDot", VEC_CLASSID, &VEC_MAXPYMDot));
+  PetscCall(PetscLogEventRegister("VecWAXPYDotNorm", VEC_CLASSID, &VEC_WAXPYDotNorm));
   PetscCall(PetscLogEventRegister("VecSwap", VEC_CLASSID, &VEC_Swap));
   PetscCall(PetscLogEventRegister("VecOps", VEC_CLASSID, &VEC_Ops));
   PetscCall(PetscLogEventRegister("VecAssemblyBegin", VEC_CLASSID, &VEC_AssemblyBegin));
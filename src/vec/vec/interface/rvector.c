@@ -826,6 +826,83 @@ PetscErrorCode VecWAXPY(Vec w, PetscScalar alpha, Vec x, Vec y)
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   VecWAXPYDotNorm - Computes `w = alpha x + y`, followed by the dot product of the new `w` with `z` and the 2-norm of the new `w`
+
+   Collective
+
+   Input Parameters:
++  w - the result vector, it may be the same as `x` or `y`, but `x` and `y` must be different
+.  alpha - the scalar
+.  x - first vector, multiplied by `alpha`
+.  y - second vector
+-  z - the vector to compute the dot product with, or `NULL` if the dot product is not needed
+
+   Output Parameters:
++  val - the dot product `z^H w` of the new `w`, or `NULL` if `z` is `NULL`
+-  nrm - the 2-norm of the new `w`, or `NULL` if it is not needed
+
+   Level: developer
+
+   Notes:
+   This is equivalent to `VecWAXPY()` (or `VecAXPY()` and `VecAYPX()` when `w` is `y` or `x`) followed by `VecDot()` and
+   `VecNorm()` with `NORM_2`, but the vector implementations that provide it traverse the vectors only once and perform a
+   single reduction. It is used for the residual update of `KSPCG` with -ksp_cg_fused and `KSPBCGS` with -ksp_bcgs_fused.
+
+   The computed norm is cached in `w` so that a following `VecNorm()` does not recompute it.
+
+.seealso: [](chapter_vectors), `Vec`, `VecWAXPY()`, `VecDot()`, `VecNorm()`, `VecMAXPYMDot()`
+@*/
+PetscErrorCode VecWAXPYDotNorm(Vec w, PetscScalar alpha, Vec x, Vec y, Vec z, PetscScalar *val, PetscReal *nrm)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(w, VEC_CLASSID, 1);
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 3);
+  PetscValidHeaderSpecific(y, VEC_CLASSID, 4);
+  PetscValidType(w, 1);
+  PetscValidType(x, 3);
+  PetscValidType(y, 4);
+  PetscCheckSameTypeAndComm(x, 3, y, 4);
+  PetscCheckSameTypeAndComm(y, 4, w, 1);
+  VecCheckSameSize(x, 3, y, 4);
+  VecCheckSameSize(x, 3, w, 1);
+  if (z) {
+    PetscValidHeaderSpecific(z, VEC_CLASSID, 5);
+    PetscValidType(z, 5);
+    PetscCheckSameTypeAndComm(z, 5, w, 1);
+    VecCheckSameSize(z, 5, w, 1);
+    VecCheckAssembled(z);
+    PetscValidScalarPointer(val, 6);
+  }
+  if (nrm) PetscValidRealPointer(nrm, 7);
+  PetscCheck(x != y, PETSC_COMM_SELF, PETSC_ERR_ARG_IDN, "Input vectors x and y cannot be the same");
+  VecCheckAssembled(x);
+  VecCheckAssembled(y);
+  PetscValidLogicalCollectiveScalar(y, alpha, 2);
+  PetscCall(VecSetErrorIfLocked(w, 1));
+
+  if ((!z && !nrm) || !w->ops->waxpydotnorm) {
+    if (w == y) PetscCall(VecAXPY(w, alpha, x));
+    else if (w == x) PetscCall(VecAYPX(w, alpha, y));
+    else PetscCall(VecWAXPY(w, alpha, x, y));
+    if (z) PetscCall(VecDot(w, z, val));
+    if (nrm) PetscCall(VecNorm(w, NORM_2, nrm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  if (x != w) PetscCall(VecLockReadPush(x));
+  if (y != w) PetscCall(VecLockReadPush(y));
+  if (z && z != w && z != x && z != y) PetscCall(VecLockReadPush(z));
+  PetscCall(PetscLogEventBegin(VEC_WAXPYDotNorm, x, y, w, 0));
+  PetscUseTypeMethod(w, waxpydotnorm, alpha, x, y, z, val, nrm);
+  PetscCall(PetscLogEventEnd(VEC_WAXPYDotNorm, x, y, w, 0));
+  PetscCall(PetscObjectStateIncrease((PetscObject)w));
+  if (nrm) PetscCall(PetscObjectComposedDataSetReal((PetscObject)w, NormIds[NORM_2], *nrm));
+  if (z && z != w && z != x && z != y) PetscCall(VecLockReadPop(z));
+  if (y != w) PetscCall(VecLockReadPop(y));
+  if (x != w) PetscCall(VecLockReadPop(x));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@C
    VecSetValues - Inserts or adds values into certain locations of a vector.
 
@@ -1237,6 +1314,71 @@ PetscErrorCode VecMAXPY(Vec y, PetscInt nv, const PetscScalar alpha[], Vec x[])
   PetscFunctionReturn(PETSC_SUCCESS);
 }
 
+/*@
+   VecMAXPYMDot - Computes `y = y + sum alpha[i] x[i]`, followed by the dot products of the new `y` with the `x` vectors and the 2-norm of the new `y`
+
+   Collective
+
+   Input Parameters:
++  y - one vector
+.  nv - number of scalars and x-vectors
+.  alpha - array of scalars
+-  x - array of vectors
+
+   Output Parameters:
++  val - array of the dot products `x[i]^H y` of the new `y`, or `NULL` if they are not needed
+-  nrm - the 2-norm of the new `y`
+
+   Level: developer
+
+   Notes:
+   This is equivalent to `VecMAXPY()` followed by `VecMDot()` and `VecNorm()` with `NORM_2`, but the vector
+   implementations that provide it traverse the vectors only once and perform a single reduction. It is used
+   by the classical Gram-Schmidt orthogonalization of `KSPGMRES` with -ksp_gmres_cgs_fused.
+
+   The computed norm is cached in `y` so that a following `VecNorm()` or `VecNormalize()` does not recompute it.
+
+   `y` cannot be any of the `x` vectors
+
+.seealso: [](chapter_vectors), `Vec`, `VecMAXPY()`, `VecMDot()`, `VecNorm()`, `KSPGMRESSetCGSRefinementType()`
+@*/
+PetscErrorCode VecMAXPYMDot(Vec y, PetscInt nv, const PetscScalar alpha[], Vec x[], PetscScalar val[], PetscReal *nrm)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y, VEC_CLASSID, 1);
+  VecCheckAssembled(y);
+  PetscValidLogicalCollectiveInt(y, nv, 2);
+  PetscValidRealPointer(nrm, 6);
+  PetscCall(VecSetErrorIfLocked(y, 1));
+  PetscCheck(nv >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of vectors (given %" PetscInt_FMT ") cannot be negative", nv);
+  if (!nv || !y->ops->maxpymdot) {
+    PetscCall(VecMAXPY(y, nv, alpha, x));
+    if (nv && val) PetscCall(VecMDot(y, nv, x, val));
+    PetscCall(VecNorm(y, NORM_2, nrm));
+    PetscFunctionReturn(PETSC_SUCCESS);
+  }
+  PetscValidScalarPointer(alpha, 3);
+  PetscValidPointer(x, 4);
+  if (val) PetscValidScalarPointer(val, 5);
+  for (PetscInt i = 0; i < nv; ++i) {
+    PetscValidLogicalCollectiveScalar(y, alpha[i], 3);
+    PetscValidHeaderSpecific(x[i], VEC_CLASSID, 4);
+    PetscValidType(x[i], 4);
+    PetscCheckSameTypeAndComm(y, 1, x[i], 4);
+    VecCheckSameSize(y, 1, x[i], 4);
+    PetscCheck(y != x[i], PETSC_COMM_SELF, PETSC_ERR_ARG_WRONG, "Array of vectors 'x' cannot contain y, found x[%" PetscInt_FMT "] == y", i);
+    VecCheckAssembled(x[i]);
+    PetscCall(VecLockReadPush(x[i]));
+  }
+  PetscCall(PetscLogEventBegin(VEC_MAXPYMDot, y, *x, 0, 0));
+  PetscUseTypeMethod(y, maxpymdot, nv, alpha, x, val, nrm);
+  PetscCall(PetscLogEventEnd(VEC_MAXPYMDot, y, *x, 0, 0));
+  PetscCall(PetscObjectStateIncrease((PetscObject)y));
+  PetscCall(PetscObjectComposedDataSetReal((PetscObject)y, NormIds[NORM_2], *nrm));
+  for (PetscInt i = 0; i < nv; ++i) PetscCall(VecLockReadPop(x[i]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
 /*@
    VecConcatenate - Creates a new vector that is a vertical concatenation of all the given array of vectors
                     in the order they appear in the array. The concatenated vector resides on the same
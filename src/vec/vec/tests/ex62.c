@@ -0,0 +1,114 @@
+static char help[] = "Tests VecMAXPYMDot() and VecWAXPYDotNorm() against VecMAXPY(), VecWAXPY(), VecMDot(), VecDot() and VecNorm().\n\n";
+
+#include <petscvec.h>
+
+int main(int argc, char **args)
+{
+  Vec         *x, y, w, u;
+  PetscInt     n = 10000, nv = 5, i;
+  PetscScalar *alpha, *val, *valw;
+  PetscReal    nrm, nrmw, err;
+  PetscBool    flg;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-nv", &nv, NULL));
+
+  PetscCall(VecCreate(PETSC_COMM_WORLD, &y));
+  PetscCall(VecSetSizes(y, PETSC_DECIDE, n));
+  PetscCall(VecSetFromOptions(y));
+  PetscCall(VecDuplicate(y, &w));
+  PetscCall(VecDuplicateVecs(y, nv, &x));
+  PetscCall(PetscMalloc3(nv, &alpha, nv, &val, nv, &valw));
+  for (i = 0; i < nv; i++) {
+    PetscCall(VecSetRandom(x[i], NULL));
+    alpha[i] = (i % 3) ? -1.0 / (i + 1) : 0.0; /* zero coefficients are skipped by the update */
+  }
+
+  /* with and without the dot products */
+  for (PetscInt k = 0; k < 2; k++) {
+    PetscCall(VecSetRandom(y, NULL));
+    PetscCall(VecCopy(y, w));
+    PetscCall(VecMAXPYMDot(y, nv, alpha, x, k ? NULL : val, &nrm));
+    PetscCall(VecMAXPY(w, nv, alpha, x));
+    PetscCall(VecMDot(w, nv, x, valw));
+    PetscCall(VecNorm(w, NORM_2, &nrmw));
+    PetscCheck(PetscAbsReal(nrm - nrmw) < 1.e3 * PETSC_MACHINE_EPSILON * nrmw, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Wrong norm %g != %g", (double)nrm, (double)nrmw);
+    if (!k) {
+      for (i = 0; i < nv; i++) {
+        err = PetscAbsScalar(val[i] - valw[i]);
+        PetscCheck(err < 1.e3 * PETSC_MACHINE_EPSILON * PetscMax(PetscAbsScalar(valw[i]), 1.0), PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Wrong dot product %" PetscInt_FMT ": error %g", i, (double)err);
+      }
+    }
+    PetscCall(VecAXPY(w, -1.0, y));
+    PetscCall(VecNorm(w, NORM_INFINITY, &err));
+    PetscCheck(err < 1.e3 * PETSC_MACHINE_EPSILON * nrmw, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Wrong update: error %g", (double)err);
+    /* the norm is cached */
+    PetscCall(VecNormAvailable(y, NORM_2, &flg, &nrmw));
+    PetscCheck(flg && nrmw == nrm, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Norm is not cached");
+  }
+
+  /* VecWAXPYDotNorm() with w different from x and y, then w == y without the dot product and w == x without the norm */
+  PetscCall(VecDuplicate(y, &u));
+  for (PetscInt k = 0; k < 3; k++) {
+    const PetscScalar a = -0.75;
+    Vec               z = k == 1 ? NULL : x[nv - 1];
+    PetscScalar       dot, dotu;
+
+    PetscCall(VecSetRandom(y, NULL));
+    PetscCall(VecCopy(y, u));
+    PetscCall(VecCopy(y, w));
+    if (k == 0) {
+      PetscCall(VecWAXPYDotNorm(w, a, x[0], y, z, &dot, &nrm));
+      PetscCall(VecWAXPY(u, a, x[0], y));
+    } else if (k == 1) {
+      PetscCall(VecWAXPYDotNorm(w, a, x[0], w, z, NULL, &nrm));
+      PetscCall(VecAXPY(u, a, x[0]));
+    } else {
+      PetscCall(VecWAXPYDotNorm(w, a, w, x[0], z, &dot, NULL));
+      PetscCall(VecAYPX(u, a, x[0]));
+    }
+    PetscCall(VecNorm(u, NORM_2, &nrmw));
+    if (k != 2) PetscCheck(PetscAbsReal(nrm - nrmw) < 1.e3 * PETSC_MACHINE_EPSILON * nrmw, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Wrong norm %g != %g in case %" PetscInt_FMT, (double)nrm, (double)nrmw, k);
+    if (z) {
+      PetscCall(VecDot(u, z, &dotu));
+      err = PetscAbsScalar(dot - dotu);
+      PetscCheck(err < 1.e3 * PETSC_MACHINE_EPSILON * PetscMax(PetscAbsScalar(dotu), 1.0), PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Wrong dot product in case %" PetscInt_FMT ": error %g", k, (double)err);
+    }
+    PetscCall(VecAXPY(u, -1.0, w));
+    PetscCall(VecNorm(u, NORM_INFINITY, &err));
+    PetscCheck(err < 1.e3 * PETSC_MACHINE_EPSILON * nrmw, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Wrong update in case %" PetscInt_FMT ": error %g", k, (double)err);
+  }
+
+  PetscCall(PetscFree3(alpha, val, valw));
+  PetscCall(VecDestroyVecs(nv, &x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&w));
+  PetscCall(VecDestroy(&u));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      suffix: 1
+      nsize: {{1 3}}
+      output_file: output/empty.out
+      args: -nv {{1 5 40}}
+
+   test:
+      # more vectors than fit in the reduction buffer on the stack
+      suffix: 2
+      nsize: 2
+      output_file: output/empty.out
+      args: -nv 100 -n 1000
+
+   test:
+      suffix: cuda
+      requires: cuda
+      output_file: output/empty.out
+      args: -vec_type cuda
+
+TEST*/
@@ -0,0 +1,141 @@
+static char help[] = "Tests the thread parallel vector kernels selected with -vec_threads against the sequential ones.\n\n";
+
+#include <petscvec.h>
+
+static PetscErrorCode CheckVec(Vec w, Vec wr, const char *op)
+{
+  Vec       d;
+  PetscReal err, nrm;
+
+  PetscFunctionBegin;
+  PetscCall(VecDuplicate(wr, &d));
+  PetscCall(VecWAXPY(d, -1.0, w, wr));
+  PetscCall(VecNorm(d, NORM_INFINITY, &err));
+  PetscCall(VecNorm(wr, NORM_INFINITY, &nrm));
+  PetscCheck(err <= 1.e2 * PETSC_MACHINE_EPSILON * PetscMax(nrm, 1.0), PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s differs: error %g", op, (double)err);
+  PetscCall(VecDestroy(&d));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode CheckScalar(PetscScalar v, PetscScalar vr, const char *op)
+{
+  PetscFunctionBegin;
+  PetscCheck(PetscAbsScalar(v - vr) <= 1.e3 * PETSC_MACHINE_EPSILON * PetscMax(PetscAbsScalar(vr), 1.0), PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s differs: %g != %g", op, (double)PetscRealPart(v), (double)PetscRealPart(vr));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Vec         x, y, w, xr, yr, wr, *v, *vr;
+  PetscInt    n = 1001, nv = 6, i;
+  PetscScalar alpha[6] = {1.0, -2.0, 0.5, 3.0, -0.25, 2.0}, val[6], valr[6], dot, dotr;
+  PetscReal   nrm[2], nrmr[2];
+  NormType    types[] = {NORM_1, NORM_2, NORM_INFINITY, NORM_1_AND_2};
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+
+  /* x and its duplicates use the options with the thr_ prefix, the reference vectors do not */
+  PetscCall(VecCreate(PETSC_COMM_WORLD, &x));
+  PetscCall(VecSetOptionsPrefix(x, "thr_"));
+  PetscCall(VecSetSizes(x, PETSC_DECIDE, n));
+  PetscCall(VecSetFromOptions(x));
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecDuplicate(x, &w));
+  PetscCall(VecDuplicateVecs(x, nv, &v));
+  PetscCall(VecCreate(PETSC_COMM_WORLD, &xr));
+  PetscCall(VecSetSizes(xr, PETSC_DECIDE, n));
+  PetscCall(VecSetFromOptions(xr));
+  PetscCall(VecDuplicate(xr, &yr));
+  PetscCall(VecDuplicate(xr, &wr));
+  PetscCall(VecDuplicateVecs(xr, nv, &vr));
+
+  PetscCall(VecSetRandom(xr, NULL));
+  PetscCall(VecSetRandom(yr, NULL));
+  PetscCall(VecShift(yr, -0.5));
+  PetscCall(VecCopy(xr, x));
+  PetscCall(VecCopy(yr, y));
+  PetscCall(CheckVec(x, xr, "VecCopy"));
+  for (i = 0; i < nv; i++) {
+    PetscCall(VecSetRandom(vr[i], NULL));
+    PetscCall(VecCopy(vr[i], v[i]));
+  }
+
+  PetscCall(VecSet(w, 2.0));
+  PetscCall(VecSet(wr, 2.0));
+  PetscCall(CheckVec(w, wr, "VecSet"));
+  PetscCall(VecAXPY(w, 3.0, x));
+  PetscCall(VecAXPY(wr, 3.0, xr));
+  PetscCall(CheckVec(w, wr, "VecAXPY"));
+  PetscCall(VecAYPX(w, -0.5, y));
+  PetscCall(VecAYPX(wr, -0.5, yr));
+  PetscCall(CheckVec(w, wr, "VecAYPX"));
+  PetscCall(VecWAXPY(w, 1.5, x, y));
+  PetscCall(VecWAXPY(wr, 1.5, xr, yr));
+  PetscCall(CheckVec(w, wr, "VecWAXPY"));
+  PetscCall(VecAXPBYPCZ(w, 2.0, -1.0, 0.5, x, y));
+  PetscCall(VecAXPBYPCZ(wr, 2.0, -1.0, 0.5, xr, yr));
+  PetscCall(CheckVec(w, wr, "VecAXPBYPCZ"));
+  PetscCall(VecScale(w, -3.0));
+  PetscCall(VecScale(wr, -3.0));
+  PetscCall(CheckVec(w, wr, "VecScale"));
+  for (i = 1; i <= nv; i++) {
+    PetscCall(VecMAXPY(w, i, alpha, v));
+    PetscCall(VecMAXPY(wr, i, alpha, vr));
+    PetscCall(CheckVec(w, wr, "VecMAXPY"));
+  }
+  PetscCall(VecPointwiseMult(w, x, y));
+  PetscCall(VecPointwiseMult(wr, xr, yr));
+  PetscCall(CheckVec(w, wr, "VecPointwiseMult"));
+  PetscCall(VecPointwiseMult(w, w, y));
+  PetscCall(VecPointwiseMult(wr, wr, yr));
+  PetscCall(CheckVec(w, wr, "VecPointwiseMult in place"));
+  PetscCall(VecPointwiseDivide(w, x, y));
+  PetscCall(VecPointwiseDivide(wr, xr, yr));
+  PetscCall(CheckVec(w, wr, "VecPointwiseDivide"));
+  PetscCall(VecPointwiseMax(w, x, y));
+  PetscCall(VecPointwiseMax(wr, xr, yr));
+  PetscCall(CheckVec(w, wr, "VecPointwiseMax"));
+  PetscCall(VecPointwiseMin(w, x, y));
+  PetscCall(VecPointwiseMin(wr, xr, yr));
+  PetscCall(CheckVec(w, wr, "VecPointwiseMin"));
+
+  PetscCall(VecDot(x, y, &dot));
+  PetscCall(VecDot(xr, yr, &dotr));
+  PetscCall(CheckScalar(dot, dotr, "VecDot"));
+  PetscCall(VecMDot(y, nv, v, val));
+  PetscCall(VecMDot(yr, nv, vr, valr));
+  for (i = 0; i < nv; i++) PetscCall(CheckScalar(val[i], valr[i], "VecMDot"));
+  for (i = 0; i < 4; i++) {
+    PetscCall(VecNorm(y, types[i], nrm));
+    PetscCall(VecNorm(yr, types[i], nrmr));
+    PetscCall(CheckScalar(nrm[0], nrmr[0], NormTypes[types[i]]));
+    if (types[i] == NORM_1_AND_2) PetscCall(CheckScalar(nrm[1], nrmr[1], NormTypes[types[i]]));
+  }
+
+  PetscCall(VecDestroyVecs(nv, &v));
+  PetscCall(VecDestroyVecs(nv, &vr));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(VecDestroy(&w));
+  PetscCall(VecDestroy(&xr));
+  PetscCall(VecDestroy(&yr));
+  PetscCall(VecDestroy(&wr));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 2}}
+      output_file: output/empty.out
+      args: -thr_vec_threads {{1 3 4}}
+
+   test:
+      suffix: small
+      output_file: output/empty.out
+      args: -thr_vec_threads 4 -n 2
+
+TEST*/
@@ -0,0 +1,115 @@
+static char help[] = "Tests the asynchronous reduction queue, VecDotAsync(), VecNormAsync() and friends.\n\n";
+
+#include <petscvec.h>
+
+static PetscErrorCode CheckScalar(PetscScalar v, PetscScalar vr, const char *op)
+{
+  PetscFunctionBegin;
+  PetscCheck(PetscAbsScalar(v - vr) <= 1.e3 * PETSC_MACHINE_EPSILON * PetscMax(PetscAbsScalar(vr), 1.0), PETSC_COMM_WORLD, PETSC_ERR_PLIB, "%s differs: %g != %g", op, (double)PetscRealPart(v), (double)PetscRealPart(vr));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+int main(int argc, char **args)
+{
+  Vec          x, y, *v;
+  PetscInt     n = 37, i, k, nbatch = 3;
+  PetscScalar  dot, dotr, vals[3], valsr[3];
+  PetscReal    nrm[2], nrmr[2];
+  PetscBool    flg;
+  VecReduction rdot[40], rnrm[3], rmax, rmdot, rtdot, r12;
+  MPI_Comm     comm;
+
+  PetscFunctionBeginUser;
+  PetscCall(PetscInitialize(&argc, &args, (char *)0, help));
+  PetscCall(PetscOptionsGetInt(NULL, NULL, "-n", &n, NULL));
+  PetscCall(VecCreate(PETSC_COMM_WORLD, &x));
+  PetscCall(VecSetSizes(x, PETSC_DECIDE, n));
+  PetscCall(VecSetFromOptions(x));
+  PetscCall(VecDuplicate(x, &y));
+  PetscCall(VecDuplicateVecs(x, 3, &v));
+  PetscCall(VecSetRandom(x, NULL));
+  PetscCall(VecSetRandom(y, NULL));
+  PetscCall(VecShift(y, -0.5));
+  for (i = 0; i < 3; i++) PetscCall(VecSetRandom(v[i], NULL));
+  PetscCall(PetscObjectGetComm((PetscObject)x, &comm));
+
+  /* several batches in flight at the same time, each one with a dot product and a norm of a changing vector */
+  for (k = 0; k < nbatch; k++) {
+    PetscCall(VecDotAsync(x, y, &rdot[k]));
+    PetscCall(VecNormAsync(y, NORM_2, &rnrm[k]));
+    PetscCall(PetscCommReductionFlush(comm));
+    PetscCall(VecReductionTest(rdot[k], &flg));
+    PetscCall(VecScale(y, 2.0));
+  }
+  PetscCall(VecScale(y, 1.0 / 8.0));
+  /* the results are obtained in reverse order */
+  for (k = nbatch - 1; k >= 0; k--) {
+    PetscCall(VecReductionGetNorm(rnrm[k], nrm));
+    PetscCall(VecReductionGetValues(rdot[k], &dot));
+    PetscCall(VecDot(x, y, &dotr));
+    PetscCall(VecNorm(y, NORM_2, nrmr));
+    PetscCall(CheckScalar(dot, PetscPowInt(2, k) * dotr, "VecDotAsync"));
+    PetscCall(CheckScalar(nrm[0], PetscPowInt(2, k) * nrmr[0], "VecNormAsync"));
+    PetscCall(VecReductionDestroy(&rdot[k]));
+    PetscCall(VecReductionDestroy(&rnrm[k]));
+  }
+
+  /* a batch mixing sums and maxima started implicitly by the first request for a result */
+  PetscCall(VecMDotAsync(x, 3, v, &rmdot));
+  PetscCall(VecNormAsync(x, NORM_MAX, &rmax));
+  PetscCall(VecTDotAsync(x, y, &rtdot));
+  PetscCall(VecNormAsync(x, NORM_1_AND_2, &r12));
+  PetscCall(VecReductionGetNorm(r12, nrm));
+  PetscCall(VecNorm(x, NORM_1_AND_2, nrmr));
+  PetscCall(CheckScalar(nrm[0], nrmr[0], "VecNormAsync NORM_1"));
+  PetscCall(CheckScalar(nrm[1], nrmr[1], "VecNormAsync NORM_2"));
+  PetscCall(VecReductionTest(rmax, &flg));
+  PetscCheck(flg, PETSC_COMM_WORLD, PETSC_ERR_PLIB, "Reduction should have completed");
+  PetscCall(VecReductionGetNorm(rmax, nrm));
+  PetscCall(VecNorm(x, NORM_MAX, nrmr));
+  PetscCall(CheckScalar(nrm[0], nrmr[0], "VecNormAsync NORM_MAX"));
+  PetscCall(VecReductionGetValues(rtdot, &dot));
+  PetscCall(VecTDot(x, y, &dotr));
+  PetscCall(CheckScalar(dot, dotr, "VecTDotAsync"));
+  PetscCall(VecReductionGetValues(rmdot, vals));
+  PetscCall(VecMDot(x, 3, v, valsr));
+  for (i = 0; i < 3; i++) PetscCall(CheckScalar(vals[i], valsr[i], "VecMDotAsync"));
+  PetscCall(VecReductionDestroy(&rmdot));
+  PetscCall(VecReductionDestroy(&rmax));
+  PetscCall(VecReductionDestroy(&rtdot));
+  PetscCall(VecReductionDestroy(&r12));
+
+  /* a batch larger than the initial allocation */
+  for (k = 0; k < 40; k++) PetscCall(VecDotAsync(v[k % 3], y, &rdot[k]));
+  for (k = 0; k < 40; k++) {
+    PetscCall(VecReductionGetValues(rdot[k], &dot));
+    PetscCall(VecDot(v[k % 3], y, &dotr));
+    PetscCall(CheckScalar(dot, dotr, "VecDotAsync"));
+    PetscCall(VecReductionDestroy(&rdot[k]));
+  }
+
+  /* a handle destroyed before its result is obtained */
+  PetscCall(VecDotAsync(x, y, &rdot[0]));
+  PetscCall(VecReductionDestroy(&rdot[0]));
+  PetscCall(PetscCommReductionFlush(comm));
+
+  PetscCall(VecDestroyVecs(3, &v));
+  PetscCall(VecDestroy(&x));
+  PetscCall(VecDestroy(&y));
+  PetscCall(PetscFinalize());
+  return 0;
+}
+
+/*TEST
+
+   test:
+      nsize: {{1 3}}
+      output_file: output/empty.out
+
+   test:
+      suffix: 2
+      nsize: 2
+      output_file: output/empty.out
+      args: -n 1000
+
+TEST*/
@@ -34,6 +34,7 @@ static PetscErrorCode MPIPetsc_Iallreduce(void *sendbuf, void *recvbuf, PetscMPI
 }
 
 static PetscErrorCode PetscSplitReductionApply(PetscSplitReduction *);
+static PetscErrorCode VecReductionBatchRelease(struct _n_VecReductionBatch **);
 
 /*
    PetscSplitReductionCreate - Creates a data structure to contain the queued information.
@@ -266,6 +267,7 @@ PetscErrorCode PetscSplitReductionExtend(PetscSplitReduction *sr)
 PetscErrorCode PetscSplitReductionDestroy(PetscSplitReduction *sr)
 {
   PetscFunctionBegin;
+  PetscCall(VecReductionBatchRelease(&sr->batch));
   PetscCall(PetscFree6(sr->lvalues, sr->gvalues, sr->reducetype, sr->invecs, sr->lvalues_mix, sr->gvalues_mix));
   PetscCall(PetscFree(sr));
   PetscFunctionReturn(PETSC_SUCCESS);
@@ -713,3 +715,497 @@ PetscErrorCode VecMTDotEnd(Vec x, PetscInt nv, const Vec y[], PetscScalar result
   PetscCall(VecMDotEnd(x, nv, y, result));
   PetscFunctionReturn(PETSC_SUCCESS);
 }
+
+/* ----------------------------------------------------------------------------------------------------*/
+/*
+      Asynchronous reduction queue.
+
+   Each communicator has at most one open batch into which VecDotAsync(), VecNormAsync(), ... put their local
+   contributions. PetscCommReductionFlush() starts a single MPI_Iallreduce() for the open batch and detaches it from
+   the communicator, so later reductions go into a new batch while the previous ones are still in flight. Each
+   VecReduction handle holds a reference to its batch, hence the results can be obtained in any order and at any time.
+*/
+typedef struct {
+  PetscScalar v;
+  PetscInt    i;
+} VecReductionScalarInt;
+
+struct _n_VecReductionBatch {
+  PetscInt               refct; /* handles referencing the batch, plus one for the communicator while it is open */
+  MPI_Comm               comm;
+  MPI_Request            request;
+  PetscBool              started, done, mix;
+  PetscInt               n, maxn;
+  PetscScalar           *lvalues, *gvalues;
+  PetscInt              *reducetype;
+  VecReductionScalarInt *lvalues_mix, *gvalues_mix;
+};
+typedef struct _n_VecReductionBatch *VecReductionBatch;
+
+struct _n_VecReduction {
+  VecReductionBatch batch;
+  PetscInt          offset, n; /* location of the values in the batch */
+  PetscBool         isnorm;
+  NormType          ntype;
+  Vec               x;     /* vector whose norm is cached when the result is obtained */
+  PetscObjectState  state; /* state of x when the norm was queued */
+};
+
+static PetscErrorCode VecReductionBatchCreate(MPI_Comm comm, VecReductionBatch *batch)
+{
+  VecReductionBatch b;
+
+  PetscFunctionBegin;
+  PetscCall(PetscNew(&b));
+  b->refct   = 1;
+  b->comm    = comm;
+  b->request = MPI_REQUEST_NULL;
+  b->maxn    = 32;
+  PetscCall(PetscMalloc5(b->maxn, &b->lvalues, b->maxn, &b->gvalues, b->maxn, &b->reducetype, b->maxn, &b->lvalues_mix, b->maxn, &b->gvalues_mix));
+  *batch = b;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Makes room for n more values; only called for a batch that has not been started */
+static PetscErrorCode VecReductionBatchExtend(VecReductionBatch b, PetscInt n)
+{
+  PetscInt              *reducetype = b->reducetype;
+  PetscScalar           *lvalues = b->lvalues, *gvalues = b->gvalues;
+  VecReductionScalarInt *lvalues_mix = b->lvalues_mix, *gvalues_mix = b->gvalues_mix;
+
+  PetscFunctionBegin;
+  if (b->n + n <= b->maxn) PetscFunctionReturn(PETSC_SUCCESS);
+  while (b->n + n > b->maxn) b->maxn *= 2;
+  PetscCall(PetscMalloc5(b->maxn, &b->lvalues, b->maxn, &b->gvalues, b->maxn, &b->reducetype, b->maxn, &b->lvalues_mix, b->maxn, &b->gvalues_mix));
+  PetscCall(PetscArraycpy(b->lvalues, lvalues, b->n));
+  PetscCall(PetscArraycpy(b->reducetype, reducetype, b->n));
+  PetscCall(PetscFree5(lvalues, gvalues, reducetype, lvalues_mix, gvalues_mix));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode VecReductionBatchRelease(VecReductionBatch *batch)
+{
+  VecReductionBatch b = *batch;
+
+  PetscFunctionBegin;
+  *batch = NULL;
+  if (!b || --b->refct > 0) PetscFunctionReturn(PETSC_SUCCESS);
+  /* the buffers may not be freed while the communication is still using them */
+  if (b->request != MPI_REQUEST_NULL) PetscCallMPI(MPI_Wait(&b->request, MPI_STATUS_IGNORE));
+  PetscCall(PetscFree5(b->lvalues, b->gvalues, b->reducetype, b->lvalues_mix, b->gvalues_mix));
+  PetscCall(PetscFree(b));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode VecReductionBatchStart(VecReductionBatch b)
+{
+  PetscInt     i, n = b->n, *reducetype = b->reducetype;
+  PetscScalar *lvalues = b->lvalues, *gvalues = b->gvalues;
+  PetscInt     sum_flg = 0, max_flg = 0, min_flg = 0;
+  MPI_Comm     comm = b->comm;
+  PetscMPIInt  size, cnt, cmul = sizeof(PetscScalar) / sizeof(PetscReal);
+
+  PetscFunctionBegin;
+  PetscCall(PetscLogEventBegin(VEC_ReduceBegin, 0, 0, 0, 0));
+  PetscCallMPI(MPI_Comm_size(comm, &size));
+  PetscCall(PetscMPIIntCast(n, &cnt));
+  if (size == 1) {
+    PetscCall(PetscArraycpy(gvalues, lvalues, n));
+    b->done = PETSC_TRUE;
+  } else {
+    for (i = 0; i < n; i++) {
+      if (reducetype[i] == PETSC_SR_REDUCE_MAX) max_flg = 1;
+      else if (reducetype[i] == PETSC_SR_REDUCE_SUM) sum_flg = 1;
+      else if (reducetype[i] == PETSC_SR_REDUCE_MIN) min_flg = 1;
+      else SETERRQ(PETSC_COMM_SELF, PETSC_ERR_PLIB, "Error in VecReduction data structure, probably memory corruption");
+    }
+    if (sum_flg + max_flg + min_flg > 1) {
+      b->mix = PETSC_TRUE;
+      for (i = 0; i < n; i++) {
+        b->lvalues_mix[i].v = lvalues[i];
+        b->lvalues_mix[i].i = reducetype[i];
+      }
+      PetscCall(MPIPetsc_Iallreduce(b->lvalues_mix, b->gvalues_mix, cnt, MPIU_SCALAR_INT, PetscSplitReduction_Op, comm, &b->request));
+    } else if (max_flg) { /* Compute max of real and imag parts separately, presumably only the real part is used */
+      PetscCall(MPIPetsc_Iallreduce((PetscReal *)lvalues, (PetscReal *)gvalues, cmul * cnt, MPIU_REAL, MPIU_MAX, comm, &b->request));
+    } else if (min_flg) {
+      PetscCall(MPIPetsc_Iallreduce((PetscReal *)lvalues, (PetscReal *)gvalues, cmul * cnt, MPIU_REAL, MPIU_MIN, comm, &b->request));
+    } else {
+      PetscCall(MPIPetsc_Iallreduce(lvalues, gvalues, cnt, MPIU_SCALAR, MPIU_SUM, comm, &b->request));
+    }
+  }
+  b->started = PETSC_TRUE;
+  PetscCall(PetscLogEventEnd(VEC_ReduceBegin, 0, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Called once the communication of a started batch has completed */
+static PetscErrorCode VecReductionBatchFinish(VecReductionBatch b)
+{
+  PetscInt i;
+
+  PetscFunctionBegin;
+  if (b->mix) {
+    for (i = 0; i < b->n; i++) b->gvalues[i] = b->gvalues_mix[i].v;
+  }
+  b->done = PETSC_TRUE;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+static PetscErrorCode VecReductionBatchWait(VecReductionBatch b)
+{
+  PetscFunctionBegin;
+  if (!b->started) PetscCall(PetscCommReductionFlush(b->comm));
+  PetscCheck(b->started, PETSC_COMM_SELF, PETSC_ERR_PLIB, "Reduction batch was not started by PetscCommReductionFlush()");
+  if (!b->done) {
+    PetscCall(PetscLogEventBegin(VEC_ReduceEnd, 0, 0, 0, 0));
+    if (b->request != MPI_REQUEST_NULL) PetscCallMPI(MPI_Wait(&b->request, MPI_STATUS_IGNORE));
+    PetscCall(VecReductionBatchFinish(b));
+    PetscCall(PetscLogEventEnd(VEC_ReduceEnd, 0, 0, 0, 0));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/* Reserves n slots in the open batch of the communicator of x and returns a new handle to them */
+static PetscErrorCode VecReductionCreate_Private(Vec x, PetscInt n, PetscSRReductionType type, VecReduction *r)
+{
+  PetscSplitReduction *sr;
+  VecReductionBatch    b;
+  MPI_Comm             comm;
+  PetscInt             i;
+
+  PetscFunctionBegin;
+  PetscCall(PetscObjectGetComm((PetscObject)x, &comm));
+  PetscCall(PetscSplitReductionGet(comm, &sr));
+  if (!sr->batch) PetscCall(VecReductionBatchCreate(comm, &sr->batch));
+  b = sr->batch;
+  PetscCall(VecReductionBatchExtend(b, n));
+  PetscCall(PetscNew(r));
+  (*r)->batch  = b;
+  (*r)->offset = b->n;
+  (*r)->n      = n;
+  b->refct++;
+  for (i = 0; i < n; i++) b->reducetype[b->n + i] = type;
+  b->n += n;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   VecDotAsync - Queues a dot product on the asynchronous reduction queue of the vector's communicator
+
+   Collective but not synchronizing
+
+   Input Parameters:
++  x - the first vector
+-  y - the second vector
+
+   Output Parameter:
+.  r - handle used to obtain the result with `VecReductionGetValues()`
+
+   Level: advanced
+
+   Notes:
+   Unlike `VecDotBegin()` and `VecDotEnd()` the reductions queued on a communicator need not be completed in the
+   order they were started and new reductions may be queued while previous ones are still being communicated. All the
+   reductions queued since the last `PetscCommReductionFlush()` on the communicator are combined into a single
+   `MPI_Iallreduce()`, which is started by the next `PetscCommReductionFlush()` or by the first request for one of its results.
+
+   Results are computed as with `VecDot()`, that is $ y^H x $.
+
+   The handle must be freed with `VecReductionDestroy()`.
+
+.seealso: `VecReduction`, `VecDot()`, `VecDotBegin()`, `VecTDotAsync()`, `VecMDotAsync()`, `VecNormAsync()`, `PetscCommReductionFlush()`,
+          `VecReductionTest()`, `VecReductionGetValues()`, `VecReductionDestroy()`
+@*/
+PetscErrorCode VecDotAsync(Vec x, Vec y, VecReduction *r)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 1);
+  PetscValidHeaderSpecific(y, VEC_CLASSID, 2);
+  PetscValidPointer(r, 3);
+  PetscCheckSameComm(x, 1, y, 2);
+  PetscCall(VecReductionCreate_Private(x, 1, PETSC_SR_REDUCE_SUM, r));
+  PetscCall(PetscLogEventBegin(VEC_ReduceArithmetic, 0, 0, 0, 0));
+  PetscUseTypeMethod(x, dot_local, y, (*r)->batch->lvalues + (*r)->offset);
+  PetscCall(PetscLogEventEnd(VEC_ReduceArithmetic, 0, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   VecTDotAsync - Queues an indefinite dot product on the asynchronous reduction queue of the vector's communicator
+
+   Collective but not synchronizing
+
+   Input Parameters:
++  x - the first vector
+-  y - the second vector
+
+   Output Parameter:
+.  r - handle used to obtain the result with `VecReductionGetValues()`
+
+   Level: advanced
+
+   Note:
+   See `VecDotAsync()` for how the queued reductions are communicated.
+
+.seealso: `VecReduction`, `VecTDot()`, `VecTDotBegin()`, `VecDotAsync()`, `VecMDotAsync()`, `VecNormAsync()`, `PetscCommReductionFlush()`,
+          `VecReductionTest()`, `VecReductionGetValues()`, `VecReductionDestroy()`
+@*/
+PetscErrorCode VecTDotAsync(Vec x, Vec y, VecReduction *r)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 1);
+  PetscValidHeaderSpecific(y, VEC_CLASSID, 2);
+  PetscValidPointer(r, 3);
+  PetscCheckSameComm(x, 1, y, 2);
+  PetscCall(VecReductionCreate_Private(x, 1, PETSC_SR_REDUCE_SUM, r));
+  PetscCall(PetscLogEventBegin(VEC_ReduceArithmetic, 0, 0, 0, 0));
+  PetscUseTypeMethod(x, tdot_local, y, (*r)->batch->lvalues + (*r)->offset);
+  PetscCall(PetscLogEventEnd(VEC_ReduceArithmetic, 0, 0, 0, 0));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   VecMDotAsync - Queues several dot products on the asynchronous reduction queue of the vector's communicator
+
+   Collective but not synchronizing
+
+   Input Parameters:
++  x - the first vector
+.  nv - number of vectors
+-  y - array of vectors
+
+   Output Parameter:
+.  r - handle used to obtain the `nv` results with `VecReductionGetValues()`
+
+   Level: advanced
+
+   Note:
+   See `VecDotAsync()` for how the queued reductions are communicated.
+
+.seealso: `VecReduction`, `VecMDot()`, `VecMDotBegin()`, `VecDotAsync()`, `VecTDotAsync()`, `VecNormAsync()`, `PetscCommReductionFlush()`,
+          `VecReductionTest()`, `VecReductionGetValues()`, `VecReductionDestroy()`
+@*/
+PetscErrorCode VecMDotAsync(Vec x, PetscInt nv, const Vec y[], VecReduction *r)
+{
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 1);
+  PetscValidLogicalCollectiveInt(x, nv, 2);
+  PetscCheck(nv >= 0, PETSC_COMM_SELF, PETSC_ERR_ARG_OUTOFRANGE, "Number of vectors (given %" PetscInt_FMT ") cannot be negative", nv);
+  if (nv) PetscValidPointer(y, 3);
+  PetscValidPointer(r, 4);
+  PetscCall(VecReductionCreate_Private(x, nv, PETSC_SR_REDUCE_SUM, r));
+  if (nv) {
+    PetscCall(PetscLogEventBegin(VEC_ReduceArithmetic, 0, 0, 0, 0));
+    PetscUseTypeMethod(x, mdot_local, nv, y, (*r)->batch->lvalues + (*r)->offset);
+    PetscCall(PetscLogEventEnd(VEC_ReduceArithmetic, 0, 0, 0, 0));
+  }
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   VecNormAsync - Queues a norm computation on the asynchronous reduction queue of the vector's communicator
+
+   Collective but not synchronizing
+
+   Input Parameters:
++  x - the vector
+-  ntype - norm type, one of `NORM_1`, `NORM_2`, `NORM_MAX`, `NORM_1_AND_2`
+
+   Output Parameter:
+.  r - handle used to obtain the result with `VecReductionGetNorm()`
+
+   Level: advanced
+
+   Notes:
+   See `VecDotAsync()` for how the queued reductions are communicated.
+
+   If `x` has not been changed when the result is obtained the norm is cached in the vector, as with `VecNorm()`.
+
+.seealso: `VecReduction`, `VecNorm()`, `VecNormBegin()`, `VecDotAsync()`, `VecTDotAsync()`, `VecMDotAsync()`, `PetscCommReductionFlush()`,
+          `VecReductionTest()`, `VecReductionGetNorm()`, `VecReductionDestroy()`
+@*/
+PetscErrorCode VecNormAsync(Vec x, NormType ntype, VecReduction *r)
+{
+  PetscReal    lresult[2];
+  PetscScalar *lvalues;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(x, VEC_CLASSID, 1);
+  PetscValidLogicalCollectiveEnum(x, ntype, 2);
+  PetscValidPointer(r, 3);
+  PetscCall(VecReductionCreate_Private(x, ntype == NORM_1_AND_2 ? 2 : 1, ntype == NORM_MAX ? PETSC_SR_REDUCE_MAX : PETSC_SR_REDUCE_SUM, r));
+  PetscCall(PetscLogEventBegin(VEC_ReduceArithmetic, 0, 0, 0, 0));
+  PetscUseTypeMethod(x, norm_local, ntype, lresult);
+  PetscCall(PetscLogEventEnd(VEC_ReduceArithmetic, 0, 0, 0, 0));
+  if (ntype == NORM_2) lresult[0] = lresult[0] * lresult[0];
+  if (ntype == NORM_1_AND_2) lresult[1] = lresult[1] * lresult[1];
+  lvalues    = (*r)->batch->lvalues + (*r)->offset;
+  lvalues[0] = lresult[0];
+  if (ntype == NORM_1_AND_2) lvalues[1] = lresult[1];
+  (*r)->isnorm = PETSC_TRUE;
+  (*r)->ntype  = ntype;
+  (*r)->x      = x;
+  PetscCall(PetscObjectReference((PetscObject)x));
+  PetscCall(PetscObjectStateGet((PetscObject)x, &(*r)->state));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   PetscCommReductionFlush - Starts the communication for all the reductions queued on a communicator with `VecDotAsync()`,
+   `VecNormAsync()` and related routines
+
+   Collective but not synchronizing
+
+   Input Parameter:
+.  comm - communicator on which the reductions have been queued
+
+   Level: advanced
+
+   Notes:
+   All the queued reductions are combined into a single `MPI_Iallreduce()`. Reductions queued after this call go into a new
+   batch, so the communication of this one can progress while the caller continues to work, for example on the next iteration
+   of a Krylov method. The results are obtained with `VecReductionGetValues()` or `VecReductionGetNorm()`.
+
+   Calling this function is optional, the communication is started when the first result of the batch is requested.
+
+   If MPI does not support nonblocking collectives the reduction is completed by this call.
+
+.seealso: `VecReduction`, `VecDotAsync()`, `VecTDotAsync()`, `VecMDotAsync()`, `VecNormAsync()`, `VecReductionTest()`, `PetscCommSplitReductionBegin()`
+@*/
+PetscErrorCode PetscCommReductionFlush(MPI_Comm comm)
+{
+  PetscSplitReduction *sr;
+
+  PetscFunctionBegin;
+  PetscCall(PetscSplitReductionGet(comm, &sr));
+  if (!sr->batch || !sr->batch->n) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecReductionBatchStart(sr->batch));
+  PetscCall(VecReductionBatchRelease(&sr->batch));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   VecReductionTest - Checks if the result of a queued reduction is available
+
+   Not Collective
+
+   Input Parameter:
+.  r - the reduction handle
+
+   Output Parameter:
+.  flg - `PETSC_TRUE` if the result can be obtained without waiting
+
+   Level: advanced
+
+   Note:
+   This does not start the communication, `flg` is always `PETSC_FALSE` before `PetscCommReductionFlush()` has been called
+   for the batch containing `r`. Calling it also helps MPI implementations that only progress communication from inside MPI calls.
+
+.seealso: `VecReduction`, `VecDotAsync()`, `VecNormAsync()`, `PetscCommReductionFlush()`, `VecReductionGetValues()`, `VecReductionGetNorm()`
+@*/
+PetscErrorCode VecReductionTest(VecReduction r, PetscBool *flg)
+{
+  VecReductionBatch b;
+  PetscMPIInt       done = 1;
+
+  PetscFunctionBegin;
+  PetscValidPointer(r, 1);
+  PetscValidBoolPointer(flg, 2);
+  b    = r->batch;
+  *flg = b->done;
+  if (!b->started || b->done) PetscFunctionReturn(PETSC_SUCCESS);
+  if (b->request != MPI_REQUEST_NULL) PetscCallMPI(MPI_Test(&b->request, &done, MPI_STATUS_IGNORE));
+  if (done) PetscCall(VecReductionBatchFinish(b));
+  *flg = b->done;
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   VecReductionGetValues - Obtains the result of a reduction queued with `VecDotAsync()`, `VecTDotAsync()` or `VecMDotAsync()`,
+   waiting for the communication to complete if needed
+
+   Collective if the communication of the batch containing `r` has not been started
+
+   Input Parameter:
+.  r - the reduction handle
+
+   Output Parameter:
+.  result - the dot product(s), one for `VecDotAsync()` and `VecTDotAsync()` and `nv` for `VecMDotAsync()`
+
+   Level: advanced
+
+   Note:
+   The result may be obtained several times, until `VecReductionDestroy()` is called.
+
+.seealso: `VecReduction`, `VecDotAsync()`, `VecTDotAsync()`, `VecMDotAsync()`, `PetscCommReductionFlush()`, `VecReductionTest()`, `VecReductionDestroy()`
+@*/
+PetscErrorCode VecReductionGetValues(VecReduction r, PetscScalar result[])
+{
+  PetscFunctionBegin;
+  PetscValidPointer(r, 1);
+  if (r->n) PetscValidScalarPointer(result, 2);
+  PetscCheck(!r->isnorm, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Use VecReductionGetNorm() for a reduction started with VecNormAsync()");
+  PetscCall(VecReductionBatchWait(r->batch));
+  PetscCall(PetscArraycpy(result, r->batch->gvalues + r->offset, r->n));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   VecReductionGetNorm - Obtains the result of a norm queued with `VecNormAsync()`, waiting for the communication to complete if needed
+
+   Collective if the communication of the batch containing `r` has not been started
+
+   Input Parameter:
+.  r - the reduction handle
+
+   Output Parameter:
+.  result - the norm, two values for `NORM_1_AND_2`
+
+   Level: advanced
+
+.seealso: `VecReduction`, `VecNormAsync()`, `PetscCommReductionFlush()`, `VecReductionTest()`, `VecReductionDestroy()`
+@*/
+PetscErrorCode VecReductionGetNorm(VecReduction r, PetscReal result[])
+{
+  PetscScalar     *gvalues;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  PetscValidPointer(r, 1);
+  PetscValidRealPointer(result, 2);
+  PetscCheck(r->isnorm, PETSC_COMM_SELF, PETSC_ERR_ARG_WRONGSTATE, "Use VecReductionGetValues() for a reduction not started with VecNormAsync()");
+  PetscCall(VecReductionBatchWait(r->batch));
+  gvalues   = r->batch->gvalues + r->offset;
+  result[0] = PetscRealPart(gvalues[0]);
+  if (r->ntype == NORM_2) result[0] = PetscSqrtReal(result[0]);
+  else if (r->ntype == NORM_1_AND_2) result[1] = PetscSqrtReal(PetscRealPart(gvalues[1]));
+  PetscCall(PetscObjectStateGet((PetscObject)r->x, &state));
+  if (r->ntype != NORM_1_AND_2 && state == r->state) PetscCall(PetscObjectComposedDataSetReal((PetscObject)r->x, NormIds[r->ntype], result[0]));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}
+
+/*@
+   VecReductionDestroy - Frees a handle obtained with `VecDotAsync()`, `VecNormAsync()` or related routines
+
+   Not Collective
+
+   Input Parameter:
+.  r - the reduction handle
+
+   Level: advanced
+
+   Note:
+   The handle may be destroyed without obtaining its result.
+
+.seealso: `VecReduction`, `VecDotAsync()`, `VecTDotAsync()`, `VecMDotAsync()`, `VecNormAsync()`, `VecReductionGetValues()`, `VecReductionGetNorm()`
+@*/
+PetscErrorCode VecReductionDestroy(VecReduction *r)
+{
+  PetscFunctionBegin;
+  if (!*r) PetscFunctionReturn(PETSC_SUCCESS);
+  PetscCall(VecReductionBatchRelease(&(*r)->batch));
+  PetscCall(VecDestroy(&(*r)->x));
+  PetscCall(PetscFree(*r));
+  PetscFunctionReturn(PETSC_SUCCESS);
+}